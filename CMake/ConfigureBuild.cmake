@@ -72,8 +72,10 @@ set(OGRE_SET_CONTAINERS_USE_ALLOCATOR 0)
 set(OGRE_SET_STRING_USE_ALLOCATOR 0)
 set(OGRE_SET_MEMTRACK_DEBUG 0)
 set(OGRE_SET_MEMTRACK_RELEASE 0)
+set(OGRE_SET_MEMORY_STATS 0)
 set(OGRE_SET_THREADS ${OGRE_CONFIG_THREADS})
 set(OGRE_SET_THREAD_PROVIDER ${OGRE_THREAD_PROVIDER})
+set(OGRE_SET_WORK_QUEUE_STEALING 0)
 set(OGRE_SET_DISABLE_FREEIMAGE 0)
 set(OGRE_SET_DISABLE_DDS 0)
 set(OGRE_SET_DISABLE_PVRTC 0)
@@ -107,6 +109,12 @@ endif()
 if (OGRE_CONFIG_MEMTRACK_RELEASE)
   set(OGRE_SET_MEMTRACK_RELEASE 1)
 endif()
+if (OGRE_CONFIG_MEMORY_STATS)
+  set(OGRE_SET_MEMORY_STATS 1)
+endif()
+if (OGRE_CONFIG_WORK_QUEUE_STEALING)
+  set(OGRE_SET_WORK_QUEUE_STEALING 1)
+endif()
 if (NOT OGRE_CONFIG_ENABLE_FREEIMAGE)
   set(OGRE_SET_DISABLE_FREEIMAGE 1)
 endif()
@@ -87,6 +87,9 @@ endif ()
 if (OGRE_BUILD_RENDERSYSTEM_GLES2)
 	set(_rendersystems "${_rendersystems}  + OpenGL ES 2.x\n")
 endif ()
+if (OGRE_BUILD_RENDERSYSTEM_NULL)
+	set(_rendersystems "${_rendersystems}  + Null (headless)\n")
+endif ()
 
 if (DEFINED _rendersystems)
 	set(_features "${_features}Building rendersystems:\n${_rendersystems}")
@@ -179,6 +182,7 @@ var_to_string(OGRE_CONFIG_CONTAINERS_USE_CUSTOM_ALLOCATOR _containers)
 var_to_string(OGRE_CONFIG_DOUBLE _double)
 var_to_string(OGRE_CONFIG_MEMTRACK_DEBUG _memtrack_debug)
 var_to_string(OGRE_CONFIG_MEMTRACK_RELEASE _memtrack_release)
+var_to_string(OGRE_CONFIG_MEMORY_STATS _memory_stats)
 var_to_string(OGRE_CONFIG_STRING_USE_CUSTOM_ALLOCATOR _string)
 var_to_string(OGRE_USE_BOOST _boost)
 # threading settings
@@ -189,6 +193,7 @@ elseif (OGRE_CONFIG_THREADS EQUAL 1)
 else ()
 	set(_threads "background (${OGRE_CONFIG_THREAD_PROVIDER})")
 endif ()
+var_to_string(OGRE_CONFIG_WORK_QUEUE_STEALING _work_stealing)
 # build type
 if (OGRE_STATIC)
 	set(_buildtype "static")
@@ -198,12 +203,14 @@ endif ()
 
 set(_features "${_features}Build type:                      ${_buildtype}\n")
 set(_features "${_features}Threading support:               ${_threads}\n")
+set(_features "${_features}Work queue stealing:             ${_work_stealing}\n")
 set(_features "${_features}Use double precision:            ${_double}\n")
 set(_features "${_features}Allocator type:                  ${_allocator}\n")
 set(_features "${_features}STL containers use allocator:    ${_containers}\n")
 set(_features "${_features}Strings use allocator:           ${_string}\n")
 set(_features "${_features}Memory tracker (debug):          ${_memtrack_debug}\n")
 set(_features "${_features}Memory tracker (release):        ${_memtrack_release}\n")
+set(_features "${_features}Memory statistics:               ${_memory_stats}\n")
 set(_features "${_features}Use new script compilers:        ${_compilers}\n")
 set(_features "${_features}Use Boost:                       ${_boost}\n")
 
@@ -458,6 +458,15 @@ namespace Ogre {
             global keyframe time list.
         */
         TimeIndex _getTimeIndex(Real timePos) const;
+
+        /** Internal method which builds the data otherwise built on demand
+            when the animation is first applied.
+        @remarks
+            Once this has been called, and until the animation is modified
+            again, the animation may be applied to different skeletons or
+            nodes from several threads at once.
+        */
+        void _buildCaches(void) const;
         
         /** Sets a base keyframe which for the skeletal / pose keyframes 
             in this animation. 
@@ -521,6 +530,12 @@ namespace Ogre {
         /// Global keyframe time list used to search global keyframe index.
         typedef vector<Real>::type KeyFrameTimeList;
         mutable KeyFrameTimeList mKeyFrameTimes;
+        /// Index of the first keyframe time in each of a number of equal
+        /// sections of the length, used to narrow the search
+        typedef vector<uint>::type KeyFrameBucketList;
+        mutable KeyFrameBucketList mKeyFrameTimeBuckets;
+        /// Number of buckets per unit of time
+        mutable Real mKeyFrameBucketScale;
         /// Dirty flag indicate that keyframe time list need to rebuild
         mutable bool mKeyFrameTimesDirty;
 
@@ -50,7 +50,7 @@ namespace Ogre {
         Other classes can hold instances of this class to store the state of any animations
         they are using.
     */
-	class _OgreExport AnimationState : public AnimationAlloc
+	class _OgreExport AnimationState : public AnimationStateAlloc
     {
     public:
 
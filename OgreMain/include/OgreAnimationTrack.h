@@ -379,16 +379,73 @@ namespace Ogre
 		/** Optimise the current track by removing any duplicate keyframes. */
 		virtual void optimise(void);
 
+		/** Compresses the keys of this track to reduce its memory footprint.
+		@remarks
+			If the parent animation is linearly interpolated, keys which
+			interpolating between their neighbours reproduces within the
+			given tolerances are removed first. The remaining keys are then
+			quantised and moved to a CompressedTransformKeys, see that class
+			for the format; this adds up to about 1e-4 of the range of each
+			channel to the error.
+		@par
+			A compressed track has no KeyFrame objects: getNumKeyFrames
+			returns 0, and keyframes can't be created until decompress is
+			called. The track can still be interpolated, applied, cloned and
+			saved by the SkeletonSerializer.
+		@param translateTolerance Largest error allowed on translations
+		@param rotateTolerance Largest error allowed on rotations
+		@param scaleTolerance Largest error allowed on scales
+		*/
+		virtual void compress(Real translateTolerance = 1e-3f,
+			const Radian& rotateTolerance = Radian(1e-3f), Real scaleTolerance = 1e-3f);
+
+		/** Replaces compressed keys by regular keyframes again, in order to
+			edit them. The keys removed by compress are not restored. */
+		virtual void decompress(void);
+
+		/** Returns whether the keys of this track are compressed. */
+		bool isCompressed(void) const { return mCompressedKeys != 0; }
+
+		/** Returns the compressed keys of this track, null if not compressed. */
+		const CompressedTransformKeys* getCompressedKeys(void) const { return mCompressedKeys; }
+
+		/** Replaces the keys of this track by the given compressed keys,
+			which the track takes ownership of (internal use only) */
+		void _setCompressedKeys(CompressedTransformKeys* keys);
+
+		/// @copydoc AnimationTrack::removeAllKeyFrames
+		virtual void removeAllKeyFrames(void);
+
+		/// @copydoc AnimationTrack::_collectKeyFrameTimes
+		virtual void _collectKeyFrameTimes(vector<Real>::type& keyFrameTimes);
+
+		/// @copydoc AnimationTrack::_buildKeyFrameIndexMap
+		virtual void _buildKeyFrameIndexMap(const vector<Real>::type& keyFrameTimes);
+
 		/** Clone this track (internal use only) */
 		NodeAnimationTrack* _clone(Animation* newParent) const;
 		
 		void _applyBaseKeyFrame(const KeyFrame* base);
+
+		/** Builds the interpolation splines now if they are out of date, rather
+			than on the next spline interpolation (internal use only) */
+		void _buildInterpolationSplines(void) const
+		{
+			if (mSplineBuildNeeded)
+				buildInterpolationSplines();
+		}
 		
 	protected:
 		/// Specialised keyframe creation
 		KeyFrame* createKeyFrameImpl(Real time);
 		// Flag indicating we need to rebuild the splines next time
 		virtual void buildInterpolationSplines(void) const;
+		/// As getKeyFramesAtTime, for compressed keys
+		Real getCompressedKeysAtTime(const TimeIndex& timeIndex,
+			unsigned short* firstKeyIndex, unsigned short* secondKeyIndex) const;
+		/// Whether interpolating between 2 keyframes reproduces those in between
+		bool canInterpolateKeyFrames(size_t first, size_t last, Real translateTolerance,
+			const Radian& rotateTolerance, Real scaleTolerance) const;
 
         // Struct for store splines, allocate on demand for better memory footprint
         struct Splines
@@ -404,6 +461,8 @@ namespace Ogre
 		mutable bool mSplineBuildNeeded;
 		/// Defines if rotation is done using shortest path
 		mutable bool mUseShortestRotationPath ;
+		/// Keys replacing mKeyFrames once compressed
+		CompressedTransformKeys* mCompressedKeys;
 	};
 
 	/** Type of vertex animation.
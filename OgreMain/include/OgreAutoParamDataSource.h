@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgreVector4.h"
 #include "OgreLight.h"
 #include "OgreColourValue.h"
+#include "OgreAtomicWrappers.h"
 
 namespace Ogre {
 
@@ -56,6 +57,10 @@ namespace Ogre {
         will calculate concatenated matrices etc only when required, passing back precalculated
         matrices when they are requested more than once when the underlying information has
         not altered.
+    @par
+        Each change made through the setters advances the version of the GpuParamInput
+        it affects, so GpuProgramParameters can skip recalculating automatic parameters
+        whose inputs have not changed since they were last calculated.
     */
 	class _OgreExport AutoParamDataSource : public SceneMgtAlloc
     {
@@ -125,6 +130,14 @@ namespace Ogre {
         const Pass* mCurrentPass;
 
         Light mBlankLight;
+
+        /// The version of the last change to each GpuParamInput
+        uint64 mInputVersions[GPI_COUNT];
+        /// Versions are shared by all sources, which may be on different threads, so they are never reused
+        static AtomicScalar<uint64> msLatestInputVersion;
+
+        /// Records a change to the given combination of GpuParamInput
+        void markInputsChanged(uint16 inputs);
     public:
         AutoParamDataSource();
         virtual ~AutoParamDataSource();
@@ -257,6 +270,17 @@ namespace Ogre {
         virtual void setPassNumber(const int passNumber);
         virtual void incPassNumber(void);
 		virtual void updateLightCustomGpuParameter(const GpuProgramParameters::AutoConstantEntry& constantEntry, GpuProgramParameters *params) const;
+
+        /** Gets the version of the latest change to any of the given inputs.
+        @param inputs A combination of GpuParamInput
+        */
+        uint64 getInputVersion(uint16 inputs) const;
+        /// Gets the version of the latest change to any input of any source
+        uint64 getLatestInputVersion(void) const { return msLatestInputVersion.get(); }
+        /** Marks all inputs as changed, for when the state has been altered
+            without going through this class.
+        */
+        void invalidateInputs(void) { markInputsChanged((uint16)((1 << GPI_COUNT) - 1)); }
     };
 	/** @} */
 	/** @} */
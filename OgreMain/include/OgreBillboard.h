@@ -64,7 +64,7 @@ namespace Ogre {
             BillboardSet
     */
 
-	class _OgreExport Billboard : public FXAlloc
+	class _OgreExport Billboard : public FXElementAlloc
     {
         friend class BillboardSet;
         friend class BillboardParticleRenderer;
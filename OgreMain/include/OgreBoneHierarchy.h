@@ -0,0 +1,159 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __BoneHierarchy_H__
+#define __BoneHierarchy_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreMatrix4.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Animation
+	*  @{
+	*/
+	/** Data-oriented storage used to update the bones of a skeleton.
+	@remarks
+		The regular update path (Skeleton::_updateTransforms) walks the bones
+		recursively through Node::_update, then Skeleton::_getBoneMatrices
+		calls Bone::_getOffsetTransform on each bone. This class instead keeps
+		the bones sorted by depth, with the index of each bone's parent, and
+		copies their local transforms to contiguous structure-of-arrays
+		streams. Each hierarchy level is then combined in a single call to
+		OptimisedUtil::concatenateNodeTransforms, and the skinning matrices
+		of all bones are calculated at once by
+		OptimisedUtil::calculateBoneMatrices; both use SIMD where available.
+	@par
+		The derived transforms are written back to the bones, so the Bone
+		and TagPoint APIs work as usual on top of this class: tag points
+		attached to the bones are updated through the regular path once their
+		bone is final.
+	@par
+		The depth-sorted layout is checked against the parent of every bone
+		on each update, and rebuilt when the bones of the skeleton change.
+	*/
+	class _OgreExport BoneHierarchy : public AnimationAlloc
+	{
+	public:
+		typedef vector<Bone*>::type BoneList;
+
+		BoneHierarchy();
+		~BoneHierarchy();
+
+		/** Updates the derived transforms of the bones of a skeleton, and
+			optionally calculates their skinning matrices.
+		@remarks
+			This is equivalent to calling _update(true, false) on every root
+			bone, then Bone::_getOffsetTransform on every bone if matrices
+			are requested.
+		@param bones The bones of the skeleton, indexed by handle
+		@param boneMatrices Array of at least as many matrices as there are
+			bones, to store the skinning matrices in (indexed by bone handle),
+			or null to update the derived transforms only
+		@return False if the bones could not be laid out (some bones are
+			missing or not reachable from a root bone), in which case nothing
+			was updated and the regular path should be used instead.
+		*/
+		bool _update(const BoneList& bones, Matrix4* boneMatrices);
+
+		/** Gets the number of bones in the current depth-sorted layout. */
+		size_t getNumBones(void) const { return mHandles.size(); }
+		/** Gets the number of hierarchy levels in the current depth-sorted layout. */
+		size_t getNumLevels(void) const { return mLevelStarts.empty() ? 0 : mLevelStarts.size() - 1; }
+
+	protected:
+		typedef vector<unsigned short>::type HandleList;
+		typedef vector<size_t>::type IndexList;
+		typedef vector<uint8>::type FlagList;
+		typedef vector<Matrix4>::type MatrixList;
+
+		/// Value of mParentSlots for root bones
+		static const size_t NO_PARENT;
+
+		/// Size of the bone list the layout was built from
+		size_t mNumBones;
+		/// Handles of the bones, sorted by depth
+		HandleList mHandles;
+		/// Index in mHandles of the parent of each bone
+		IndexList mParentSlots;
+		/// Index in mHandles of the first child bone of each bone, plus one
+		/// past the last bone; the child bones of a bone are contiguous
+		IndexList mChildStarts;
+		/// First index in mHandles of each level, plus one past the last bone
+		IndexList mLevelStarts;
+		/// Whether the derived transform of each bone changed this update
+		FlagList mChanged;
+		/// Whether mHandles is sorted by handle, so matrices need no reordering
+		bool mHandleOrder;
+		/// Skinning matrices in layout order, when mHandleOrder is false
+		MatrixList mMatrices;
+
+		/// Number of bones the streams can hold
+		size_t mCapacity;
+		/// SIMD aligned storage backing all streams
+		void* mBuffer;
+		/// Derived transforms of the parents of a level, in level order
+		TransformStreams mParentTransforms;
+		/// Local transforms of all bones, in layout order
+		TransformStreams mLocalTransforms;
+		/// Derived transforms of all bones, in layout order
+		TransformStreams mDerivedTransforms;
+		/// Inverse binding pose transforms of all bones, in layout order
+		TransformStreams mBindingPoseInverses;
+		/// Inheritance masks of all bones, in layout order
+		uint32* mInheritOrientation;
+		uint32* mInheritScale;
+
+		/// Whether the layout still matches the given bones
+		bool isLayoutValid(const BoneList& bones) const;
+		/// Rebuild the depth-sorted layout from the given bones
+		void buildLayout(const BoneList& bones);
+		/// Make sure the streams can hold the given number of bones
+		void reserve(size_t numBones);
+		/// Gather the transforms of the given bone at the given slot
+		void gatherBone(size_t slot, const Bone* bone);
+		/// Calculate the derived transform of the given slot without SIMD,
+		/// for levels too narrow to fill a block
+		void combineBone(size_t slot);
+		/// Write back the derived transform calculated for the given slot
+		void scatterBone(size_t slot, Bone* bone);
+		/// Update the children of a bone which are not bones (tag points)
+		void updateAttachments(size_t slot, Bone* bone, const BoneList& bones);
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -604,10 +604,16 @@ namespace Ogre {
         bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const;
         /// @copydoc Frustum::isVisible(const Vector3&, FrustumPlane*) const
         bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
+        /// @copydoc Frustum::isVisible(const AxisAlignedBox* const*, size_t, char*) const
+        void isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const;
+        /// @copydoc Frustum::isVisible(const Sphere* const*, size_t, char*) const
+        void isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const;
         /// @copydoc Frustum::getWorldSpaceCorners
         const Vector3* getWorldSpaceCorners(void) const;
         /// @copydoc Frustum::getFrustumPlane
         const Plane& getFrustumPlane( unsigned short plane ) const;
+        /// @copydoc Frustum::getCullingPlanes
+        void getCullingPlanes(CullingPlanes& planes) const;
         /// @copydoc Frustum::projectSphere
         bool projectSphere(const Sphere& sphere, 
             Real* left, Real* top, Real* right, Real* bottom) const;
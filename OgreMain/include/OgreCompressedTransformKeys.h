@@ -0,0 +1,156 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __CompressedTransformKeys_H__
+#define __CompressedTransformKeys_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreVector3.h"
+#include "OgreQuaternion.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Animation
+	*  @{
+	*/
+	/** Compact, read-only storage of the keys of a NodeAnimationTrack.
+	@remarks
+		A TransformKeyFrame is a separately allocated object holding full
+		precision rotation, translation and scale. This class instead stores
+		the keys of a track in a few arrays:
+		<ul>
+		<li>Rotations are stored with the 'smallest three' encoding, the
+		largest component of the normalised quaternion is dropped and
+		recovered from the other three, which take 15 bits each. The
+		3 remaining bits hold the index and sign of the dropped component.</li>
+		<li>Translations and scales take 16 bits per axis, relative to the
+		range of values of the track.</li>
+		<li>A channel which does not change by more than its tolerance over
+		the track is stored once, instead of once per key.</li>
+		</ul>
+		This brings a key from about 90 bytes, allocation overhead included,
+		down to at most 22, and usually less since scale is rarely animated.
+	@see NodeAnimationTrack::compress
+	*/
+	class _OgreExport CompressedTransformKeys : public AnimationAlloc
+	{
+	public:
+		typedef vector<Real>::type TimeList;
+
+		CompressedTransformKeys();
+
+		/** Quantises the given keys, replacing any held before.
+		@param numKeys Number of keys in the following arrays
+		@param times Times of the keys, in ascending order
+		@param rotations Rotations of the keys
+		@param translates Translations of the keys
+		@param scales Scales of the keys
+		@param translateTolerance Largest change of translation stored as a constant
+		@param rotateTolerance Largest change of rotation stored as a constant
+		@param scaleTolerance Largest change of scale stored as a constant
+		*/
+		void setKeys(size_t numKeys, const Real* times, const Quaternion* rotations,
+			const Vector3* translates, const Vector3* scales, Real translateTolerance,
+			const Radian& rotateTolerance, Real scaleTolerance);
+
+		/** Returns the number of keys. */
+		size_t getNumKeys(void) const { return mTimes.size(); }
+		/** Returns the times of the keys, in ascending order. */
+		const TimeList& getTimes(void) const { return mTimes; }
+		/** Returns the time of a key. */
+		Real getTime(size_t index) const { return mTimes[index]; }
+
+		/** Decodes the rotation of a key. */
+		Quaternion getRotation(size_t index) const;
+		/** Decodes the translation of a key. */
+		Vector3 getTranslate(size_t index) const;
+		/** Decodes the scale of a key. */
+		Vector3 getScale(size_t index) const;
+		/** Decodes all the channels of a key. */
+		void getKey(size_t index, Quaternion& rotate, Vector3& translate, Vector3& scale) const
+		{
+			rotate = getRotation(index);
+			translate = getTranslate(index);
+			scale = getScale(index);
+		}
+
+		/** Returns the tolerance on translation the keys were compressed with. */
+		Real getTranslateTolerance(void) const { return mTranslateTolerance; }
+		/** Returns the tolerance on rotation the keys were compressed with. */
+		const Radian& getRotateTolerance(void) const { return mRotateTolerance; }
+		/** Returns the tolerance on scale the keys were compressed with. */
+		Real getScaleTolerance(void) const { return mScaleTolerance; }
+
+		/** Returns the memory used by the keys, in bytes. */
+		size_t calculateSize(void) const;
+
+	protected:
+		friend class SkeletonSerializer;
+
+		typedef vector<uint16>::type QuantisedList;
+
+		/// Vector values quantised between a base and base + extent
+		struct VectorChannel
+		{
+			/// Lowest value, or the value of every key if constant
+			Vector3 base;
+			/// Range of values, zero if constant
+			Vector3 extent;
+			/// 3 values per key, empty if constant
+			QuantisedList values;
+		};
+
+		TimeList mTimes;
+		/// Rotation of every key if constant
+		Quaternion mRotation;
+		/// 3 values per key with the 'smallest three' encoding, empty if constant
+		QuantisedList mRotations;
+		VectorChannel mTranslates;
+		VectorChannel mScales;
+
+		Real mTranslateTolerance;
+		Radian mRotateTolerance;
+		Real mScaleTolerance;
+
+		static void quantiseChannel(VectorChannel& channel, size_t numKeys,
+			const Vector3* values, Real tolerance);
+		static Vector3 decodeChannel(const VectorChannel& channel, size_t index);
+		static void encodeRotation(const Quaternion& q, uint16* dest);
+		static Quaternion decodeRotation(const uint16* src);
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
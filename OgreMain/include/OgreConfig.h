@@ -114,6 +114,12 @@ THE SOFTWARE.
 #ifndef OGRE_MEMORY_TRACKER_RELEASE_MODE
 #  define OGRE_MEMORY_TRACKER_RELEASE_MODE 0
 #endif
+
+// enable or disable the lightweight allocation counters per memory category,
+// which unlike the memory tracker are cheap enough to leave on in release builds
+#ifndef OGRE_MEMORY_STATS
+#  define OGRE_MEMORY_STATS 0
+#endif
 /** Define max number of multiple render targets (MRTs) to render to at once.
 */
 #define OGRE_MAX_MULTIPLE_RENDER_TARGETS 8
@@ -159,6 +165,16 @@ OGRE_THREAD_PROVIDER = 3
 #define OGRE_THREAD_PROVIDER 0
 #endif
 
+/** Whether DefaultWorkQueue gives each worker thread a request queue of its
+	own and lets idle workers steal requests from the others, rather than
+	sharing a single queue among all workers. This only sets the default,
+	it can also be changed at runtime with
+	DefaultWorkQueueBase::setRequestScheduling.
+*/
+#ifndef OGRE_WORK_QUEUE_STEALING
+#define OGRE_WORK_QUEUE_STEALING 0
+#endif
+
 /** Disables use of the FreeImage image library for loading images.
 WARNING: Use only when you want to provide your own image loading code via codecs.
 */
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreString.h"
 #include "OgreSharedPtr.h"
+#include "OgreAtomicWrappers.h"
 #include <istream>
 #include "OgreHeaderPrefix.h"
 
@@ -325,6 +326,13 @@ namespace Ogre {
 	    uchar* mEnd;
         /// Do we delete the memory on close
 		bool mFreeOnClose;			
+		/// Stream whose memory this one shares, kept alive as long as this one
+		DataStreamPtr mSharedSource;
+
+		/** Share the memory of a memory mapped stream rather than copying it,
+			returns false if the stream is not memory mapped.
+		*/
+		bool shareMapping(const DataStreamPtr& sourceStream);
 	public:
 		
 		/** Wrap an existing memory chunk in a stream.
@@ -372,6 +380,8 @@ namespace Ogre {
 			This constructor can be used to intentionally read in the entire
 			contents of another stream, copying them to the internal buffer
 			and thus making them available in memory as a single unit.
+			If the source is a MmapDataStream, its memory is shared instead 
+			of copied, from the current position to the end.
 		@param sourceStream Weak reference to another DataStream which will provide the source
 			of data
 		@param freeOnClose If true, the memory associated will be destroyed
@@ -403,6 +413,8 @@ namespace Ogre {
         This constructor can be used to intentionally read in the entire
         contents of another stream, copying them to the internal buffer
         and thus making them available in memory as a single unit.
+        If the source is a MmapDataStream, its memory is shared instead 
+        of copied, from the current position to the end.
         @param name The name to give the stream
         @param sourceStream Another DataStream which will provide the source
         of data
@@ -483,6 +495,56 @@ namespace Ogre {
     */
     typedef SharedPtr<MemoryDataStream> MemoryDataStreamPtr;
 
+	/** Common subclass of DataStream for handling data from a file mapped
+		into memory.
+	@remarks
+		The operating system pages the file in as it is accessed, so getPtr
+		gives access to the whole file without reading it into a buffer first,
+		and loaders can parse it in place. MemoryDataStream constructors taking
+		a shared pointer to a stream of this type share its memory rather than
+		copying it.
+	@par
+		The mapping is private to the process: writing to the memory never
+		changes the file, only the pages written to get copied. On platforms
+		without memory mapping the file is read into memory instead.
+	*/
+	class _OgreExport MmapDataStream : public MemoryDataStream
+	{
+	public:
+		/** Map a file into memory.
+		@param name The name to give the stream
+		@param fullPath The path to the file
+		@param readOnly Whether to make the stream read-only once created
+		*/
+		MmapDataStream(const String& name, const String& fullPath, bool readOnly = true);
+
+		~MmapDataStream();
+
+		/** @copydoc DataStream::close
+		@remarks
+			While MemoryDataStream instances share the mapping, this only
+			closes this stream; the file is unmapped when the last of them
+			is closed.
+		*/
+		void close(void);
+	protected:
+		friend class MemoryDataStream;
+
+		/// Start of the mapped view of the file, null if not mapped
+		void* mMapping;
+		/// Size of the mapped view of the file
+		size_t mMappingSize;
+		/// Number of MemoryDataStream instances sharing the mapping
+		AtomicScalar<size_t> mShareCount;
+		/// Whether close was called while the mapping was shared
+		AtomicScalar<bool> mClosePending;
+
+		/// Called by a sharing MemoryDataStream when it is closed
+		void releaseShare(void);
+		/// Unmap the file
+		void unmap(void);
+	};
+
     /** Common subclass of DataStream for handling data from 
 		std::basic_istream.
 	*/
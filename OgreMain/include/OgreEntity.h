@@ -203,6 +203,14 @@ namespace Ogre {
         */
         bool cacheBoneMatrices(void);
 
+        /// Gets the number of frames between evaluations of the animation at the current level of detail.
+        unsigned short getAnimationLodUpdateInterval(void) const;
+
+        /** Private method caching bone matrices at a level of animation detail which
+            evaluates the animation every few frames, interpolating in between.
+        */
+        void cacheBoneMatricesAtLod(unsigned long frameNumber, unsigned short updateInterval);
+
         /// Flag determines whether or not to display skeleton.
         bool mDisplaySkeleton;
         /** Flag indicating whether hardware animation is supported by this entities materials
@@ -246,6 +254,32 @@ namespace Ogre {
         /// Index of maximum detail LOD (NB lower index is higher detail).
         ushort mMaxMaterialLodIndex;
 
+        /// The level of animation detail of the skeleton, calculated by _notifyCurrentCamera.
+        ushort mAnimationLodIndex;
+        /// Animation LOD bias factor, not transformed.
+        Real mAnimationLodFactor;
+        /// Index of minimum detail animation LOD (NB higher index is lower detail).
+        ushort mMinAnimationLodIndex;
+        /// Index of maximum detail animation LOD (NB lower index is higher detail).
+        ushort mMaxAnimationLodIndex;
+        /// Offset of the frames in which the animation is evaluated at lower levels of
+        /// animation detail, so that entities do not all evaluate it in the same frame.
+        uint32 mAnimationLodPhase;
+        /// Records the last frame in which the animation was evaluated at a lower level of detail.
+        unsigned long mFrameAnimationLodEvaluated;
+        /// Transform of a bone, decomposed to be interpolated.
+        struct AnimationLodBoneTransform
+        {
+            Vector3 position;
+            Vector3 scale;
+            Quaternion orientation;
+        };
+        /// Bone transforms interpolated from at lower levels of animation detail, the
+        /// pose displayed before the last evaluation followed by the evaluated one.
+        AnimationLodBoneTransform* mAnimationLodBoneTransforms;
+        /// Whether the bone matrices have yet to reach the last evaluated pose.
+        bool mAnimationLodBlendPending;
+
         /** List of LOD Entity instances (for manual LODs).
             We don't know when the mesh is using manual LODs whether one LOD to the next will have the
             same number of SubMeshes, therefore we have to allow a separate Entity list
@@ -535,6 +569,28 @@ namespace Ogre {
         */
         void setMaterialLodBias(Real factor, ushort maxDetailIndex = 0, ushort minDetailIndex = 99);
 
+        /** Sets a level-of-detail bias for the animation detail of this entity.
+        @remarks
+            The levels of animation detail are set on the Skeleton, see
+            Skeleton::addAnimationLodLevel. The parameters work as for setMeshLodBias.
+        @param factor
+            Proportional factor to apply to the distance at which LOD is changed.
+            Higher values increase the distance at which higher LODs are displayed (2.0 is
+            twice the normal distance, 0.5 is half).
+        @param maxDetailIndex
+            The index of the maximum LOD this entity is allowed to use (lower
+            indexes are higher detail: index 0 evaluates every bone every frame).
+        @param minDetailIndex
+            The index of the minimum LOD this entity is allowed to use (higher
+            indexes are lower detail). Use something like 99 if you want unlimited LODs (the actual
+            LOD will be limited by the number in the Skeleton).
+        */
+        void setAnimationLodBias(Real factor, ushort maxDetailIndex = 0, ushort minDetailIndex = 99);
+
+        /** Returns the current level of animation detail of the skeleton.
+        */
+        ushort getCurrentAnimationLodIndex() const { return mAnimationLodIndex; }
+
         /** Sets whether the polygon mode of this entire entity may be
             overridden by the camera detail settings.
         */
@@ -854,6 +910,32 @@ namespace Ogre {
             return mAlwaysUpdateMainSkeleton;
         }
 
+        /** Internal method returning whether the bone matrices of this entity
+            can be evaluated ahead of rendering by _updateBoneMatrices.
+        @remarks
+            This is the case for entities in the scene whose skeletal animation
+            changed since it was last evaluated, and which were rendered at full
+            detail in the previous frame, so are likely to be rendered again.
+            Used by SceneManager::setParallelAnimationEnabled.
+        */
+        bool _isBoneMatricesUpdatePending(void) const;
+
+        /** Internal method building the shared data which _updateBoneMatrices
+            would otherwise build on demand. Must be called on the thread which
+            then waits for _updateBoneMatrices to complete.
+        */
+        void _prepareBoneMatricesUpdate(void);
+
+        /** Internal method evaluating the animation state of the skeleton and
+            caching the resulting bone matrices, as rendering the entity would.
+        @remarks
+            Once _prepareBoneMatricesUpdate has been called, this may be called
+            from several threads at once for entities which do not share a
+            skeleton instance. Software skinning and the other updates of
+            rendering are left to the rendering thread.
+        */
+        void _updateBoneMatrices(void);
+
         
     };
 
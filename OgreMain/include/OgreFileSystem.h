@@ -119,7 +119,22 @@ namespace Ogre {
             return msIgnoreHidden;
         }
 
+        /// Set whether files opened read-only are mapped into memory, returning
+        /// a MmapDataStream rather than reading them through a file stream. This lets
+        /// loaders parse the files in place. The default is false.
+        static void setUseMemoryMapping(bool useMapping)
+        {
+            msUseMemoryMapping = useMapping;
+        }
+
+        /// Get whether files opened read-only are mapped into memory.
+        static bool getUseMemoryMapping()
+        {
+            return msUseMemoryMapping;
+        }
+
         static bool msIgnoreHidden;
+        static bool msUseMemoryMapping;
     };
 
     /** Specialisation of ArchiveFactory for FileSystem files. */
@@ -78,6 +78,30 @@ namespace Ogre
         FRUSTUM_PLANE_BOTTOM = 5
     };
 
+    /** A copy of the planes bounds are culled against in a frustum.
+    @remarks
+        A Frustum brings its planes up to date when they are first used, so
+        testing bounds against it may modify it. This copy is never modified
+        by the tests, so threads culling against the same frustum can share
+        it once it has been filled in by Frustum::getCullingPlanes.
+    */
+    struct _OgreExport CullingPlanes
+    {
+        /// The planes, without the far plane of an infinite frustum
+        Plane planes[6];
+        /// Number of planes in use
+        size_t numPlanes;
+
+        CullingPlanes() : numPlanes(0) {}
+
+        /// @copydoc Frustum::isVisible(const AxisAlignedBox&, FrustumPlane*) const
+        bool isVisible(const AxisAlignedBox& bound) const;
+        /// @copydoc Frustum::isVisible(const AxisAlignedBox* const*, size_t, char*) const
+        void isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const;
+        /// @copydoc Frustum::isVisible(const Sphere* const*, size_t, char*) const
+        void isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const;
+    };
+
     /** A frustum represents a pyramid, capped at the near and far end which is
         used to represent either a visible area or a projection area. Can be used
         for a number of applications.
@@ -430,6 +454,13 @@ namespace Ogre
         */
         virtual const Plane& getFrustumPlane( unsigned short plane ) const;
 
+        /** Copies the up to date planes bounds are culled against.
+        @remarks
+            This must be called from the thread which updates the frustum; the
+            copy can then be shared by threads culling against it.
+        */
+        virtual void getCullingPlanes(CullingPlanes& planes) const;
+
         /** Tests whether the given container is visible in the Frustum.
         @param bound
             Bounding box to be checked (world space).
@@ -469,6 +500,36 @@ namespace Ogre
         */
         virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
 
+        /** Tests whether each of a list of bounding boxes is visible in the Frustum.
+        @remarks
+            This gives the same results as testing the boxes one at a time, but
+            tests several of them at once using OptimisedUtil. Subclasses which
+            change the single box test should override this as well.
+        @param bounds
+            Pointers to the bounding boxes to be checked (world space).
+        @param count
+            Number of bounding boxes.
+        @param visibilities
+            Array of at least count flags, each set to @c true if the corresponding
+            box is visible or @c false otherwise.
+        */
+        virtual void isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const;
+
+        /** Tests whether each of a list of bounding spheres is visible in the Frustum.
+        @remarks
+            This gives the same results as testing the spheres one at a time, but
+            tests several of them at once using OptimisedUtil. Subclasses which
+            change the single sphere test should override this as well.
+        @param bounds
+            Pointers to the bounding spheres to be checked (world space).
+        @param count
+            Number of bounding spheres.
+        @param visibilities
+            Array of at least count flags, each set to @c true if the corresponding
+            sphere is visible or @c false otherwise.
+        */
+        virtual void isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const;
+
         /// Overridden from MovableObject::getTypeFlags
         uint32 getTypeFlags(void) const;
 
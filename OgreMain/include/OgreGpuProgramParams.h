@@ -114,6 +114,31 @@ namespace Ogre {
 
 	};
 
+	/** The state held by AutoParamDataSource which automatic parameters are derived from.
+	These values must be powers of two since they are used in masks. An automatic
+	parameter with no inputs is recalculated every time it is updated.
+	*/
+	enum GpuParamInput
+	{
+		/// The current renderable and its world matrices
+		GPI_RENDERABLE = 1,
+		/// The current camera
+		GPI_CAMERA = 2,
+		/// The current viewport and render target
+		GPI_VIEWPORT = 4,
+		/// The current light list
+		GPI_LIGHTS = 8,
+		/// The current pass and pass number
+		GPI_PASS = 16,
+		/// The current texture projectors
+		GPI_TEXTURE_PROJECTORS = 32,
+		/// Scene wide settings such as fog and ambient light
+		GPI_SCENE = 64,
+
+		/// The number of inputs
+		GPI_COUNT = 7
+	};
+
 	/** Information about predefined program constants. 
 	@note Only available for high-level programs but is referenced generically
 	by GpuProgramParameters.
@@ -350,6 +375,56 @@ namespace Ogre {
 	typedef map<String, GpuConstantDefinition>::type GpuConstantDefinitionMap;
 	typedef ConstMapIterator<GpuConstantDefinitionMap> GpuConstantDefinitionIterator;
 
+	/** The layout of one of a program's constant buffers (or uniform blocks).
+	@remarks
+		Render systems which upload constants a buffer at a time describe each
+		buffer with one of these, so that the values can be copied from 
+		GpuProgramParameters with a memcpy per block instead of a name lookup per
+		constant. 
+	@see GpuNamedConstants::addBufferLayout
+	*/
+	struct _OgreExport GpuConstantBufferLayout
+	{
+		/// A named constant placed in the buffer
+		struct Entry
+		{
+			/// Name of the constant in GpuNamedConstants
+			String name;
+			/// Byte offset in the buffer
+			size_t offset;
+			/// Byte size in the buffer
+			size_t size;
+		};
+		typedef vector<Entry>::type EntryList;
+
+		/** A run of constants which is laid out the same way in the buffer and in
+			one of the physical buffers of GpuProgramParameters. */
+		struct Block
+		{
+			/// Byte offset in the buffer
+			size_t offset;
+			/// Byte size, including any padding between the constants
+			size_t size;
+			/// Start index in the physical float, double or int buffer
+			size_t physicalIndex;
+			/// Type of the first constant, identifies the physical buffer
+			GpuConstantType constType;
+		};
+		typedef vector<Block>::type BlockList;
+
+		/// Byte size of the buffer
+		size_t size;
+		/// The constants in order of offset
+		EntryList entries;
+		/// The copies needed to fill the buffer, derived from the entries
+		BlockList blocks;
+
+		GpuConstantBufferLayout(size_t bufferSize = 0) : size(bufferSize) {}
+	};
+	typedef vector<GpuConstantBufferLayout>::type GpuConstantBufferLayoutList;
+
+	struct GpuLogicalBufferStruct;
+
 	/// Struct collecting together the information for named constants.
 	struct _OgreExport GpuNamedConstants : public GpuParamsAlloc
 	{
@@ -361,8 +436,60 @@ namespace Ogre {
 		size_t intBufferSize;
 		/// Map of parameter names to GpuConstantDefinition
 		GpuConstantDefinitionMap map;
+		/** Layouts of the program's constant buffers, empty unless the program
+			uses the buffer layout mode. @see addBufferLayout */
+		mutable GpuConstantBufferLayoutList bufferLayouts;
+
+		GpuNamedConstants() : floatBufferSize(0), doubleBufferSize(0), intBufferSize(0),
+			mBufferLayoutsDirty(true) {}
+		GpuNamedConstants(const GpuNamedConstants& rhs);
+		GpuNamedConstants& operator=(const GpuNamedConstants& rhs);
 
-		GpuNamedConstants() : floatBufferSize(0), doubleBufferSize(0), intBufferSize(0) {}
+		/** Adds a constant buffer, switching these constants to the buffer layout mode.
+		@remarks
+			In this mode named constants are looked up through a hash index rather
+			than the name map, and render systems can fill each buffer with
+			GpuProgramParameters::_copyConstantBuffer. Constants are added to the
+			buffer with addBufferConstant.
+		@param size Byte size of the buffer
+		@return The index of the buffer
+		*/
+		size_t addBufferLayout(size_t size);
+
+		/** Places a named constant in a buffer added with addBufferLayout.
+		@param bufferIndex Index of the buffer
+		@param name Name of a constant already in the map
+		@param offset Byte offset of the constant, which must follow the constants 
+			already in the buffer
+		@param size Byte size of the constant in the buffer
+		*/
+		void addBufferConstant(size_t bufferIndex, const String& name, size_t offset, size_t size);
+
+		/** Moves the physical indexes of the constants in the buffers so that the 
+			physical buffers mirror the constant buffers. 
+		@remarks
+			Constants of the same type which follow each other in a constant buffer
+			can then be copied together, so a buffer holding only floats is filled
+			with a single memcpy. This must be done before any GpuProgramParameters
+			are created from these constants.
+		@param floatLogicalToPhysical, doubleLogicalToPhysical, intLogicalToPhysical
+			The logical to physical index maps of the program, updated to match the
+			new physical indexes. May be null if the program has none.
+		*/
+		void mirrorBufferLayouts(GpuLogicalBufferStruct* floatLogicalToPhysical = 0,
+			GpuLogicalBufferStruct* doubleLogicalToPhysical = 0,
+			GpuLogicalBufferStruct* intLogicalToPhysical = 0);
+
+		/// Gets a buffer layout, with its blocks up to date
+		const GpuConstantBufferLayout& getBufferLayout(size_t bufferIndex) const;
+
+		/** Finds a named constant, through the hash index in the buffer layout mode.
+		@return The definition, or 0 if there is no constant with this name
+		*/
+		const GpuConstantDefinition* findConstantDefinition(const String& name) const;
+
+		/// Notifies that the physical indexes of the constants have changed
+		void _markBufferLayoutsDirty(void);
 
 		/** Generate additional constant entries for arrays based on a base definition.
 		@remarks
@@ -406,6 +533,18 @@ namespace Ogre {
 		to be generated and added to the map.
 		*/
 		static bool msGenerateAllConstantDefinitionArrayEntries;
+
+		typedef HashMap<String, const GpuConstantDefinition*> ConstantDefinitionHashMap;
+		/// Hash index of the map, used in the buffer layout mode
+		mutable ConstantDefinitionHashMap mHashIndex;
+		/// Whether the hash index and buffer layout blocks need rebuilding
+		mutable bool mBufferLayoutsDirty;
+		/** Protects the hash index and buffer layout blocks, which are rebuilt
+			lazily by lookups from any thread sharing these constants */
+		OGRE_MUTEX(mBufferLayoutsMutex)
+
+		/// Rebuilds the hash index and buffer layout blocks, the mutex must be locked
+		void updateBufferLayouts(void) const;
 	};
 	typedef SharedPtr<GpuNamedConstants> GpuNamedConstantsPtr;
 
@@ -1205,16 +1344,20 @@ namespace Ogre {
 			};
 			/// The variability of this parameter (see GpuParamVariability)
 			uint16 variability;
+			/// The source state this parameter is derived from (see GpuParamInput)
+			uint16 inputs;
+			/// The input version this parameter was last calculated at, 0 if never
+			uint64 version;
 
 			AutoConstantEntry(AutoConstantType theType, size_t theIndex, size_t theData, 
 				uint16 theVariability, size_t theElemCount = 4)
 				: paramType(theType), physicalIndex(theIndex), elementCount(theElemCount), 
-				data(theData), variability(theVariability) {}
+				data(theData), variability(theVariability), inputs(deriveInputs(theType)), version(0) {}
 
 			AutoConstantEntry(AutoConstantType theType, size_t theIndex, Real theData, 
 				uint16 theVariability, size_t theElemCount = 4)
 				: paramType(theType), physicalIndex(theIndex), elementCount(theElemCount), 
-				fData(theData), variability(theVariability) {}
+				fData(theData), variability(theVariability), inputs(deriveInputs(theType)), version(0) {}
 
 		};
 		// Auto parameter storage
@@ -1257,6 +1400,10 @@ namespace Ogre {
 		bool mIgnoreMissingParams;
 		/// physical index for active pass iteration parameter real constant entry;
 		size_t mActivePassIterationIndex;
+		/// The source the automatic parameters were last calculated from
+		const AutoParamDataSource* mAutoParamsSource;
+		/// The combined variability masks of the parameters changed by the last update
+		uint16 mUpdatedVariability;
 
 		/** Gets the low-level structure for a logical index. 
 		*/
@@ -1270,6 +1417,8 @@ namespace Ogre {
 
 		/// Return the variability for an auto constant
 		uint16 deriveVariability(AutoConstantType act);
+		/// Return the AutoParamDataSource state an auto constant is derived from
+		static uint16 deriveInputs(AutoConstantType act);
 
 		void copySharedParamSetUsage(const GpuSharedParamUsageList& srcList);
 
@@ -1666,11 +1815,30 @@ namespace Ogre {
 		const AutoConstantEntry* _findRawAutoConstantEntryInt(size_t physicalIndex);
 
 		/** Update automatic parameters.
+		@remarks
+			Parameters whose inputs have not changed since they were last calculated
+			from the same source are left as they are.
 		@param source The source of the parameters
 		@param variabilityMask A mask of GpuParamVariability which identifies which autos will need updating
 		*/
 		void _updateAutoParams(const AutoParamDataSource* source, uint16 variabilityMask);
 
+		/** Copies the constants of one of the program's constant buffers into memory
+			laid out as that buffer.
+		@see GpuNamedConstants::addBufferLayout
+		@param bufferIndex Index of the buffer layout
+		@param dest Memory the size of the buffer
+		*/
+		void _copyConstantBuffer(size_t bufferIndex, void* dest) const;
+
+		/** Gets the combined variability of the automatic parameters which were
+			recalculated by the last call to _updateAutoParams.
+		@remarks
+			Constants of the other variabilities still hold the values last uploaded, 
+			so a render system only needs to upload these again.
+		*/
+		uint16 _getUpdatedVariability(void) const { return mUpdatedVariability; }
+
 		/** Tells the program whether to ignore missing parameters or not.
 		*/
 		void setIgnoreMissingParams(bool state) { mIgnoreMissingParams = state; }
@@ -107,6 +107,7 @@ namespace Ogre
         size_t                  mIdCount;
 
         InstanceBatchVec        mDirtyBatches;
+        OGRE_MUTEX(mDirtyBatchesMutex)
 
         RenderOperation         mSharedRenderOperation;
 
@@ -174,10 +174,12 @@ namespace Ogre
 		MEMCATEGORY_SCRIPTING = 6,
 		/// Rendersystem structures
 		MEMCATEGORY_RENDERSYS = 7,
+		/// Temporary data which does not outlive the current frame
+		MEMCATEGORY_FRAME = 8,
 
 		
 		// sentinel value, do not use 
-		MEMCATEGORY_COUNT = 8
+		MEMCATEGORY_COUNT = 9
 	};
 	/** @} */
 	/** @} */
@@ -186,6 +188,8 @@ namespace Ogre
 
 #include "OgreMemoryAllocatedObject.h"
 #include "OgreMemorySTLAllocator.h"
+#include "OgreMemoryFrameAlloc.h"
+#include "OgreMemoryStats.h"
 
 #if OGRE_MEMORY_ALLOCATOR == OGRE_MEMORY_ALLOCATOR_NEDPOOLING
 
@@ -198,8 +202,13 @@ namespace Ogre
 
 	// configurable category, for general malloc
 	// notice how we ignore the category here, you could specialise
+#if OGRE_MEMORY_STATS
+	template <MemoryCategory Cat> class CategorisedAllocPolicy : public CountedAllocPolicy<Cat, NedPoolingPolicy>{};
+	template <MemoryCategory Cat, size_t align = 0> class CategorisedAlignAllocPolicy : public CountedAllocPolicy<Cat, NedPoolingAlignedPolicy<align>, align>{};
+#else
 	template <MemoryCategory Cat> class CategorisedAllocPolicy : public NedPoolingPolicy{};
 	template <MemoryCategory Cat, size_t align = 0> class CategorisedAlignAllocPolicy : public NedPoolingAlignedPolicy<align>{};
+#endif
 }
 
 #elif OGRE_MEMORY_ALLOCATOR == OGRE_MEMORY_ALLOCATOR_NED
@@ -213,8 +222,13 @@ namespace Ogre
 
 	// configurable category, for general malloc
 	// notice how we ignore the category here, you could specialise
+#if OGRE_MEMORY_STATS
+	template <MemoryCategory Cat> class CategorisedAllocPolicy : public CountedAllocPolicy<Cat, NedAllocPolicy>{};
+	template <MemoryCategory Cat, size_t align = 0> class CategorisedAlignAllocPolicy : public CountedAllocPolicy<Cat, NedAlignedAllocPolicy<align>, align>{};
+#else
 	template <MemoryCategory Cat> class CategorisedAllocPolicy : public NedAllocPolicy{};
 	template <MemoryCategory Cat, size_t align = 0> class CategorisedAlignAllocPolicy : public NedAlignedAllocPolicy<align>{};
+#endif
 }
 
 #elif OGRE_MEMORY_ALLOCATOR == OGRE_MEMORY_ALLOCATOR_STD
@@ -228,8 +242,13 @@ namespace Ogre
 
 	// configurable category, for general malloc
 	// notice how we ignore the category here
+#if OGRE_MEMORY_STATS
+	template <MemoryCategory Cat> class CategorisedAllocPolicy : public CountedAllocPolicy<Cat, StdAllocPolicy>{};
+	template <MemoryCategory Cat, size_t align = 0> class CategorisedAlignAllocPolicy : public CountedAllocPolicy<Cat, StdAlignedAllocPolicy<align>, align>{};
+#else
 	template <MemoryCategory Cat> class CategorisedAllocPolicy : public StdAllocPolicy{};
 	template <MemoryCategory Cat, size_t align = 0> class CategorisedAlignAllocPolicy : public StdAlignedAllocPolicy<align>{};
+#endif
 
 	// if you wanted to specialise the allocation per category, here's how it might work:
 	// template <> class CategorisedAllocPolicy<MEMCATEGORY_SCENE_OBJECTS> : public YourSceneObjectAllocPolicy{};
@@ -244,8 +263,19 @@ namespace Ogre
 
 #endif
 
+#include "OgreMemoryPoolAlloc.h"
+
 namespace Ogre
 {
+	// per-frame temporaries come from the frame arena whichever allocator is configured
+#if OGRE_MEMORY_STATS
+	template <> class CategorisedAllocPolicy<MEMCATEGORY_FRAME> : public CountedAllocPolicy<MEMCATEGORY_FRAME, FrameAllocPolicy>{};
+	template <size_t align> class CategorisedAlignAllocPolicy<MEMCATEGORY_FRAME, align> : public CountedAllocPolicy<MEMCATEGORY_FRAME, FrameAlignedAllocPolicy<align>, align>{};
+#else
+	template <> class CategorisedAllocPolicy<MEMCATEGORY_FRAME> : public FrameAllocPolicy{};
+	template <size_t align> class CategorisedAlignAllocPolicy<MEMCATEGORY_FRAME, align> : public FrameAlignedAllocPolicy<align>{};
+#endif
+
 	// Useful shortcuts
 	typedef CategorisedAllocPolicy<Ogre::MEMCATEGORY_GENERAL> GeneralAllocPolicy;
 	typedef CategorisedAllocPolicy<Ogre::MEMCATEGORY_GEOMETRY> GeometryAllocPolicy;
@@ -256,6 +286,11 @@ namespace Ogre
 	typedef CategorisedAllocPolicy<Ogre::MEMCATEGORY_SCRIPTING> ScriptingAllocPolicy;
 	typedef CategorisedAllocPolicy<Ogre::MEMCATEGORY_RENDERSYS> RenderSysAllocPolicy;
 
+	// Pooled variants, for small objects created and destroyed in large numbers
+	typedef PooledAllocPolicy<Ogre::MEMCATEGORY_ANIMATION> AnimationPooledAllocPolicy;
+	typedef PooledAllocPolicy<Ogre::MEMCATEGORY_SCENE_CONTROL> SceneCtlPooledAllocPolicy;
+	typedef PooledAllocPolicy<Ogre::MEMCATEGORY_SCENE_OBJECTS> SceneObjPooledAllocPolicy;
+
 	// Now define all the base classes for each allocation
 	typedef AllocatedObject<GeneralAllocPolicy> GeneralAllocatedObject;
 	typedef AllocatedObject<GeometryAllocPolicy> GeometryAllocatedObject;
@@ -265,6 +300,9 @@ namespace Ogre
 	typedef AllocatedObject<ResourceAllocPolicy> ResourceAllocatedObject;
 	typedef AllocatedObject<ScriptingAllocPolicy> ScriptingAllocatedObject;
 	typedef AllocatedObject<RenderSysAllocPolicy> RenderSysAllocatedObject;
+	typedef AllocatedObject<AnimationPooledAllocPolicy> AnimationPooledAllocatedObject;
+	typedef AllocatedObject<SceneCtlPooledAllocPolicy> SceneCtlPooledAllocatedObject;
+	typedef AllocatedObject<SceneObjPooledAllocPolicy> SceneObjPooledAllocatedObject;
 
 
 	// Per-class allocators defined here
@@ -274,6 +312,7 @@ namespace Ogre
 	typedef ScriptingAllocatedObject	AbstractNodeAlloc;
 	typedef AnimationAllocatedObject	AnimableAlloc;
 	typedef AnimationAllocatedObject	AnimationAlloc;
+	typedef AnimationPooledAllocatedObject	AnimationStateAlloc;
 	typedef GeneralAllocatedObject		ArchiveAlloc;
 	typedef GeometryAllocatedObject		BatchedGeometryAlloc;
 	typedef RenderSysAllocatedObject	BufferAlloc;
@@ -286,11 +325,12 @@ namespace Ogre
 	typedef GeometryAllocatedObject		EdgeDataAlloc;
 	typedef GeneralAllocatedObject		FactoryAlloc;
 	typedef SceneObjAllocatedObject		FXAlloc;
+	typedef SceneObjPooledAllocatedObject	FXElementAlloc;
 	typedef GeneralAllocatedObject		ImageAlloc;
 	typedef GeometryAllocatedObject		IndexDataAlloc;
 	typedef GeneralAllocatedObject		LogAlloc;
 	typedef SceneObjAllocatedObject		MovableAlloc;
-	typedef SceneCtlAllocatedObject		NodeAlloc;
+	typedef SceneCtlPooledAllocatedObject	NodeAlloc;
 	typedef SceneObjAllocatedObject		OverlayAlloc;
 	typedef RenderSysAllocatedObject	GpuParamsAlloc;
 	typedef ResourceAllocatedObject		PassAlloc;
@@ -308,7 +348,7 @@ namespace Ogre
 	typedef ScriptingAllocatedObject    ScriptTranslatorAlloc;
 	typedef SceneCtlAllocatedObject		ShadowDataAlloc;
 	typedef GeneralAllocatedObject		StreamAlloc;
-	typedef SceneObjAllocatedObject		SubEntityAlloc;
+	typedef SceneObjPooledAllocatedObject	SubEntityAlloc;
 	typedef ResourceAllocatedObject		SubMeshAlloc;
 	typedef ResourceAllocatedObject		TechniqueAlloc;
 	typedef GeneralAllocatedObject		TimerAlloc;
@@ -0,0 +1,179 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __MemoryFrameAlloc_H__
+#define __MemoryFrameAlloc_H__
+
+#include <limits>
+
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Memory
+	*  @{
+	*/
+	/** Linear arena for temporary data which does not outlive the current frame.
+	@remarks
+		Allocations are carved sequentially out of a single chunk, so they cost
+		little more than a pointer increment and individual deallocations are
+		just counted. Once every allocation has been given back the arena
+		rewinds to the start of its chunk. Requests which do not fit in the
+		chunk are satisfied from the general allocator, and the chunk is grown
+		to the high water mark on the next rewind, so that after a few frames
+		all per-frame temporaries come from one block of memory.
+	@par
+		Root::renderOneFrame calls reset() once the frame has ended. Memory from
+		the arena must not be held beyond that point; containers backed by it
+		should be locals which go out of scope during the frame, never members.
+	@note
+		All methods are thread safe.
+	*/
+	class _OgreExport FrameArena
+	{
+	public:
+		/** Allocate memory from the arena.
+		@param count The number of bytes
+		@param alignment The alignment of the returned pointer, a power of 2
+			up to 128; 0 means the default SIMD alignment
+		*/
+		static void* allocate(size_t count, size_t alignment = 0);
+		/// Give back memory obtained from allocate
+		static void deallocate(void* ptr);
+		/** Called at the end of each frame.
+		@remarks
+			Resets the per-frame statistics, and if nothing from the arena is
+			still in use, releases the overflow allocations and grows the
+			chunk if the frame needed more than it held.
+		*/
+		static void reset(void);
+		/** Free all memory held by the arena.
+		@remarks
+			Only has an effect when no allocation is outstanding.
+		*/
+		static void releaseMemory(void);
+
+		/** Set the minimum size of the arena's chunk in bytes.
+		@remarks
+			Takes effect the next time the chunk is (re)allocated. The default is
+			64KB.
+		*/
+		static void setChunkSize(size_t size);
+		/// Get the minimum size of the arena's chunk in bytes
+		static size_t getChunkSize(void);
+		/// Get the number of bytes held by the chunk
+		static size_t getCapacity(void);
+		/// Get the number of bytes currently allocated, including alignment padding
+		static size_t getBytesAllocated(void);
+		/// Get the highest number of bytes allocated at once since the last reset
+		static size_t getPeakBytesAllocated(void);
+		/// Get the number of allocations not yet given back
+		static size_t getNumLiveAllocations(void);
+	private:
+		// no instantiation
+		FrameArena()
+		{ }
+	};
+
+	/** An allocation policy for use with STLAllocator which takes its memory
+		from the FrameArena, aligned for SIMD use.
+	@see FrameArena
+	*/
+	class _OgreExport FrameAllocPolicy
+	{
+	public:
+		static inline void* allocateBytes(size_t count,
+			const char*  = 0, int  = 0, const char* = 0)
+		{
+			return FrameArena::allocate(count);
+		}
+
+		static inline void deallocateBytes(void* ptr)
+		{
+			FrameArena::deallocate(ptr);
+		}
+
+		/// Get the maximum size of a single allocation
+		static inline size_t getMaxAllocationSize()
+		{
+			return std::numeric_limits<size_t>::max();
+		}
+	private:
+		// no instantiation
+		FrameAllocPolicy()
+		{ }
+	};
+
+	/** An allocation policy which takes its memory from the FrameArena, aligned
+		at a given boundary (which should be a power of 2).
+	@note
+		template parameter Alignment equal to zero means use default
+		platform dependent alignment.
+	@see FrameArena
+	*/
+	template <size_t Alignment = 0>
+	class FrameAlignedAllocPolicy
+	{
+	public:
+		// compile-time check alignment is available.
+		typedef int IsValidAlignment
+			[Alignment <= 128 && ((Alignment & (Alignment-1)) == 0) ? +1 : -1];
+
+		static inline void* allocateBytes(size_t count,
+			const char*  = 0, int  = 0, const char* = 0)
+		{
+			return FrameArena::allocate(count, Alignment);
+		}
+
+		static inline void deallocateBytes(void* ptr)
+		{
+			FrameArena::deallocate(ptr);
+		}
+
+		/// Get the maximum size of a single allocation
+		static inline size_t getMaxAllocationSize()
+		{
+			return std::numeric_limits<size_t>::max();
+		}
+	private:
+		// no instantiation
+		FrameAlignedAllocPolicy()
+		{ }
+	};
+
+	/** @} */
+	/** @} */
+
+}// namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __MemoryFrameAlloc_H__
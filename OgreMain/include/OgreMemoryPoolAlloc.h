@@ -0,0 +1,182 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __MemoryPoolAlloc_H__
+#define __MemoryPoolAlloc_H__
+
+#include "OgreHeaderPrefix.h"
+
+// Don't include prerequisites, can cause a circular dependency
+// This file must be included within another file which already has the prerequisites in it
+//#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Memory
+	*  @{
+	*/
+	/** A set of pools of fixed size slots, one per size class up to a maximum.
+	@remarks
+		Each pool carves its slots out of large slabs and keeps the slots
+		given back in a free list, so objects of the same size end up close
+		together and creating and destroying them never fragments the heap.
+		Slabs are kept until the set is destroyed.
+	@par
+		Every slot starts with a header naming the pool it belongs to, so
+		memory can be given back without knowing which set it came from,
+		for example when it is freed by another module.
+	@note
+		All methods are thread safe.
+	*/
+	class _OgreExport FixedSizePoolSet
+	{
+	public:
+		typedef void* (*SlabAllocFunc)(size_t bytes);
+		typedef void (*SlabFreeFunc)(void* ptr);
+
+		/// Bytes in front of every slot, keeps the alignment of the slabs
+		static const size_t HEADER_SIZE = 16;
+
+		/** Constructor.
+		@param maxSlotSize The largest allocation the set will serve
+		@param allocSlab, freeSlab Functions providing the memory for the slabs,
+			which should be aligned for SIMD use
+		*/
+		FixedSizePoolSet(size_t maxSlotSize, SlabAllocFunc allocSlab, SlabFreeFunc freeSlab);
+		/** Destructor, frees the slabs of the pools with no slots in use.
+		@remarks
+			Pools still in use keep their memory, as objects may outlive the set
+			when it is a static destroyed on exit.
+		*/
+		~FixedSizePoolSet();
+
+		/// Allocate a slot of at least count bytes, which must not exceed the maximum slot size
+		void* allocate(size_t count);
+		/// Give back a slot obtained from allocate on any set
+		static void deallocate(void* ptr);
+		/// Tell whether memory was allocated from a pool, or by _markUnpooled
+		static bool isPooled(const void* ptr);
+		/** Prepare a header for an allocation which is not pooled.
+		@param block The start of a block of at least HEADER_SIZE bytes more
+			than the allocation, the memory to use starts HEADER_SIZE bytes in.
+		*/
+		static void _markUnpooled(void* block);
+
+		/// Get the largest allocation the set will serve
+		size_t getMaxSlotSize(void) const { return mMaxSlotSize; }
+		/// Get the number of slots in use over all pools
+		size_t getNumSlotsInUse(void) const;
+		/// Get the number of slots in use or free over all pools
+		size_t getNumSlots(void) const;
+	private:
+		struct Pool;
+		Pool* mPools;
+		size_t mNumPools;
+		size_t mMaxSlotSize;
+
+		// not copyable
+		FixedSizePoolSet(const FixedSizePoolSet&);
+		FixedSizePoolSet& operator=(const FixedSizePoolSet&);
+	};
+
+	/** An allocation policy for use with AllocatedObject and STLAllocator
+		which serves small allocations from fixed size pools.
+	@remarks
+		Each instantiation has its own set of pools, with a pool for every
+		size in steps of 16 bytes up to MaxSlotSize, so each class of a given
+		size effectively gets a pool of its own. Larger allocations, such as
+		a subclass bigger than expected, go to CategorisedAllocPolicy.
+	@note
+		Each module using an instantiation gets pools of its own. Memory may
+		still be freed by any module.
+	*/
+	template <MemoryCategory Cat, size_t MaxSlotSize = 640>
+	class PooledAllocPolicy
+	{
+	public:
+		static inline void* allocateBytes(size_t count,
+			const char* file = 0, int line = 0, const char* func = 0)
+		{
+			if (count <= MaxSlotSize)
+				return getPools().allocate(count);
+
+			char* block = static_cast<char*>(CategorisedAllocPolicy<Cat>::allocateBytes(
+				count + FixedSizePoolSet::HEADER_SIZE, file, line, func));
+			FixedSizePoolSet::_markUnpooled(block);
+			return block + FixedSizePoolSet::HEADER_SIZE;
+		}
+
+		static inline void deallocateBytes(void* ptr)
+		{
+			if (!ptr)
+				return;
+			if (FixedSizePoolSet::isPooled(ptr))
+				FixedSizePoolSet::deallocate(ptr);
+			else
+				CategorisedAllocPolicy<Cat>::deallocateBytes(
+					static_cast<char*>(ptr) - FixedSizePoolSet::HEADER_SIZE);
+		}
+
+		/// Get the maximum size of a single allocation
+		static inline size_t getMaxAllocationSize()
+		{
+			return CategorisedAllocPolicy<Cat>::getMaxAllocationSize() - FixedSizePoolSet::HEADER_SIZE;
+		}
+
+		/// Get the pools of this policy
+		static FixedSizePoolSet& getPools()
+		{
+			static FixedSizePoolSet pools(MaxSlotSize, &allocateSlab, &deallocateSlab);
+			return pools;
+		}
+	private:
+		static void* allocateSlab(size_t bytes)
+		{
+			return CategorisedAlignAllocPolicy<Cat>::allocateBytes(bytes);
+		}
+		static void deallocateSlab(void* ptr)
+		{
+			CategorisedAlignAllocPolicy<Cat>::deallocateBytes(ptr);
+		}
+
+		// no instantiation
+		PooledAllocPolicy()
+		{ }
+	};
+
+	/** @} */
+	/** @} */
+
+}// namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __MemoryPoolAlloc_H__
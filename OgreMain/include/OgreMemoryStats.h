@@ -0,0 +1,168 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __MemoryStats_H__
+#define __MemoryStats_H__
+
+#include "OgreHeaderPrefix.h"
+
+// Don't include prerequisites, can cause a circular dependency
+// This file must be included within another file which already has the prerequisites in it
+//#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Memory
+	*  @{
+	*/
+
+#if OGRE_MEMORY_STATS
+
+	/// Allocation counters of one memory category
+	struct MemoryCategoryStats
+	{
+		/// Bytes currently allocated, as requested by the callers
+		size_t liveBytes;
+		/// Number of allocations not yet freed
+		size_t liveAllocations;
+		/// Highest value of liveBytes seen so far
+		size_t peakBytes;
+		/// Number of allocations made since startup
+		size_t totalAllocations;
+		/// Number of allocations made during the last frame
+		size_t frameAllocations;
+
+		MemoryCategoryStats()
+			: liveBytes(0), liveAllocations(0), peakBytes(0)
+			, totalAllocations(0), frameAllocations(0) {}
+	};
+
+	/** Counts the allocations made through the categorised allocation
+		policies.
+	@remarks
+		Unlike MemoryTracker this only keeps counters, and every thread
+		updates counters of its own so that allocating never takes a lock. The
+		counters are summed up when the statistics are requested, and by Root
+		at the end of every frame, so the peak is the highest amount seen at
+		those points rather than at every allocation. The sums are exact when
+		no other thread is allocating, and approximate otherwise.
+	@par
+		This is cheap enough to stay enabled in release builds; it is turned
+		on with OGRE_MEMORY_STATS. Each allocation is made a little larger
+		to remember its size and category.
+	*/
+	class _OgreExport MemoryStats
+	{
+	public:
+		/// Get the statistics of a memory category
+		static MemoryCategoryStats getStats(MemoryCategory category);
+		/// Get the statistics of all memory categories added together
+		static MemoryCategoryStats getTotalStats(void);
+
+		/// Record an allocation, called by the allocation policies
+		static void _recordAlloc(MemoryCategory category, size_t bytes);
+		/// Record a deallocation, called by the allocation policies
+		static void _recordDealloc(MemoryCategory category, size_t bytes);
+		/// Update the peaks and the per frame counts, called by Root
+		static void _frameEnded(void);
+	private:
+		// no instantiation
+		MemoryStats()
+		{ }
+	};
+
+	/** An allocation policy which records allocations in MemoryStats before
+		passing them on to another policy.
+	@remarks
+		The size and category are stored in a header in front of the memory
+		handed out, which is padded to keep the alignment of the underlying
+		policy.
+	@note
+		template parameter Alignment is the alignment of the memory returned by
+		Policy, zero meaning the default platform dependent alignment.
+	*/
+	template <MemoryCategory Cat, class Policy, size_t Alignment = 0>
+	class CountedAllocPolicy
+	{
+	public:
+		static inline void* allocateBytes(size_t count,
+			const char* file = 0, int line = 0, const char* func = 0)
+		{
+			char* ptr = static_cast<char*>(Policy::allocateBytes(count + HEADER_SIZE, file, line, func));
+			if (!ptr)
+				return 0;
+			Header* header = reinterpret_cast<Header*>(ptr);
+			header->bytes = count;
+			header->category = Cat;
+			MemoryStats::_recordAlloc(Cat, count);
+			return ptr + HEADER_SIZE;
+		}
+
+		static inline void deallocateBytes(void* ptr)
+		{
+			if (!ptr)
+				return;
+			char* block = static_cast<char*>(ptr) - HEADER_SIZE;
+			// Memory is sometimes freed with a different category than
+			// it was allocated with, so trust the header
+			const Header* header = reinterpret_cast<const Header*>(block);
+			MemoryStats::_recordDealloc(header->category, header->bytes);
+			Policy::deallocateBytes(block);
+		}
+
+		/// Get the maximum size of a single allocation
+		static inline size_t getMaxAllocationSize()
+		{
+			return Policy::getMaxAllocationSize() - HEADER_SIZE;
+		}
+	private:
+		struct Header
+		{
+			size_t bytes;
+			MemoryCategory category;
+		};
+		// Big enough for the header while keeping the alignment of Policy
+		enum { HEADER_SIZE = Alignment > 16 ? Alignment : 16 };
+
+		// no instantiation
+		CountedAllocPolicy()
+		{ }
+	};
+
+#endif
+	/** @} */
+	/** @} */
+
+}// namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif // __MemoryStats_H__
@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "OgreIteratorWrappers.h"
 #include "OgreMesh.h"
 #include "OgreUserObjectBindings.h"
+#include "OgreAtomicWrappers.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -62,6 +63,8 @@ namespace Ogre {
     */
     class _OgreExport Node : public NodeAlloc
     {
+        friend class TransformHierarchy;
+        friend class BoneHierarchy;
     public:
         /** Enumeration denoting the spaces which a transform can be relative to.
         */
@@ -230,6 +233,9 @@ namespace Ogre {
         typedef vector<Node*>::type QueuedUpdates;
         static QueuedUpdates msQueuedUpdates;
 
+        /// Incremented every time a node is attached to or detached from a parent, from any thread
+        static AtomicScalar<unsigned long> msHierarchyRevision;
+
         DebugRenderable* mDebug;
 
         /// User objects binding.
@@ -657,6 +663,22 @@ namespace Ogre {
         */
         virtual void _update(bool updateChildren, bool parentHasChanged);
 
+        /** Internal method to update the Node, leaving its children to the caller.
+        @remarks
+            This does the same work on this node as _update(true, parentHasChanged),
+            but instead of recursing it appends the children needing an update
+            to the given list. Each of them must then be updated by calling
+            _update(true, value returned by this method). The subtrees are
+            independent, so this allows them to be updated from several threads.
+        @param children
+            The list the children needing an update are appended to.
+        @param parentHasChanged
+            As for _update.
+        @return
+            The parentHasChanged value to update the children with.
+        */
+        virtual bool _updateAndGatherChildren(vector<Node*>::type& children, bool parentHasChanged);
+
         /** Sets a listener for this Node.
         @remarks
             Note for size and performance reasons only one listener per node is
@@ -743,6 +765,13 @@ namespace Ogre {
         /** Process queued 'needUpdate' calls. */
         static void processQueuedUpdates(void);
 
+        /** Gets a counter which changes whenever the parent of any node changes.
+        @remarks
+            This allows classes caching the layout of a node hierarchy, such as
+            TransformHierarchy, to find out cheaply whether it is still valid.
+        */
+        static unsigned long _getHierarchyRevision(void) { return msHierarchyRevision.get(); }
+
 
         /** @deprecated use UserObjectBindings::setUserAny via getUserObjectBindings() instead.
             Sets any kind of user value on this object.
@@ -40,6 +40,21 @@ namespace Ogre {
 	/** \addtogroup Math
 	*  @{
 	*/
+	/** Structure-of-arrays view over a block of node transforms.
+    @remarks
+        Each pointer refers to an array holding one component for every node
+        in the block, so that the same component of consecutive nodes is
+        contiguous in memory. Orientations are stored in (w, x, y, z) order,
+        like Quaternion. The arrays should be aligned to SIMD alignment for
+        best performance.
+    */
+    struct TransformStreams
+    {
+        Real* position[3];
+        Real* orientation[4];
+        Real* scale[3];
+    };
+
 	/** Utility class for provides optimised functions.
     @note
         This class are supposed used by internal engine only.
@@ -72,6 +87,19 @@ namespace Ogre {
         */
         static OptimisedUtil* getImplementation(void) { return msImplementation; }
 
+        /// A named implementation of this class
+        typedef std::pair<String, OptimisedUtil*> NamedImplementation;
+        typedef vector<NamedImplementation>::type NamedImplementationList;
+
+        /** Gets all the implementations usable with the run-time environment.
+        @remarks
+            The generic implementation comes first, followed by the ones
+            using the instruction sets supported by the CPU. This is intended
+            for tests and benchmarks comparing the implementations, the engine
+            itself always uses getImplementation().
+        */
+        static NamedImplementationList getAvailableImplementations(void);
+
         /** Performs software vertex skinning.
         @param srcPosPtr Pointer to source position buffer.
         @param destPosPtr Pointer to destination position buffer.
@@ -203,6 +231,103 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices) = 0;
+
+        /** Calculate the derived transforms of a block of nodes.
+        @remarks
+            Performs the same combination as Node::updateFromParentImpl for
+            every node of the block at once: the derived orientation and scale
+            are the parent's ones combined with the local ones (subject to the
+            inheritance flags), and the local position is scaled and rotated
+            by the parent before being offset by the parent's position.
+        @param parentTransforms Derived transforms of the parent of each node.
+        @param localTransforms Transforms of each node relative to its parent.
+        @param inheritOrientation Array of masks, all bits set if the node
+            inherits orientation from its parent, zero otherwise.
+        @param inheritScale Array of masks, all bits set if the node inherits
+            scale from its parent, zero otherwise.
+        @param derivedTransforms Streams to store the derived transforms in,
+            may not alias the source streams.
+        @param numNodes Number of nodes in the block.
+        */
+        virtual void concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes) = 0;
+
+        /** Calculate the skinning matrices of a block of bones.
+        @remarks
+            Performs the same calculation as Bone::_getOffsetTransform for
+            every bone of the block at once: the derived transform of each
+            bone is combined with the inverse of its binding pose, and the
+            result is expanded to an affine matrix like Matrix4::makeTransform
+            does.
+        @param derivedTransforms Derived transforms of the bones.
+        @param bindingPoseInverses Inverse binding pose transforms of the
+            bones, as returned by Bone::_getBindingPoseInversePosition,
+            Bone::_getBindingPoseInverseOrientation and
+            Bone::_getBindingPoseInverseScale.
+        @param dstMatrices Array of matrices to store the results in. No
+            alignment requirement.
+        @param numBones Number of bones in the block.
+        */
+        virtual void calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones) = 0;
+
+        /** Calculate whether each of a list of boxes is inside a convex volume.
+        @remarks
+            A box is culled when it lies entirely on the negative side of one
+            of the planes, as told by Plane::getSide(centre, halfSize). This
+            is the test Frustum::isVisible performs for a single box.
+        @param planes The planes bounding the volume, facing inwards.
+        @param numPlanes Number of planes.
+        @param centres Streams of the x, y and z coordinates of the box
+            centres. No SIMD alignment requirement but loss performance for
+            unaligned data.
+        @param halfSizes Streams of the x, y and z half sizes of the boxes,
+            with the same alignment requirement as the centres.
+        @param visibilities An array of flags to store the results in, the
+            result flag is true if the corresponding box is not culled by any
+            of the planes, false otherwise. This array no alignment requires.
+        @param numBoxes Number of boxes to test.
+        */
+        virtual void calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes) = 0;
+
+        /** Calculate whether each of a list of spheres is inside a convex volume.
+        @remarks
+            A sphere is culled when its centre is further than its radius on
+            the negative side of one of the planes, which is the test
+            Frustum::isVisible performs for a single sphere.
+        @param planes The planes bounding the volume, facing inwards.
+        @param numPlanes Number of planes.
+        @param centres Streams of the x, y and z coordinates of the sphere
+            centres. No SIMD alignment requirement but loss performance for
+            unaligned data.
+        @param radii Array of the radii of the spheres, with the same
+            alignment requirement as the centres.
+        @param visibilities An array of flags to store the results in, the
+            result flag is true if the corresponding sphere is not culled by
+            any of the planes, false otherwise. This array no alignment requires.
+        @param numSpheres Number of spheres to test.
+        */
+        virtual void calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres) = 0;
     };
 
     /** Returns raw offseted of the given pointer.
@@ -58,7 +58,7 @@ namespace Ogre {
 	};
 
 	/** Class representing a single particle instance. */
-	class _OgreExport Particle : public FXAlloc
+	class _OgreExport Particle : public FXElementAlloc
     {
     protected:
         /// Parent ParticleSystem
@@ -95,6 +95,16 @@ namespace Ogre {
 #   define __OGRE_HAVE_SSE  1
 #endif
 
+/* Define whether or not Ogre compiled with AVX2 and FMA supports. The AVX
+   code is enabled per function, so only compilers which can do that qualify.
+*/
+#if __OGRE_HAVE_SSE && \
+    ((OGRE_COMPILER == OGRE_COMPILER_MSVC && OGRE_COMP_VER >= 1700) || \
+     (OGRE_COMPILER == OGRE_COMPILER_GNUC && OGRE_COMP_VER >= 490) || \
+     (OGRE_COMPILER == OGRE_COMPILER_CLANG && OGRE_COMP_VER >= 380))
+#   define __OGRE_HAVE_AVX  1
+#endif
+
 /* Define whether or not Ogre compiled with VFP supports.
  */
 #if OGRE_DOUBLE_PRECISION == 0 && OGRE_CPU == OGRE_CPU_ARM && (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && defined(__ARM_ARCH_6K__) && defined(__VFP_FP__)
@@ -111,6 +121,10 @@ namespace Ogre {
 #   define __OGRE_HAVE_SSE  0
 #endif
 
+#ifndef __OGRE_HAVE_AVX
+#   define __OGRE_HAVE_AVX  0
+#endif
+
 #ifndef __OGRE_HAVE_VFP
 #   define __OGRE_HAVE_VFP  0
 #endif
@@ -160,6 +174,9 @@ namespace Ogre {
             CPU_FEATURE_FPU         = 1 << 9,
             CPU_FEATURE_PRO         = 1 << 10,
             CPU_FEATURE_HTT         = 1 << 11,
+            CPU_FEATURE_AVX         = 1 << 14,
+            CPU_FEATURE_AVX2        = 1 << 15,
+            CPU_FEATURE_FMA         = 1 << 16,
 #elif OGRE_CPU == OGRE_CPU_ARM
             CPU_FEATURE_VFP         = 1 << 12,
             CPU_FEATURE_NEON        = 1 << 13,
@@ -140,14 +140,17 @@ namespace Ogre {
     class BillboardChain;
     class BillboardSet;
     class Bone;
+    class BoneHierarchy;
     class Camera;
     class Codec;
     class ColourValue;
+    class CompressedTransformKeys;
     class ConfigDialog;
     template <typename T> class Controller;
     template <typename T> class ControllerFunction;
     class ControllerManager;
     template <typename T> class ControllerValue;
+    struct CullingPlanes;
 	class DefaultWorkQueue;
     class Degree;
 	class DepthBuffer;
@@ -297,6 +300,7 @@ namespace Ogre {
     class Texture;
     class TexturePtr;
     class TextureManager;
+    class TransformHierarchy;
     class TransformKeyFrame;
 	class Timer;
 	class UserObjectBindings;
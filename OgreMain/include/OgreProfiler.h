@@ -44,18 +44,24 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #include "OgrePrerequisites.h"
 #include "OgreSingleton.h"
 #include "OgreString.h"
+#include "OgreAtomicWrappers.h"
 #include "OgreHeaderPrefix.h"
 
 #if OGRE_PROFILING == 1
-#	define OgreProfile( a ) Ogre::Profile _OgreProfileInstance( (a) )
-#	define OgreProfileBegin( a ) Ogre::Profiler::getSingleton().beginProfile( (a) )
+// The trace identifier of each call site's name is cached in a static, so the
+// name given to these macros must not change between calls
+#	define OgreProfile( a ) OgreProfileGroup( (a), (Ogre::uint32)Ogre::OGREPROF_USER_DEFAULT )
+#	define OgreProfileBegin( a ) OgreProfileBeginGroup( (a), (Ogre::uint32)Ogre::OGREPROF_USER_DEFAULT )
 #	define OgreProfileEnd( a ) Ogre::Profiler::getSingleton().endProfile( (a) )
-#	define OgreProfileGroup( a, g ) Ogre::Profile _OgreProfileInstance( (a), (g) )
-#	define OgreProfileBeginGroup( a, g ) Ogre::Profiler::getSingleton().beginProfile( (a), (g) )
+#	define OgreProfileGroup( a, g ) static Ogre::uint32 _OgreProfileScope = 0; \
+		Ogre::Profile _OgreProfileInstance( (a), (g), &_OgreProfileScope )
+#	define OgreProfileBeginGroup( a, g ) do { static Ogre::uint32 _OgreProfileScope = 0; \
+		Ogre::Profiler::getSingleton().beginProfile( (a), (g), &_OgreProfileScope ); } while (0)
 #	define OgreProfileEndGroup( a, g ) Ogre::Profiler::getSingleton().endProfile( (a), (g) )
 #	define OgreProfileBeginGPUEvent( g ) Ogre::Profiler::getSingleton().beginGPUEvent(g)
 #	define OgreProfileEndGPUEvent( g ) Ogre::Profiler::getSingleton().endGPUEvent(g)
 #	define OgreProfileMarkGPUEvent( e ) Ogre::Profiler::getSingleton().markGPUEvent(e)
+#	define OgreProfileThreadName( n ) Ogre::Profiler::getSingleton().setTraceThreadName(n)
 #else
 #   define OgreProfile( a )
 #   define OgreProfileBegin( a )
@@ -66,6 +72,7 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #	define OgreProfileBeginGPUEvent( e )
 #	define OgreProfileEndGPUEvent( e )
 #	define OgreProfileMarkGPUEvent( e )
+#	define OgreProfileThreadName( n )
 #endif
 
 namespace Ogre {
@@ -106,7 +113,8 @@ namespace Ogre {
 	{
 
         public:
-            Profile(const String& profileName, uint32 groupID = (uint32)OGREPROF_USER_DEFAULT);
+            Profile(const String& profileName, uint32 groupID = (uint32)OGREPROF_USER_DEFAULT,
+                uint32* traceScope = 0);
             ~Profile();
 
         protected:
@@ -273,6 +281,12 @@ namespace Ogre {
             OgreProfile(name) and braces to limit the scope. You must enable the Profile
             before you can used it with setEnabled(true). If you want to disable profiling
             in Ogre, simply set the macro OGRE_PROFILING to 0.
+        @par
+            Besides the per frame statistics gathered on the main thread, the profiler
+            can capture a trace of every profile completed by every thread, see
+            beginTraceCapture. Each thread records into its own buffer, whose lock
+            is only contended while the trace is exported. Traces can be exported
+            to the Chrome trace event format with exportTrace.
         @author Amit Mathew (amitmathew (at) yahoo (dot) com)
         @todo resolve artificial cap on number of profiles displayed
         @todo fix display ordering of profiles not called every frame
@@ -303,8 +317,12 @@ namespace Ogre {
                 disabled or if the profiler is disabled.
             @param profileName Must be unique and must not be an empty string
 			@param groupID A profile group identifier, which can allow you to mask profiles
+			@param traceScope Optional cache of the identifier of profileName in traces,
+				which must be zero before the first call. The macros pass one per call
+				site, so that the name is only looked up once.
             */
-            void beginProfile(const String& profileName, uint32 groupID = (uint32)OGREPROF_USER_DEFAULT);
+            void beginProfile(const String& profileName, uint32 groupID = (uint32)OGREPROF_USER_DEFAULT,
+                uint32* traceScope = 0);
 
             /** Ends a profile
             @remarks 
@@ -401,6 +419,56 @@ namespace Ogre {
             /** Gets the frequency that the Profiler display is updated */
             uint getUpdateDisplayFrequency() const;
 
+            /** Starts capturing a trace of the profiles completed by all threads.
+            @remarks
+                While capturing, each thread records the profiles it completes into its
+                own ring buffer, without taking any lock, so worker threads such as those
+                of the DefaultWorkQueue can be profiled. This is independent of the per
+                frame statistics enabled with setEnabled, which only follow the thread
+                the Profiler was created on. The group mask applies to traces but profiles
+                disabled by name are still recorded. When the ring buffer of a thread is
+                full, its oldest profiles are overwritten. The previous capture is discarded.
+            */
+            void beginTraceCapture(void);
+
+            /** Stops capturing the trace.
+            @remarks
+                Profiles still open on other threads are not waited for and will be
+                missing from the capture, so this is best called between frames while
+                the worker threads are idle.
+            */
+            void endTraceCapture(void);
+
+            /** Gets whether a trace is being captured */
+            bool isTraceCapturing(void) const { return mTraceCapturing.get(); }
+
+            /** Sets the number of profiles each thread can hold in a trace capture.
+            @remarks
+                Takes effect at the next call to beginTraceCapture. The default is 65536.
+            */
+            void setTraceBufferSize(size_t profiles);
+
+            /** Gets the number of profiles each thread can hold in a trace capture */
+            size_t getTraceBufferSize(void) const { return mTraceBufferSize; }
+
+            /** Sets the name under which the calling thread appears in traces.
+            @remarks
+                Use the macro OgreProfileThreadName(name) instead of calling this directly.
+            */
+            void setTraceThreadName(const String& name);
+
+            /** Writes the last trace captured in the Chrome trace event JSON format.
+            @remarks
+                The output can be loaded in the chrome://tracing page of Chrome or in
+                any viewer supporting this format. Must not be called while capturing.
+            */
+            void exportTrace(std::ostream& stream);
+
+            /** Writes the last trace captured to a file in the Chrome trace event JSON format.
+            @see Profiler::exportTrace(std::ostream&)
+            */
+            void exportTrace(const String& filename);
+
 			/**
 			@remarks
 				Register a ProfileSessionListener from the Profiler
@@ -469,6 +537,27 @@ namespace Ogre {
             /** Handles a change of the profiler's enabled state*/
             void changeEnableState();
 
+            /// Profiles recorded by a thread for trace captures
+            struct TraceThread;
+            /// Thread local reference to a TraceThread, which outlives the thread
+            struct TraceThreadHandle;
+            typedef vector<TraceThread*>::type TraceThreadList;
+
+            /** Gets the trace data of the calling thread, creating it if needed */
+            TraceThread* getTraceThread(void);
+
+            /** Gets the identifier of a profile name, shared by all threads and profilers */
+            static uint32 registerTraceScope(const String& profileName);
+
+            /** Gets the identifier of a profile name, using the cache of the thread */
+            uint32 getTraceScopeId(TraceThread* thread, const String& profileName);
+
+            /** Records the beginning of a profile into the trace of the calling thread */
+            void beginTraceProfile(TraceThread* thread, const String& profileName, uint32* traceScope);
+
+            /** Records the end of a profile into the trace of the calling thread */
+            void endTraceProfile(TraceThread* thread, uint32 groupID);
+
 			// lol. Uses typedef; put's original container type in name.
             typedef set<String>::type DisabledProfileMap;
 			typedef ProfileInstance::ProfileChildren ProfileChildren;
@@ -513,6 +602,27 @@ namespace Ogre {
 			Real mAverageFrameTime;
 			bool mResetExtents;
 
+            /// Trace data of each thread which ever used the profiler
+            TraceThreadList mTraceThreads;
+            /// Trace data of the thread the profiler was created on
+            TraceThread* mMainTraceThread;
+            OGRE_THREAD_POINTER(TraceThreadHandle, mTraceThreadHandle);
+            /// Names of the profiles seen in traces, indexed by identifier. These
+            /// outlive the profiler, as the macros cache the identifiers.
+            static vector<String>::type msTraceScopeNames;
+            /// Identifiers of the profiles seen in traces
+            static HashMap<String, uint32> msTraceScopeIds;
+            /// Protects the profile names
+            OGRE_STATIC_MUTEX(msTraceScopeMutex)
+            /// Protects the list of trace threads
+            OGRE_MUTEX(mTraceMutex)
+            /// Whether a trace is being captured
+            AtomicScalar<bool> mTraceCapturing;
+            /// Incremented by each capture, lets threads reset their buffers lazily
+            AtomicScalar<uint32> mTraceCapture;
+            /// Number of profiles each thread can hold in a capture
+            size_t mTraceBufferSize;
+
 
     }; // end class
 	/** @} */
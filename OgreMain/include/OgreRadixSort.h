@@ -83,6 +83,11 @@ namespace Ogre {
 		floats (which are often not supported by other radix sorters). doubles
 		are not supported; you will need to implement your functor object to convert
 		to float if you wish to use this sort routine.
+	@par
+		64-bit unsigned keys are supported too, which allows several sort criteria
+		to be packed into a single key and sorted in one go. Byte positions which
+		are identical for every item are skipped, so sparse keys cost less than
+		their full width.
 	*/
 	template <class TContainer, class TContainerValueType, typename TCompValueType>
 	class RadixSort
@@ -91,8 +96,8 @@ namespace Ogre {
 		typedef typename TContainer::iterator ContainerIter;
 	protected:
 		/// Alpha-pass counters of values (histogram)
-		/// 4 of them so we can radix sort a maximum of a 32bit value
-		int mCounters[4][256];
+		/// One per byte of the sort value
+		int mCounters[sizeof(TCompValueType)][256];
 		/// Beta-pass offsets 
 		int mOffsets[256];
 		/// Sort area size
@@ -302,6 +307,11 @@ namespace Ogre {
 
 			for (p = 0; p < mNumPasses - 1; ++p)
 			{
+				// Skip bytes which are the same for every item, the
+				// pass would leave the order untouched
+				if (mCounters[p][getByte(p, mSortArea1[0].key)] == mSortSize)
+					continue;
+
 				sortPass(p);
 				// flip src/dst
 				SortVector* tmp = mSrc;
@@ -130,7 +130,19 @@ namespace Ogre {
 			/** Sort ascending camera distance 
 				Note value overlaps with descending since both use same sort
 			*/
-			OM_SORT_ASCENDING = 6
+			OM_SORT_ASCENDING = 6,
+			/** Group by pass using packed 64-bit sort keys
+			@remarks
+				Visited like OM_PASS_GROUP, but the items are kept in a single
+				contiguous list which is reused between frames and ordered with one
+				radix sort on a key made of the pass hash and the camera distance,
+				so items sharing a pass are also drawn front to back. This avoids
+				the per-pass lists and map lookups of OM_PASS_GROUP, which is
+				faster for queues holding thousands of renderables. An
+				OM_PASS_GROUP visit falls back to this mode if it is the only
+				grouping requested.
+			*/
+			OM_SORT_KEY = 8
 		};
 
 	protected:
@@ -198,19 +210,10 @@ namespace Ogre {
         /** Map of pass to renderable lists, this is a grouping by pass. */
         typedef map<Pass*, RenderableList*, PassGroupLess>::type PassGroupRenderableMap;
 
-		/// Functor for accessing sort value 1 for radix sort (Pass)
-		struct RadixSortFunctorPass
-		{
-			uint32 operator()(const RenderablePass& p) const
-            {
-                return p.pass->getHash();
-            }
-		};
-
-        /// Radix sorter for accessing sort value 1 (Pass)
-		static RadixSort<RenderablePassList, RenderablePass, uint32> msRadixSorter1;
+		/// Converts a float to an unsigned integer with the same ordering
+		static uint32 getOrderedBits(float value);
 
-		/// Functor for descending sort value 2 for radix sort (distance)
+		/// Functor for the radix sort key of OM_SORT_DESCENDING (distance, then pass)
 		struct RadixSortFunctorDistance
 		{
 			const Camera* camera;
@@ -220,16 +223,40 @@ namespace Ogre {
             {
             }
 
-			float operator()(const RenderablePass& p) const
+			uint64 operator()(const RenderablePass& p) const;
+		};
+
+		/// Functor for the radix sort key of OM_SORT_KEY (pass, then distance)
+		struct RadixSortFunctorPassDistance
+		{
+			const Camera* camera;
+
+            RadixSortFunctorPassDistance(const Camera* cam)
+                : camera(cam)
             {
-                // Sort DESCENDING by depth (ie far objects first), use negative distance
-                // here because radix sorter always dealing with accessing sort
-                return static_cast<float>(- p.renderable->getSquaredViewDepth(camera));
             }
+
+			uint64 operator()(const RenderablePass& p) const;
 		};
 
-        /// Radix sorter for sort value 2 (distance)
-		static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
+		/// Comparator to order OM_SORT_KEY lists too short for a radix sort
+		struct PassDistanceLess
+		{
+			RadixSortFunctorPassDistance key;
+
+			PassDistanceLess(const Camera* cam)
+				: key(cam)
+			{
+			}
+
+			bool operator()(const RenderablePass& a, const RenderablePass& b) const
+			{
+				return key(a) < key(b);
+			}
+		};
+
+        /// Radix sorter for the packed sort keys
+		static RadixSort<RenderablePassList, RenderablePass, uint64> msRadixSorter;
 
 		/// Bitmask of the organisation modes requested
 		uint8 mOrganisationMode;
@@ -238,6 +265,8 @@ namespace Ogre {
 		PassGroupRenderableMap mGrouped;
 		/// Sorted descending (can iterate backwards to get ascending)
 		RenderablePassList mSortedDescending;
+		/// Grouped by pass through sort keys
+		RenderablePassList mSortedByKey;
 
 		/// Internal visitor implementation
 		void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
@@ -245,6 +274,8 @@ namespace Ogre {
 		void acceptVisitorDescending(QueuedRenderableVisitor* visitor) const;
 		/// Internal visitor implementation
 		void acceptVisitorAscending(QueuedRenderableVisitor* visitor) const;
+		/// Internal visitor implementation
+		void acceptVisitorSortKey(QueuedRenderableVisitor* visitor) const;
 
 	public:
 		QueuedRenderableCollection();
@@ -47,6 +47,19 @@ namespace Ogre {
 	/// Identifier of a background process
 	typedef WorkQueue::RequestID BackgroundProcessTicket;
 
+	/** The stages a background process goes through */
+	enum BackgroundProcessState
+	{
+		/// Waiting in the ResourceBackgroundQueue for its turn
+		BPS_QUEUED,
+		/// Handed to the WorkQueue, waiting for a worker thread or running on one
+		BPS_PROCESSING,
+		/// Done in the background, waiting for its main thread step
+		BPS_WAITING_FOR_LOAD,
+		/// Completed or aborted, or an unknown ticket
+		BPS_COMPLETE
+	};
+
 	/** Encapsulates the result of a background queue request */
 	struct BackgroundProcessResult
 	{
@@ -77,6 +90,19 @@ namespace Ogre {
 		performed, and once finished the ticket will be marked as complete. 
 		You can check the status of tickets by calling isProcessComplete() 
 		from your queueing thread. 
+	@par
+		Every request has a priority. Only a few requests are handed to the
+		WorkQueue at once (see setMaxActiveRequests), the others wait in
+		this class, where requests of a higher priority go first. Waiting
+		requests can still be given another priority or aborted cheaply,
+		which lets a streaming application keep the threads busy with what is
+		needed next.
+	@par
+		When OGRE_THREAD_SUPPORT is 2, loading is split into a prepare step in
+		the background and a load step on the main thread. The time and size
+		of the load steps run per frame can be limited with setLoadTimeBudget
+		and setLoadSizeBudget, in which case they are queued in order of
+		priority and run by _processPendingLoads.
 	*/
 	class _OgreExport ResourceBackgroundQueue : public Singleton<ResourceBackgroundQueue>, public ResourceAlloc, 
 		public WorkQueue::RequestHandler, public WorkQueue::ResponseHandler
@@ -133,6 +159,8 @@ namespace Ogre {
 			NameValuePairList* loadParams;
 			Listener* listener;
 			BackgroundProcessResult result;
+			BackgroundProcessTicket ticket;
+			uint8 priority;
 
 			_OgreExport friend std::ostream& operator<<(std::ostream& o, const ResourceRequest& r)
 			{ (void)r; return o; }
@@ -157,6 +185,42 @@ namespace Ogre {
 
 		BackgroundProcessTicket addRequest(ResourceRequest& req);
 
+		typedef list<ResourceRequest>::type ResourceRequestList;
+		/// Requests not handed to the WorkQueue yet, highest priority first
+		ResourceRequestList mQueuedRequests;
+		/// Details kept of a request handed to the WorkQueue
+		struct ActiveRequest
+		{
+			BackgroundProcessTicket ticket;
+			uint8 priority;
+		};
+		typedef map<WorkQueue::RequestID, ActiveRequest>::type ActiveRequestMap;
+		/// Requests handed to the WorkQueue whose response hasn't been handled yet
+		ActiveRequestMap mActiveRequests;
+		/// Number of requests handed to the WorkQueue which haven't been processed yet
+		size_t mNumRunningRequests;
+		size_t mMaxActiveRequests;
+		typedef list<ResourceResponse>::type ResourceResponseList;
+		/// Responses waiting for their main thread step, highest priority first
+		ResourceResponseList mPendingLoads;
+		unsigned long mLoadTimeBudget;
+		size_t mLoadSizeBudget;
+		BackgroundProcessTicket mNextTicket;
+		OGRE_MUTEX(mRequestMutex)
+
+		/// Inserts a request into mQueuedRequests after those of the same or a higher priority
+		void queueRequest(const ResourceRequest& req);
+		/// Inserts a response into mPendingLoads after those of the same or a higher priority
+		void queuePendingLoad(const ResourceResponse& resresp);
+		/// Hands queued requests to the WorkQueue while there is room, must be called with mRequestMutex locked
+		void dispatchRequests(void);
+		/// Processes a request, called by handleRequest
+		WorkQueue::Response* processRequest(const WorkQueue::Request* req);
+		/// Runs the main thread step of a request and notifies the listeners
+		void completeRequest(ResourceResponse& resresp);
+		/// Deletes the load parameters of a request which won't run
+		void discardRequest(ResourceRequest& req);
+
 	public:
 		ResourceBackgroundQueue();
 		virtual ~ResourceBackgroundQueue();
@@ -176,43 +240,47 @@ namespace Ogre {
 		@param name The name of the resource group to initialise
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@return Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket initialiseResourceGroup(
-			const String& name, Listener* listener = 0);
+			const String& name, Listener* listener = 0, uint8 priority = 0);
 
 		/** Initialise all resource groups which are yet to be initialised in 
 			the background.
 		@see ResourceGroupManager::intialiseResourceGroup
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@return Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket initialiseAllResourceGroups( 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 		/** Prepares a resource group in the background.
 		@see ResourceGroupManager::prepareResourceGroup
 		@param name The name of the resource group to prepare
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@return Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket prepareResourceGroup(const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 
 		/** Loads a resource group in the background.
 		@see ResourceGroupManager::loadResourceGroup
 		@param name The name of the resource group to load
 		@param listener Optional callback interface, take note of warnings in 
 			the header and only use if you understand them.
+		@param priority Requests with a higher priority are processed first
 		@return Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket loadResourceGroup(const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 
 
 		/** Unload a single resource in the background. 
@@ -220,29 +288,32 @@ namespace Ogre {
 		@param resType The type of the resource 
 			(from ResourceManager::getResourceType())
 		@param name The name of the Resource
+		@param priority Requests with a higher priority are processed first
 		*/
 		virtual BackgroundProcessTicket unload(
 			const String& resType, const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 
 		/** Unload a single resource in the background. 
 		@see ResourceManager::unload
 		@param resType The type of the resource 
 			(from ResourceManager::getResourceType())
 		@param handle Handle to the resource 
+		@param priority Requests with a higher priority are processed first
 		*/
 		virtual BackgroundProcessTicket unload(
 			const String& resType, ResourceHandle handle, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 
 		/** Unloads a resource group in the background.
 		@see ResourceGroupManager::unloadResourceGroup
 		@param name The name of the resource group to load
+		@param priority Requests with a higher priority are processed first
 		@return Ticket identifying the request, use isProcessComplete() to 
 			determine if completed if not using listener
 		*/
 		virtual BackgroundProcessTicket unloadResourceGroup(const String& name, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 
 
 		/** Prepare a single resource in the background. 
@@ -259,13 +330,14 @@ namespace Ogre {
         @param loadParams Optional pointer to a list of name/value pairs 
             containing loading parameters for this type of resource. Remember 
 			that this must have a lifespan longer than the return of this call!
+		@param priority Requests with a higher priority are processed first
 		*/
 		virtual BackgroundProcessTicket prepare(
 			const String& resType, const String& name, 
             const String& group, bool isManual = false, 
 			ManualResourceLoader* loader = 0, 
 			const NameValuePairList* loadParams = 0, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 
 		/** Load a single resource in the background. 
 		@see ResourceManager::load
@@ -281,13 +353,14 @@ namespace Ogre {
         @param loadParams Optional pointer to a list of name/value pairs 
             containing loading parameters for this type of resource. Remember 
 			that this must have a lifespan longer than the return of this call!
+		@param priority Requests with a higher priority are processed first
 		*/
 		virtual BackgroundProcessTicket load(
 			const String& resType, const String& name, 
             const String& group, bool isManual = false, 
 			ManualResourceLoader* loader = 0, 
 			const NameValuePairList* loadParams = 0, 
-			Listener* listener = 0);
+			Listener* listener = 0, uint8 priority = 0);
 		/** Returns whether a previously queued process has completed or not. 
 		@remarks
 			This method of checking that a background process has completed is
@@ -303,10 +376,70 @@ namespace Ogre {
 		*/
 		virtual bool isProcessComplete(BackgroundProcessTicket ticket);
 
+		/** Gets the stage a previously queued process has reached.
+		@param ticket The ticket which was returned when the process was queued
+		*/
+		virtual BackgroundProcessState getProcessState(BackgroundProcessTicket ticket);
+
 		/** Aborts background process.
+		@remarks
+			A process still waiting in this class or waiting for its main thread
+			step is dropped straight away. One handed to the WorkQueue is marked
+			as aborted, and is dropped unless it has already started. Listeners
+			are not called for aborted processes.
 		*/
 		void abortRequest( BackgroundProcessTicket ticket );
 
+		/** Aborts all background processes with a priority lower than the one given.
+		@see abortRequest
+		*/
+		void abortRequestsBelowPriority(uint8 priority);
+
+		/** Changes the priority of a previously queued process.
+		@remarks
+			This only has an effect while the process is waiting in this class
+			or waiting for its main thread step.
+		@return Whether the process was found at one of these stages
+		*/
+		bool setRequestPriority(BackgroundProcessTicket ticket, uint8 priority);
+
+		/** Sets the maximum number of requests handed to the WorkQueue at once.
+		@remarks
+			Further requests wait in this class, in order of priority, until
+			one of those is processed. A lower number lets priorities take
+			effect sooner. The default is 0, meaning no limit, in which case
+			priorities only apply to the main thread step.
+		*/
+		void setMaxActiveRequests(size_t count);
+		/// Gets the maximum number of requests handed to the WorkQueue at once
+		size_t getMaxActiveRequests(void) const { return mMaxActiveRequests; }
+
+		/** Sets the time _processPendingLoads may spend on load steps per frame.
+		@remarks
+			At least one load step is run per frame however long it takes.
+			Setting this and the size budget to 0, the default, runs the
+			load steps as soon as their background step completes, outside
+			of any budget.
+		@param ms Time in milliseconds, 0 for no limit
+		*/
+		void setLoadTimeBudget(unsigned long ms);
+		/// Gets the time _processPendingLoads may spend on load steps per frame
+		unsigned long getLoadTimeBudget(void) const { return mLoadTimeBudget; }
+		/** Sets the size of the resources _processPendingLoads may load per frame.
+		@remarks
+			At least one load step is run per frame however large the resource.
+		@param bytes Total size of the resources loaded, 0 for no limit
+		@see setLoadTimeBudget
+		*/
+		void setLoadSizeBudget(size_t bytes);
+		/// Gets the size of the resources _processPendingLoads may load per frame
+		size_t getLoadSizeBudget(void) const { return mLoadSizeBudget; }
+
+		/** Runs the main thread steps waiting for the load budget.
+		@note Called by Root at the end of every frame.
+		*/
+		void _processPendingLoads(void);
+
 		/// Implementation for WorkQueue::RequestHandler
 		bool canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
 		/// Implementation for WorkQueue::RequestHandler
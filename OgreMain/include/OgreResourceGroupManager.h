@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreResource.h"
 #include "OgreArchive.h"
 #include "OgreIteratorWrappers.h"
+#include "OgreTaskGroup.h"
 #include <ctime>
 #include "OgreHeaderPrefix.h"
 
@@ -358,6 +359,11 @@ namespace Ogre {
 			Called as part of initialiseResourceGroup
 		*/
 		void parseResourceGroupScripts(ResourceGroup* grp);
+		/** Opens a script found for a group, in memory if it's a small file.
+		@remarks
+			Called as part of parseResourceGroupScripts
+		*/
+		DataStreamPtr openResourceGroupScript(const FileInfo& fileInfo, ResourceGroup* grp);
 		/** Create all the pre-declared resources.
 		@remarks
 			Called as part of initialiseResourceGroup
@@ -400,6 +406,35 @@ namespace Ogre {
 
 		/// Stored current group - optimisation for when bulk loading a group
 		ResourceGroup* mCurrentGroup;
+
+		/// Task preparing one of the resources of a group
+		class _OgreExport ResourcePrepareTask : public TaskGroup::Task
+		{
+		public:
+			Resource* resource;
+			void execute(void);
+		};
+		/// Runs the preparation of resources across threads, null unless parallel loading is enabled
+		TaskGroup* mPrepareTaskGroup;
+		/// Task doing the first part of parsing one script
+		class _OgreExport ScriptPreParseTask : public TaskGroup::Task
+		{
+		public:
+			ScriptLoader* loader;
+			DataStreamPtr stream;
+			String groupName;
+			void execute(void);
+		};
+		/// Runs the parsing of scripts across threads, null unless parallel loading is enabled
+		TaskGroup* mScriptTaskGroup;
+		/// Held for the whole of a parallel prepare or load, as the group isn't locked then
+		OGRE_MUTEX(mParallelLoadMutex)
+
+		/** Prepares or loads the resources of a group after preparing them
+			across the threads of mPrepareTaskGroup.
+		*/
+		void processResourceGroupInParallel(const String& name, bool load,
+			bool mainResources, bool worldGeom);
     public:
         ResourceGroupManager();
         virtual ~ResourceGroupManager();
@@ -530,6 +565,33 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
 			bool loadWorldGeom = true);
 
+		/** Sets whether prepareResourceGroup and loadResourceGroup prepare
+			resources on several threads.
+		@remarks
+			When enabled, the resources of the group are taken in batches. The
+			resources of a batch are first prepared across the WorkQueue worker
+			threads and the calling thread, which is where reading and decoding
+			files takes place. They are then prepared or loaded one by one on the
+			calling thread as usual, so anything which needs the render system is
+			still done there, and the ResourceGroupListener events are fired in
+			the same order and number as without parallel loading.
+		@par
+			The resource group isn't locked while a batch is being prepared,
+			since preparing a resource needs to open files through this class.
+			These methods must then not be called with this class or one of its
+			groups locked, and resources added to the group meanwhile are left
+			out. Failures to prepare a resource are reported by the calling
+			thread.
+		@par
+			Initialising a resource group also tokenises and parses its scripts
+			across threads, batch by batch, when the ScriptLoader supports it.
+			The scripts are still compiled one by one in the usual order.
+			Disabled by default.
+		*/
+		void setParallelLoadingEnabled(bool enabled);
+		/// Gets whether resources of groups are prepared on several threads
+		bool isParallelLoadingEnabled(void) const { return mPrepareTaskGroup != 0; }
+
         /** Unloads a resource group.
         @remarks
             This method unloads all the resources that have been declared as
@@ -55,6 +55,7 @@ Torus Knot Software Ltd.
 #include "OgreLodListener.h"
 #include "OgreInstanceManager.h"
 #include "OgreRenderSystem.h"
+#include "OgreTaskGroup.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -215,6 +216,61 @@ namespace Ogre {
 			Real skyBoxDistance;
 		};
 
+		/** Instrumentation of the work done by a SceneManager during one frame.
+		@remarks
+			The counters are always maintained, since they cost no more than an
+			increment. The timings, in microseconds, are only measured when
+			enabled with setFrameTimingEnabled, as some of them query the timer
+			for every renderable.
+		@par
+			All the cameras rendered by the SceneManager during the frame are
+			accumulated, shadow cameras included. The timings do not overlap:
+			the scene graph updates, culling, sorting and parameter updates done
+			for the shadow cameras are counted in their own timings rather than
+			in the time spent preparing the shadow textures.
+		@see SceneManager::getLastFrameStatistics
+		*/
+		struct _OgreExport FrameStatistics
+		{
+			/// Number of the frame, as returned by Root::getNextFrameNumber
+			unsigned long frameNumber;
+			/// Number of calls to _renderScene
+			size_t scenesRendered;
+
+			/// Time spent in _updateSceneGraph
+			unsigned long updateSceneGraphTime;
+			/// Time spent in _findVisibleObjects
+			unsigned long findVisibleObjectsTime;
+			/// Time spent sorting the render queue groups
+			unsigned long sortQueueTime;
+			/// Time spent in prepareShadowTextures, less the other timings above
+			unsigned long prepareShadowTexturesTime;
+			/// Time spent updating and binding GPU program parameters
+			unsigned long gpuParametersTime;
+
+			/// Passes whose state was sent to the render system by _setPass
+			size_t passesApplied;
+			/// Sorted renderables which did not set their pass again, because
+			/// the previous renderable had already set the same one
+			size_t passesAvoided;
+			/// GPU programs bound on the render system
+			size_t programsBound;
+			/// GPU program binds skipped because the program was still bound
+			size_t programBindsAvoided;
+			/// GPU programs unbound on the render system
+			size_t programsUnbound;
+			/// Texture units set by _setPass
+			size_t textureUnitsApplied;
+			/// Texture units not set again because their pass was avoided
+			size_t textureUnitsAvoided;
+			/// GPU program parameter sets sent to the render system
+			size_t gpuParametersApplied;
+			/// Parameter updates skipped because no parameters were dirty
+			size_t gpuParametersAvoided;
+
+			FrameStatistics();
+		};
+
 		/** Class that allows listening in on the various stages of SceneManager
 			processing, so that custom behaviour can be implemented from outside.
 		*/
@@ -358,13 +414,17 @@ namespace Ogre {
 		protected:
 			/// Pass that was actually used at the grouping level
 			const Pass* mUsedPass;
+			/// Pass set for the last sorted renderable, if still applied
+			const Pass* mLastSortedPass;
 		public:
 			SceneMgrQueuedRenderableVisitor() 
-				:transparentShadowCastersMode(false) {}
+				:mUsedPass(0), mLastSortedPass(0), transparentShadowCastersMode(false) {}
 			~SceneMgrQueuedRenderableVisitor() {}
 			void visit(Renderable* r);
 			bool visit(const Pass* p);
 			void visit(RenderablePass* rp);
+			/// Called before visiting a collection, the render state is unknown
+			void resetLastPass(void) { mLastSortedPass = 0; }
 
 			/// Target SM to send renderables to
 			SceneManager* targetSceneMgr;
@@ -797,6 +857,7 @@ namespace Ogre {
 		typedef vector<InstanceManager*>::type		InstanceManagerVec;
 		InstanceManagerVec mDirtyInstanceManagers;
 		InstanceManagerVec mDirtyInstanceMgrsTmp;
+		OGRE_MUTEX(mDirtyInstanceManagersMutex)
 
 		/** Updates all instance managaers with dirty instance batches. @see _addDirtyInstanceManager */
 		void updateDirtyInstanceManagers(void);
@@ -871,6 +932,151 @@ namespace Ogre {
 		uint32 mVisibilityMask;
 		bool mFindVisibleObjects;
 
+		/// Depth-sorted transform storage used by _updateSceneGraph, if enabled
+		TransformHierarchy* mTransformHierarchy;
+
+		/// A subtree of the scene graph updated by one of the parallel update tasks
+		struct SceneGraphSubtree
+		{
+			Node* node;
+			/// Whether the transform of the parent of the subtree changed
+			bool parentHasChanged;
+		};
+		typedef vector<SceneGraphSubtree>::type SceneGraphSubtreeList;
+
+		/** Task updating a range of subtrees, used by the parallel scene graph
+			update.
+		*/
+		class _OgreExport SceneGraphUpdateTask : public TaskGroup::Task
+		{
+		public:
+			/// The subtrees to update
+			const SceneGraphSubtreeList* subtrees;
+			/// Range of subtrees updated by this task
+			size_t begin, end;
+
+			void execute(void);
+		};
+		typedef vector<SceneGraphUpdateTask>::type SceneGraphUpdateTaskList;
+
+		/// Runs the parallel scene graph update tasks, if enabled
+		TaskGroup* mSceneGraphTaskGroup;
+		/// Subtrees to update this frame
+		SceneGraphSubtreeList mSceneGraphUpdateSubtrees;
+		/// Nodes split into subtrees, whose bounds are updated once their children are
+		vector<SceneNode*>::type mSceneGraphSplitNodes;
+		/// Parallel scene graph update tasks, kept to avoid allocating every frame
+		SceneGraphUpdateTaskList mSceneGraphUpdateTasks;
+		/// Pointers to mSceneGraphUpdateTasks, as passed to mSceneGraphTaskGroup
+		TaskGroup::TaskList mSceneGraphUpdateTaskList;
+
+		/** Updates the scene graph by distributing its subtrees across the
+			threads of mSceneGraphTaskGroup.
+		@remarks
+			The nodes near the root are split level by level on the calling
+			thread until there are enough subtrees to keep the threads busy,
+			so that a graph with few children below the root still updates in
+			parallel.
+		*/
+		virtual void updateSceneGraphInParallel(void);
+
+		/** Task culling a range of the subtrees below the root node, used by
+			the parallel visibility culling.
+		*/
+		class _OgreExport FindVisibleNodesTask : public TaskGroup::Task
+		{
+		public:
+			/// The planes of the camera to cull against
+			const CullingPlanes* planes;
+			/// The subtrees to cull
+			const vector<SceneNode*>::type* nodes;
+			/// Range of nodes culled by this task
+			size_t begin, end;
+			/// Visible nodes found by the task, in scene graph order
+			vector<SceneNode*>::type visibleNodes;
+
+			void execute(void);
+		};
+		typedef vector<FindVisibleNodesTask>::type FindVisibleNodesTaskList;
+
+		/// Runs the parallel visibility culling tasks, if enabled
+		TaskGroup* mCullingTaskGroup;
+		/// Culling planes of the camera, shared by the culling tasks
+		CullingPlanes mCullingPlanes;
+		/// Subtrees below the root node to cull
+		vector<SceneNode*>::type mCullingSubtrees;
+		/// Parallel culling tasks, kept to avoid allocating every frame
+		FindVisibleNodesTaskList mCullingTasks;
+		/// Pointers to mCullingTasks, as passed to mCullingTaskGroup
+		TaskGroup::TaskList mCullingTaskList;
+
+		/** Finds the visible objects by culling the subtrees below the root
+			node on the threads of mCullingTaskGroup.
+		@remarks
+			Only the culling is done in parallel: the visible nodes found by each
+			task are then queued on the calling thread, in the order of the tasks,
+			since adding objects to the render queue may modify materials and
+			other shared state. The queue is thus filled in the same order for
+			any number of threads.
+		*/
+		virtual void findVisibleObjectsInParallel(Camera* cam, 
+			VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters);
+
+		/** Task evaluating the skeletal animation of a range of entities, used
+			by the parallel animation update.
+		*/
+		class _OgreExport AnimationUpdateTask : public TaskGroup::Task
+		{
+		public:
+			/// The entities to update
+			const vector<Entity*>::type* entities;
+			/// Range of entities updated by this task
+			size_t begin, end;
+
+			void execute(void);
+		};
+		typedef vector<AnimationUpdateTask>::type AnimationUpdateTaskList;
+
+		/// Runs the parallel animation update tasks, if enabled
+		TaskGroup* mAnimationTaskGroup;
+		/// Entities whose bone matrices are evaluated this frame
+		vector<Entity*>::type mAnimationUpdateEntities;
+		/// Parallel animation update tasks, kept to avoid allocating every frame
+		AnimationUpdateTaskList mAnimationUpdateTasks;
+		/// Pointers to mAnimationUpdateTasks, as passed to mAnimationTaskGroup
+		TaskGroup::TaskList mAnimationUpdateTaskList;
+
+		/** Evaluates the skeletal animation of the animated entities on the
+			threads of mAnimationTaskGroup.
+		@remarks
+			Only the animation state and bone matrices are evaluated in parallel,
+			for the entities which report Entity::_isBoneMatricesUpdatePending.
+			Rendering the entities then finds their bone matrices up to date, and
+			does the remaining work (software skinning, attached objects) on the
+			rendering thread as usual.
+		*/
+		virtual void updateAnimationsInParallel(void);
+
+		/// Statistics of the frame in progress
+		FrameStatistics mFrameStatistics;
+		/// Statistics of the last completed frame
+		FrameStatistics mLastFrameStatistics;
+		/// Whether the frame statistics timings are measured
+		bool mFrameTimingEnabled;
+		/// File the statistics of each completed frame are written to, if any
+		String mFrameStatisticsLogName;
+		std::ofstream mFrameStatisticsLog;
+
+		/** Completes the statistics of the frame in progress if a new frame
+			has started since, called at the start of _renderScene.
+		*/
+		virtual void updateFrameStatistics(void);
+		/** Writes the statistics of a frame to the frame statistics file. */
+		void writeFrameStatistics(const FrameStatistics& stats);
+
+		/** Sorts a render queue group, as the first step of rendering it. */
+		void sortPriorityGroup(RenderPriorityGroup* group);
+
 		/// Suppress render state changes?
 		bool mSuppressRenderStateChanges;
 		/// Suppress shadows?
@@ -996,8 +1202,13 @@ namespace Ogre {
 		virtual void useLights(const LightList& lights, unsigned short limit);
 		virtual void setViewMatrix(const Matrix4& m);
 		virtual void useLightsGpuProgram(const Pass* pass, const LightList* lights);
+		/// GPU program last bound through bindGpuProgram, per GpuProgramType
+		GpuProgram* mBoundGpuPrograms[GPT_COMPUTE_PROGRAM + 1];
 		virtual void bindGpuProgram(GpuProgram* prog);
+		virtual void unbindGpuProgram(GpuProgramType gptype);
 		virtual void updateGpuProgramParameters(const Pass* p);
+		/// Uploads the parameters of one program, skipping those that are unchanged
+		void bindGpuProgramParameters(GpuProgramType gptype, const GpuProgramParametersSharedPtr& params);
 
 
 
@@ -3353,6 +3564,104 @@ namespace Ogre {
  		*/
 		virtual bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+		/** Sets whether the scene graph is updated through a TransformHierarchy.
+		@remarks
+			When enabled, _updateSceneGraph keeps the scene nodes sorted by depth
+			and updates their derived transforms one hierarchy level at a time
+			using SIMD code, instead of walking the graph recursively. This is
+			much faster for large scenes, but SceneNode subclasses overriding
+			_update are bypassed, so scene managers relying on that should not
+			enable it. Disabled by default.
+		*/
+		virtual void setTransformHierarchyEnabled(bool enabled);
+
+		/** Gets whether the scene graph is updated through a TransformHierarchy. */
+		virtual bool isTransformHierarchyEnabled(void) const { return mTransformHierarchy != 0; }
+
+		/** Sets whether the scene graph is updated using the WorkQueue worker threads.
+		@remarks
+			When enabled, _updateSceneGraph updates the root node on the calling
+			thread, then splits its child subtrees into tasks executed by the
+			threads of Root::getWorkQueue, and waits for all of them to complete
+			before returning; the calling thread takes part in the work. The
+			number of threads used is set with DefaultWorkQueue::setWorkerThreadCount.
+		@par
+			Node and MovableObject listeners may then be called from several
+			threads at once, and SceneNode subclasses must only modify state
+			shared between nodes in a thread-safe way. This has no effect while
+			a TransformHierarchy is in use (see setTransformHierarchyEnabled).
+			Disabled by default.
+		*/
+		virtual void setParallelSceneGraphUpdateEnabled(bool enabled);
+
+		/** Gets whether the scene graph is updated using the WorkQueue worker threads. */
+		virtual bool isParallelSceneGraphUpdateEnabled(void) const { return mSceneGraphTaskGroup != 0; }
+
+		/** Sets whether visibility culling uses the WorkQueue worker threads.
+		@remarks
+			When enabled, _findVisibleObjects tests the bounds of the scene nodes
+			against the camera from several threads, then queues the objects of
+			the visible nodes on the calling thread in a deterministic order. The
+			number of threads used is set with DefaultWorkQueue::setWorkerThreadCount.
+			Scene managers overriding _findVisibleObjects may or may not
+			support this option. Disabled by default.
+		*/
+		virtual void setParallelCullingEnabled(bool enabled);
+
+		/** Gets whether visibility culling uses the WorkQueue worker threads. */
+		virtual bool isParallelCullingEnabled(void) const { return mCullingTaskGroup != 0; }
+
+		/** Sets whether skeletal animation is evaluated using the WorkQueue worker threads.
+		@remarks
+			When enabled, each frame after the scene graph update and before
+			visibility culling, the animation states and bone matrices of the
+			skeletally animated entities are evaluated in a single batch spread
+			over the threads of Root::getWorkQueue, rather than one entity at a
+			time as each is rendered. Entities are included in the batch if they
+			were rendered in the previous frame and their animation has changed
+			since; others are updated when rendered as before.
+		@par
+			Custom Bone and TagPoint subclasses and node listeners on bones may
+			then be called from several threads at once. Disabled by default.
+		*/
+		virtual void setParallelAnimationEnabled(bool enabled);
+
+		/** Gets whether skeletal animation is evaluated using the WorkQueue worker threads. */
+		virtual bool isParallelAnimationEnabled(void) const { return mAnimationTaskGroup != 0; }
+
+		/** Gets the statistics of the last frame completed by this SceneManager.
+		@remarks
+			A frame is completed when this SceneManager renders a scene for the
+			first time in the next frame, so during a frame this returns the
+			statistics of the previous one.
+		*/
+		virtual const FrameStatistics& getLastFrameStatistics(void) const { return mLastFrameStatistics; }
+
+		/** Sets whether the times spent in the stages of rendering are measured
+			in the frame statistics.
+		@remarks
+			Measuring the GPU program parameter updates queries the timer for
+			each renderable, which is why this is disabled by default.
+		@see FrameStatistics
+		*/
+		virtual void setFrameTimingEnabled(bool enabled) { mFrameTimingEnabled = enabled; }
+
+		/** Gets whether the times spent in the stages of rendering are measured. */
+		virtual bool isFrameTimingEnabled(void) const { return mFrameTimingEnabled; }
+
+		/** Sets a file to write the statistics of every completed frame to.
+		@remarks
+			The file is overwritten and receives a header line, followed by one
+			line of comma separated values per frame, so that the results of
+			several runs can be compared in a spreadsheet. Pass an empty
+			string to stop writing. The frame in progress is written when
+			the file is closed, including when the SceneManager is destroyed.
+		*/
+		virtual void setFrameStatisticsLogFile(const String& filename);
+
+		/** Gets the file the statistics of every completed frame are written to. */
+		virtual const String& getFrameStatisticsLogFile(void) const { return mFrameStatisticsLogName; }
+
 		/** Set whether to automatically normalise normals on objects whenever they
 			are scaled.
 		@remarks
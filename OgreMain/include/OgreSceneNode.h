@@ -57,6 +57,7 @@ namespace Ogre {
     */
     class _OgreExport SceneNode : public Node
     {
+        friend class TransformHierarchy;
     public:
         typedef HashMap<String, MovableObject*> ObjectMap;
         typedef MapIterator<ObjectMap> ObjectIterator;
@@ -80,6 +81,9 @@ namespace Ogre {
         /** @copydoc Node::updateFromParentImpl. */
         void updateFromParentImpl(void) const;
 
+        /** Tells the attached objects that the derived transform of this node changed. */
+        void notifyObjectsMoved(void) const;
+
         /** See Node. */
         Node* createChildImpl(void);
 
@@ -210,6 +214,45 @@ namespace Ogre {
 			VisibleObjectsBoundsInfo* visibleBounds, 
             bool includeChildren = true, bool displayNodes = false, bool onlyShadowCasters = false);
 
+        /** Internal method which lists the visible nodes of this subtree.
+            @remarks
+                This performs the same culling as _findVisibleObjects, appending the nodes whose
+                world bounds are visible from the camera in the order _findVisibleObjects visits
+                them, but does not queue anything nor modify any node, object or the camera.
+                Separate subtrees can therefore be culled from several threads at once. The
+                contents of the visible nodes are then queued with _addObjectsToRenderQueue.
+            @par
+                The children of each visible node are tested against the planes together, using
+                CullingPlanes::isVisible for lists of boxes.
+            @param
+                planes The culling planes of the active camera, see Frustum::getCullingPlanes
+            @param
+                visibleNodes List the visible nodes are appended to
+            @param
+                boundsVisible Whether the bounds of this node are already known to be
+                visible, as they are when the node's parent calls this for its children
+        */
+        virtual void _findVisibleNodes(const CullingPlanes& planes, vector<SceneNode*>::type& visibleNodes,
+            bool boundsVisible = false);
+
+        /** Internal method which adds the objects attached to this node alone to the passed in queue.
+            @remarks
+                This does what _findVisibleObjects does for a node once it has been found visible,
+                without testing its bounds nor cascading to its children.
+            @param
+                cam The active camera
+            @param
+                queue The SceneManager's rendering queue
+			@param
+				visibleBounds bounding information created on the fly containing all visible objects by the camera
+            @param
+                displayNodes If true, the node itself is rendered as a set of 3 axes as well
+                    as the objects being rendered. For debugging purposes.
+        */
+		virtual void _addObjectsToRenderQueue(Camera* cam, RenderQueue* queue, 
+			VisibleObjectsBoundsInfo* visibleBounds, 
+            bool displayNodes = false, bool onlyShadowCasters = false);
+
         /** Gets the axis-aligned bounding box of this node (and hence all subnodes).
         @remarks
             Recommended only if you are extending a SceneManager, because the bounding box returned
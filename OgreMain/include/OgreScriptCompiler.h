@@ -400,6 +400,24 @@ namespace Ogre
 
 		// A pointer to the specific compiler instance used
 		OGRE_THREAD_POINTER(ScriptCompiler, mScriptCompiler);
+
+		// Scripts tokenised and parsed by preParseScript, waiting for parseScript;
+		// the streams are kept so that their addresses can't be reused
+		typedef std::pair<DataStreamPtr, ConcreteNodeListPtr> ParsedScript;
+		typedef map<const DataStream*, ParsedScript>::type ParsedScriptMap;
+		ParsedScriptMap mParsedScripts;
+		OGRE_MUTEX(mParsedScriptsMutex)
+
+		// Directory where tokenised and parsed scripts are cached, empty if none
+		String mScriptCacheLocation;
+		OGRE_MUTEX(mScriptCacheMutex)
+
+		/// Tokenises and parses a script, through the cache if there is one
+		ConcreteNodeListPtr parseScriptText(const String& text, const String& source);
+		/// Loads the nodes of a script from the cache, null if they aren't there
+		ConcreteNodeListPtr loadCachedScript(const String& location, const String& text, const String& source);
+		/// Saves the nodes of a script to the cache
+		void saveCachedScript(const String& location, const String& text, const ConcreteNodeListPtr& nodes);
 	public:
 		ScriptCompilerManager();
 		virtual ~ScriptCompilerManager();
@@ -424,9 +442,24 @@ namespace Ogre
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName);
+        /// @copydoc ScriptLoader::preParseScript
+        void preParseScript(DataStreamPtr& stream, const String& groupName);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
+		/** Sets a directory where scripts are cached once tokenised and parsed.
+		@remarks
+			Each script is stored in a binary file named after a hash of its
+			text, so a script which hasn't changed since it was cached is read
+			back from there instead of being tokenised and parsed again. The
+			directory must exist and be writable; files for scripts which have
+			changed are left behind, so it can be emptied at any time. An empty
+			path, the default, disables the cache.
+		*/
+		void setScriptCacheLocation(const String& path);
+		/// Gets the directory where scripts are cached, empty if there is no cache
+		String getScriptCacheLocation(void);
+
 		/** Override standard Singleton retrieval.
         @remarks
         Why do we do this? Well, it's because the Singleton
@@ -77,6 +77,19 @@ namespace Ogre {
 		*/
 		virtual void parseScript(DataStreamPtr& stream, const String& groupName) = 0;
 
+		/** Does the part of parsing a script file which doesn't depend on
+			other scripts, ahead of parseScript.
+		@remarks
+			When parallel loading is enabled, ResourceGroupManager calls this
+			for several files at once on different threads, then calls
+			parseScript with the same streams on the initialising thread in the
+			usual order. Implementations must be thread safe, and parseScript
+			must still work if this failed. The default does nothing.
+		@param stream Weak reference to a data stream which is the source of the script
+		@param groupName The name of the resource group the script belongs to
+		*/
+		virtual void preParseScript(DataStreamPtr& stream, const String& groupName) {}
+
 		/** Gets the relative loading order of scripts of this type.
 		@remarks
 			There are dependencies between some kinds of scripts, and to enforce
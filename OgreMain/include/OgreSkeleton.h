@@ -295,6 +295,21 @@ namespace Ogre {
         /// Updates all the derived transforms in the skeleton
         virtual void _updateTransforms(void);
 
+		/** Sets whether the bones are updated through a BoneHierarchy.
+		@remarks
+			When enabled, _updateTransforms and _getBoneMatrices process the
+			bones one hierarchy level at a time on structure-of-arrays copies
+			of their transforms, using SIMD where available, instead of
+			walking them recursively. The bones keep their derived
+			transforms, so the Bone and TagPoint APIs are not affected.
+			Skeleton instances created from this skeleton afterwards use the
+			same setting. Disabled by default.
+		*/
+		virtual void setBoneHierarchyEnabled(bool enabled);
+
+		/** Gets whether the bones are updated through a BoneHierarchy. */
+		virtual bool isBoneHierarchyEnabled(void) const { return mBoneHierarchy != 0; }
+
 		/** Optimise all of this skeleton's animations.
 		@see Animation::optimise
         @param
@@ -302,6 +317,90 @@ namespace Ogre {
 		*/
 		virtual void optimiseAllAnimations(bool preservingIdentityNodeTracks = false);
 
+		/** Compress the node tracks of all of this skeleton's animations.
+		@remarks
+			Best called after optimiseAllAnimations, the compressed tracks are
+			saved as such by the SkeletonSerializer.
+		@see NodeAnimationTrack::compress
+		*/
+		virtual void compressAllAnimations(Real translateTolerance = 1e-3f,
+			const Radian& rotateTolerance = Radian(1e-3f), Real scaleTolerance = 1e-3f);
+
+		/// List of bone handles
+		typedef vector<unsigned short>::type BoneHandleList;
+
+		/** A level of animation detail, which reduces the cost of animating
+			entities which are far away or small on screen.
+		*/
+		struct AnimationLodUsage
+		{
+			/// Value at which this level comes into effect, as given by the user
+			Real userValue;
+			/// User value transformed by the LodStrategy of the skeleton
+			Real value;
+			/// Number of frames between evaluations of the animations, 1 evaluates every frame
+			unsigned short updateInterval;
+			/// Weight of each bone handle, 0 for bones which are not animated; empty to animate all bones
+			AnimationState::BoneBlendMask boneMask;
+		};
+		typedef vector<AnimationLodUsage>::type AnimationLodUsageList;
+
+		/** Adds a level of animation detail.
+		@remarks
+			Entities using this skeleton pick their level of animation detail
+			with the LodStrategy of the skeleton, as they do for their mesh.
+			At lower levels the animations are evaluated every few frames, the
+			bone matrices of the frames in between are interpolated from the
+			last two evaluations, so the entity lags behind its animation
+			state by up to one interval. Objects attached to bones follow the
+			evaluated poses. Level 0 is always present and evaluates all bones
+			every frame.
+		@par
+			Levels must be added from highest to lowest detail. Entities which
+			share their skeleton instance always use level 0.
+		@param lodValue
+			Value at which the level comes into effect, such as the distance
+			for the default strategy.
+		@param updateInterval
+			Number of frames between evaluations of the animations.
+		@param animatedBones
+			Handles of the bones to animate at this level, the others are left
+			in their initial state; such as fingers, whose motion is not visible
+			from far away. Null to animate all bones.
+		*/
+		virtual void addAnimationLodLevel(Real lodValue, unsigned short updateInterval,
+			const BoneHandleList* animatedBones = 0);
+
+		/** Removes all levels of animation detail but level 0. */
+		virtual void removeAllAnimationLodLevels(void);
+
+		/** Gets the number of levels of animation detail, including level 0. */
+		virtual unsigned short getNumAnimationLodLevels(void) const;
+
+		/** Gets a level of animation detail. */
+		virtual const AnimationLodUsage& getAnimationLodLevel(unsigned short index) const;
+
+		/** Gets the index of the level of animation detail which applies to a value
+			calculated by the LodStrategy of this skeleton.
+		*/
+		virtual unsigned short getAnimationLodIndex(Real value) const;
+
+		/** Sets the LodStrategy used to pick the level of animation detail.
+		@remarks
+			Defaults to the default strategy of the LodStrategyManager.
+		*/
+		virtual void setAnimationLodStrategy(const LodStrategy* strategy);
+
+		/** Gets the LodStrategy used to pick the level of animation detail. */
+		virtual const LodStrategy* getAnimationLodStrategy(void) const;
+
+		/** Changes the state of the skeleton to reflect the application of the
+			passed in collection of animations, at a level of animation detail.
+		@see Skeleton::setAnimationState
+		*/
+		virtual void _setAnimationState(const AnimationStateSet& animSet,
+			unsigned short animationLodIndex);
+
 		/** Allows you to use the animations from another Skeleton object to animate
 			this skeleton.
 		@remarks
@@ -430,6 +529,16 @@ namespace Ogre {
 		BoneSet mManualBones;
 		/// Manual bones dirty?
 		bool mManualBonesDirty;
+		/// Data-oriented bone update, if enabled
+		BoneHierarchy* mBoneHierarchy;
+		/// Levels of animation detail, starting with full detail
+		mutable AnimationLodUsageList mAnimationLodUsageList;
+		/// Values of the levels of animation detail, for LodStrategy::getIndex
+		mutable vector<Real>::type mAnimationLodValues;
+		/// Strategy picking the level of animation detail, 0 for the default one
+		mutable const LodStrategy* mAnimationLodStrategy;
+		/// Blend mask combining those of an animation state and of a level of animation detail
+		AnimationState::BoneBlendMask mAnimationLodBlendMask;
 
 
         /// Storage of animations, lookup by name
@@ -101,6 +101,25 @@ namespace Ogre {
                     // Quaternion rotate            : Rotation to apply at this keyframe
                     // Vector3 translate            : Translation to apply at this keyframe
                     // Vector3 scale                : Scale to apply at this keyframe
+
+                SKELETON_ANIMATION_TRACK_COMPRESSED = 0x4120,
+                // [v1.90+] Keys of a compressed track, in place of the keyframes
+                // (see CompressedTransformKeys)
+
+                    // unsigned short numKeys        : Number of keys
+                    // float times[numKeys]          : The time positions (seconds)
+                    // float translateTolerance      : Tolerances the keys were compressed with
+                    // float rotateTolerance         : (radians)
+                    // float scaleTolerance
+                    // unsigned short animated       : Bit 0 rotation, 1 translation, 2 scale vary per key
+                    // Quaternion rotation           : Constant rotation, if not animated
+                    // unsigned short rotations[numKeys * 3] : 'Smallest three' rotations, if animated
+                    // Vector3 translateBase         : Lowest translation, or constant translation
+                    // Vector3 translateExtent       : Range of translations
+                    // unsigned short translates[numKeys * 3] : Quantised translations, if animated
+                    // Vector3 scaleBase             : Lowest scale, or constant scale
+                    // Vector3 scaleExtent           : Range of scales
+                    // unsigned short scales[numKeys * 3] : Quantised scales, if animated
 		SKELETON_ANIMATION_LINK         = 0x5000
 		// Link to another skeleton, to re-use its animations
 
@@ -110,6 +110,22 @@ namespace Ogre {
 		/// @copydoc Skeleton::_refreshAnimationState
 		void _refreshAnimationState(AnimationStateSet* animSet);
 
+		/// @copydoc Skeleton::addAnimationLodLevel
+		void addAnimationLodLevel(Real lodValue, unsigned short updateInterval,
+			const BoneHandleList* animatedBones = 0);
+		/// @copydoc Skeleton::removeAllAnimationLodLevels
+		void removeAllAnimationLodLevels(void);
+		/// @copydoc Skeleton::getNumAnimationLodLevels
+		unsigned short getNumAnimationLodLevels(void) const;
+		/// @copydoc Skeleton::getAnimationLodLevel
+		const AnimationLodUsage& getAnimationLodLevel(unsigned short index) const;
+		/// @copydoc Skeleton::getAnimationLodIndex
+		unsigned short getAnimationLodIndex(Real value) const;
+		/// @copydoc Skeleton::setAnimationLodStrategy
+		void setAnimationLodStrategy(const LodStrategy* strategy);
+		/// @copydoc Skeleton::getAnimationLodStrategy
+		const LodStrategy* getAnimationLodStrategy(void) const;
+
 		/// @copydoc Resource::getName
 		const String& getName(void) const;
 		/// @copydoc Resource::getHandle
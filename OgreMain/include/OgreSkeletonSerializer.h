@@ -42,6 +42,8 @@ namespace Ogre {
 		SKELETON_VERSION_1_0,
 		/// OGRE version v1.8+
 		SKELETON_VERSION_1_8,
+		/// OGRE version v1.9+, compressed tracks
+		SKELETON_VERSION_1_9,
 		
 		/// Latest version available
 		SKELETON_VERSION_LATEST = 100
@@ -114,8 +116,12 @@ namespace Ogre {
         void writeBone(const Skeleton* pSkel, const Bone* pBone);
         void writeBoneParent(const Skeleton* pSkel, unsigned short boneId, unsigned short parentId);
 		void writeAnimation(const Skeleton* pSkel, const Animation* anim, SkeletonVersion ver);
-        void writeAnimationTrack(const Skeleton* pSkel, const NodeAnimationTrack* track);
+        void writeAnimationTrack(const Skeleton* pSkel, const NodeAnimationTrack* track,
+            SkeletonVersion ver);
         void writeKeyFrame(const Skeleton* pSkel, const TransformKeyFrame* key);
+        void writeKeyFrame(const Skeleton* pSkel, Real time, const Quaternion& rotate,
+            const Vector3& translate, const Vector3& scale);
+        void writeCompressedKeys(const Skeleton* pSkel, const CompressedTransformKeys* keys);
 		void writeSkeletonAnimationLink(const Skeleton* pSkel, 
 			const LinkedSkeletonAnimationSource& link);
 
@@ -126,14 +132,19 @@ namespace Ogre {
         void readAnimation(DataStreamPtr& stream, Skeleton* pSkel);
         void readAnimationTrack(DataStreamPtr& stream, Animation* anim, Skeleton* pSkel);
         void readKeyFrame(DataStreamPtr& stream, NodeAnimationTrack* track, Skeleton* pSkel);
+        void readCompressedKeys(DataStreamPtr& stream, NodeAnimationTrack* track, Skeleton* pSkel);
 		void readSkeletonAnimationLink(DataStreamPtr& stream, Skeleton* pSkel);
 
         size_t calcBoneSize(const Skeleton* pSkel, const Bone* pBone);
         size_t calcBoneSizeWithoutScale(const Skeleton* pSkel, const Bone* pBone);
         size_t calcBoneParentSize(const Skeleton* pSkel);
-        size_t calcAnimationSize(const Skeleton* pSkel, const Animation* pAnim);
-        size_t calcAnimationTrackSize(const Skeleton* pSkel, const NodeAnimationTrack* pTrack);
+        size_t calcAnimationSize(const Skeleton* pSkel, const Animation* pAnim,
+            SkeletonVersion ver);
+        size_t calcAnimationTrackSize(const Skeleton* pSkel, const NodeAnimationTrack* pTrack,
+            SkeletonVersion ver);
         size_t calcKeyFrameSize(const Skeleton* pSkel, const TransformKeyFrame* pKey);
+        size_t calcKeyFrameSize(const Skeleton* pSkel, const Vector3& scale);
+        size_t calcCompressedKeysSize(const Skeleton* pSkel, const CompressedTransformKeys* keys);
         size_t calcKeyFrameSizeWithoutScale(const Skeleton* pSkel, const TransformKeyFrame* pKey);
 		size_t calcSkeletonAnimationLinkSize(const Skeleton* pSkel, 
 			const LinkedSkeletonAnimationSource& link);
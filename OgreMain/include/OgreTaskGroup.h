@@ -0,0 +1,126 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TaskGroup_H__
+#define __TaskGroup_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreWorkQueue.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup General
+	*  @{
+	*/
+	/** Runs a list of independent tasks across the WorkQueue worker threads
+		and waits for all of them to complete.
+	@remarks
+		WorkQueue requests are normally fire-and-forget: their responses are
+		only delivered on the next call to WorkQueue::processResponses. This
+		class instead is meant for work which has to be finished before the
+		calling thread can carry on, such as splitting a per-frame update into
+		several parts. The calling thread takes tasks from the list too, so
+		run() always makes progress even when every worker thread is busy with
+		other requests, or when there are no worker threads at all.
+	@par
+		A TaskGroup registers itself as the request handler of its channel on
+		the WorkQueue which is current when it is created. It must be destroyed
+		before that WorkQueue.
+	*/
+	class _OgreExport TaskGroup : public WorkQueue::RequestHandler, public UtilityAlloc
+	{
+	public:
+		/** A unit of work executed by a TaskGroup. */
+		class _OgreExport Task
+		{
+		public:
+			virtual ~Task() {}
+			/** Performs the work of the task; this may be called on any thread. */
+			virtual void execute(void) = 0;
+		};
+		typedef vector<Task*>::type TaskList;
+
+		/** Constructor.
+		@param channelName Name of the WorkQueue channel the tasks are sent on
+		*/
+		TaskGroup(const String& channelName);
+		virtual ~TaskGroup();
+
+		/** Executes a list of tasks and returns once they have all completed.
+		@remarks
+			The tasks may run in any order and concurrently with each other,
+			so they must not depend on each other's results. This method is
+			not reentrant: a task may not call run() on the same group.
+		*/
+		void run(const TaskList& tasks);
+
+		/** Gets the number of threads which may execute tasks concurrently,
+			including the thread calling run().
+		*/
+		size_t getConcurrency(void) const;
+
+		/// Accepts aborted helper requests too, so that they are accounted for
+		bool canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
+		/** Executes tasks of the current run on a worker thread.
+		@remarks
+			Completion is signalled through the count of completed tasks, so
+			no response is returned and nothing is allocated per task.
+		*/
+		WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
+
+	protected:
+		/// Executes tasks from the current list until none is left to start
+		void executePendingTasks(void);
+
+		/// The WorkQueue the helper requests are sent to
+		WorkQueue* mWorkQueue;
+		/// Channel of the helper requests
+		uint16 mChannel;
+		/// The list being run, or null outside of run()
+		const TaskList* mTasks;
+		/// Index of the next task of mTasks to start
+		size_t mNextTask;
+		/// Number of tasks of mTasks which have completed
+		size_t mCompletedTasks;
+		/// Number of helper requests queued or being processed
+		size_t mPendingHelpers;
+
+		OGRE_MUTEX(mTaskMutex)
+		OGRE_THREAD_SYNCHRONISER(mTaskSync)
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
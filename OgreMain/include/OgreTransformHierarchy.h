@@ -0,0 +1,140 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TransformHierarchy_H__
+#define __TransformHierarchy_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+	/** \addtogroup Core
+	*  @{
+	*/
+	/** \addtogroup Scene
+	*  @{
+	*/
+	/** Data-oriented storage used to update the transforms of a scene graph.
+	@remarks
+		The regular update path (Node::_update) walks the graph recursively and
+		combines the transforms of each node with scalar maths. This class
+		instead keeps the nodes of a SceneNode tree sorted by depth, so that a
+		whole hierarchy level can be processed at once: the local and parent
+		transforms of every node needing an update in a level are gathered in
+		structure-of-arrays blocks, combined with
+		OptimisedUtil::concatenateNodeTransforms (which uses SIMD where
+		available), and written back to the nodes. Bounds are then updated
+		bottom-up. The nodes keep their derived transforms, so the whole
+		Node / SceneNode API works as usual on top of it.
+	@par
+		The depth-sorted layout is rebuilt whenever a node of the application
+		is attached or detached (see Node::_getHierarchyRevision), so this is
+		best suited to scenes whose structure changes rarely compared to how
+		often their nodes move.
+	@note
+		SceneNode subclasses which override _update are not called through
+		that method by this class, only _updateBounds is; scene managers
+		which rely on such overrides should keep using the regular path.
+	*/
+	class _OgreExport TransformHierarchy : public NodeAlloc
+	{
+	public:
+		TransformHierarchy();
+		~TransformHierarchy();
+
+		/** Updates the derived transforms and world bounds of a tree.
+		@remarks
+			This is equivalent to calling root->_update(true, false), only
+			processing one hierarchy level at a time.
+		@param root The root of the tree to update
+		*/
+		void _update(SceneNode* root);
+
+		/** Gets the number of nodes in the current depth-sorted layout. */
+		size_t getNumNodes(void) const { return mNodes.size(); }
+		/** Gets the number of hierarchy levels in the current depth-sorted layout. */
+		size_t getNumLevels(void) const { return mLevelStarts.empty() ? 0 : mLevelStarts.size() - 1; }
+
+	protected:
+		typedef vector<SceneNode*>::type NodeList;
+		typedef vector<size_t>::type IndexList;
+		typedef vector<uint8>::type FlagList;
+
+		/// Value of mParentSlots for nodes whose parent is not in the layout
+		static const size_t NO_PARENT;
+
+		/// Root of the tree the layout was built from
+		SceneNode* mRoot;
+		/// Node::_getHierarchyRevision at the time the layout was built
+		unsigned long mRevision;
+
+		/// All nodes of the tree, sorted by depth
+		NodeList mNodes;
+		/// Index in mNodes of the parent of each node
+		IndexList mParentSlots;
+		/// First index in mNodes of each level, plus one past the last node
+		IndexList mLevelStarts;
+		/// Whether the derived transform of each node changed this update
+		FlagList mChanged;
+		/// Whether each node has to be visited when updating the bounds
+		FlagList mVisited;
+
+		/// Index in mNodes of each node of the block being processed
+		IndexList mBlockSlots;
+		/// Number of nodes the block buffers can hold
+		size_t mBlockCapacity;
+		/// SIMD aligned storage backing all block streams
+		void* mBlockBuffer;
+		/// Derived transforms of the parents of the nodes in the block
+		TransformStreams mParentTransforms;
+		/// Local transforms of the nodes in the block
+		TransformStreams mLocalTransforms;
+		/// Derived transforms calculated for the nodes in the block
+		TransformStreams mDerivedTransforms;
+		/// Inheritance masks of the nodes in the block
+		uint32* mInheritOrientation;
+		uint32* mInheritScale;
+
+		/// Rebuild the depth-sorted layout from the given root
+		void buildLayout(SceneNode* root);
+		/// Make sure the block buffers can hold the given number of nodes
+		void reserveBlock(size_t numNodes);
+		/// Gather the transforms of the given node at the given block index
+		void gatherNode(size_t index, const SceneNode* node, size_t parentSlot);
+		/// Write back the transforms calculated for the given block index
+		void scatterNode(size_t index, SceneNode* node);
+	};
+	/** @} */
+	/** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -96,10 +96,12 @@ namespace Ogre
 			RequestID mID;
 			/// Abort Flag
 			mutable bool mAborted;
+			/// Priority, requests with a higher value are processed first
+			uint8 mPriority;
 
 		public:
 			/// Constructor 
-			Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid);
+			Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid, uint8 priority = 0);
 			~Request();
 			/// Set the abort flag
 			void abortRequest() const { mAborted = true; }
@@ -115,6 +117,8 @@ namespace Ogre
 			RequestID getID() const { return mID; }
 			/// Get the abort flag
 			bool getAborted() const { return mAborted; }
+			/// Get the priority of this request, higher values are processed first
+			uint8 getPriority() const { return mPriority; }
 		};
 
 		/** General purpose response structure. 
@@ -181,7 +185,9 @@ namespace Ogre
 			Response regardless of success or failure.
 			@param srcQ The work queue that this request originated from
 			@return Pointer to a Response object - the caller is responsible
-			for deleting the object.
+			for deleting the object. Handlers which report their results some
+			other way may return null, in which case the request is deleted
+			without any response.
 			*/
 			virtual Response* handleRequest(const Request* req, const WorkQueue* srcQ) = 0;
 		};
@@ -360,6 +366,16 @@ namespace Ogre
 	class _OgreExport DefaultWorkQueueBase : public WorkQueue
 	{
 	public:
+		/// How requests waiting to be processed are shared among the worker threads
+		enum RequestScheduling
+		{
+			/// All workers take requests from a single queue
+			RS_SHARED_QUEUE,
+			/** Each worker has a queue of its own, and idle workers steal
+				requests from the queues of the others
+			*/
+			RS_WORK_STEALING
+		};
 
 		/** Constructor.
 			Call startup() to initialise.
@@ -406,6 +422,51 @@ namespace Ogre
 		*/
 		virtual void setWorkersCanAccessRenderSystem(bool access);
 
+		/** Get how requests are shared among the worker threads. 
+		*/
+		virtual RequestScheduling getRequestScheduling() const;
+
+		/** Set how requests are shared among the worker threads. 
+		@remarks
+			With a single shared queue every worker locks the same queue to
+			take a request, which gets contended when many subsystems post
+			small requests. With work stealing requests are spread over one
+			queue per worker, so workers mostly lock their own queue. Requests
+			are taken in order of priority either way, but with work stealing
+			the order is only kept within each worker's queue.
+		@par
+			The default is RS_SHARED_QUEUE unless OGRE_WORK_QUEUE_STEALING is
+			set. Work stealing is only supported by the standard
+			implementation of DefaultWorkQueue; others ignore this setting.
+			Calling this will have no effect unless the queue is shut down and
+			restarted.
+		*/
+		virtual void setRequestScheduling(RequestScheduling scheduling);
+
+		/** Set the priority of the requests added to a channel from now on.
+		@remarks
+			Requests with a higher priority are taken before any request with
+			a lower one which is still waiting. Requests of the same priority
+			are processed in the order they were added. The default is 0.
+		*/
+		virtual void setChannelPriority(uint16 channel, uint8 priority);
+
+		/// Get the priority of the requests added to a channel
+		virtual uint8 getChannelPriority(uint16 channel) const;
+
+		/** Bind the requests added to a channel from now on to one worker thread.
+		@remarks
+			Bound requests are never stolen by other workers, which keeps the data
+			of a channel in the caches of one thread, and lets requests of the
+			channel be processed one at a time in the order they were added.
+			Only has an effect with RS_WORK_STEALING; the worker index is taken
+			modulo the number of worker threads.
+		*/
+		virtual void setChannelAffinity(uint16 channel, size_t workerIndex);
+
+		/// Let any worker thread process the requests of a channel again
+		virtual void clearChannelAffinity(uint16 channel);
+
 		/** Process the next request on the queue. 
 		@remarks
 			This method is public, but only intended for advanced users to call. 
@@ -468,6 +529,45 @@ namespace Ogre
 		RequestQueue mProcessQueue; // Guarded by mProcessMutex
 		ResponseQueue mResponseQueue; // Guarded by mResponseMutex
 
+		/// Requests of one worker thread when work stealing
+		struct WorkerRequests : public UtilityAlloc
+		{
+			OGRE_MUTEX(mMutex)
+			/// Requests waiting, which any worker may take
+			RequestQueue mQueue;
+			/// Requests waiting of channels bound to this worker
+			RequestQueue mBoundQueue;
+			/// Requests taken from this worker's queues being processed
+			RequestQueue mProcessQueue;
+
+			/// Abort the request with the given ID, returns whether it was found
+			bool abortRequest(RequestID id);
+			/// Abort the requests of a channel
+			void abortRequestsByChannel(uint16 channel, bool includeProcessing);
+			/// Abort all requests
+			void abortAllRequests();
+		};
+		typedef vector<WorkerRequests*>::type WorkerRequestsList;
+		/// Queues of each worker thread, empty unless work stealing
+		WorkerRequestsList mWorkerRequests;
+		/// Number of requests which can be stolen over all workers
+		AtomicScalar<size_t> mNumStealableRequests;
+		/// Number of worker threads which have registered themselves
+		AtomicScalar<size_t> mNumRegisteredWorkers;
+
+		/// Index of the worker a thread is
+		struct WorkerHandle : public UtilityAlloc
+		{
+			size_t index;
+		};
+		OGRE_THREAD_POINTER(WorkerHandle, mWorkerHandle);
+
+		RequestScheduling mRequestScheduling;
+		typedef map<uint16, uint8>::type ChannelPriorityMap;
+		typedef map<uint16, size_t>::type ChannelAffinityMap;
+		ChannelPriorityMap mChannelPriorities; // Guarded by mRequestMutex
+		ChannelAffinityMap mChannelAffinities; // Guarded by mRequestMutex
+
 		/// Thread function
 		struct WorkerFunc OGRE_THREAD_WORKER_INHERIT
 		{
@@ -509,9 +609,11 @@ namespace Ogre
 			RequestHandler* getHandler() { return mHandler; }
 
 			/** Process a request if possible.
-			@return Valid response if processed, null otherwise
+			@param handled Set to true if the handler processed the request
+			@return The response of the handler, null if it did not process
+				the request or had no response
 			*/
-			Response* handleRequest(const Request* req, const WorkQueue* srcQ)
+			Response* handleRequest(const Request* req, const WorkQueue* srcQ, bool& handled)
 			{
 				// Read mutex so that multiple requests can be processed by the
 				// same handler in parallel if required
@@ -522,6 +624,7 @@ namespace Ogre
 					if (mHandler->canHandleRequest(req, srcQ))
 					{
 						response = mHandler->handleRequest(req, srcQ);
+						handled = true;
 					}
 				}
 				return response;
@@ -555,12 +658,38 @@ namespace Ogre
 
 
 		void processRequestResponse(Request* r, bool synchronous);
-		Response* processRequest(Request* r);
+		Response* processRequest(Request* r, bool& handled);
 		void processResponse(Response* r);
 		/// Notify workers about a new request. 
 		virtual void notifyWorkers() = 0;
+		/// Notify all workers about a new request, when it may only be taken by one of them.
+		virtual void notifyAllWorkers() { notifyWorkers(); }
 		/// Put a Request on the queue with a specific RequestID.
 		void addRequestWithRID(RequestID rid, uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount);
+
+		/** Set up the request queues for the current scheduling and number of
+			workers, moving any requests still waiting over to them. Must be
+			called before the worker threads are started.
+		*/
+		void setupRequestQueues();
+		/** Register the calling thread as a worker, before it takes requests.
+		@remarks
+			Workers are numbered in the order they register, and with work stealing
+			each prefers the requests in the queue with its number. Threads
+			which do not register only steal.
+		*/
+		void registerWorkerThread();
+		/// Put a request in the queue it belongs to, may be called with mRequestMutex locked
+		void queueRequest(Request* r, size_t boundWorker);
+		/** Take the next request to process off the queues, and keep note of
+			it being processed. Must be called with mProcessMutex locked when
+			not work stealing.
+		*/
+		Request* takeNextRequest();
+		/// Tell whether there are requests the calling thread could take
+		bool hasPendingRequests() const;
+		/// Get the priority and the bound worker of a new request, must be called with mRequestMutex locked
+		void getChannelScheduling(uint16 channel, uint8& priority, size_t& boundWorker) const;
 		
 		RequestQueue mIdleRequestQueue; // Guarded by mIdleMutex
 		bool mIdleThreadRunning; // Guarded by mIdleMutex
@@ -62,6 +62,7 @@ namespace Ogre
 		virtual void notifyThreadRegistered();
 
 		virtual void notifyWorkers();
+		virtual void notifyAllWorkers();
 
 		size_t mNumThreadsRegisteredWithRS;
 		/// Init notification mutex (must lock before waiting on initCondition)
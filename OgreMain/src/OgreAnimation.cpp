@@ -48,6 +48,8 @@ namespace Ogre {
         , mLength(length)
         , mInterpolationMode(msDefaultInterpolationMode)
         , mRotationInterpolationMode(msDefaultRotationInterpolationMode)
+        , mKeyFrameTimeBuckets(2, 0)
+        , mKeyFrameBucketScale(0)
         , mKeyFrameTimesDirty(false)
 		, mUseBaseKeyFrame(false)
 		, mBaseKeyFrameTime(0.0f)
@@ -69,6 +71,8 @@ namespace Ogre {
 	void Animation::setLength(Real len)
 	{
 		mLength = len;
+        // Time buckets are relative to the length
+        mKeyFrameTimesDirty = true;
 	}
     //---------------------------------------------------------------------
     NodeAnimationTrack* Animation::createNodeTrack(unsigned short handle)
@@ -380,7 +384,10 @@ namespace Ogre {
       {
         // get bone to apply to 
         Bone* b = skel->getBone(i->first);
-		i->second->applyToNode(b, timeIndex, (*blendMask)[b->getHandle()] * weight, scale);
+        // Masked out bones are left alone
+        Real boneWeight = (*blendMask)[b->getHandle()] * weight;
+        if (boneWeight != 0)
+            i->second->applyToNode(b, timeIndex, boneWeight, scale);
       }
     }
 	//---------------------------------------------------------------------
@@ -652,13 +659,44 @@ namespace Ogre {
         if( timePos > totalAnimationLength && totalAnimationLength > 0.0f )
 			timePos = fmod( timePos, totalAnimationLength );
 
-        // Search for global index
-        KeyFrameTimeList::iterator it =
-            std::lower_bound(mKeyFrameTimes.begin(), mKeyFrameTimes.end(), timePos);
+        // Search for global index, only within the keyframes of the bucket
+        // this time falls into (widened in case of rounding at the bounds)
+        size_t bucket = 0;
+        if (timePos > 0)
+        {
+            bucket = std::min(static_cast<size_t>(timePos * mKeyFrameBucketScale),
+                mKeyFrameTimeBuckets.size() - 2);
+        }
+        size_t first = mKeyFrameTimeBuckets[bucket];
+        size_t last = mKeyFrameTimeBuckets[bucket + 1];
+        while (first > 0 && mKeyFrameTimes[first - 1] >= timePos)
+            --first;
+        while (last < mKeyFrameTimes.size() && mKeyFrameTimes[last] < timePos)
+            ++last;
+
+        KeyFrameTimeList::iterator it = std::lower_bound(
+            mKeyFrameTimes.begin() + first, mKeyFrameTimes.begin() + last, timePos);
 
         return TimeIndex(timePos, std::distance(mKeyFrameTimes.begin(), it));
     }
     //-----------------------------------------------------------------------
+    void Animation::_buildCaches(void) const
+    {
+        if (mKeyFrameTimesDirty)
+        {
+            buildKeyFrameTimeList();
+        }
+
+        if (mInterpolationMode == IM_SPLINE)
+        {
+            NodeTrackList::const_iterator i;
+            for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
+            {
+                i->second->_buildInterpolationSplines();
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
     void Animation::buildKeyFrameTimeList(void) const
     {
         NodeTrackList::const_iterator i;
@@ -682,6 +720,22 @@ namespace Ogre {
             k->second->_collectKeyFrameTimes(mKeyFrameTimes);
 		}
 
+        // Split the length into as many buckets as there are keyframe times
+        // and record the first keyframe of each, so a lookup is constant time
+        // unless the keyframes are very unevenly spread
+        size_t numBuckets = std::max(mKeyFrameTimes.size(), static_cast<size_t>(1));
+        mKeyFrameTimeBuckets.resize(numBuckets + 1);
+        mKeyFrameBucketScale = mLength > 0 ? numBuckets / mLength : 0;
+        size_t t = 0;
+        for (size_t b = 0; b < numBuckets; ++b)
+        {
+            Real bucketStart = mLength * b / numBuckets;
+            while (t < mKeyFrameTimes.size() && mKeyFrameTimes[t] < bucketStart)
+                ++t;
+            mKeyFrameTimeBuckets[b] = static_cast<uint>(t);
+        }
+        mKeyFrameTimeBuckets[numBuckets] = static_cast<uint>(mKeyFrameTimes.size());
+
         // Build global index to local index map for each track
         for (i = mNodeTrackList.begin(); i != mNodeTrackList.end(); ++i)
         {
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "OgreAnimationTrack.h"
 #include "OgreAnimation.h"
 #include "OgreKeyFrame.h"
+#include "OgreCompressedTransformKeys.h"
 #include "OgreNode.h"
 #include "OgreLogManager.h"
 #include "OgreHardwareBufferManager.h"
@@ -357,6 +358,7 @@ namespace Ogre {
 		: AnimationTrack(parent, handle), mTargetNode(0)
         , mSplines(0), mSplineBuildNeeded(false)
         , mUseShortestRotationPath(true)
+        , mCompressedKeys(0)
 	{
 	}
 	//---------------------------------------------------------------------
@@ -365,12 +367,14 @@ namespace Ogre {
 		: AnimationTrack(parent, handle), mTargetNode(targetNode)
         , mSplines(0), mSplineBuildNeeded(false)
         , mUseShortestRotationPath(true)
+        , mCompressedKeys(0)
 	{
 	}
     //---------------------------------------------------------------------
     NodeAnimationTrack::~NodeAnimationTrack()
     {
         OGRE_DELETE_T(mSplines, Splines, MEMCATEGORY_ANIMATION);
+        OGRE_DELETE mCompressedKeys;
     }
 	//---------------------------------------------------------------------
     void NodeAnimationTrack::getInterpolatedKeyFrame(const TimeIndex& timeIndex, KeyFrame* kf) const
@@ -383,21 +387,53 @@ namespace Ogre {
 
 		TransformKeyFrame* kret = static_cast<TransformKeyFrame*>(kf);
 
-        // Keyframe pointers
-		KeyFrame *kBase1, *kBase2;
-        TransformKeyFrame *k1, *k2;
+        // Key values, in the keyframes or decoded from the compressed keys
+        const Quaternion *rotate1, *rotate2;
+        const Vector3 *translate1, *translate2, *scale1, *scale2;
+        Quaternion decodedRotate[2];
+        Vector3 decodedTranslate[2], decodedScale[2];
         unsigned short firstKeyIndex;
+        Real t;
 
-        Real t = this->getKeyFramesAtTime(timeIndex, &kBase1, &kBase2, &firstKeyIndex);
-		k1 = static_cast<TransformKeyFrame*>(kBase1);
-		k2 = static_cast<TransformKeyFrame*>(kBase2);
+        if (mCompressedKeys)
+        {
+            unsigned short secondKeyIndex;
+            t = getCompressedKeysAtTime(timeIndex, &firstKeyIndex, &secondKeyIndex);
+            mCompressedKeys->getKey(firstKeyIndex,
+                decodedRotate[0], decodedTranslate[0], decodedScale[0]);
+            if (t != 0.0)
+            {
+                mCompressedKeys->getKey(secondKeyIndex,
+                    decodedRotate[1], decodedTranslate[1], decodedScale[1]);
+            }
+            rotate1 = &decodedRotate[0];
+            rotate2 = &decodedRotate[1];
+            translate1 = &decodedTranslate[0];
+            translate2 = &decodedTranslate[1];
+            scale1 = &decodedScale[0];
+            scale2 = &decodedScale[1];
+        }
+        else
+        {
+            // Keyframe pointers
+            KeyFrame *kBase1, *kBase2;
+            t = this->getKeyFramesAtTime(timeIndex, &kBase1, &kBase2, &firstKeyIndex);
+            const TransformKeyFrame* k1 = static_cast<TransformKeyFrame*>(kBase1);
+            const TransformKeyFrame* k2 = static_cast<TransformKeyFrame*>(kBase2);
+            rotate1 = &k1->getRotation();
+            rotate2 = &k2->getRotation();
+            translate1 = &k1->getTranslate();
+            translate2 = &k2->getTranslate();
+            scale1 = &k1->getScale();
+            scale2 = &k2->getScale();
+        }
 
         if (t == 0.0)
         {
             // Just use k1
-            kret->setRotation(k1->getRotation());
-            kret->setTranslate(k1->getTranslate());
-            kret->setScale(k1->getScale());
+            kret->setRotation(*rotate1);
+            kret->setTranslate(*translate1);
+            kret->setScale(*scale1);
         }
         else
         {
@@ -414,22 +450,22 @@ namespace Ogre {
                 // Interpolate to nearest rotation if mUseShortestRotationPath set
                 if (rim == Animation::RIM_LINEAR)
                 {
-                    kret->setRotation( Quaternion::nlerp(t, k1->getRotation(),
-                        k2->getRotation(), mUseShortestRotationPath) );
+                    kret->setRotation( Quaternion::nlerp(t, *rotate1,
+                        *rotate2, mUseShortestRotationPath) );
                 }
                 else //if (rim == Animation::RIM_SPHERICAL)
                 {
-                    kret->setRotation( Quaternion::Slerp(t, k1->getRotation(),
-					    k2->getRotation(), mUseShortestRotationPath) );
+                    kret->setRotation( Quaternion::Slerp(t, *rotate1,
+					    *rotate2, mUseShortestRotationPath) );
                 }
 
                 // Translation
-                base = k1->getTranslate();
-                kret->setTranslate( base + ((k2->getTranslate() - base) * t) );
+                base = *translate1;
+                kret->setTranslate( base + ((*translate2 - base) * t) );
 
                 // Scale
-                base = k1->getScale();
-                kret->setScale( base + ((k2->getScale() - base) * t) );
+                base = *scale1;
+                kret->setScale( base + ((*scale2 - base) * t) );
                 break;
 
             case Animation::IM_SPLINE:
@@ -477,7 +513,7 @@ namespace Ogre {
 		Real scl)
     {
 		// Nothing to do if no keyframes or zero weight or no node
-		if (mKeyFrames.empty() || !weight || !node)
+		if ((mKeyFrames.empty() && !mCompressedKeys) || !weight || !node)
 			return;
 
         TransformKeyFrame kf(0, timeIndex.getTimePos());
@@ -535,14 +571,27 @@ namespace Ogre {
         splines->rotationSpline.clear();
         splines->scaleSpline.clear();
 
-        KeyFrameList::const_iterator i, iend;
-        iend = mKeyFrames.end(); // precall to avoid overhead
-        for (i = mKeyFrames.begin(); i != iend; ++i)
+        if (mCompressedKeys)
         {
-			TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(*i);
-            splines->positionSpline.addPoint(kf->getTranslate());
-            splines->rotationSpline.addPoint(kf->getRotation());
-            splines->scaleSpline.addPoint(kf->getScale());
+            size_t numKeys = mCompressedKeys->getNumKeys();
+            for (size_t k = 0; k < numKeys; ++k)
+            {
+                splines->positionSpline.addPoint(mCompressedKeys->getTranslate(k));
+                splines->rotationSpline.addPoint(mCompressedKeys->getRotation(k));
+                splines->scaleSpline.addPoint(mCompressedKeys->getScale(k));
+            }
+        }
+        else
+        {
+            KeyFrameList::const_iterator i, iend;
+            iend = mKeyFrames.end(); // precall to avoid overhead
+            for (i = mKeyFrames.begin(); i != iend; ++i)
+            {
+                TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(*i);
+                splines->positionSpline.addPoint(kf->getTranslate());
+                splines->rotationSpline.addPoint(kf->getRotation());
+                splines->scaleSpline.addPoint(kf->getScale());
+            }
         }
 
         splines->positionSpline.recalcTangents();
@@ -572,18 +621,28 @@ namespace Ogre {
     //---------------------------------------------------------------------
 	bool NodeAnimationTrack::hasNonZeroKeyFrames(void) const
 	{
-        KeyFrameList::const_iterator i = mKeyFrames.begin();
-        for (; i != mKeyFrames.end(); ++i)
+        size_t numKeys = mCompressedKeys ? mCompressedKeys->getNumKeys() : mKeyFrames.size();
+        for (size_t k = 0; k < numKeys; ++k)
         {
 			// look for keyframes which have any component which is non-zero
 			// Since exporters can be a little inaccurate sometimes we use a
 			// tolerance value rather than looking for nothing
-			TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(*i);
-			Vector3 trans = kf->getTranslate();
-			Vector3 scale = kf->getScale();
+			Vector3 trans, scale;
+			Quaternion rotate;
+			if (mCompressedKeys)
+			{
+				mCompressedKeys->getKey(k, rotate, trans, scale);
+			}
+			else
+			{
+				TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(mKeyFrames[k]);
+				trans = kf->getTranslate();
+				scale = kf->getScale();
+				rotate = kf->getRotation();
+			}
 			Vector3 axis;
 			Radian angle;
-			kf->getRotation().ToAngleAxis(angle, axis);
+			rotate.ToAngleAxis(angle, axis);
 			Real tolerance = 1e-3f;
 			if (!trans.positionEquals(Vector3::ZERO, tolerance) ||
 				!scale.positionEquals(Vector3::UNIT_SCALE, tolerance) ||
@@ -599,6 +658,10 @@ namespace Ogre {
     //---------------------------------------------------------------------
 	void NodeAnimationTrack::optimise(void)
 	{
+		// Compression has already removed the redundant keys
+		if (mCompressedKeys)
+			return;
+
 		// Eliminate duplicate keyframes from 2nd to penultimate keyframe
 		// NB only eliminate middle keys from sequences of 5+ identical keyframes
 		// since we need to preserve the boundary keys in place, and we need
@@ -656,6 +719,12 @@ namespace Ogre {
 	//--------------------------------------------------------------------------
 	KeyFrame* NodeAnimationTrack::createKeyFrameImpl(Real time)
 	{
+		if (mCompressedKeys)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Keyframes can't be created on a compressed track, call decompress first.",
+				"NodeAnimationTrack::createKeyFrameImpl");
+		}
 		return OGRE_NEW TransformKeyFrame(this, time);
 	}
 	//--------------------------------------------------------------------------
@@ -668,6 +737,213 @@ namespace Ogre {
 	{
 		return static_cast<TransformKeyFrame*>(getKeyFrame(index));
 	}
+	//--------------------------------------------------------------------------
+	void NodeAnimationTrack::compress(Real translateTolerance,
+		const Radian& rotateTolerance, Real scaleTolerance)
+	{
+		if (mCompressedKeys)
+			decompress();
+
+		size_t numKeys = mKeyFrames.size();
+		if (!numKeys)
+			return;
+
+		// Splines go through every key, so keys are only removed from
+		// linearly interpolated animations
+		bool reduce = mParent->getInterpolationMode() == Animation::IM_LINEAR;
+		vector<size_t>::type kept;
+		kept.push_back(0);
+		for (size_t k = 1; k + 1 < numKeys; ++k)
+		{
+			// Keep this key if the next one can't replace it and the keys
+			// removed since the last one kept
+			if (!reduce || !canInterpolateKeyFrames(kept.back(), k + 1,
+				translateTolerance, rotateTolerance, scaleTolerance))
+			{
+				kept.push_back(k);
+			}
+		}
+		if (numKeys > 1)
+			kept.push_back(numKeys - 1);
+
+		vector<Real>::type times(kept.size());
+		vector<Quaternion>::type rotations(kept.size());
+		vector<Vector3>::type translates(kept.size());
+		vector<Vector3>::type scales(kept.size());
+		for (size_t k = 0; k < kept.size(); ++k)
+		{
+			const TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(mKeyFrames[kept[k]]);
+			times[k] = kf->getTime();
+			rotations[k] = kf->getRotation();
+			translates[k] = kf->getTranslate();
+			scales[k] = kf->getScale();
+		}
+
+		CompressedTransformKeys* keys = OGRE_NEW CompressedTransformKeys();
+		keys->setKeys(kept.size(), &times[0], &rotations[0], &translates[0], &scales[0],
+			translateTolerance, rotateTolerance, scaleTolerance);
+		_setCompressedKeys(keys);
+	}
+	//--------------------------------------------------------------------------
+	void NodeAnimationTrack::decompress(void)
+	{
+		if (!mCompressedKeys)
+			return;
+
+		// Detach first, keyframes can't be created while compressed
+		CompressedTransformKeys* keys = mCompressedKeys;
+		mCompressedKeys = 0;
+
+		size_t numKeys = keys->getNumKeys();
+		for (size_t k = 0; k < numKeys; ++k)
+		{
+			TransformKeyFrame* kf = createNodeKeyFrame(keys->getTime(k));
+			kf->setRotation(keys->getRotation(k));
+			kf->setTranslate(keys->getTranslate(k));
+			kf->setScale(keys->getScale(k));
+		}
+
+		OGRE_DELETE keys;
+	}
+	//--------------------------------------------------------------------------
+	void NodeAnimationTrack::_setCompressedKeys(CompressedTransformKeys* keys)
+	{
+		for (KeyFrameList::iterator i = mKeyFrames.begin(); i != mKeyFrames.end(); ++i)
+		{
+			OGRE_DELETE *i;
+		}
+		mKeyFrames.clear();
+
+		OGRE_DELETE mCompressedKeys;
+		mCompressedKeys = keys;
+
+		_keyFrameDataChanged();
+		mParent->_keyFrameListChanged();
+	}
+	//--------------------------------------------------------------------------
+	void NodeAnimationTrack::removeAllKeyFrames(void)
+	{
+		OGRE_DELETE mCompressedKeys;
+		mCompressedKeys = 0;
+
+		AnimationTrack::removeAllKeyFrames();
+	}
+	//--------------------------------------------------------------------------
+	void NodeAnimationTrack::_collectKeyFrameTimes(vector<Real>::type& keyFrameTimes)
+	{
+		if (!mCompressedKeys)
+		{
+			AnimationTrack::_collectKeyFrameTimes(keyFrameTimes);
+			return;
+		}
+
+		const CompressedTransformKeys::TimeList& times = mCompressedKeys->getTimes();
+		for (CompressedTransformKeys::TimeList::const_iterator i = times.begin(); i != times.end(); ++i)
+		{
+			vector<Real>::type::iterator it =
+				std::lower_bound(keyFrameTimes.begin(), keyFrameTimes.end(), *i);
+			if (it == keyFrameTimes.end() || *it != *i)
+			{
+				keyFrameTimes.insert(it, *i);
+			}
+		}
+	}
+	//--------------------------------------------------------------------------
+	void NodeAnimationTrack::_buildKeyFrameIndexMap(const vector<Real>::type& keyFrameTimes)
+	{
+		if (!mCompressedKeys)
+		{
+			AnimationTrack::_buildKeyFrameIndexMap(keyFrameTimes);
+			return;
+		}
+
+		const CompressedTransformKeys::TimeList& times = mCompressedKeys->getTimes();
+		mKeyFrameIndexMap.resize(keyFrameTimes.size() + 1);
+
+		size_t i = 0, j = 0;
+		while (j <= keyFrameTimes.size())
+		{
+			mKeyFrameIndexMap[j] = static_cast<ushort>(i);
+			while (i < times.size() && j < keyFrameTimes.size() && times[i] <= keyFrameTimes[j])
+				++i;
+			++j;
+		}
+	}
+	//--------------------------------------------------------------------------
+	Real NodeAnimationTrack::getCompressedKeysAtTime(const TimeIndex& timeIndex,
+		unsigned short* firstKeyIndex, unsigned short* secondKeyIndex) const
+	{
+		const CompressedTransformKeys::TimeList& times = mCompressedKeys->getTimes();
+		Real timePos = timeIndex.getTimePos();
+
+		// Find first key after or on current time
+		size_t i;
+		if (timeIndex.hasKeyIndex())
+		{
+			assert(timeIndex.getKeyIndex() < mKeyFrameIndexMap.size());
+			i = mKeyFrameIndexMap[timeIndex.getKeyIndex()];
+		}
+		else
+		{
+			Real totalAnimationLength = mParent->getLength();
+			if (timePos > totalAnimationLength && totalAnimationLength > 0.0f)
+				timePos = fmod(timePos, totalAnimationLength);
+
+			i = std::distance(times.begin(),
+				std::lower_bound(times.begin(), times.end(), timePos));
+		}
+
+		Real t1, t2;
+		if (i == times.size())
+		{
+			// There is no key after this time, wrap back to first
+			*secondKeyIndex = 0;
+			t2 = mParent->getLength() + times.front();
+			--i;
+		}
+		else
+		{
+			*secondKeyIndex = static_cast<unsigned short>(i);
+			t2 = times[i];
+			// Find last key before or on current time
+			if (i > 0 && timePos < times[i])
+				--i;
+		}
+
+		*firstKeyIndex = static_cast<unsigned short>(i);
+		t1 = times[i];
+
+		return t1 == t2 ? 0 : (timePos - t1) / (t2 - t1);
+	}
+	//--------------------------------------------------------------------------
+	bool NodeAnimationTrack::canInterpolateKeyFrames(size_t first, size_t last,
+		Real translateTolerance, const Radian& rotateTolerance, Real scaleTolerance) const
+	{
+		const TransformKeyFrame* k1 = static_cast<TransformKeyFrame*>(mKeyFrames[first]);
+		const TransformKeyFrame* k2 = static_cast<TransformKeyFrame*>(mKeyFrames[last]);
+		Real duration = k2->getTime() - k1->getTime();
+		bool spherical = mParent->getRotationInterpolationMode() == Animation::RIM_SPHERICAL;
+
+		for (size_t k = first + 1; k < last; ++k)
+		{
+			const TransformKeyFrame* kf = static_cast<TransformKeyFrame*>(mKeyFrames[k]);
+			Real t = (kf->getTime() - k1->getTime()) / duration;
+
+			Quaternion rotate = spherical ?
+				Quaternion::Slerp(t, k1->getRotation(), k2->getRotation(), mUseShortestRotationPath) :
+				Quaternion::nlerp(t, k1->getRotation(), k2->getRotation(), mUseShortestRotationPath);
+			Vector3 translate = k1->getTranslate() + (k2->getTranslate() - k1->getTranslate()) * t;
+			Vector3 scale = k1->getScale() + (k2->getScale() - k1->getScale()) * t;
+
+			if (!rotate.equals(kf->getRotation(), rotateTolerance) ||
+				!translate.positionEquals(kf->getTranslate(), translateTolerance) ||
+				!scale.positionEquals(kf->getScale(), scaleTolerance))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
     //---------------------------------------------------------------------
 	NodeAnimationTrack* NodeAnimationTrack::_clone(Animation* newParent) const
 	{
@@ -675,12 +951,28 @@ namespace Ogre {
 			newParent->createNodeTrack(mHandle, mTargetNode);
 		newTrack->mUseShortestRotationPath = mUseShortestRotationPath;
 		populateClone(newTrack);
+		if (mCompressedKeys)
+			newTrack->_setCompressedKeys(OGRE_NEW CompressedTransformKeys(*mCompressedKeys));
+		// Splines are built on demand, the cloned keys didn't flag them
+		newTrack->_keyFrameDataChanged();
 		return newTrack;
 	}
 	//--------------------------------------------------------------------------
 	void NodeAnimationTrack::_applyBaseKeyFrame(const KeyFrame* b)
 	{
 		const TransformKeyFrame* base = static_cast<const TransformKeyFrame*>(b);
+
+		// Compressed keys are re-based decoded, then compressed again
+		bool compressed = mCompressedKeys != 0;
+		Real translateTolerance = 0, scaleTolerance = 0;
+		Radian rotateTolerance(0);
+		if (compressed)
+		{
+			translateTolerance = mCompressedKeys->getTranslateTolerance();
+			rotateTolerance = mCompressedKeys->getRotateTolerance();
+			scaleTolerance = mCompressedKeys->getScaleTolerance();
+			decompress();
+		}
 		
         for (KeyFrameList::iterator i = mKeyFrames.begin(); i != mKeyFrames.end(); ++i)
         {
@@ -689,6 +981,11 @@ namespace Ogre {
 			kf->setRotation(base->getRotation().Inverse() * kf->getRotation());
 			kf->setScale(kf->getScale() * (Vector3::UNIT_SCALE / base->getScale()));
 		}
+
+		if (compressed)
+		{
+			compress(translateTolerance, rotateTolerance, scaleTolerance);
+		}
 			
 	}
 	//--------------------------------------------------------------------------
@@ -43,6 +43,14 @@ namespace Ogre {
         0,      0,    1,    0,
         0,      0,    0,    1);
 
+    AtomicScalar<uint64> AutoParamDataSource::msLatestInputVersion(0);
+
+    //-----------------------------------------------------------------------------
+    static bool usesIdentityViewProj(const Renderable* rend)
+    {
+        return rend && (rend->getUseIdentityView() || rend->getUseIdentityProjection());
+    }
+
     //-----------------------------------------------------------------------------
     AutoParamDataSource::AutoParamDataSource()
         : mWorldMatrixDirty(true),
@@ -83,11 +91,32 @@ namespace Ogre {
 			mCurrentTextureProjector[i] = 0;
 			mShadowCamDepthRangesDirty[i] = false;
 		}
-
+        invalidateInputs();
     }
     //-----------------------------------------------------------------------------
     AutoParamDataSource::~AutoParamDataSource()
     {
+    }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::markInputsChanged(uint16 inputs)
+    {
+        uint64 version = ++msLatestInputVersion;
+        for (size_t i = 0; i < GPI_COUNT; ++i)
+        {
+            if (inputs & (1 << i))
+                mInputVersions[i] = version;
+        }
+    }
+    //-----------------------------------------------------------------------------
+    uint64 AutoParamDataSource::getInputVersion(uint16 inputs) const
+    {
+        uint64 version = 0;
+        for (size_t i = 0; i < GPI_COUNT; ++i)
+        {
+            if ((inputs & (1 << i)) && mInputVersions[i] > version)
+                version = mInputVersions[i];
+        }
+        return version;
     }
 	//-----------------------------------------------------------------------------
     const Light& AutoParamDataSource::getLight(size_t index) const
@@ -105,6 +134,12 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderable(const Renderable* rend)
     {
+        // The view and projection come from the renderable instead of the camera
+        // when it wants identity ones
+        if (usesIdentityViewProj(mCurrentRenderable) || usesIdentityViewProj(rend))
+            markInputsChanged((uint16)GPI_RENDERABLE | (uint16)GPI_CAMERA);
+        else
+            markInputsChanged((uint16)GPI_RENDERABLE);
 		mCurrentRenderable = rend;
 		mWorldMatrixDirty = true;
         mViewMatrixDirty = true;
@@ -129,6 +164,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentCamera(const Camera* cam, bool useCameraRelative)
     {
+        markInputsChanged((uint16)GPI_CAMERA);
         mCurrentCamera = cam;
 		mCameraRelativeRendering = useCameraRelative;
 		mCameraRelativePosition = cam->getDerivedPosition();
@@ -148,6 +184,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentLightList(const LightList* ll)
     {
+        markInputsChanged((uint16)GPI_LIGHTS);
         mCurrentLightList = ll;
 		for(size_t i = 0; i < ll->size() && i < OGRE_MAX_SIMULTANEOUS_LIGHTS; ++i)
 		{
@@ -252,17 +289,20 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
 	void AutoParamDataSource::setMainCamBoundsInfo(VisibleObjectsBoundsInfo* info)
 	{
+		markInputsChanged((uint16)GPI_SCENE);
 		mMainCamBoundsInfo = info;
 		mSceneDepthRangeDirty = true;
 	}
 	//-----------------------------------------------------------------------------
 	void AutoParamDataSource::setCurrentSceneManager(const SceneManager* sm)
 	{
+		markInputsChanged((uint16)GPI_SCENE);
 		mCurrentSceneManager = sm;
 	}
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setWorldMatrices(const Matrix4* m, size_t count)
     {
+        markInputsChanged((uint16)GPI_RENDERABLE);
         mWorldMatrixArray = m;
         mWorldMatrixCount = count;
         mWorldMatrixDirty = false;
@@ -508,6 +548,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
 	void AutoParamDataSource::setAmbientLightColour(const ColourValue& ambient)
 	{
+		markInputsChanged((uint16)GPI_SCENE);
 		mAmbientLight = ambient;
 	}
 	//---------------------------------------------------------------------
@@ -529,6 +570,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentPass(const Pass* pass)
     {
+        markInputsChanged((uint16)GPI_PASS);
         mCurrentPass = pass;
     }
     //-----------------------------------------------------------------------------
@@ -609,6 +651,7 @@ namespace Ogre {
         Real expDensity, Real linearStart, Real linearEnd)
     {
         (void)mode; // ignored
+        markInputsChanged((uint16)GPI_SCENE);
         mFogColour = colour;
         mFogParams.x = expDensity;
         mFogParams.y = linearStart;
@@ -630,6 +673,7 @@ namespace Ogre {
     {
 		if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
 		{
+			markInputsChanged((uint16)GPI_TEXTURE_PROJECTORS);
 			mCurrentTextureProjector[index] = frust;
 			mTextureViewProjMatrixDirty[index] = true;
 			mTextureWorldViewProjMatrixDirty[index] = true;
@@ -783,6 +827,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentRenderTarget(const RenderTarget* target)
     {
+        markInputsChanged((uint16)GPI_VIEWPORT);
         mCurrentRenderTarget = target;
     }
     //-----------------------------------------------------------------------------
@@ -793,11 +838,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentViewport(const Viewport* viewport)
     {
+        markInputsChanged((uint16)GPI_VIEWPORT);
         mCurrentViewport = viewport;
     }
     //-----------------------------------------------------------------------------
 	void AutoParamDataSource::setShadowDirLightExtrusionDistance(Real dist)
 	{
+		markInputsChanged((uint16)GPI_LIGHTS);
 		mDirLightExtrusionDistance = dist;
 	}
     //-----------------------------------------------------------------------------
@@ -1038,11 +1085,13 @@ namespace Ogre {
 	//-----------------------------------------------------------------------------
     void AutoParamDataSource::setPassNumber(const int passNumber)
     {
+        markInputsChanged((uint16)GPI_PASS);
         mPassNumber = passNumber;
     }
 	//-----------------------------------------------------------------------------
     void AutoParamDataSource::incPassNumber(void)
     {
+        markInputsChanged((uint16)GPI_PASS);
         ++mPassNumber;
     }
 	//-----------------------------------------------------------------------------
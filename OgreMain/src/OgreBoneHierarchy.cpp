@@ -0,0 +1,415 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreBoneHierarchy.h"
+#include "OgreBone.h"
+
+namespace Ogre {
+
+	const size_t BoneHierarchy::NO_PARENT = ~static_cast<size_t>(0);
+	//-----------------------------------------------------------------------
+	/// Streams starting the given number of elements into the given ones
+	static TransformStreams offsetStreams(const TransformStreams& streams, size_t offset)
+	{
+		TransformStreams ret;
+		for (size_t c = 0; c < 3; ++c)
+		{
+			ret.position[c] = streams.position[c] + offset;
+			ret.scale[c] = streams.scale[c] + offset;
+		}
+		for (size_t c = 0; c < 4; ++c)
+			ret.orientation[c] = streams.orientation[c] + offset;
+		return ret;
+	}
+	//-----------------------------------------------------------------------
+	BoneHierarchy::BoneHierarchy()
+		: mNumBones(0)
+		, mHandleOrder(true)
+		, mCapacity(0)
+		, mBuffer(0)
+		, mInheritOrientation(0)
+		, mInheritScale(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	BoneHierarchy::~BoneHierarchy()
+	{
+		if (mBuffer)
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_ANIMATION);
+	}
+	//-----------------------------------------------------------------------
+	bool BoneHierarchy::isLayoutValid(const BoneList& bones) const
+	{
+		if (bones.size() != mNumBones)
+			return false;
+
+		// Any change to the bone tree reparents at least one bone
+		for (size_t slot = 0; slot < mHandles.size(); ++slot)
+		{
+			const Bone* bone = bones[mHandles[slot]];
+			size_t parentSlot = mParentSlots[slot];
+			const Node* parent = parentSlot != NO_PARENT ? bones[mHandles[parentSlot]] : 0;
+			if (!bone || bone->mParent != parent)
+				return false;
+		}
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	void BoneHierarchy::buildLayout(const BoneList& bones)
+	{
+		mHandles.clear();
+		mParentSlots.clear();
+		mChildStarts.clear();
+		mLevelStarts.clear();
+
+		// Children of bones can be tag points, so tell bones apart by address
+		typedef map<const Node*, unsigned short>::type HandleMap;
+		HandleMap handles;
+		for (size_t h = 0; h < bones.size(); ++h)
+		{
+			if (!bones[h])
+				continue;
+			handles[bones[h]] = static_cast<unsigned short>(h);
+			if (!bones[h]->mParent)
+			{
+				mHandles.push_back(static_cast<unsigned short>(h));
+				mParentSlots.push_back(NO_PARENT);
+			}
+		}
+
+		// Breadth first traversal, so that every level is contiguous and
+		// parents always come before their children
+		size_t levelStart = 0;
+		while (levelStart < mHandles.size())
+		{
+			size_t levelEnd = mHandles.size();
+			mLevelStarts.push_back(levelStart);
+
+			for (size_t slot = levelStart; slot < levelEnd; ++slot)
+			{
+				mChildStarts.push_back(mHandles.size());
+
+				const Bone* bone = bones[mHandles[slot]];
+				Node::ChildNodeMap::const_iterator i, iend;
+				iend = bone->mChildren.end();
+				for (i = bone->mChildren.begin(); i != iend; ++i)
+				{
+					HandleMap::const_iterator h = handles.find(i->second);
+					if (h != handles.end())
+					{
+						mHandles.push_back(h->second);
+						mParentSlots.push_back(slot);
+					}
+				}
+			}
+			levelStart = levelEnd;
+		}
+		mLevelStarts.push_back(mHandles.size());
+		mChildStarts.push_back(mHandles.size());
+
+		mHandleOrder = true;
+		for (size_t slot = 0; slot < mHandles.size(); ++slot)
+		{
+			if (mHandles[slot] != slot)
+			{
+				mHandleOrder = false;
+				break;
+			}
+		}
+
+		mChanged.resize(mHandles.size());
+		mMatrices.resize(mHandleOrder ? 0 : mHandles.size());
+		reserve(mHandles.size());
+		mNumBones = bones.size();
+	}
+	//-----------------------------------------------------------------------
+	void BoneHierarchy::reserve(size_t numBones)
+	{
+		if (numBones <= mCapacity)
+			return;
+
+		// Round up so that every stream stays aligned
+		size_t capacity = (numBones + 3) & ~static_cast<size_t>(3);
+		size_t streamSize = capacity * sizeof(Real);
+		void* buffer = OGRE_MALLOC_SIMD(streamSize * 40 + capacity * sizeof(uint32) * 2,
+			MEMCATEGORY_ANIMATION);
+		if (mBuffer)
+			OGRE_FREE_SIMD(mBuffer, MEMCATEGORY_ANIMATION);
+		mBuffer = buffer;
+		mCapacity = capacity;
+
+		Real* stream = static_cast<Real*>(buffer);
+		TransformStreams* allStreams[4] = {
+			&mParentTransforms, &mLocalTransforms, &mDerivedTransforms, &mBindingPoseInverses };
+		for (size_t s = 0; s < 4; ++s)
+		{
+			for (size_t c = 0; c < 3; ++c, stream += capacity)
+				allStreams[s]->position[c] = stream;
+			for (size_t c = 0; c < 4; ++c, stream += capacity)
+				allStreams[s]->orientation[c] = stream;
+			for (size_t c = 0; c < 3; ++c, stream += capacity)
+				allStreams[s]->scale[c] = stream;
+		}
+		mInheritOrientation = reinterpret_cast<uint32*>(stream);
+		mInheritScale = mInheritOrientation + capacity;
+	}
+	//-----------------------------------------------------------------------
+	void BoneHierarchy::gatherBone(size_t slot, const Bone* bone)
+	{
+		mLocalTransforms.position[0][slot] = bone->mPosition.x;
+		mLocalTransforms.position[1][slot] = bone->mPosition.y;
+		mLocalTransforms.position[2][slot] = bone->mPosition.z;
+		mLocalTransforms.orientation[0][slot] = bone->mOrientation.w;
+		mLocalTransforms.orientation[1][slot] = bone->mOrientation.x;
+		mLocalTransforms.orientation[2][slot] = bone->mOrientation.y;
+		mLocalTransforms.orientation[3][slot] = bone->mOrientation.z;
+		mLocalTransforms.scale[0][slot] = bone->mScale.x;
+		mLocalTransforms.scale[1][slot] = bone->mScale.y;
+		mLocalTransforms.scale[2][slot] = bone->mScale.z;
+
+		const Vector3& inversePosition = bone->_getBindingPoseInversePosition();
+		const Quaternion& inverseOrientation = bone->_getBindingPoseInverseOrientation();
+		const Vector3& inverseScale = bone->_getBindingPoseInverseScale();
+		mBindingPoseInverses.position[0][slot] = inversePosition.x;
+		mBindingPoseInverses.position[1][slot] = inversePosition.y;
+		mBindingPoseInverses.position[2][slot] = inversePosition.z;
+		mBindingPoseInverses.orientation[0][slot] = inverseOrientation.w;
+		mBindingPoseInverses.orientation[1][slot] = inverseOrientation.x;
+		mBindingPoseInverses.orientation[2][slot] = inverseOrientation.y;
+		mBindingPoseInverses.orientation[3][slot] = inverseOrientation.z;
+		mBindingPoseInverses.scale[0][slot] = inverseScale.x;
+		mBindingPoseInverses.scale[1][slot] = inverseScale.y;
+		mBindingPoseInverses.scale[2][slot] = inverseScale.z;
+
+		mInheritOrientation[slot] = bone->mInheritOrientation ? 0xFFFFFFFF : 0;
+		mInheritScale[slot] = bone->mInheritScale ? 0xFFFFFFFF : 0;
+	}
+	//-----------------------------------------------------------------------
+	void BoneHierarchy::combineBone(size_t slot)
+	{
+		Quaternion orientation(
+			mLocalTransforms.orientation[0][slot],
+			mLocalTransforms.orientation[1][slot],
+			mLocalTransforms.orientation[2][slot],
+			mLocalTransforms.orientation[3][slot]);
+		Vector3 scale(
+			mLocalTransforms.scale[0][slot],
+			mLocalTransforms.scale[1][slot],
+			mLocalTransforms.scale[2][slot]);
+		Vector3 position(
+			mLocalTransforms.position[0][slot],
+			mLocalTransforms.position[1][slot],
+			mLocalTransforms.position[2][slot]);
+
+		// Same combination as Node::updateFromParentImpl
+		size_t parentSlot = mParentSlots[slot];
+		if (parentSlot != NO_PARENT)
+		{
+			const Quaternion parentOrientation(
+				mDerivedTransforms.orientation[0][parentSlot],
+				mDerivedTransforms.orientation[1][parentSlot],
+				mDerivedTransforms.orientation[2][parentSlot],
+				mDerivedTransforms.orientation[3][parentSlot]);
+			const Vector3 parentScale(
+				mDerivedTransforms.scale[0][parentSlot],
+				mDerivedTransforms.scale[1][parentSlot],
+				mDerivedTransforms.scale[2][parentSlot]);
+
+			if (mInheritOrientation[slot])
+				orientation = parentOrientation * orientation;
+			if (mInheritScale[slot])
+				scale = parentScale * scale;
+
+			position = parentOrientation * (parentScale * position);
+			position.x += mDerivedTransforms.position[0][parentSlot];
+			position.y += mDerivedTransforms.position[1][parentSlot];
+			position.z += mDerivedTransforms.position[2][parentSlot];
+		}
+
+		mDerivedTransforms.position[0][slot] = position.x;
+		mDerivedTransforms.position[1][slot] = position.y;
+		mDerivedTransforms.position[2][slot] = position.z;
+		mDerivedTransforms.orientation[0][slot] = orientation.w;
+		mDerivedTransforms.orientation[1][slot] = orientation.x;
+		mDerivedTransforms.orientation[2][slot] = orientation.y;
+		mDerivedTransforms.orientation[3][slot] = orientation.z;
+		mDerivedTransforms.scale[0][slot] = scale.x;
+		mDerivedTransforms.scale[1][slot] = scale.y;
+		mDerivedTransforms.scale[2][slot] = scale.z;
+	}
+	//-----------------------------------------------------------------------
+	void BoneHierarchy::scatterBone(size_t slot, Bone* bone)
+	{
+		bone->mDerivedPosition.x = mDerivedTransforms.position[0][slot];
+		bone->mDerivedPosition.y = mDerivedTransforms.position[1][slot];
+		bone->mDerivedPosition.z = mDerivedTransforms.position[2][slot];
+		bone->mDerivedOrientation.w = mDerivedTransforms.orientation[0][slot];
+		bone->mDerivedOrientation.x = mDerivedTransforms.orientation[1][slot];
+		bone->mDerivedOrientation.y = mDerivedTransforms.orientation[2][slot];
+		bone->mDerivedOrientation.z = mDerivedTransforms.orientation[3][slot];
+		bone->mDerivedScale.x = mDerivedTransforms.scale[0][slot];
+		bone->mDerivedScale.y = mDerivedTransforms.scale[1][slot];
+		bone->mDerivedScale.z = mDerivedTransforms.scale[2][slot];
+		bone->mCachedTransformOutOfDate = true;
+		bone->mNeedParentUpdate = false;
+
+		// Same notification as Node::_updateFromParent
+		if (bone->mListener)
+		{
+			bone->mListener->nodeUpdated(bone);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void BoneHierarchy::updateAttachments(size_t slot, Bone* bone, const BoneList& bones)
+	{
+		size_t childStart = mChildStarts[slot];
+		size_t childEnd = mChildStarts[slot + 1];
+
+		Node::ChildNodeMap::iterator i, iend;
+		iend = bone->mChildren.end();
+		for (i = bone->mChildren.begin(); i != iend; ++i)
+		{
+			Node* child = i->second;
+			bool isBone = false;
+			for (size_t c = childStart; c < childEnd && !isBone; ++c)
+			{
+				isBone = bones[mHandles[c]] == child;
+			}
+			if (!isBone)
+			{
+				child->_update(true, mChanged[slot] != 0);
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	bool BoneHierarchy::_update(const BoneList& bones, Matrix4* boneMatrices)
+	{
+		if (!isLayoutValid(bones))
+		{
+			buildLayout(bones);
+		}
+
+		size_t numBones = mHandles.size();
+		if (!numBones || numBones != mNumBones)
+			return false;
+
+		// All local transforms, so that every level can be processed at once
+		for (size_t slot = 0; slot < numBones; ++slot)
+		{
+			const Bone* bone = bones[mHandles[slot]];
+			size_t parentSlot = mParentSlots[slot];
+			mChanged[slot] = bone->mNeedParentUpdate || bone->mNeedChildUpdate ||
+				(parentSlot != NO_PARENT && mChanged[parentSlot]);
+			gatherBone(slot, bone);
+		}
+
+		// Top-down: derived transforms, one level at a time
+		OptimisedUtil* util = OptimisedUtil::getImplementation();
+		size_t numLevels = mLevelStarts.size() - 1;
+		for (size_t level = 0; level < numLevels; ++level)
+		{
+			size_t levelStart = mLevelStarts[level];
+			size_t levelEnd = mLevelStarts[level + 1];
+			if (levelEnd - levelStart < 4)
+			{
+				// Too narrow to fill a SIMD block, typical of bone chains
+				for (size_t slot = levelStart; slot < levelEnd; ++slot)
+				{
+					combineBone(slot);
+				}
+				continue;
+			}
+
+			for (size_t slot = levelStart; slot < levelEnd; ++slot)
+			{
+				size_t index = slot - levelStart;
+				size_t parentSlot = mParentSlots[slot];
+				for (size_t c = 0; c < 3; ++c)
+				{
+					mParentTransforms.position[c][index] = parentSlot != NO_PARENT ?
+						mDerivedTransforms.position[c][parentSlot] : 0;
+					mParentTransforms.scale[c][index] = parentSlot != NO_PARENT ?
+						mDerivedTransforms.scale[c][parentSlot] : 1;
+				}
+				for (size_t c = 0; c < 4; ++c)
+				{
+					// Identity is (1, 0, 0, 0) in (w, x, y, z) order
+					mParentTransforms.orientation[c][index] = parentSlot != NO_PARENT ?
+						mDerivedTransforms.orientation[c][parentSlot] : (c == 0 ? 1 : 0);
+				}
+			}
+
+			util->concatenateNodeTransforms(
+				mParentTransforms,
+				offsetStreams(mLocalTransforms, levelStart),
+				mInheritOrientation + levelStart,
+				mInheritScale + levelStart,
+				offsetStreams(mDerivedTransforms, levelStart),
+				levelEnd - levelStart);
+		}
+
+		// Write back, and bring the tag points up to date now that their
+		// bone is final
+		for (size_t slot = 0; slot < numBones; ++slot)
+		{
+			Bone* bone = bones[mHandles[slot]];
+			if (mChanged[slot])
+			{
+				scatterBone(slot, bone);
+			}
+			if (bone->mChildren.size() != mChildStarts[slot + 1] - mChildStarts[slot])
+			{
+				updateAttachments(slot, bone, bones);
+			}
+			bone->mParentNotified = false;
+			bone->mNeedChildUpdate = false;
+			bone->mChildrenToUpdate.clear();
+		}
+
+		if (boneMatrices)
+		{
+			if (mHandleOrder)
+			{
+				util->calculateBoneMatrices(
+					mDerivedTransforms, mBindingPoseInverses, boneMatrices, numBones);
+			}
+			else
+			{
+				util->calculateBoneMatrices(
+					mDerivedTransforms, mBindingPoseInverses, &mMatrices[0], numBones);
+				for (size_t slot = 0; slot < numBones; ++slot)
+				{
+					boneMatrices[mHandles[slot]] = mMatrices[slot];
+				}
+			}
+		}
+
+		return true;
+	}
+
+}
@@ -894,6 +894,30 @@ namespace Ogre {
 		}
 	}
 	//-----------------------------------------------------------------------
+	void Camera::isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const
+	{
+		if (mCullFrustum)
+		{
+			mCullFrustum->isVisible(bounds, count, visibilities);
+		}
+		else
+		{
+			Frustum::isVisible(bounds, count, visibilities);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void Camera::isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const
+	{
+		if (mCullFrustum)
+		{
+			mCullFrustum->isVisible(bounds, count, visibilities);
+		}
+		else
+		{
+			Frustum::isVisible(bounds, count, visibilities);
+		}
+	}
+	//-----------------------------------------------------------------------
 	bool Camera::isVisible(const Vector3& vert, FrustumPlane* culledBy) const
 	{
 		if (mCullFrustum)
@@ -930,6 +954,18 @@ namespace Ogre {
 		}
 	}
 	//-----------------------------------------------------------------------
+	void Camera::getCullingPlanes(CullingPlanes& planes) const
+	{
+		if (mCullFrustum)
+		{
+			mCullFrustum->getCullingPlanes(planes);
+		}
+		else
+		{
+			Frustum::getCullingPlanes(planes);
+		}
+	}
+	//-----------------------------------------------------------------------
 	bool Camera::projectSphere(const Sphere& sphere, 
 		Real* left, Real* top, Real* right, Real* bottom) const
 	{
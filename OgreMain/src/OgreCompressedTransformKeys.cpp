@@ -0,0 +1,209 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreCompressedTransformKeys.h"
+
+namespace Ogre {
+
+	/// The three smallest components of a unit quaternion are within +/- this
+	static const Real SMALLEST_THREE_RANGE = 0.707106781f;
+	/// Largest value of a quantised rotation component, the low bits of the
+	/// words hold the index of the dropped component and whether it was negative
+	static const Real ROTATION_STEPS = 32767.0f;
+	/// Largest value of a quantised translation or scale
+	static const Real CHANNEL_STEPS = 65535.0f;
+	//-----------------------------------------------------------------------
+	CompressedTransformKeys::CompressedTransformKeys()
+		: mRotation(Quaternion::IDENTITY)
+		, mTranslateTolerance(0)
+		, mRotateTolerance(0)
+		, mScaleTolerance(0)
+	{
+		mTranslates.base = Vector3::ZERO;
+		mTranslates.extent = Vector3::ZERO;
+		mScales.base = Vector3::UNIT_SCALE;
+		mScales.extent = Vector3::ZERO;
+	}
+	//-----------------------------------------------------------------------
+	void CompressedTransformKeys::setKeys(size_t numKeys, const Real* times,
+		const Quaternion* rotations, const Vector3* translates, const Vector3* scales,
+		Real translateTolerance, const Radian& rotateTolerance, Real scaleTolerance)
+	{
+		mTranslateTolerance = translateTolerance;
+		mRotateTolerance = rotateTolerance;
+		mScaleTolerance = scaleTolerance;
+
+		mTimes.assign(times, times + numKeys);
+		mRotations.clear();
+		if (!numKeys)
+			return;
+
+		// Rotation is constant if every key is within tolerance of the first
+		mRotation = rotations[0];
+		mRotation.normalise();
+		for (size_t i = 1; i < numKeys; ++i)
+		{
+			if (!rotations[i].equals(mRotation, rotateTolerance))
+			{
+				mRotations.resize(numKeys * 3);
+				for (size_t k = 0; k < numKeys; ++k)
+				{
+					encodeRotation(rotations[k], &mRotations[k * 3]);
+				}
+				break;
+			}
+		}
+
+		quantiseChannel(mTranslates, numKeys, translates, translateTolerance);
+		quantiseChannel(mScales, numKeys, scales, scaleTolerance);
+	}
+	//-----------------------------------------------------------------------
+	Quaternion CompressedTransformKeys::getRotation(size_t index) const
+	{
+		if (mRotations.empty())
+			return mRotation;
+		return decodeRotation(&mRotations[index * 3]);
+	}
+	//-----------------------------------------------------------------------
+	Vector3 CompressedTransformKeys::getTranslate(size_t index) const
+	{
+		return decodeChannel(mTranslates, index);
+	}
+	//-----------------------------------------------------------------------
+	Vector3 CompressedTransformKeys::getScale(size_t index) const
+	{
+		return decodeChannel(mScales, index);
+	}
+	//-----------------------------------------------------------------------
+	size_t CompressedTransformKeys::calculateSize(void) const
+	{
+		return sizeof(*this) + mTimes.capacity() * sizeof(Real) +
+			(mRotations.capacity() + mTranslates.values.capacity() +
+			mScales.values.capacity()) * sizeof(uint16);
+	}
+	//-----------------------------------------------------------------------
+	void CompressedTransformKeys::quantiseChannel(VectorChannel& channel, size_t numKeys,
+		const Vector3* values, Real tolerance)
+	{
+		Vector3 minimum = values[0];
+		Vector3 maximum = values[0];
+		for (size_t i = 1; i < numKeys; ++i)
+		{
+			minimum.makeFloor(values[i]);
+			maximum.makeCeil(values[i]);
+		}
+		Vector3 extent = maximum - minimum;
+
+		channel.values.clear();
+		if (extent.x <= 2 * tolerance && extent.y <= 2 * tolerance && extent.z <= 2 * tolerance)
+		{
+			// Every key is within tolerance of the middle of the range
+			channel.base = minimum.midPoint(maximum);
+			channel.extent = Vector3::ZERO;
+			return;
+		}
+
+		channel.base = minimum;
+		channel.extent = extent;
+		channel.values.resize(numKeys * 3);
+		for (size_t i = 0; i < numKeys; ++i)
+		{
+			for (size_t a = 0; a < 3; ++a)
+			{
+				Real v = extent[a] > 0 ? (values[i][a] - minimum[a]) / extent[a] : 0;
+				channel.values[i * 3 + a] = static_cast<uint16>(v * CHANNEL_STEPS + 0.5f);
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	Vector3 CompressedTransformKeys::decodeChannel(const VectorChannel& channel, size_t index)
+	{
+		if (channel.values.empty())
+			return channel.base;
+
+		const uint16* v = &channel.values[index * 3];
+		return Vector3(
+			channel.base.x + channel.extent.x * (v[0] / CHANNEL_STEPS),
+			channel.base.y + channel.extent.y * (v[1] / CHANNEL_STEPS),
+			channel.base.z + channel.extent.z * (v[2] / CHANNEL_STEPS));
+	}
+	//-----------------------------------------------------------------------
+	void CompressedTransformKeys::encodeRotation(const Quaternion& rotation, uint16* dest)
+	{
+		Quaternion q = rotation;
+		q.normalise();
+
+		size_t largest = 0;
+		for (size_t i = 1; i < 4; ++i)
+		{
+			if (Math::Abs(q[i]) > Math::Abs(q[largest]))
+				largest = i;
+		}
+		// The dropped component is made positive so that it can be recovered
+		// from the other three. q and -q are the same rotation, but the sign
+		// is kept for spline interpolation, which depends on it.
+		bool negative = q[largest] < 0;
+		Real sign = negative ? Real(-1) : Real(1);
+		uint16 flags[3] = { static_cast<uint16>(largest & 1),
+			static_cast<uint16>(largest >> 1), negative ? uint16(1) : uint16(0) };
+
+		size_t c = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+				continue;
+			Real v = Math::Clamp(q[i] * sign / SMALLEST_THREE_RANGE, Real(-1), Real(1));
+			uint16 bits = static_cast<uint16>((v * 0.5f + 0.5f) * ROTATION_STEPS + 0.5f);
+			dest[c] = static_cast<uint16>((bits << 1) | flags[c]);
+			++c;
+		}
+	}
+	//-----------------------------------------------------------------------
+	Quaternion CompressedTransformKeys::decodeRotation(const uint16* src)
+	{
+		size_t largest = (src[0] & 1) | ((src[1] & 1) << 1);
+
+		Real q[4];
+		Real sumSquares = 0;
+		size_t c = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			if (i == largest)
+				continue;
+			Real v = ((src[c] >> 1) / ROTATION_STEPS * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+			q[i] = v;
+			sumSquares += v * v;
+			++c;
+		}
+		q[largest] = Math::Sqrt(std::max(Real(0), 1 - sumSquares));
+
+		Quaternion ret(q[0], q[1], q[2], q[3]);
+		return (src[2] & 1) ? -ret : ret;
+	}
+
+}
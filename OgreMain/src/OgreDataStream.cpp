@@ -30,6 +30,20 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreException.h"
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#	define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT && OGRE_PLATFORM != OGRE_PLATFORM_NACL && \
+    OGRE_PLATFORM != OGRE_PLATFORM_FLASHCC
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -240,6 +254,9 @@ namespace Ogre {
         bool freeOnClose, bool readOnly)
         : DataStream(static_cast<uint16>(readOnly ? READ : (READ | WRITE)))
     {
+        if (shareMapping(sourceStream))
+            return;
+
         // Copy data from incoming stream
         mSize = sourceStream->size();
         if (mSize == 0 && !sourceStream->eof())
@@ -292,6 +309,9 @@ namespace Ogre {
         bool freeOnClose, bool readOnly)
         : DataStream(name, static_cast<uint16>(readOnly ? READ : (READ | WRITE)))
     {
+        if (shareMapping(sourceStream))
+            return;
+
         // Copy data from incoming stream
         mSize = sourceStream->size();
         if (mSize == 0 && !sourceStream->eof())
@@ -342,6 +362,25 @@ namespace Ogre {
         close();
     }
     //-----------------------------------------------------------------------
+    bool MemoryDataStream::shareMapping(const DataStreamPtr& sourceStream)
+    {
+        MmapDataStream* mapped = dynamic_cast<MmapDataStream*>(sourceStream.get());
+        // closed and empty streams have nothing to share
+        if (!mapped || !mapped->getPtr())
+            return false;
+
+        // Take over the rest of the source, as a copy would
+        mData = mapped->getCurrentPtr();
+        mPos = mData;
+        mSize = mapped->size() - mapped->tell();
+        mEnd = mData + mSize;
+        mFreeOnClose = false;
+        mapped->seek(mapped->size());
+        ++mapped->mShareCount;
+        mSharedSource = sourceStream;
+        return true;
+    }
+    //-----------------------------------------------------------------------
     size_t MemoryDataStream::read(void* buf, size_t count)
     {
         size_t cnt = count;
@@ -466,10 +505,137 @@ namespace Ogre {
             OGRE_FREE(mData, MEMCATEGORY_GENERAL);
             mData = 0;
         }
+        if (!mSharedSource.isNull())
+        {
+            static_cast<MmapDataStream*>(mSharedSource.get())->releaseShare();
+            mSharedSource.setNull();
+        }
 
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    MmapDataStream::MmapDataStream(const String& name, const String& fullPath, bool readOnly)
+        : MemoryDataStream(name, static_cast<void*>(0), 0, false, readOnly)
+        , mMapping(0), mMappingSize(0), mShareCount(0), mClosePending(false)
+    {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        HANDLE file = CreateFileA(fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + fullPath,
+                "MmapDataStream::MmapDataStream");
+        }
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(file, &fileSize);
+        mMappingSize = static_cast<size_t>(fileSize.QuadPart);
+        // Files of size zero can't be mapped, they are just empty streams
+        if (mMappingSize)
+        {
+            HANDLE mapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+            if (mapping)
+            {
+                // The view keeps the file and the mapping open
+                mMapping = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        if (mMappingSize && !mMapping)
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot map file: " + fullPath,
+                "MmapDataStream::MmapDataStream");
+        }
+#elif OGRE_PLATFORM == OGRE_PLATFORM_WINRT || OGRE_PLATFORM == OGRE_PLATFORM_NACL || \
+    OGRE_PLATFORM == OGRE_PLATFORM_FLASHCC
+        // No memory mapping here, read the whole file instead
+        std::ifstream file(fullPath.c_str(), std::ios::in | std::ios::binary);
+        if (file.fail())
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + fullPath,
+                "MmapDataStream::MmapDataStream");
+        }
+        file.seekg(0, std::ios_base::end);
+        mMappingSize = static_cast<size_t>(file.tellg());
+        file.seekg(0, std::ios_base::beg);
+        // freed by unmap, like a mapping, since it can be shared the same way
+        mMapping = OGRE_ALLOC_T(uchar, mMappingSize, MEMCATEGORY_GENERAL);
+        file.read(static_cast<char*>(mMapping), static_cast<std::streamsize>(mMappingSize));
+#else
+        int fd = ::open(fullPath.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND,
+                "Cannot open file: " + fullPath,
+                "MmapDataStream::MmapDataStream");
+        }
+        struct stat tagStat;
+        if (fstat(fd, &tagStat) == 0)
+            mMappingSize = static_cast<size_t>(tagStat.st_size);
+        // Files of size zero can't be mapped, they are just empty streams
+        if (mMappingSize)
+        {
+            // The mapping keeps the file open
+            void* mapping = mmap(0, mMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+                mMapping = mapping;
+        }
+        ::close(fd);
+        if (mMappingSize && !mMapping)
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Cannot map file: " + fullPath,
+                "MmapDataStream::MmapDataStream");
+        }
+#endif
+        mData = static_cast<uchar*>(mMapping);
+        mPos = mData;
+        mSize = mMappingSize;
+        mEnd = mData + mSize;
+    }
+    //-----------------------------------------------------------------------
+    MmapDataStream::~MmapDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::close(void)
+    {
+        mData = 0;
+        mPos = mEnd = 0;
+        // streams sharing the mapping still read from it, the last one unmaps
+        mClosePending = true;
+        if (mShareCount.get() == 0 && mClosePending.cas(true, false))
+            unmap();
+        MemoryDataStream::close();
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::releaseShare(void)
+    {
+        if (--mShareCount == 0 && mClosePending.cas(true, false))
+            unmap();
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::unmap(void)
+    {
+        if (mMapping)
+        {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            UnmapViewOfFile(mMapping);
+#elif OGRE_PLATFORM != OGRE_PLATFORM_WINRT && OGRE_PLATFORM != OGRE_PLATFORM_NACL && \
+    OGRE_PLATFORM != OGRE_PLATFORM_FLASHCC
+            munmap(mMapping, mMappingSize);
+#else
+            OGRE_FREE(mMapping, MEMCATEGORY_GENERAL);
+#endif
+            mMapping = 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mInStream(s), mFStreamRO(s), mFStream(0), mFreeOnClose(freeOnClose)
     {
@@ -84,6 +84,14 @@ namespace Ogre {
           mMaterialLodFactorTransformed(1.0f),
 		  mMinMaterialLodIndex(99),
 		  mMaxMaterialLodIndex(0), 		// Backwards, remember low value = high detail
+		  mAnimationLodIndex(0),
+		  mAnimationLodFactor(1.0f),
+		  mMinAnimationLodIndex(99),
+		  mMaxAnimationLodIndex(0),
+		  mAnimationLodPhase(0),
+		  mFrameAnimationLodEvaluated(std::numeric_limits<unsigned long>::max()),
+		  mAnimationLodBoneTransforms(NULL),
+		  mAnimationLodBlendPending(false),
           mSkeletonInstance(0),
 		  mInitialised(false),
 		  mLastParentXform(Matrix4::ZERO),
@@ -121,6 +129,14 @@ namespace Ogre {
         mMaterialLodFactorTransformed(1.0f),
 		mMinMaterialLodIndex(99),
 		mMaxMaterialLodIndex(0), 		// Backwards, remember low value = high detail
+		mAnimationLodIndex(0),
+		mAnimationLodFactor(1.0f),
+		mMinAnimationLodIndex(99),
+		mMaxAnimationLodIndex(0),
+		mAnimationLodPhase(FastHash(name.c_str(), static_cast<int>(name.size()))),
+		mFrameAnimationLodEvaluated(std::numeric_limits<unsigned long>::max()),
+		mAnimationLodBoneTransforms(NULL),
+		mAnimationLodBlendPending(false),
 		mSkeletonInstance(0),
 		mInitialised(false),
 		mLastParentXform(Matrix4::ZERO),
@@ -261,6 +277,9 @@ namespace Ogre {
 		if (mSkeletonInstance) {
 			OGRE_FREE_SIMD(mBoneWorldMatrices, MEMCATEGORY_ANIMATION);
             mBoneWorldMatrices = 0;
+			OGRE_FREE(mAnimationLodBoneTransforms, MEMCATEGORY_ANIMATION);
+			mAnimationLodBoneTransforms = 0;
+			mFrameAnimationLodEvaluated = std::numeric_limits<unsigned long>::max();
 
             if (mSharedSkeletonEntities) {
                 mSharedSkeletonEntities->erase(this);
@@ -424,6 +443,21 @@ namespace Ogre {
             // Change lod index
             mMeshLodIndex = evt.newLodIndex;
 
+            // Animation LOD, entities sharing a skeleton instance always use full detail
+            mAnimationLodIndex = 0;
+            if (hasSkeleton() && !mSharedSkeletonEntities &&
+                mSkeletonInstance->getNumAnimationLodLevels() > 1)
+            {
+                const LodStrategy *animationStrategy = mSkeletonInstance->getAnimationLodStrategy();
+                Real animationLodValue = animationStrategy == meshStrategy ?
+                    lodValue : animationStrategy->getValue(this, cam);
+                animationLodValue *= animationStrategy->transformBias(mAnimationLodFactor);
+
+                ushort newAnimationLodIndex = mSkeletonInstance->getAnimationLodIndex(animationLodValue);
+                newAnimationLodIndex = std::max(mMaxAnimationLodIndex, newAnimationLodIndex);
+                mAnimationLodIndex = std::min(mMinAnimationLodIndex, newAnimationLodIndex);
+            }
+
             // Now do material LOD
             lodValue *= mMaterialLodFactorTransformed;
 
@@ -784,9 +818,11 @@ namespace Ogre {
 		// since shadows only require positions
 		bool blendNormals = !hwAnimation || forcedNormals;
         // Animation dirty if animation state modified or manual bones modified
+        // or the bones are still being interpolated at a lower level of animation detail
         bool animationDirty =
             (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber()) ||
-            (hasSkeleton() && getSkeleton()->getManualBonesDirty());
+            (hasSkeleton() && getSkeleton()->getManualBonesDirty()) ||
+            mAnimationLodBlendPending;
 		
 		//update the current hardware animation state
 		mCurrentHWAnimationState = hwAnimation;
@@ -1354,9 +1390,19 @@ namespace Ogre {
         if ((*mFrameBonesLastUpdated != currentFrameNumber) ||
 			(hasSkeleton() && getSkeleton()->getManualBonesDirty()))
 		{
-			if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
-	            mSkeletonInstance->setAnimationState(*mAnimationState);
-            mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+			unsigned short updateInterval = getAnimationLodUpdateInterval();
+			if (updateInterval > 1)
+			{
+				cacheBoneMatricesAtLod(currentFrameNumber, updateInterval);
+			}
+			else
+			{
+				if ((!mSkipAnimStateUpdates) && (*mFrameBonesLastUpdated != currentFrameNumber))
+					mSkeletonInstance->_setAnimationState(*mAnimationState, mAnimationLodIndex);
+				mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+				mFrameAnimationLodEvaluated = std::numeric_limits<unsigned long>::max();
+				mAnimationLodBlendPending = false;
+			}
             *mFrameBonesLastUpdated  = currentFrameNumber;
 
 			return true;
@@ -1364,6 +1410,121 @@ namespace Ogre {
 		return false;
     }
     //-----------------------------------------------------------------------
+    unsigned short Entity::getAnimationLodUpdateInterval(void) const
+    {
+        // Manually driven skeletons are evaluated whenever they change
+        if (!mAnimationLodIndex || mSharedSkeletonEntities || mSkipAnimStateUpdates ||
+            mSkeletonInstance->getManualBonesDirty())
+            return 1;
+
+        return mSkeletonInstance->getAnimationLodLevel(mAnimationLodIndex).updateInterval;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::cacheBoneMatricesAtLod(unsigned long frameNumber, unsigned short updateInterval)
+    {
+        if (!mAnimationLodBoneTransforms)
+        {
+            mAnimationLodBoneTransforms = OGRE_ALLOC_T(AnimationLodBoneTransform,
+                mNumBoneMatrices * 2, MEMCATEGORY_ANIMATION);
+        }
+        AnimationLodBoneTransform* previous = mAnimationLodBoneTransforms;
+        AnimationLodBoneTransform* latest = mAnimationLodBoneTransforms + mNumBoneMatrices;
+
+        // Whether the displayed pose comes from the recent evaluations
+        bool continuous = mFrameAnimationLodEvaluated != std::numeric_limits<unsigned long>::max() &&
+            frameNumber - mFrameAnimationLodEvaluated <= updateInterval;
+
+        // Evaluate once per interval, in frames spread by the phase of the entity
+        if (!continuous || frameNumber - mFrameAnimationLodEvaluated == updateInterval ||
+            (frameNumber + mAnimationLodPhase) % updateInterval == 0)
+        {
+            // Carry on from the displayed pose, so the bones do not jump
+            if (continuous)
+            {
+                for (unsigned short i = 0; i < mNumBoneMatrices; ++i)
+                {
+                    mBoneMatrices[i].decomposition(
+                        previous[i].position, previous[i].scale, previous[i].orientation);
+                }
+            }
+
+            mSkeletonInstance->_setAnimationState(*mAnimationState, mAnimationLodIndex);
+            mSkeletonInstance->_getBoneMatrices(mBoneMatrices);
+            // Bone matrices have no shearing, so they decompose exactly
+            for (unsigned short i = 0; i < mNumBoneMatrices; ++i)
+            {
+                mBoneMatrices[i].decomposition(
+                    latest[i].position, latest[i].scale, latest[i].orientation);
+            }
+            if (!continuous)
+                std::copy(latest, latest + mNumBoneMatrices, previous);
+            mFrameAnimationLodEvaluated = frameNumber;
+        }
+
+        // Reach the evaluated pose just before the next evaluation. The transforms
+        // are interpolated rather than the matrices, which would shrink the bones
+        // while they rotate.
+        Real t = std::min(Real(1),
+            Real(frameNumber - mFrameAnimationLodEvaluated + 1) / updateInterval);
+        for (unsigned short i = 0; i < mNumBoneMatrices; ++i)
+        {
+            const AnimationLodBoneTransform& from = previous[i];
+            const AnimationLodBoneTransform& to = latest[i];
+            mBoneMatrices[i].makeTransform(
+                from.position + (to.position - from.position) * t,
+                from.scale + (to.scale - from.scale) * t,
+                Quaternion::nlerp(t, from.orientation, to.orientation, true));
+        }
+        mAnimationLodBlendPending = t < 1;
+    }
+    //-----------------------------------------------------------------------
+    bool Entity::_isBoneMatricesUpdatePending(void) const
+    {
+        if (!mInitialised || !hasSkeleton() || !isInScene() || !isVisible() ||
+            isParentTagPoint())
+            return false;
+
+        // Manual LOD entities have their own skeletons
+        if (mMeshLodIndex > 0 && mMesh->isLodManual())
+            return false;
+
+        // Manual bone changes are applied on top of the animation when rendering
+        if (mSkeletonInstance->getManualBonesDirty())
+            return false;
+
+        // Animated since last evaluated, and evaluated in the previous frame
+        unsigned long currentFrameNumber = Root::getSingleton().getNextFrameNumber();
+        return (mFrameAnimationLastUpdated != mAnimationState->getDirtyFrameNumber() ||
+            mAnimationLodBlendPending) &&
+            currentFrameNumber > 0 && *mFrameBonesLastUpdated == currentFrameNumber - 1;
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_prepareBoneMatricesUpdate(void)
+    {
+        if (!mSkipAnimStateUpdates)
+        {
+            // Animations are shared by every instance of the skeleton
+            ConstEnabledAnimationStateIterator it =
+                mAnimationState->getEnabledAnimationStateIterator();
+            while (it.hasMoreElements())
+            {
+                Animation* anim = mSkeletonInstance->_getAnimationImpl(
+                    it.getNext()->getAnimationName());
+                if (anim)
+                    anim->_buildCaches();
+            }
+        }
+
+        // Tag points read the transform of the parent node, which may be
+        // shared with other entities
+        _getParentNodeFullTransform();
+    }
+    //-----------------------------------------------------------------------
+    void Entity::_updateBoneMatrices(void)
+    {
+        cacheBoneMatrices();
+    }
+    //-----------------------------------------------------------------------
     void Entity::setDisplaySkeleton(bool display)
     {
         mDisplaySkeleton = display;
@@ -1403,6 +1564,13 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void Entity::setAnimationLodBias(Real factor, ushort maxDetailIndex, ushort minDetailIndex)
+    {
+        mAnimationLodFactor = factor;
+        mMaxAnimationLodIndex = maxDetailIndex;
+        mMinAnimationLodIndex = minDetailIndex;
+    }
+    //-----------------------------------------------------------------------
     void Entity::buildSubEntityList(MeshPtr& mesh, SubEntityList* sublist)
     {
         // Create SubEntities
@@ -2265,6 +2433,9 @@ namespace Ogre {
         {
             OGRE_DELETE mSkeletonInstance;
             OGRE_FREE_SIMD(mBoneMatrices, MEMCATEGORY_ANIMATION);
+            OGRE_FREE(mAnimationLodBoneTransforms, MEMCATEGORY_ANIMATION);
+            mAnimationLodBoneTransforms = 0;
+            mAnimationLodIndex = 0;
             OGRE_DELETE mAnimationState;
 			// using OGRE_FREE since unsigned long is not a destructor
 			OGRE_FREE(mFrameBonesLastUpdated, MEMCATEGORY_ANIMATION);
@@ -2302,6 +2473,7 @@ namespace Ogre {
         {
             mSkeletonInstance = OGRE_NEW SkeletonInstance(mMesh->getSkeleton());
             mSkeletonInstance->load();
+            mFrameAnimationLodEvaluated = std::numeric_limits<unsigned long>::max();
             mAnimationState = OGRE_NEW AnimationStateSet();
             mMesh->_initAnimationState(mAnimationState);
             mFrameBonesLastUpdated = OGRE_NEW_T(unsigned long, MEMCATEGORY_ANIMATION)(std::numeric_limits<unsigned long>::max());
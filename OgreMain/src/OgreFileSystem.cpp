@@ -58,6 +58,7 @@ THE SOFTWARE.
 namespace Ogre {
 
 	bool FileSystemArchive::msIgnoreHidden = true;
+	bool FileSystemArchive::msUseMemoryMapping = false;
 
     //-----------------------------------------------------------------------
     FileSystemArchive::FileSystemArchive(const String& name, const String& archType, bool readOnly )
@@ -228,6 +229,11 @@ namespace Ogre {
                         "FileSystemArchive::open");
         }
 
+		if (readOnly && msUseMemoryMapping)
+		{
+			return DataStreamPtr(OGRE_NEW MmapDataStream(filename, full_path));
+		}
+
 		if (!readOnly)
 		{
 			mode |= std::ios::out;
@@ -41,6 +41,8 @@ THE SOFTWARE.
 #include "OgreHardwareIndexBuffer.h"
 #include "OgreMaterialManager.h"
 #include "OgreRenderSystem.h"
+#include "OgreOptimisedUtil.h"
+#include "OgrePlatformInformation.h"
 
 namespace Ogre {
 
@@ -314,6 +316,130 @@ namespace Ogre {
         }
 
         return true;
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::getCullingPlanes(CullingPlanes& planes) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        planes.numPlanes = 0;
+        for (int plane = 0; plane < 6; ++plane)
+        {
+            // Skip far plane if infinite view frustum
+            if (plane == FRUSTUM_PLANE_FAR && mFarDist == 0)
+                continue;
+
+            planes.planes[planes.numPlanes++] = mFrustumPlanes[plane];
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const
+    {
+        CullingPlanes planes;
+        getCullingPlanes(planes);
+        planes.isVisible(bounds, count, visibilities);
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const
+    {
+        CullingPlanes planes;
+        getCullingPlanes(planes);
+        planes.isVisible(bounds, count, visibilities);
+    }
+    //-----------------------------------------------------------------------
+    bool CullingPlanes::isVisible(const AxisAlignedBox& bound) const
+    {
+        // Null boxes always invisible
+        if (bound.isNull()) return false;
+
+        // Infinite boxes always visible
+        if (bound.isInfinite()) return true;
+
+        Vector3 centre = bound.getCenter();
+        Vector3 halfSize = bound.getHalfSize();
+        for (size_t plane = 0; plane < numPlanes; ++plane)
+        {
+            if (planes[plane].getSide(centre, halfSize) == Plane::NEGATIVE_SIDE)
+                return false;
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void CullingPlanes::isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const
+    {
+        // Transpose the boxes to streams on the stack a batch at a time
+        const size_t BATCH_SIZE = 64;
+        OGRE_SIMD_ALIGNED_DECL(Real, centres[3][BATCH_SIZE]);
+        OGRE_SIMD_ALIGNED_DECL(Real, halfSizes[3][BATCH_SIZE]);
+        const Real* const centreStreams[3] = { centres[0], centres[1], centres[2] };
+        const Real* const halfSizeStreams[3] = { halfSizes[0], halfSizes[1], halfSizes[2] };
+
+        for (size_t first = 0; first < count; first += BATCH_SIZE)
+        {
+            size_t batchSize = std::min(count - first, BATCH_SIZE);
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                const AxisAlignedBox& bound = *bounds[first + i];
+                if (bound.isFinite())
+                {
+                    Vector3 centre = bound.getCenter();
+                    Vector3 halfSize = bound.getHalfSize();
+                    centres[0][i] = centre.x;
+                    centres[1][i] = centre.y;
+                    centres[2][i] = centre.z;
+                    halfSizes[0][i] = halfSize.x;
+                    halfSizes[1][i] = halfSize.y;
+                    halfSizes[2][i] = halfSize.z;
+                }
+                else
+                {
+                    // Fixed up below
+                    centres[0][i] = centres[1][i] = centres[2][i] = 0;
+                    halfSizes[0][i] = halfSizes[1][i] = halfSizes[2][i] = 0;
+                }
+            }
+
+            OptimisedUtil::getImplementation()->calculateBoxesVisibility(
+                planes, numPlanes, centreStreams, halfSizeStreams,
+                visibilities + first, batchSize);
+
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                const AxisAlignedBox& bound = *bounds[first + i];
+                // Null boxes always invisible, infinite boxes always visible
+                if (bound.isNull())
+                    visibilities[first + i] = false;
+                else if (bound.isInfinite())
+                    visibilities[first + i] = true;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void CullingPlanes::isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const
+    {
+        // Transpose the spheres to streams on the stack a batch at a time
+        const size_t BATCH_SIZE = 64;
+        OGRE_SIMD_ALIGNED_DECL(Real, centres[3][BATCH_SIZE]);
+        OGRE_SIMD_ALIGNED_DECL(Real, radii[BATCH_SIZE]);
+        const Real* const centreStreams[3] = { centres[0], centres[1], centres[2] };
+
+        for (size_t first = 0; first < count; first += BATCH_SIZE)
+        {
+            size_t batchSize = std::min(count - first, BATCH_SIZE);
+            for (size_t i = 0; i < batchSize; ++i)
+            {
+                const Sphere& bound = *bounds[first + i];
+                centres[0][i] = bound.getCenter().x;
+                centres[1][i] = bound.getCenter().y;
+                centres[2][i] = bound.getCenter().z;
+                radii[i] = bound.getRadius();
+            }
+
+            OptimisedUtil::getImplementation()->calculateSpheresVisibility(
+                planes, numPlanes, centreStreams, radii,
+                visibilities + first, batchSize);
+        }
     }
 	//---------------------------------------------------------------------
 	uint32 Frustum::getTypeFlags(void) const
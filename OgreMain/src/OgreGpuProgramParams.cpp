@@ -236,6 +236,228 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	//  GpuNamedConstants methods
 	//---------------------------------------------------------------------
+	GpuNamedConstants::GpuNamedConstants(const GpuNamedConstants& rhs)
+		: mBufferLayoutsDirty(true)
+	{
+		*this = rhs;
+	}
+	//---------------------------------------------------------------------
+	GpuNamedConstants& GpuNamedConstants::operator=(const GpuNamedConstants& rhs)
+	{
+		floatBufferSize = rhs.floatBufferSize;
+		doubleBufferSize = rhs.doubleBufferSize;
+		intBufferSize = rhs.intBufferSize;
+		map = rhs.map;
+		bufferLayouts = rhs.bufferLayouts;
+		// The hash index points into the map so is not copied
+		OGRE_LOCK_MUTEX(mBufferLayoutsMutex)
+		mHashIndex.clear();
+		mBufferLayoutsDirty = true;
+		return *this;
+	}
+	//---------------------------------------------------------------------
+	void GpuNamedConstants::_markBufferLayoutsDirty(void)
+	{
+		OGRE_LOCK_MUTEX(mBufferLayoutsMutex)
+		mBufferLayoutsDirty = true;
+	}
+	//---------------------------------------------------------------------
+	size_t GpuNamedConstants::addBufferLayout(size_t size)
+	{
+		bufferLayouts.push_back(GpuConstantBufferLayout(size));
+		_markBufferLayoutsDirty();
+		return bufferLayouts.size() - 1;
+	}
+	//---------------------------------------------------------------------
+	void GpuNamedConstants::addBufferConstant(size_t bufferIndex, const String& name, 
+		size_t offset, size_t size)
+	{
+		if (bufferIndex >= bufferLayouts.size())
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Buffer index out of bounds.",
+				"GpuNamedConstants::addBufferConstant");
+		if (map.find(name) == map.end())
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Parameter called " + name + " does not exist.",
+				"GpuNamedConstants::addBufferConstant");
+
+		GpuConstantBufferLayout& layout = bufferLayouts[bufferIndex];
+		if (offset + size > layout.size || 
+			(!layout.entries.empty() && offset < layout.entries.back().offset + layout.entries.back().size))
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
+				"Parameter " + name + " overlaps the previous one or the end of the buffer.",
+				"GpuNamedConstants::addBufferConstant");
+
+		GpuConstantBufferLayout::Entry entry;
+		entry.name = name;
+		entry.offset = offset;
+		entry.size = size;
+		layout.entries.push_back(entry);
+		_markBufferLayoutsDirty();
+	}
+	//---------------------------------------------------------------------
+	/// Byte size of the elements of the physical buffer holding a constant type
+	static size_t getPhysicalElementSize(GpuConstantType constType)
+	{
+		if (GpuConstantDefinition::isFloat(constType))
+			return sizeof(float);
+		else if (GpuConstantDefinition::isDouble(constType))
+			return sizeof(double);
+		else
+			return sizeof(int);
+	}
+	//---------------------------------------------------------------------
+	/// Points the logical index of a constant at its new physical index
+	static void updateLogicalToPhysical(GpuLogicalBufferStruct* logicalToPhysical,
+		const GpuConstantDefinition& def)
+	{
+		if (!logicalToPhysical)
+			return;
+		OGRE_LOCK_MUTEX(logicalToPhysical->mutex)
+		GpuLogicalIndexUseMap::iterator i = logicalToPhysical->map.find(def.logicalIndex);
+		if (i != logicalToPhysical->map.end())
+			i->second.physicalIndex = def.physicalIndex;
+	}
+	//---------------------------------------------------------------------
+	void GpuNamedConstants::mirrorBufferLayouts(GpuLogicalBufferStruct* floatLogicalToPhysical,
+		GpuLogicalBufferStruct* doubleLogicalToPhysical, GpuLogicalBufferStruct* intLogicalToPhysical)
+	{
+		// Array entries are aliases of the constants they belong to
+		set<String>::type buffered;
+		for (GpuConstantBufferLayoutList::iterator b = bufferLayouts.begin(); b != bufferLayouts.end(); ++b)
+		{
+			for (GpuConstantBufferLayout::EntryList::iterator e = b->entries.begin(); e != b->entries.end(); ++e)
+				buffered.insert(e->name);
+		}
+
+		// Constants in no buffer keep their place at the start of the physical buffers
+		size_t floatEnd = 0, doubleEnd = 0, intEnd = 0;
+		for (GpuConstantDefinitionMap::const_iterator i = map.begin(); i != map.end(); ++i)
+		{
+			if (buffered.count(i->first.substr(0, i->first.find('['))) || i->second.isSampler())
+				continue;
+			size_t end = i->second.physicalIndex + i->second.elementSize * i->second.arraySize;
+			size_t& typeEnd = i->second.isFloat() ? floatEnd : (i->second.isDouble() ? doubleEnd : intEnd);
+			typeEnd = std::max(typeEnd, end);
+		}
+
+		for (GpuConstantBufferLayoutList::iterator b = bufferLayouts.begin(); b != bufferLayouts.end(); ++b)
+		{
+			bool usesFloat = false, usesDouble = false, usesInt = false;
+			for (GpuConstantBufferLayout::EntryList::iterator e = b->entries.begin(); e != b->entries.end(); ++e)
+			{
+				GpuConstantDefinition& def = map[e->name];
+				size_t elementBytes = getPhysicalElementSize(def.constType);
+				size_t base = def.isFloat() ? floatEnd : (def.isDouble() ? doubleEnd : intEnd);
+				(def.isFloat() ? usesFloat : (def.isDouble() ? usesDouble : usesInt)) = true;
+				def.physicalIndex = base + e->offset / elementBytes;
+				updateLogicalToPhysical(def.isFloat() ? floatLogicalToPhysical :
+					(def.isDouble() ? doubleLogicalToPhysical : intLogicalToPhysical), def);
+
+				for (size_t a = 0; a < def.arraySize; ++a)
+				{
+					GpuConstantDefinitionMap::iterator arrayEntry = 
+						map.find(e->name + "[" + StringConverter::toString(a) + "]");
+					if (arrayEntry != map.end())
+						arrayEntry->second.physicalIndex = def.physicalIndex + a * def.elementSize;
+				}
+			}
+			// Each physical buffer used gets a region the size of the whole buffer
+			if (usesFloat)
+				floatEnd += (b->size + sizeof(float) - 1) / sizeof(float);
+			if (usesDouble)
+				doubleEnd += (b->size + sizeof(double) - 1) / sizeof(double);
+			if (usesInt)
+				intEnd += (b->size + sizeof(int) - 1) / sizeof(int);
+		}
+
+		floatBufferSize = floatEnd;
+		doubleBufferSize = doubleEnd;
+		intBufferSize = intEnd;
+		if (floatLogicalToPhysical)
+		{
+			OGRE_LOCK_MUTEX(floatLogicalToPhysical->mutex)
+			floatLogicalToPhysical->bufferSize = floatEnd;
+		}
+		if (doubleLogicalToPhysical)
+		{
+			OGRE_LOCK_MUTEX(doubleLogicalToPhysical->mutex)
+			doubleLogicalToPhysical->bufferSize = doubleEnd;
+		}
+		if (intLogicalToPhysical)
+		{
+			OGRE_LOCK_MUTEX(intLogicalToPhysical->mutex)
+			intLogicalToPhysical->bufferSize = intEnd;
+		}
+		_markBufferLayoutsDirty();
+	}
+	//---------------------------------------------------------------------
+	void GpuNamedConstants::updateBufferLayouts(void) const
+	{
+		if (!mBufferLayoutsDirty && mHashIndex.size() == map.size())
+			return;
+
+		mHashIndex.clear();
+		for (GpuConstantDefinitionMap::const_iterator i = map.begin(); i != map.end(); ++i)
+			mHashIndex[i->first] = &i->second;
+
+		for (GpuConstantBufferLayoutList::iterator b = bufferLayouts.begin(); b != bufferLayouts.end(); ++b)
+		{
+			b->blocks.clear();
+			for (GpuConstantBufferLayout::EntryList::const_iterator e = b->entries.begin(); e != b->entries.end(); ++e)
+			{
+				ConstantDefinitionHashMap::const_iterator found = mHashIndex.find(e->name);
+				if (found == mHashIndex.end())
+					continue;
+				const GpuConstantDefinition* def = found->second;
+				size_t elementBytes = getPhysicalElementSize(def->constType);
+				size_t size = std::min(e->size, def->elementSize * def->arraySize * elementBytes);
+
+				// Extend the previous block when the padding between the constants is
+				// the same in the buffer and the physical buffer
+				if (!b->blocks.empty())
+				{
+					GpuConstantBufferLayout::Block& last = b->blocks.back();
+					if (GpuConstantDefinition::isFloat(last.constType) == def->isFloat() &&
+						getPhysicalElementSize(last.constType) == elementBytes &&
+						def->physicalIndex >= last.physicalIndex &&
+						(def->physicalIndex - last.physicalIndex) * elementBytes == e->offset - last.offset)
+					{
+						last.size = e->offset + size - last.offset;
+						continue;
+					}
+				}
+
+				GpuConstantBufferLayout::Block block;
+				block.offset = e->offset;
+				block.size = size;
+				block.physicalIndex = def->physicalIndex;
+				block.constType = def->constType;
+				b->blocks.push_back(block);
+			}
+		}
+		mBufferLayoutsDirty = false;
+	}
+	//---------------------------------------------------------------------
+	const GpuConstantBufferLayout& GpuNamedConstants::getBufferLayout(size_t bufferIndex) const
+	{
+		assert(bufferIndex < bufferLayouts.size());
+		OGRE_LOCK_MUTEX(mBufferLayoutsMutex)
+		updateBufferLayouts();
+		return bufferLayouts[bufferIndex];
+	}
+	//---------------------------------------------------------------------
+	const GpuConstantDefinition* GpuNamedConstants::findConstantDefinition(const String& name) const
+	{
+		if (bufferLayouts.empty())
+		{
+			GpuConstantDefinitionMap::const_iterator i = map.find(name);
+			return i == map.end() ? 0 : &i->second;
+		}
+
+		OGRE_LOCK_MUTEX(mBufferLayoutsMutex)
+		updateBufferLayouts();
+		ConstantDefinitionHashMap::const_iterator i = mHashIndex.find(name);
+		return i == mHashIndex.end() ? 0 : i->second;
+	}
 	void GpuNamedConstants::save(const String& filename) const
 	{
 		GpuNamedConstantsSerializer ser;
@@ -322,6 +544,7 @@ namespace Ogre
 
 		// simple file structure, no chunks
 		pDest->map.clear();
+		pDest->_markBufferLayoutsDirty();
 
 		readInts(stream, ((uint32*)&pDest->floatBufferSize), 1);
 		readInts(stream, ((uint32*)&pDest->intBufferSize), 1);
@@ -749,6 +972,8 @@ namespace Ogre
 		, mTransposeMatrices(false)
 		, mIgnoreMissingParams(false)
 		, mActivePassIterationIndex(std::numeric_limits<size_t>::max())	
+		, mAutoParamsSource(0)
+		, mUpdatedVariability(0)
 	{
 	}
 	//-----------------------------------------------------------------------------
@@ -775,6 +1000,8 @@ namespace Ogre
 		mTransposeMatrices = oth.mTransposeMatrices;
 		mIgnoreMissingParams  = oth.mIgnoreMissingParams;
 		mActivePassIterationIndex = oth.mActivePassIterationIndex;
+		mAutoParamsSource = oth.mAutoParamsSource;
+		mUpdatedVariability = oth.mUpdatedVariability;
 
 		return *this;
 	}
@@ -1194,6 +1421,168 @@ namespace Ogre
 			return (uint16)GPV_GLOBAL;
 		};
 
+	}
+	//---------------------------------------------------------------------
+	uint16 GpuProgramParameters::deriveInputs(GpuProgramParameters::AutoConstantType act)
+	{
+		switch(act)
+		{
+		case ACT_VIEW_MATRIX:
+		case ACT_INVERSE_VIEW_MATRIX:
+		case ACT_TRANSPOSE_VIEW_MATRIX:
+		case ACT_INVERSE_TRANSPOSE_VIEW_MATRIX:
+		case ACT_PROJECTION_MATRIX:
+		case ACT_INVERSE_PROJECTION_MATRIX:
+		case ACT_TRANSPOSE_PROJECTION_MATRIX:
+		case ACT_INVERSE_TRANSPOSE_PROJECTION_MATRIX:
+		case ACT_VIEWPROJ_MATRIX:
+		case ACT_INVERSE_VIEWPROJ_MATRIX:
+		case ACT_TRANSPOSE_VIEWPROJ_MATRIX:
+		case ACT_INVERSE_TRANSPOSE_VIEWPROJ_MATRIX:
+			// The render system may alter the projection for the viewport
+			return (uint16)GPI_CAMERA | (uint16)GPI_VIEWPORT;
+
+		case ACT_CAMERA_POSITION:
+		case ACT_LOD_CAMERA_POSITION:
+		case ACT_VIEW_DIRECTION:
+		case ACT_VIEW_SIDE_VECTOR:
+		case ACT_VIEW_UP_VECTOR:
+		case ACT_FOV:
+		case ACT_NEAR_CLIP_DISTANCE:
+		case ACT_FAR_CLIP_DISTANCE:
+
+			return (uint16)GPI_CAMERA;
+
+		case ACT_WORLD_MATRIX:
+		case ACT_INVERSE_WORLD_MATRIX:
+		case ACT_TRANSPOSE_WORLD_MATRIX:
+		case ACT_INVERSE_TRANSPOSE_WORLD_MATRIX:
+		case ACT_WORLD_MATRIX_ARRAY_3x4:
+		case ACT_WORLD_MATRIX_ARRAY:
+		case ACT_WORLD_DUALQUATERNION_ARRAY_2x4:
+		case ACT_WORLD_SCALE_SHEAR_MATRIX_ARRAY_3x4:
+		case ACT_CAMERA_POSITION_OBJECT_SPACE:
+		case ACT_LOD_CAMERA_POSITION_OBJECT_SPACE:
+			// World matrices are relative to the camera with camera relative rendering
+			return (uint16)GPI_RENDERABLE | (uint16)GPI_CAMERA;
+
+		case ACT_WORLDVIEW_MATRIX:
+		case ACT_INVERSE_WORLDVIEW_MATRIX:
+		case ACT_TRANSPOSE_WORLDVIEW_MATRIX:
+		case ACT_INVERSE_TRANSPOSE_WORLDVIEW_MATRIX:
+		case ACT_WORLDVIEWPROJ_MATRIX:
+		case ACT_INVERSE_WORLDVIEWPROJ_MATRIX:
+		case ACT_TRANSPOSE_WORLDVIEWPROJ_MATRIX:
+		case ACT_INVERSE_TRANSPOSE_WORLDVIEWPROJ_MATRIX:
+
+			return (uint16)GPI_RENDERABLE | (uint16)GPI_CAMERA | (uint16)GPI_VIEWPORT;
+
+		case ACT_RENDER_TARGET_FLIPPING:
+		case ACT_VIEWPORT_WIDTH:
+		case ACT_VIEWPORT_HEIGHT:
+		case ACT_INVERSE_VIEWPORT_WIDTH:
+		case ACT_INVERSE_VIEWPORT_HEIGHT:
+		case ACT_VIEWPORT_SIZE:
+		case ACT_TEXEL_OFFSETS:
+
+			return (uint16)GPI_VIEWPORT;
+
+		case ACT_AMBIENT_LIGHT_COLOUR:
+		case ACT_FOG_COLOUR:
+		case ACT_FOG_PARAMS:
+		case ACT_SHADOW_COLOUR:
+
+			return (uint16)GPI_SCENE;
+
+		case ACT_DERIVED_AMBIENT_LIGHT_COLOUR:
+		case ACT_DERIVED_SCENE_COLOUR:
+
+			return (uint16)GPI_SCENE | (uint16)GPI_PASS;
+
+		case ACT_SURFACE_AMBIENT_COLOUR:
+		case ACT_SURFACE_DIFFUSE_COLOUR:
+		case ACT_SURFACE_SPECULAR_COLOUR:
+		case ACT_SURFACE_EMISSIVE_COLOUR:
+		case ACT_SURFACE_SHININESS:
+		case ACT_TEXTURE_SIZE:
+		case ACT_INVERSE_TEXTURE_SIZE:
+		case ACT_PACKED_TEXTURE_SIZE:
+		case ACT_TEXTURE_MATRIX:
+		case ACT_PASS_NUMBER:
+
+			return (uint16)GPI_PASS;
+
+		case ACT_SCENE_DEPTH_RANGE:
+
+			return (uint16)GPI_SCENE | (uint16)GPI_CAMERA;
+
+		case ACT_LIGHT_COUNT:
+		case ACT_LIGHT_DIFFUSE_COLOUR:
+		case ACT_LIGHT_SPECULAR_COLOUR:
+		case ACT_LIGHT_POSITION:
+		case ACT_LIGHT_DIRECTION:
+		case ACT_LIGHT_POSITION_VIEW_SPACE:
+		case ACT_LIGHT_DIRECTION_VIEW_SPACE:
+		case ACT_LIGHT_POWER_SCALE:
+		case ACT_LIGHT_DIFFUSE_COLOUR_POWER_SCALED:
+		case ACT_LIGHT_SPECULAR_COLOUR_POWER_SCALED:
+		case ACT_LIGHT_NUMBER:
+		case ACT_LIGHT_CASTS_SHADOWS:
+		case ACT_LIGHT_ATTENUATION:
+		case ACT_SPOTLIGHT_PARAMS:
+		case ACT_LIGHT_DIFFUSE_COLOUR_ARRAY:
+		case ACT_LIGHT_SPECULAR_COLOUR_ARRAY:
+		case ACT_LIGHT_DIFFUSE_COLOUR_POWER_SCALED_ARRAY:
+		case ACT_LIGHT_SPECULAR_COLOUR_POWER_SCALED_ARRAY:
+		case ACT_LIGHT_POSITION_ARRAY:
+		case ACT_LIGHT_DIRECTION_ARRAY:
+		case ACT_LIGHT_POSITION_VIEW_SPACE_ARRAY:
+		case ACT_LIGHT_DIRECTION_VIEW_SPACE_ARRAY:
+		case ACT_LIGHT_POWER_SCALE_ARRAY:
+		case ACT_LIGHT_ATTENUATION_ARRAY:
+		case ACT_SPOTLIGHT_PARAMS_ARRAY:
+		case ACT_SPOTLIGHT_VIEWPROJ_MATRIX:
+		case ACT_SPOTLIGHT_VIEWPROJ_MATRIX_ARRAY:
+			// Light positions are relative to the camera with camera relative rendering
+			return (uint16)GPI_LIGHTS | (uint16)GPI_CAMERA;
+
+		case ACT_LIGHT_POSITION_OBJECT_SPACE:
+		case ACT_LIGHT_DIRECTION_OBJECT_SPACE:
+		case ACT_LIGHT_DISTANCE_OBJECT_SPACE:
+		case ACT_LIGHT_POSITION_OBJECT_SPACE_ARRAY:
+		case ACT_LIGHT_DIRECTION_OBJECT_SPACE_ARRAY:
+		case ACT_LIGHT_DISTANCE_OBJECT_SPACE_ARRAY:
+		case ACT_SPOTLIGHT_WORLDVIEWPROJ_MATRIX:
+		case ACT_SHADOW_EXTRUSION_DISTANCE:
+
+			return (uint16)GPI_LIGHTS | (uint16)GPI_CAMERA | (uint16)GPI_RENDERABLE;
+
+		case ACT_DERIVED_LIGHT_DIFFUSE_COLOUR:
+		case ACT_DERIVED_LIGHT_SPECULAR_COLOUR:
+		case ACT_DERIVED_LIGHT_DIFFUSE_COLOUR_ARRAY:
+		case ACT_DERIVED_LIGHT_SPECULAR_COLOUR_ARRAY:
+
+			return (uint16)GPI_LIGHTS | (uint16)GPI_PASS;
+
+		case ACT_TEXTURE_VIEWPROJ_MATRIX:
+		case ACT_TEXTURE_VIEWPROJ_MATRIX_ARRAY:
+
+			return (uint16)GPI_TEXTURE_PROJECTORS | (uint16)GPI_CAMERA;
+
+		case ACT_TEXTURE_WORLDVIEWPROJ_MATRIX:
+		case ACT_TEXTURE_WORLDVIEWPROJ_MATRIX_ARRAY:
+
+			return (uint16)GPI_TEXTURE_PROJECTORS | (uint16)GPI_CAMERA | (uint16)GPI_RENDERABLE;
+
+		case ACT_SHADOW_SCENE_DEPTH_RANGE:
+
+			return (uint16)GPI_TEXTURE_PROJECTORS | (uint16)GPI_SCENE;
+
+		default:
+			// Time based, custom and render system state, always recalculated
+			return 0;
+		};
+
 	}
 	//---------------------------------------------------------------------
 	GpuLogicalIndexUse* GpuProgramParameters::_getFloatConstantLogicalIndexUse(
@@ -1290,6 +1679,7 @@ namespace Ogre
 							i->second.physicalIndex += insertCount;
 					}
 					mNamedConstants->floatBufferSize += insertCount;
+					mNamedConstants->_markBufferLayoutsDirty();
 				}
 
 				logi->second.currentSize += insertCount;
@@ -1397,6 +1787,7 @@ namespace Ogre
 							i->second.physicalIndex += insertCount;
 					}
 					mNamedConstants->doubleBufferSize += insertCount;
+					mNamedConstants->_markBufferLayoutsDirty();
 				}
                 
 				logi->second.currentSize += insertCount;
@@ -1626,19 +2017,12 @@ namespace Ogre
 			return 0;
 		}
 
-		GpuConstantDefinitionMap::const_iterator i = mNamedConstants->map.find(name);
-		if (i == mNamedConstants->map.end())
-		{
-			if (throwExceptionIfNotFound)
-				OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
-				"Parameter called " + name + " does not exist. ",
-				"GpuProgramParameters::_findNamedConstantDefinition");
-			return 0;
-		}
-		else
-		{
-			return &(i->second);
-		}
+		const GpuConstantDefinition* def = mNamedConstants->findConstantDefinition(name);
+		if (!def && throwExceptionIfNotFound)
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
+			"Parameter called " + name + " does not exist. ",
+			"GpuProgramParameters::_findNamedConstantDefinition");
+		return def;
 	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::setAutoConstant(size_t index, AutoConstantType acType, size_t extraInfo)
@@ -1678,6 +2062,8 @@ namespace Ogre
 				i->data = extraInfo;
 				i->elementCount = elementSize;
 				i->variability = variability;
+				i->inputs = deriveInputs(acType);
+				i->version = 0;
 				found = true;
 				break;
 			}
@@ -1728,6 +2114,8 @@ namespace Ogre
 				i->fData = rData;
 				i->elementCount = elementSize;
 				i->variability = variability;
+				i->inputs = deriveInputs(acType);
+				i->version = 0;
 				found = true;
 				break;
 			}
@@ -1817,9 +2205,33 @@ namespace Ogre
 	}
 	//-----------------------------------------------------------------------------
 
+	//-----------------------------------------------------------------------------
+	void GpuProgramParameters::_copyConstantBuffer(size_t bufferIndex, void* dest) const
+	{
+		if (mNamedConstants.isNull())
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, 
+			"Named constants have not been initialised, perhaps a compile error.",
+			"GpuProgramParameters::_copyConstantBuffer");
+
+		const GpuConstantBufferLayout& layout = mNamedConstants->getBufferLayout(bufferIndex);
+		char* buffer = static_cast<char*>(dest);
+		for (GpuConstantBufferLayout::BlockList::const_iterator b = layout.blocks.begin(); 
+			b != layout.blocks.end(); ++b)
+		{
+			const void* src;
+			if (GpuConstantDefinition::isFloat(b->constType))
+				src = &mFloatConstants[b->physicalIndex];
+			else if (GpuConstantDefinition::isDouble(b->constType))
+				src = &mDoubleConstants[b->physicalIndex];
+			else
+				src = &mIntConstants[b->physicalIndex];
+			memcpy(buffer + b->offset, src, b->size);
+		}
+	}
 	//-----------------------------------------------------------------------------
 	void GpuProgramParameters::_updateAutoParams(const AutoParamDataSource* source, uint16 mask)
 	{
+		mUpdatedVariability = 0;
 		// abort early if no autos
 		if (!hasAutoConstants()) return; 
 		// abort early if variability doesn't match any param
@@ -1838,12 +2250,23 @@ namespace Ogre
 
 		mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
+		// Values calculated from another source tell nothing about this one
+		bool sourceChanged = source != mAutoParamsSource;
+		mAutoParamsSource = source;
+		uint64 version = source->getLatestInputVersion();
+
 		// Autoconstant index is not a physical index
-		for (AutoConstantList::const_iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
+		for (AutoConstantList::iterator i = mAutoConstants.begin(); i != mAutoConstants.end(); ++i)
 		{
 			// Only update needed slots
 			if (i->variability & mask)
 			{
+				// Skip slots whose inputs have not changed since they were calculated
+				if (i->inputs && !sourceChanged && source->getInputVersion(i->inputs) <= i->version)
+					continue;
+				i->version = version;
+				mUpdatedVariability |= i->variability;
+
 
 				switch(i->paramType)
 				{
@@ -2753,6 +3176,7 @@ namespace Ogre
 		mIntConstants = source.getIntConstantList();
 		mAutoConstants = source.getAutoConstantList();
 		mCombinedVariability = source.mCombinedVariability;
+		mAutoParamsSource = source.mAutoParamsSource;
 		copySharedParamSetUsage(source.mSharedParamSets);
 	}
 	//---------------------------------------------------------------------
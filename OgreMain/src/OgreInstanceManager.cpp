@@ -490,6 +490,9 @@ namespace Ogre
 	//-----------------------------------------------------------------------
 	void InstanceManager::_addDirtyBatch( InstanceBatch *dirtyBatch )
 	{
+		// May be called from several threads by the parallel scene graph update
+		OGRE_LOCK_MUTEX(mDirtyBatchesMutex)
+
 		if( mDirtyBatches.empty() )
 			mSceneManager->_addDirtyInstanceManager( this );
 
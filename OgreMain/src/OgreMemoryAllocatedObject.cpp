@@ -50,6 +50,9 @@ namespace Ogre
 	template class AllocatedObject<ResourceAllocPolicy>;
 	template class AllocatedObject<ScriptingAllocPolicy>;
 	template class AllocatedObject<RenderSysAllocPolicy>; 
+	template class AllocatedObject<AnimationPooledAllocPolicy>;
+	template class AllocatedObject<SceneCtlPooledAllocPolicy>;
+	template class AllocatedObject<SceneObjPooledAllocPolicy>;
 
 
 
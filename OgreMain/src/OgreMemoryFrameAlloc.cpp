@@ -0,0 +1,196 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePrerequisites.h"
+#include "OgreMemoryFrameAlloc.h"
+#include "OgrePlatformInformation.h"
+#include "OgreBitwise.h"
+
+namespace Ogre
+{
+	namespace
+	{
+		/// The single chunk allocations are carved from
+		char* sChunk = 0;
+		size_t sCapacity = 0;
+		/// Offset of the first free byte in the chunk
+		size_t sOffset = 0;
+		size_t sChunkSize = 64 * 1024;
+		/// Allocations which did not fit in the chunk, freed on rewind
+		vector<void*>::type sOverflow;
+		size_t sLiveAllocations = 0;
+		size_t sBytesAllocated = 0;
+		/// Highest number of bytes allocated at once since the last rewind
+		size_t sHighWater = 0;
+		/// Highest number of bytes allocated at once since the last reset
+		size_t sPeakBytesAllocated = 0;
+
+		OGRE_STATIC_MUTEX(msArenaMutex)
+
+		void freeChunk()
+		{
+			OGRE_FREE_SIMD(sChunk, MEMCATEGORY_GENERAL);
+			sChunk = 0;
+			sCapacity = 0;
+		}
+
+		/// Make all memory available again, must only be called with nothing in use
+		void rewind()
+		{
+			for (vector<void*>::type::iterator i = sOverflow.begin(); i != sOverflow.end(); ++i)
+			{
+				OGRE_FREE_SIMD(*i, MEMCATEGORY_GENERAL);
+			}
+			sOverflow.clear();
+
+			// Grow the chunk so that everything needed since the last rewind fits in it
+			if (sChunk && sHighWater > sCapacity)
+			{
+				freeChunk();
+				size_t newSize = ((sHighWater + sChunkSize - 1) / sChunkSize) * sChunkSize;
+				sChunk = static_cast<char*>(OGRE_MALLOC_SIMD(newSize, MEMCATEGORY_GENERAL));
+				sCapacity = newSize;
+			}
+			sOffset = 0;
+			sBytesAllocated = 0;
+			sHighWater = 0;
+		}
+	}
+	//---------------------------------------------------------------------
+	void* FrameArena::allocate(size_t count, size_t alignment)
+	{
+		if (!alignment)
+			alignment = OGRE_SIMD_ALIGNMENT;
+		assert(alignment <= 128 && Bitwise::isPO2(alignment));
+
+		OGRE_LOCK_MUTEX(msArenaMutex)
+
+		if (!sChunk)
+		{
+			sCapacity = std::max(sChunkSize, count + alignment);
+			sChunk = static_cast<char*>(OGRE_MALLOC_SIMD(sCapacity, MEMCATEGORY_GENERAL));
+		}
+
+		void* ret;
+		size_t base = reinterpret_cast<size_t>(sChunk);
+		size_t start = ((base + sOffset + alignment - 1) & ~(alignment - 1)) - base;
+		if (start + count <= sCapacity)
+		{
+			ret = sChunk + start;
+			sBytesAllocated += start + count - sOffset;
+			sOffset = start + count;
+		}
+		else
+		{
+			// Over-allocate so that any alignment can be honoured
+			size_t size = count + alignment;
+			char* block = static_cast<char*>(OGRE_MALLOC_SIMD(size, MEMCATEGORY_GENERAL));
+			sOverflow.push_back(block);
+			size_t blockBase = reinterpret_cast<size_t>(block);
+			ret = block + (((blockBase + alignment - 1) & ~(alignment - 1)) - blockBase);
+			sBytesAllocated += size;
+		}
+
+		++sLiveAllocations;
+		sHighWater = std::max(sHighWater, sBytesAllocated);
+		sPeakBytesAllocated = std::max(sPeakBytesAllocated, sBytesAllocated);
+		return ret;
+	}
+	//---------------------------------------------------------------------
+	void FrameArena::deallocate(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		OGRE_LOCK_MUTEX(msArenaMutex)
+
+		assert(sLiveAllocations && "Memory given back to the frame arena more than once");
+		if (--sLiveAllocations == 0)
+			rewind();
+	}
+	//---------------------------------------------------------------------
+	void FrameArena::reset(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+
+		// Anything still in use has been kept beyond its frame, so nothing
+		// can be reclaimed until that is given back too
+		if (!sLiveAllocations)
+			rewind();
+		sPeakBytesAllocated = sBytesAllocated;
+	}
+	//---------------------------------------------------------------------
+	void FrameArena::releaseMemory(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+
+		if (!sLiveAllocations)
+		{
+			sHighWater = 0;
+			rewind();
+			freeChunk();
+			sPeakBytesAllocated = 0;
+		}
+	}
+	//---------------------------------------------------------------------
+	void FrameArena::setChunkSize(size_t size)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+		sChunkSize = std::max(size, static_cast<size_t>(OGRE_SIMD_ALIGNMENT));
+	}
+	//---------------------------------------------------------------------
+	size_t FrameArena::getChunkSize(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+		return sChunkSize;
+	}
+	//---------------------------------------------------------------------
+	size_t FrameArena::getCapacity(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+		return sCapacity;
+	}
+	//---------------------------------------------------------------------
+	size_t FrameArena::getBytesAllocated(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+		return sBytesAllocated;
+	}
+	//---------------------------------------------------------------------
+	size_t FrameArena::getPeakBytesAllocated(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+		return sPeakBytesAllocated;
+	}
+	//---------------------------------------------------------------------
+	size_t FrameArena::getNumLiveAllocations(void)
+	{
+		OGRE_LOCK_MUTEX(msArenaMutex)
+		return sLiveAllocations;
+	}
+}
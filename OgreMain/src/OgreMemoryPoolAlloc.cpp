@@ -0,0 +1,200 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+	namespace
+	{
+		/// Size classes are this many bytes apart
+		const size_t SIZE_STEP = 16;
+		/// Slabs are at least this big, and hold at least MIN_SLAB_SLOTS slots
+		const size_t MIN_SLAB_SIZE = 16 * 1024;
+		const size_t MIN_SLAB_SLOTS = 8;
+
+		struct FreeSlot
+		{
+			FreeSlot* next;
+		};
+	}
+	//---------------------------------------------------------------------
+	struct FixedSizePoolSet::Pool
+	{
+		/// Distance between slots, including the header
+		size_t stride;
+		size_t slotsPerSlab;
+		SlabAllocFunc allocSlab;
+		SlabFreeFunc freeSlab;
+		vector<char*>::type slabs;
+		/// Slots given back, linked through their memory
+		FreeSlot* freeList;
+		/// Slots of the newest slab which have never been used
+		char* fresh;
+		char* freshEnd;
+		size_t numSlots;
+		size_t numSlotsInUse;
+		OGRE_MUTEX(mutex)
+
+		Pool()
+			: stride(0), slotsPerSlab(0), allocSlab(0), freeSlab(0), freeList(0)
+			, fresh(0), freshEnd(0), numSlots(0), numSlotsInUse(0) {}
+
+		void* allocate()
+		{
+			OGRE_LOCK_MUTEX(mutex)
+
+			char* slot;
+			if (freeList)
+			{
+				slot = reinterpret_cast<char*>(freeList) - HEADER_SIZE;
+				freeList = freeList->next;
+			}
+			else
+			{
+				if (fresh == freshEnd)
+				{
+					size_t slabSize = stride * slotsPerSlab;
+					fresh = static_cast<char*>(allocSlab(slabSize));
+					freshEnd = fresh + slabSize;
+					slabs.push_back(fresh);
+					numSlots += slotsPerSlab;
+				}
+				slot = fresh;
+				fresh += stride;
+				*reinterpret_cast<Pool**>(slot) = this;
+			}
+			++numSlotsInUse;
+			return slot + HEADER_SIZE;
+		}
+
+		void deallocate(void* ptr)
+		{
+			OGRE_LOCK_MUTEX(mutex)
+
+			FreeSlot* freeSlot = static_cast<FreeSlot*>(ptr);
+			freeSlot->next = freeList;
+			freeList = freeSlot;
+			--numSlotsInUse;
+		}
+
+		void releaseMemory()
+		{
+			OGRE_LOCK_MUTEX(mutex)
+
+			for (vector<char*>::type::iterator i = slabs.begin(); i != slabs.end(); ++i)
+			{
+				freeSlab(*i);
+			}
+			slabs.clear();
+			freeList = 0;
+			fresh = freshEnd = 0;
+			numSlots = 0;
+		}
+	};
+	//---------------------------------------------------------------------
+	FixedSizePoolSet::FixedSizePoolSet(size_t maxSlotSize, SlabAllocFunc allocSlab,
+		SlabFreeFunc freeSlab)
+		: mPools(0)
+		, mNumPools((maxSlotSize + SIZE_STEP - 1) / SIZE_STEP)
+		, mMaxSlotSize(maxSlotSize)
+	{
+		mPools = OGRE_NEW_ARRAY_T(Pool, mNumPools, MEMCATEGORY_GENERAL);
+		for (size_t i = 0; i < mNumPools; ++i)
+		{
+			Pool& pool = mPools[i];
+			pool.stride = HEADER_SIZE + (i + 1) * SIZE_STEP;
+			pool.slotsPerSlab = std::max(MIN_SLAB_SLOTS, MIN_SLAB_SIZE / pool.stride);
+			pool.allocSlab = allocSlab;
+			pool.freeSlab = freeSlab;
+		}
+	}
+	//---------------------------------------------------------------------
+	FixedSizePoolSet::~FixedSizePoolSet()
+	{
+		bool inUse = false;
+		for (size_t i = 0; i < mNumPools; ++i)
+		{
+			if (mPools[i].numSlotsInUse)
+				inUse = true;
+			else
+				mPools[i].releaseMemory();
+		}
+		// Slots still in use point back to their pool
+		if (!inUse)
+			OGRE_DELETE_ARRAY_T(mPools, Pool, mNumPools, MEMCATEGORY_GENERAL);
+	}
+	//---------------------------------------------------------------------
+	void* FixedSizePoolSet::allocate(size_t count)
+	{
+		assert(count <= mMaxSlotSize);
+		size_t index = count ? (count - 1) / SIZE_STEP : 0;
+		return mPools[index].allocate();
+	}
+	//---------------------------------------------------------------------
+	void FixedSizePoolSet::deallocate(void* ptr)
+	{
+		if (!ptr)
+			return;
+		Pool* pool = *reinterpret_cast<Pool**>(static_cast<char*>(ptr) - HEADER_SIZE);
+		assert(pool && "Memory was not allocated from a pool");
+		pool->deallocate(ptr);
+	}
+	//---------------------------------------------------------------------
+	bool FixedSizePoolSet::isPooled(const void* ptr)
+	{
+		return *reinterpret_cast<Pool* const*>(static_cast<const char*>(ptr) - HEADER_SIZE) != 0;
+	}
+	//---------------------------------------------------------------------
+	void FixedSizePoolSet::_markUnpooled(void* block)
+	{
+		*static_cast<Pool**>(block) = 0;
+	}
+	//---------------------------------------------------------------------
+	size_t FixedSizePoolSet::getNumSlotsInUse(void) const
+	{
+		size_t ret = 0;
+		for (size_t i = 0; i < mNumPools; ++i)
+		{
+			OGRE_LOCK_MUTEX(mPools[i].mutex)
+			ret += mPools[i].numSlotsInUse;
+		}
+		return ret;
+	}
+	//---------------------------------------------------------------------
+	size_t FixedSizePoolSet::getNumSlots(void) const
+	{
+		size_t ret = 0;
+		for (size_t i = 0; i < mNumPools; ++i)
+		{
+			OGRE_LOCK_MUTEX(mPools[i].mutex)
+			ret += mPools[i].numSlots;
+		}
+		return ret;
+	}
+}
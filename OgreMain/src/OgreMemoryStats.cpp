@@ -0,0 +1,213 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgrePrerequisites.h"
+
+#if OGRE_MEMORY_STATS
+
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+#	include <intrin.h>
+#	pragma intrinsic(_InterlockedCompareExchangePointer)
+#	define OGRE_STATS_THREAD_LOCAL __declspec(thread)
+#else
+#	define OGRE_STATS_THREAD_LOCAL __thread
+#endif
+
+namespace Ogre
+{
+	namespace
+	{
+		/** Counters updated by a single thread.
+		@remarks
+			They only ever grow, so that memory freed by another thread than
+			the one which allocated it still adds up once all threads are
+			summed. They are allocated with malloc, since they are needed while
+			allocating through Ogre, and are kept until shutdown as there is
+			no portable way to learn that a thread has finished.
+		*/
+		struct ThreadCounters
+		{
+			size_t allocations[MEMCATEGORY_COUNT];
+			size_t deallocations[MEMCATEGORY_COUNT];
+			size_t bytesAllocated[MEMCATEGORY_COUNT];
+			size_t bytesDeallocated[MEMCATEGORY_COUNT];
+			ThreadCounters* next;
+		};
+
+		/** Adds to a counter of the calling thread.
+		@remarks
+			Each counter has a single writer, so a relaxed load and store is
+			enough for aggregate never to read a torn value, without the cost
+			of an atomic add.
+		*/
+		inline void addToCounter(size_t& counter, size_t value)
+		{
+#if OGRE_THREAD_SUPPORT == 0
+			counter += value;
+#elif OGRE_COMPILER == OGRE_COMPILER_MSVC
+			// Aligned word sized accesses are atomic on the supported platforms
+			*static_cast<volatile size_t*>(&counter) = counter + value;
+#else
+			__atomic_store_n(&counter, counter + value, __ATOMIC_RELAXED);
+#endif
+		}
+
+		/// Reads a counter which another thread may be adding to
+		inline size_t readCounter(const size_t& counter)
+		{
+#if OGRE_THREAD_SUPPORT == 0
+			return counter;
+#elif OGRE_COMPILER == OGRE_COMPILER_MSVC
+			return *static_cast<const volatile size_t*>(&counter);
+#else
+			return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+#endif
+		}
+
+		OGRE_STATS_THREAD_LOCAL ThreadCounters* tlsCounters = 0;
+		/// The counters of all threads, only ever pushed to
+		ThreadCounters* volatile sCounterList = 0;
+
+		struct Totals
+		{
+			size_t peakBytes[MEMCATEGORY_COUNT];
+			size_t allocationsAtFrameStart[MEMCATEGORY_COUNT];
+			size_t frameAllocations[MEMCATEGORY_COUNT];
+		};
+		Totals sTotals;
+		OGRE_STATIC_MUTEX(msTotalsMutex)
+
+		bool pushCounters(ThreadCounters* head, ThreadCounters* counters)
+		{
+#if OGRE_THREAD_SUPPORT == 0
+			sCounterList = counters;
+			return true;
+#elif OGRE_COMPILER == OGRE_COMPILER_MSVC
+			return _InterlockedCompareExchangePointer(
+				reinterpret_cast<void* volatile*>(&sCounterList), counters, head) == head;
+#else
+			return __sync_bool_compare_and_swap(&sCounterList, head, counters);
+#endif
+		}
+
+		ThreadCounters* getThreadCounters()
+		{
+			ThreadCounters* counters = tlsCounters;
+			if (!counters)
+			{
+				counters = static_cast<ThreadCounters*>(calloc(1, sizeof(ThreadCounters)));
+				ThreadCounters* head;
+				do
+				{
+					head = sCounterList;
+					counters->next = head;
+				} while (!pushCounters(head, counters));
+				tlsCounters = counters;
+			}
+			return counters;
+		}
+
+		/** Sum the counters of all threads, must be called with the totals locked.
+		@remarks
+			The threads keep counting while they are summed, so memory moving
+			between threads meanwhile may be counted as freed but not yet
+			allocated. The live counts are only exact when no other thread
+			allocates, and are kept from going below zero otherwise.
+		*/
+		MemoryCategoryStats aggregate(size_t category)
+		{
+			size_t allocations = 0, deallocations = 0, bytesAllocated = 0, bytesDeallocated = 0;
+			for (ThreadCounters* c = sCounterList; c; c = c->next)
+			{
+				allocations += readCounter(c->allocations[category]);
+				deallocations += readCounter(c->deallocations[category]);
+				bytesAllocated += readCounter(c->bytesAllocated[category]);
+				bytesDeallocated += readCounter(c->bytesDeallocated[category]);
+			}
+
+			MemoryCategoryStats ret;
+			ret.liveBytes = bytesAllocated > bytesDeallocated ? bytesAllocated - bytesDeallocated : 0;
+			ret.liveAllocations = allocations > deallocations ? allocations - deallocations : 0;
+			ret.totalAllocations = allocations;
+			sTotals.peakBytes[category] = std::max(sTotals.peakBytes[category], ret.liveBytes);
+			ret.peakBytes = sTotals.peakBytes[category];
+			ret.frameAllocations = sTotals.frameAllocations[category];
+			return ret;
+		}
+	}
+	//---------------------------------------------------------------------
+	MemoryCategoryStats MemoryStats::getStats(MemoryCategory category)
+	{
+		OGRE_LOCK_MUTEX(msTotalsMutex)
+		return aggregate(category);
+	}
+	//---------------------------------------------------------------------
+	MemoryCategoryStats MemoryStats::getTotalStats(void)
+	{
+		OGRE_LOCK_MUTEX(msTotalsMutex)
+		MemoryCategoryStats ret;
+		for (size_t i = 0; i < MEMCATEGORY_COUNT; ++i)
+		{
+			MemoryCategoryStats stats = aggregate(i);
+			ret.liveBytes += stats.liveBytes;
+			ret.liveAllocations += stats.liveAllocations;
+			// The categories need not peak at the same time
+			ret.peakBytes += stats.peakBytes;
+			ret.totalAllocations += stats.totalAllocations;
+			ret.frameAllocations += stats.frameAllocations;
+		}
+		return ret;
+	}
+	//---------------------------------------------------------------------
+	void MemoryStats::_recordAlloc(MemoryCategory category, size_t bytes)
+	{
+		ThreadCounters* counters = getThreadCounters();
+		addToCounter(counters->allocations[category], 1);
+		addToCounter(counters->bytesAllocated[category], bytes);
+	}
+	//---------------------------------------------------------------------
+	void MemoryStats::_recordDealloc(MemoryCategory category, size_t bytes)
+	{
+		ThreadCounters* counters = getThreadCounters();
+		addToCounter(counters->deallocations[category], 1);
+		addToCounter(counters->bytesDeallocated[category], bytes);
+	}
+	//---------------------------------------------------------------------
+	void MemoryStats::_frameEnded(void)
+	{
+		OGRE_LOCK_MUTEX(msTotalsMutex)
+		for (size_t i = 0; i < MEMCATEGORY_COUNT; ++i)
+		{
+			size_t allocations = aggregate(i).totalAllocations;
+			sTotals.frameAllocations[i] = allocations - sTotals.allocationsAtFrameStart[i];
+			sTotals.allocationsAtFrameStart[i] = allocations;
+		}
+	}
+}
+
+#endif
@@ -45,6 +45,7 @@ namespace Ogre {
 
     NameGenerator Node::msNameGenerator("Unnamed_");
 	Node::QueuedUpdates Node::msQueuedUpdates;
+	AtomicScalar<unsigned long> Node::msHierarchyRevision(0);
     //-----------------------------------------------------------------------
     Node::Node()
 		:mParent(0),
@@ -146,6 +147,8 @@ namespace Ogre {
 		bool different = (parent != mParent);
 
         mParent = parent;
+        if (different)
+            ++msHierarchyRevision;
         // Request update from parent
 		mParentNotified = false ;
         needUpdate();
@@ -216,6 +219,36 @@ namespace Ogre {
             mChildrenToUpdate.clear();
             mNeedChildUpdate = false;
         }
+    }
+    //-----------------------------------------------------------------------
+    bool Node::_updateAndGatherChildren(vector<Node*>::type& children, bool parentHasChanged)
+    {
+        mParentNotified = false;
+
+        if (mNeedParentUpdate || parentHasChanged)
+        {
+            _updateFromParent();
+        }
+
+        bool updateAll = mNeedChildUpdate || parentHasChanged;
+        if (updateAll)
+        {
+            ChildNodeMap::iterator it, itend;
+            itend = mChildren.end();
+            for (it = mChildren.begin(); it != itend; ++it)
+            {
+                children.push_back(it->second);
+            }
+        }
+        else
+        {
+            children.insert(children.end(), mChildrenToUpdate.begin(), mChildrenToUpdate.end());
+        }
+
+        mChildrenToUpdate.clear();
+        mNeedChildUpdate = false;
+
+        return updateAll;
     }
 	//-----------------------------------------------------------------------
 	void Node::_updateFromParent(void) const
@@ -43,6 +43,9 @@ namespace Ogre {
     extern OptimisedUtil* _getOptimisedUtilGeneral(void);
 #if __OGRE_HAVE_SSE
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
+#if __OGRE_HAVE_AVX
+    extern OptimisedUtil* _getOptimisedUtilAVX(void);
+#endif
 //#elif __OGRE_HAVE_NEON
 //    extern OptimisedUtil* _getOptimisedUtilNEON(void);
 //#elif __OGRE_HAVE_VFP
@@ -52,6 +55,17 @@ namespace Ogre {
     extern OptimisedUtil* _getOptimisedUtilDirectXMath(void);
 #endif
 
+#if __OGRE_HAVE_AVX
+    //---------------------------------------------------------------------
+    // The AVX implementation needs both AVX2 and FMA, and falls back to SSE
+    static bool _hasAVXSupport(void)
+    {
+        const uint features = PlatformInformation::CPU_FEATURE_SSE |
+            PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+        return (PlatformInformation::getCpuFeatures() & features) == features;
+    }
+#endif
+
 #ifdef __DO_PROFILE__
     //---------------------------------------------------------------------
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
@@ -86,6 +100,9 @@ namespace Ogre {
             IMPL_DEFAULT,
 #if __OGRE_HAVE_SSE
             IMPL_SSE,
+#if __OGRE_HAVE_AVX
+            IMPL_AVX,
+#endif
 //#elif __OGRE_HAVE_NEON
 //            IMPL_NEON,
 //#elif __OGRE_HAVE_VFP
@@ -136,6 +153,12 @@ namespace Ogre {
             {
                 mOptimisedUtils.push_back(_getOptimisedUtilSSE());
             }
+#if __OGRE_HAVE_AVX
+            if (_hasAVXSupport())
+            {
+                mOptimisedUtils.push_back(_getOptimisedUtilAVX());
+            }
+#endif
 //#elif __OGRE_HAVE_VFP
 //            if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_VFP)
 //            {
@@ -347,6 +370,122 @@ namespace Ogre {
             ++index;    // So we can put break point here even if in release build
         }
 
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->concatenateNodeTransforms(
+                parentTransforms,
+                localTransforms,
+                inheritOrientation,
+                inheritScale,
+                derivedTransforms,
+                numNodes);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoneMatrices
+        virtual void calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->calculateBoneMatrices(
+                derivedTransforms,
+                bindingPoseInverses,
+                dstMatrices,
+                numBones);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoxesVisibility
+        virtual void calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->calculateBoxesVisibility(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                visibilities,
+                numBoxes);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
+        /// @copydoc OptimisedUtil::calculateSpheresVisibility
+        virtual void calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres)
+        {
+            static ProfileItems results;
+            static size_t index;
+            index = Root::getSingleton().getNextFrameNumber() % mOptimisedUtils.size();
+            OptimisedUtil* impl = mOptimisedUtils[index];
+            ProfileItem& profile = results[index];
+
+            profile.begin();
+            impl->calculateSpheresVisibility(
+                planes,
+                numPlanes,
+                centres,
+                radii,
+                visibilities,
+                numSpheres);
+            profile.end();
+
+            // You can put break point here while running test application, to
+            // watch profile results.
+            ++index;    // So we can put break point here even if in release build
+        }
+
     };
 #endif // __DO_PROFILE__
 
@@ -400,6 +539,13 @@ namespace Ogre {
 
 #else   // !__DO_PROFILE__
 
+#if __OGRE_HAVE_AVX
+        if (_hasAVXSupport())
+        {
+            return _getOptimisedUtilAVX();
+        }
+        else
+#endif  // __OGRE_HAVE_AVX
 #if __OGRE_HAVE_SSE
         if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
         {
@@ -429,5 +575,27 @@ namespace Ogre {
 
 #endif  // __DO_PROFILE__
     }
+    //---------------------------------------------------------------------
+    OptimisedUtil::NamedImplementationList OptimisedUtil::getAvailableImplementations(void)
+    {
+        NamedImplementationList implementations;
+        implementations.push_back(NamedImplementation("General", _getOptimisedUtilGeneral()));
+#if __OGRE_HAVE_SSE
+        if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
+        {
+            implementations.push_back(NamedImplementation("SSE", _getOptimisedUtilSSE()));
+        }
+#if __OGRE_HAVE_AVX
+        if (_hasAVXSupport())
+        {
+            implementations.push_back(NamedImplementation("AVX", _getOptimisedUtilAVX()));
+        }
+#endif
+#endif  // __OGRE_HAVE_SSE
+#if __OGRE_HAVE_DIRECTXMATH
+        implementations.push_back(NamedImplementation("DirectXMath", _getOptimisedUtilDirectXMath()));
+#endif
+        return implementations;
+    }
 
 }
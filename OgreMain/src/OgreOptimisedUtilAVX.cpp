@@ -0,0 +1,699 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgreOptimisedUtil.h"
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_AVX
+
+#include "OgreMatrix4.h"
+
+#include <immintrin.h>
+
+//-------------------------------------------------------------------------
+//
+// Unlike the SSE implementation, the routines in this file are not built by
+// compiling the whole file for the instruction set. Each function using AVX
+// is marked with __OGRE_AVX_TARGET instead, so the inline functions of the
+// headers included here are never emitted with AVX instructions, which
+// would break them for the CPUs without AVX when the linker happens to pick
+// this copy.
+//
+// Anything not worth an AVX version is forwarded to the SSE implementation.
+//
+//-------------------------------------------------------------------------
+
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+#   define __OGRE_AVX_TARGET
+#else
+#   define __OGRE_AVX_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+namespace Ogre {
+
+    extern OptimisedUtil* _getOptimisedUtilSSE(void);
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX2 and FMA implementation of OptimisedUtil.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX : public OptimisedUtil
+    {
+    protected:
+        /// The implementation used for the functions without an AVX version
+        OptimisedUtil* mFallback;
+
+    public:
+        OptimisedUtilAVX(OptimisedUtil* fallback)
+            : mFallback(fallback)
+        {
+        }
+
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        virtual void __OGRE_AVX_TARGET softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Matrix4* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        virtual void __OGRE_AVX_TARGET softwareVertexMorph(
+            Real t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals);
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        virtual void __OGRE_AVX_TARGET concatenateAffineMatrices(
+            const Matrix4& baseMatrix,
+            const Matrix4* srcMatrices,
+            Matrix4* dstMatrices,
+            size_t numMatrices);
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        virtual void __OGRE_AVX_TARGET calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles);
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        virtual void __OGRE_AVX_TARGET calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces);
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        virtual void __OGRE_AVX_TARGET extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes)
+        {
+            mFallback->concatenateNodeTransforms(
+                parentTransforms, localTransforms,
+                inheritOrientation, inheritScale,
+                derivedTransforms, numNodes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoneMatrices
+        virtual void calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones)
+        {
+            mFallback->calculateBoneMatrices(
+                derivedTransforms, bindingPoseInverses, dstMatrices, numBones);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoxesVisibility
+        virtual void calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes)
+        {
+            mFallback->calculateBoxesVisibility(
+                planes, numPlanes, centres, halfSizes, visibilities, numBoxes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateSpheresVisibility
+        virtual void calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres)
+        {
+            mFallback->calculateSpheresVisibility(
+                planes, numPlanes, centres, radii, visibilities, numSpheres);
+        }
+    };
+
+//---------------------------------------------------------------------
+// AVX helpers.
+//---------------------------------------------------------------------
+
+    /// Combine two 128 bits vectors into the low and high halves of a 256 bits one
+    static FORCEINLINE __OGRE_AVX_TARGET __m256 _combineAVX(const __m128& lo, const __m128& hi)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    /// Mask selecting the first count lanes, for the masked loads and stores
+    static FORCEINLINE __OGRE_AVX_TARGET __m256i _firstLanesMaskAVX(size_t count)
+    {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)count),
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    /// Mask selecting x, y and z, to access packed vectors without touching the next float
+    static FORCEINLINE __OGRE_AVX_TARGET __m128i _vector3MaskAVX(void)
+    {
+        return _mm_setr_epi32(-1, -1, -1, 0);
+    }
+
+    /// Normalise the x, y, z vector like Vector3::normalise, w must be zero
+    static FORCEINLINE __OGRE_AVX_TARGET __m128 _normaliseVector3AVX(const __m128& v)
+    {
+        __m128 length = _mm_sqrt_ps(_mm_dp_ps(v, v, 0x7F));
+        if (_mm_cvtss_f32(length) > 1e-08f)
+            return _mm_div_ps(v, length);
+        return v;
+    }
+
+    /** Transpose eight packed (x, y, z) vectors to three vectors of x, y
+        and z. The order of the vectors in the results is shuffled, but
+        _storeVector3x8AVX puts them back in place.
+    */
+    static FORCEINLINE __OGRE_AVX_TARGET void _loadVector3x8AVX(const float* p,
+        __m256& x, __m256& y, __m256& z)
+    {
+        __m256 m03 = _combineAVX(_mm_loadu_ps(p + 0), _mm_loadu_ps(p + 12));
+        __m256 m14 = _combineAVX(_mm_loadu_ps(p + 4), _mm_loadu_ps(p + 16));
+        __m256 m25 = _combineAVX(_mm_loadu_ps(p + 8), _mm_loadu_ps(p + 20));
+
+        __m256 xy = _mm256_shuffle_ps(m14, m25, _MM_SHUFFLE(2, 1, 3, 2));
+        __m256 yz = _mm256_shuffle_ps(m03, m14, _MM_SHUFFLE(1, 0, 2, 1));
+        x = _mm256_shuffle_ps(m03, xy, _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        z = _mm256_shuffle_ps(yz, m25, _MM_SHUFFLE(3, 0, 3, 1));
+    }
+
+    /// Inverse of _loadVector3x8AVX
+    static FORCEINLINE __OGRE_AVX_TARGET void _storeVector3x8AVX(float* p,
+        const __m256& x, const __m256& y, const __m256& z)
+    {
+        __m256 xy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 yz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256 zx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+
+        __m256 m03 = _mm256_shuffle_ps(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 m14 = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m256 m25 = _mm256_shuffle_ps(zx, yz, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm_storeu_ps(p + 0, _mm256_castps256_ps128(m03));
+        _mm_storeu_ps(p + 4, _mm256_castps256_ps128(m14));
+        _mm_storeu_ps(p + 8, _mm256_castps256_ps128(m25));
+        _mm_storeu_ps(p + 12, _mm256_extractf128_ps(m03, 1));
+        _mm_storeu_ps(p + 16, _mm256_extractf128_ps(m14, 1));
+        _mm_storeu_ps(p + 20, _mm256_extractf128_ps(m25, 1));
+    }
+
+    /** Transform a pair of (x, y, z, w) vectors, one in each half, by the
+        first three rows of a pair of matrices, giving (x, y, z, 0) vectors.
+    */
+    static FORCEINLINE __OGRE_AVX_TARGET __m256 _transformVector4PairAVX(
+        const __m256& row0, const __m256& row1, const __m256& row2, const __m256& v)
+    {
+        __m256 xy = _mm256_hadd_ps(_mm256_mul_ps(row0, v), _mm256_mul_ps(row1, v));
+        __m256 z = _mm256_hadd_ps(_mm256_mul_ps(row2, v), _mm256_setzero_ps());
+        return _mm256_hadd_ps(xy, z);
+    }
+
+    /** Load a (x, y, z, 0) vector without reading the float after it.
+    @remarks
+        Cheaper than _mm_maskload_ps for a single vector.
+    */
+    static FORCEINLINE __OGRE_AVX_TARGET __m128 _loadVector3AVX(const float* p)
+    {
+        return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd((const double*)p)), _mm_load_ss(p + 2));
+    }
+
+    /// Store the x, y, z of a vector without writing the float after it
+    static FORCEINLINE __OGRE_AVX_TARGET void _storeVector3AVX(float* p, const __m128& v)
+    {
+        _mm_store_sd((double*)p, _mm_castps_pd(v));
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+
+    // Map to convert 4-bits mask to 4 byte values
+    static const char msMaskMappingAVX[16][4] =
+    {
+        {0, 0, 0, 0},   {1, 0, 0, 0},   {0, 1, 0, 0},   {1, 1, 0, 0},
+        {0, 0, 1, 0},   {1, 0, 1, 0},   {0, 1, 1, 0},   {1, 1, 1, 0},
+        {0, 0, 0, 1},   {1, 0, 0, 1},   {0, 1, 0, 1},   {1, 1, 0, 1},
+        {0, 0, 1, 1},   {1, 0, 1, 1},   {0, 1, 1, 1},   {1, 1, 1, 1},
+    };
+
+    /** Software skinning of positions only, two vertices at a time, see
+        OptimisedUtil::softwareVertexSkinning.
+    @remarks
+        The weight count is a template parameter for the common counts, so
+        that collapsing the blend matrices gets unrolled. Zero means that
+        numWeightsPerVertex is used instead.
+    */
+    template <size_t fixedNumWeights>
+    static __OGRE_AVX_TARGET void _softwareVertexSkinningAVX(
+        const float *pSrcPos, float *pDestPos,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Matrix4* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        const size_t numWeights = fixedNumWeights ? fixedNumWeights : numWeightsPerVertex;
+
+        // Two vertices are skinned at once, one in each 128 bits half of the
+        // registers, so that collapsing their blend matrices takes one FMA
+        // per row and weight for both
+        for (size_t vertIdx = 0; vertIdx < numVertices; vertIdx += 2)
+        {
+            // An odd last vertex is skinned as both halves, but stored once
+            bool hasSecond = vertIdx + 1 < numVertices;
+            ptrdiff_t next = hasSecond ? 1 : 0;
+            const float* pBlendWeight2 = rawOffsetPointer(pBlendWeight, next * blendWeightStride);
+            const unsigned char* pBlendIndex2 = rawOffsetPointer(pBlendIndex, next * blendIndexStride);
+
+            // Collapse the blend matrices, only the first three rows are used
+            __m256 m0 = _mm256_setzero_ps();
+            __m256 m1 = _mm256_setzero_ps();
+            __m256 m2 = _mm256_setzero_ps();
+            for (size_t blendIdx = 0; blendIdx < numWeights; ++blendIdx)
+            {
+                const Matrix4& mat1 = *blendMatrices[pBlendIndex[blendIdx]];
+                const Matrix4& mat2 = *blendMatrices[pBlendIndex2[blendIdx]];
+                __m256 weight = _combineAVX(
+                    _mm_broadcast_ss(pBlendWeight + blendIdx), _mm_broadcast_ss(pBlendWeight2 + blendIdx));
+                m0 = _mm256_fmadd_ps(_combineAVX(_mm_loadu_ps(mat1[0]), _mm_loadu_ps(mat2[0])), weight, m0);
+                m1 = _mm256_fmadd_ps(_combineAVX(_mm_loadu_ps(mat1[1]), _mm_loadu_ps(mat2[1])), weight, m1);
+                m2 = _mm256_fmadd_ps(_combineAVX(_mm_loadu_ps(mat1[2]), _mm_loadu_ps(mat2[2])), weight, m2);
+            }
+
+            // Transform the positions (x, y, z, 1)
+            const float* pSrcPos2 = rawOffsetPointer(pSrcPos, next * srcPosStride);
+            __m256 pos = _combineAVX(_loadVector3AVX(pSrcPos), _loadVector3AVX(pSrcPos2));
+            pos = _mm256_blend_ps(pos, _mm256_set1_ps(1.0f), 0x88);
+            __m256 result = _transformVector4PairAVX(m0, m1, m2, pos);
+            _storeVector3AVX(pDestPos, _mm256_castps256_ps128(result));
+            if (hasSecond)
+                _storeVector3AVX(rawOffsetPointer(pDestPos, destPosStride), _mm256_extractf128_ps(result, 1));
+
+            advanceRawPointer(pSrcPos, 2 * srcPosStride);
+            advanceRawPointer(pDestPos, 2 * destPosStride);
+            advanceRawPointer(pBlendWeight, 2 * blendWeightStride);
+            advanceRawPointer(pBlendIndex, 2 * blendIndexStride);
+        }
+    }
+
+//---------------------------------------------------------------------
+// OptimisedUtilAVX implementation.
+//---------------------------------------------------------------------
+
+    void OptimisedUtilAVX::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Matrix4* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        if (pSrcNorm)
+        {
+            // Normals need transposing to be renormalised four at a time,
+            // which the SSE implementation does best: with them, skinning
+            // two vertices per 256 bits register measured slower than it
+            mFallback->softwareVertexSkinning(pSrcPos, pDestPos,
+                pSrcNorm, pDestNorm, pBlendWeight, pBlendIndex, blendMatrices,
+                srcPosStride, destPosStride, srcNormStride, destNormStride,
+                blendWeightStride, blendIndexStride, numWeightsPerVertex, numVertices);
+            return;
+        }
+
+#define __OGRE_AVX_SKINNING(numWeights)                                         \
+        _softwareVertexSkinningAVX<numWeights>(                                 \
+            pSrcPos, pDestPos, pBlendWeight, pBlendIndex, blendMatrices,        \
+            srcPosStride, destPosStride, blendWeightStride, blendIndexStride,   \
+            numWeightsPerVertex, numVertices)
+
+        switch (numWeightsPerVertex)
+        {
+        case 1: __OGRE_AVX_SKINNING(1); break;
+        case 2: __OGRE_AVX_SKINNING(2); break;
+        case 3: __OGRE_AVX_SKINNING(3); break;
+        case 4: __OGRE_AVX_SKINNING(4); break;
+        default: __OGRE_AVX_SKINNING(0); break;
+        }
+
+#undef __OGRE_AVX_SKINNING
+    }
+    //---------------------------------------------------------------------
+
+    void OptimisedUtilAVX::softwareVertexMorph(
+        Real t,
+        const float *pSrc1, const float *pSrc2,
+        float *pDst,
+        size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+        size_t numVertices,
+        bool morphNormals)
+    {
+        const size_t vertexSize = (morphNormals ? 6 : 3) * sizeof(float);
+        const __m128i mask3 = _vector3MaskAVX();
+
+        if (pos1VSize == vertexSize && pos2VSize == vertexSize && dstVSize == vertexSize)
+        {
+            // Packed buffers, so all the floats can be interpolated as one array
+            const __m256 t8 = _mm256_set1_ps(t);
+            size_t numFloats = numVertices * vertexSize / sizeof(float);
+            size_t i = 0;
+            for (; i + 8 <= numFloats; i += 8)
+            {
+                __m256 a = _mm256_loadu_ps(pSrc1 + i);
+                __m256 b = _mm256_loadu_ps(pSrc2 + i);
+                _mm256_storeu_ps(pDst + i, _mm256_fmadd_ps(t8, _mm256_sub_ps(b, a), a));
+            }
+            if (i < numFloats)
+            {
+                __m256i mask = _firstLanesMaskAVX(numFloats - i);
+                __m256 a = _mm256_maskload_ps(pSrc1 + i, mask);
+                __m256 b = _mm256_maskload_ps(pSrc2 + i, mask);
+                _mm256_maskstore_ps(pDst + i, mask, _mm256_fmadd_ps(t8, _mm256_sub_ps(b, a), a));
+            }
+
+            if (morphNormals)
+            {
+                // Renormalise the interpolated normals in place
+                for (float* pNorm = pDst + 3; numVertices; --numVertices, pNorm += 6)
+                {
+                    __m128 norm = _mm_maskload_ps(pNorm, mask3);
+                    _mm_maskstore_ps(pNorm, mask3, _normaliseVector3AVX(norm));
+                }
+            }
+        }
+        else
+        {
+            const __m128 t4 = _mm_set1_ps(t);
+            for (size_t i = 0; i < numVertices; ++i)
+            {
+                __m128 a = _mm_maskload_ps(pSrc1, mask3);
+                __m128 b = _mm_maskload_ps(pSrc2, mask3);
+                _mm_maskstore_ps(pDst, mask3, _mm_fmadd_ps(t4, _mm_sub_ps(b, a), a));
+
+                if (morphNormals)
+                {
+                    // Normals must be in the same buffer as the positions, nlerp them
+                    a = _mm_maskload_ps(pSrc1 + 3, mask3);
+                    b = _mm_maskload_ps(pSrc2 + 3, mask3);
+                    __m128 norm = _mm_fmadd_ps(t4, _mm_sub_ps(b, a), a);
+                    _mm_maskstore_ps(pDst + 3, mask3, _normaliseVector3AVX(norm));
+                }
+
+                advanceRawPointer(pSrc1, pos1VSize);
+                advanceRawPointer(pSrc2, pos2VSize);
+                advanceRawPointer(pDst, dstVSize);
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX::concatenateAffineMatrices(
+        const Matrix4& baseMatrix,
+        const Matrix4* pSrcMat,
+        Matrix4* pDstMat,
+        size_t numMatrices)
+    {
+        const Matrix4& m = baseMatrix;
+
+        // Coefficients of the base matrix columns, rows 0 and 1 of the result
+        // are computed together in the two halves of 256 bits registers
+        __m256 c01[3];
+        __m128 c2[3];
+        for (size_t j = 0; j < 3; ++j)
+        {
+            c01[j] = _combineAVX(_mm_set1_ps(m[0][j]), _mm_set1_ps(m[1][j]));
+            c2[j] = _mm_set1_ps(m[2][j]);
+        }
+        // Column 3 is only added to the translation, the source being affine
+        __m256 t01 = _combineAVX(_mm_setr_ps(0, 0, 0, m[0][3]), _mm_setr_ps(0, 0, 0, m[1][3]));
+        __m128 t2 = _mm_setr_ps(0, 0, 0, m[2][3]);
+        __m128 row3 = _mm_setr_ps(0, 0, 0, 1);
+
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            const Matrix4& s = *pSrcMat++;
+            Matrix4& d = *pDstMat++;
+
+            __m128 s0 = _mm_loadu_ps(s[0]);
+            __m128 s1 = _mm_loadu_ps(s[1]);
+            __m128 s2 = _mm_loadu_ps(s[2]);
+
+            __m256 d01 = _mm256_mul_ps(c01[0], _combineAVX(s0, s0));
+            d01 = _mm256_fmadd_ps(c01[1], _combineAVX(s1, s1), d01);
+            d01 = _mm256_fmadd_ps(c01[2], _combineAVX(s2, s2), d01);
+            d01 = _mm256_add_ps(d01, t01);
+
+            __m128 d2 = _mm_mul_ps(c2[0], s0);
+            d2 = _mm_fmadd_ps(c2[1], s1, d2);
+            d2 = _mm_fmadd_ps(c2[2], s2, d2);
+            d2 = _mm_add_ps(d2, t2);
+
+            _mm256_storeu_ps(d[0], d01);
+            _mm_storeu_ps(d[2], d2);
+            _mm_storeu_ps(d[3], row3);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX::calculateFaceNormals(
+        const float *positions,
+        const EdgeData::Triangle *triangles,
+        Vector4 *faceNormals,
+        size_t numTriangles)
+    {
+        size_t numPacked = numTriangles & ~7;
+        for (size_t i = 0; i < numPacked; i += 8)
+        {
+            const EdgeData::Triangle* t = triangles + i;
+
+            // Gather the three vertices of eight triangles
+            __m256 x[3], y[3], z[3];
+            for (size_t v = 0; v < 3; ++v)
+            {
+                __m256i offsets = _mm256_setr_epi32(
+                    (int)t[0].vertIndex[v] * 3, (int)t[1].vertIndex[v] * 3,
+                    (int)t[2].vertIndex[v] * 3, (int)t[3].vertIndex[v] * 3,
+                    (int)t[4].vertIndex[v] * 3, (int)t[5].vertIndex[v] * 3,
+                    (int)t[6].vertIndex[v] * 3, (int)t[7].vertIndex[v] * 3);
+                x[v] = _mm256_i32gather_ps(positions + 0, offsets, 4);
+                y[v] = _mm256_i32gather_ps(positions + 1, offsets, 4);
+                z[v] = _mm256_i32gather_ps(positions + 2, offsets, 4);
+            }
+
+            // Same as Math::calculateFaceNormalWithoutNormalize
+            __m256 ax = _mm256_sub_ps(x[1], x[0]);
+            __m256 ay = _mm256_sub_ps(y[1], y[0]);
+            __m256 az = _mm256_sub_ps(z[1], z[0]);
+            __m256 bx = _mm256_sub_ps(x[2], x[0]);
+            __m256 by = _mm256_sub_ps(y[2], y[0]);
+            __m256 bz = _mm256_sub_ps(z[2], z[0]);
+
+            __m256 nx = _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by));
+            __m256 ny = _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz));
+            __m256 nz = _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx));
+            __m256 nw = _mm256_fmadd_ps(nz, z[0], _mm256_fmadd_ps(ny, y[0], _mm256_mul_ps(nx, x[0])));
+            nw = _mm256_sub_ps(_mm256_setzero_ps(), nw);
+
+            // Transpose to (x, y, z, w) vectors, triangles 0-3 come out of
+            // the low halves and triangles 4-7 out of the high halves
+            __m256 t0 = _mm256_unpacklo_ps(nx, ny);
+            __m256 t1 = _mm256_unpackhi_ps(nx, ny);
+            __m256 t2 = _mm256_unpacklo_ps(nz, nw);
+            __m256 t3 = _mm256_unpackhi_ps(nz, nw);
+            __m256 r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+            float* dst = &faceNormals[i].x;
+            _mm256_storeu_ps(dst + 0, _mm256_permute2f128_ps(r0, r1, 0x20));
+            _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(r2, r3, 0x20));
+            _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(r0, r1, 0x31));
+            _mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(r2, r3, 0x31));
+        }
+
+        if (numPacked < numTriangles)
+        {
+            mFallback->calculateFaceNormals(positions, triangles + numPacked,
+                faceNormals + numPacked, numTriangles - numPacked);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX::calculateLightFacing(
+        const Vector4& lightPos,
+        const Vector4* faceNormals,
+        char* lightFacings,
+        size_t numFaces)
+    {
+        __m128 lp = _mm_loadu_ps(&lightPos.x);
+        __m256 lp8 = _combineAVX(lp, lp);
+        __m256 zero = _mm256_setzero_ps();
+        // Puts the dot products in face order, see below
+        __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        size_t numPacked = numFaces & ~7;
+        for (size_t i = 0; i < numPacked; i += 8)
+        {
+            const float* n = &faceNormals[i].x;
+            __m256 n01 = _mm256_mul_ps(_mm256_loadu_ps(n + 0), lp8);
+            __m256 n23 = _mm256_mul_ps(_mm256_loadu_ps(n + 8), lp8);
+            __m256 n45 = _mm256_mul_ps(_mm256_loadu_ps(n + 16), lp8);
+            __m256 n67 = _mm256_mul_ps(_mm256_loadu_ps(n + 24), lp8);
+
+            // Horizontal adds give dot products 0, 2, 4, 6 in the low half
+            // and 1, 3, 5, 7 in the high half
+            __m256 dp = _mm256_hadd_ps(_mm256_hadd_ps(n01, n23), _mm256_hadd_ps(n45, n67));
+            dp = _mm256_permutevar8x32_ps(dp, order);
+
+            int bitmask = _mm256_movemask_ps(_mm256_cmp_ps(dp, zero, _CMP_GT_OQ));
+            memcpy(lightFacings + i, msMaskMappingAVX[bitmask & 15], 4);
+            memcpy(lightFacings + i + 4, msMaskMappingAVX[bitmask >> 4], 4);
+        }
+
+        if (numPacked < numFaces)
+        {
+            mFallback->calculateLightFacing(lightPos, faceNormals + numPacked,
+                lightFacings + numPacked, numFaces - numPacked);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilAVX::extrudeVertices(
+        const Vector4& lightPos,
+        Real extrudeDist,
+        const float* pSrcPos,
+        float* pDestPos,
+        size_t numVertices)
+    {
+        size_t numPacked = numVertices & ~7;
+
+        if (lightPos.w == 0.0f)
+        {
+            // Directional light, extrusion is along light direction
+            Vector3 extrusionDir(-lightPos.x, -lightPos.y, -lightPos.z);
+            extrusionDir.normalise();
+            extrusionDir *= extrudeDist;
+
+            // The direction repeated over eight packed vertices
+            const Real& dx = extrusionDir.x;
+            const Real& dy = extrusionDir.y;
+            const Real& dz = extrusionDir.z;
+            __m256 dir0 = _mm256_setr_ps(dx, dy, dz, dx, dy, dz, dx, dy);
+            __m256 dir1 = _mm256_setr_ps(dz, dx, dy, dz, dx, dy, dz, dx);
+            __m256 dir2 = _mm256_setr_ps(dy, dz, dx, dy, dz, dx, dy, dz);
+
+            for (size_t i = 0; i < numPacked; i += 8)
+            {
+                _mm256_storeu_ps(pDestPos + 0, _mm256_add_ps(_mm256_loadu_ps(pSrcPos + 0), dir0));
+                _mm256_storeu_ps(pDestPos + 8, _mm256_add_ps(_mm256_loadu_ps(pSrcPos + 8), dir1));
+                _mm256_storeu_ps(pDestPos + 16, _mm256_add_ps(_mm256_loadu_ps(pSrcPos + 16), dir2));
+                pSrcPos += 24;
+                pDestPos += 24;
+            }
+        }
+        else
+        {
+            // Point light, calculate extrusionDir for every vertex
+            assert(lightPos.w == 1.0f);
+
+            __m256 lx = _mm256_set1_ps(lightPos.x);
+            __m256 ly = _mm256_set1_ps(lightPos.y);
+            __m256 lz = _mm256_set1_ps(lightPos.z);
+            __m256 dist = _mm256_set1_ps(extrudeDist);
+            __m256 epsilon = _mm256_set1_ps(1e-08f);
+
+            for (size_t i = 0; i < numPacked; i += 8)
+            {
+                __m256 x, y, z;
+                _loadVector3x8AVX(pSrcPos, x, y, z);
+
+                __m256 dx = _mm256_sub_ps(x, lx);
+                __m256 dy = _mm256_sub_ps(y, ly);
+                __m256 dz = _mm256_sub_ps(z, lz);
+
+                // Scale to the extrusion distance, leaving zero length
+                // directions alone like Vector3::normalise
+                __m256 length = _mm256_sqrt_ps(
+                    _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx))));
+                __m256 scale = _mm256_and_ps(_mm256_div_ps(dist, length),
+                    _mm256_cmp_ps(length, epsilon, _CMP_GT_OQ));
+
+                _storeVector3x8AVX(pDestPos,
+                    _mm256_fmadd_ps(dx, scale, x),
+                    _mm256_fmadd_ps(dy, scale, y),
+                    _mm256_fmadd_ps(dz, scale, z));
+                pSrcPos += 24;
+                pDestPos += 24;
+            }
+        }
+
+        if (numPacked < numVertices)
+        {
+            mFallback->extrudeVertices(lightPos, extrudeDist, pSrcPos, pDestPos,
+                numVertices - numPacked);
+        }
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX(void)
+    {
+        static OptimisedUtilAVX msOptimisedUtilAVX(_getOptimisedUtilSSE());
+        return &msOptimisedUtilAVX;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX
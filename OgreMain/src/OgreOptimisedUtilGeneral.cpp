@@ -31,6 +31,8 @@ THE SOFTWARE.
 
 #include "OgreVector3.h"
 #include "OgreMatrix4.h"
+#include "OgreQuaternion.h"
+#include "OgrePlane.h"
 
 namespace Ogre {
 
@@ -94,6 +96,40 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::calculateBoneMatrices
+        virtual void calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones);
+
+        /// @copydoc OptimisedUtil::calculateBoxesVisibility
+        virtual void calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::calculateSpheresVisibility
+        virtual void calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres);
     };
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -392,6 +428,148 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::concatenateNodeTransforms(
+        const TransformStreams& parentTransforms,
+        const TransformStreams& localTransforms,
+        const uint32* inheritOrientation,
+        const uint32* inheritScale,
+        const TransformStreams& derivedTransforms,
+        size_t numNodes)
+    {
+        for (size_t i = 0; i < numNodes; ++i)
+        {
+            const Quaternion parentOrientation(
+                parentTransforms.orientation[0][i],
+                parentTransforms.orientation[1][i],
+                parentTransforms.orientation[2][i],
+                parentTransforms.orientation[3][i]);
+            const Vector3 parentScale(
+                parentTransforms.scale[0][i],
+                parentTransforms.scale[1][i],
+                parentTransforms.scale[2][i]);
+            Quaternion orientation(
+                localTransforms.orientation[0][i],
+                localTransforms.orientation[1][i],
+                localTransforms.orientation[2][i],
+                localTransforms.orientation[3][i]);
+            Vector3 scale(
+                localTransforms.scale[0][i],
+                localTransforms.scale[1][i],
+                localTransforms.scale[2][i]);
+            Vector3 position(
+                localTransforms.position[0][i],
+                localTransforms.position[1][i],
+                localTransforms.position[2][i]);
+
+            if (inheritOrientation[i])
+                orientation = parentOrientation * orientation;
+            if (inheritScale[i])
+                scale = parentScale * scale;
+
+            position = parentOrientation * (parentScale * position);
+
+            derivedTransforms.position[0][i] = position.x + parentTransforms.position[0][i];
+            derivedTransforms.position[1][i] = position.y + parentTransforms.position[1][i];
+            derivedTransforms.position[2][i] = position.z + parentTransforms.position[2][i];
+            derivedTransforms.orientation[0][i] = orientation.w;
+            derivedTransforms.orientation[1][i] = orientation.x;
+            derivedTransforms.orientation[2][i] = orientation.y;
+            derivedTransforms.orientation[3][i] = orientation.z;
+            derivedTransforms.scale[0][i] = scale.x;
+            derivedTransforms.scale[1][i] = scale.y;
+            derivedTransforms.scale[2][i] = scale.z;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateBoneMatrices(
+        const TransformStreams& derivedTransforms,
+        const TransformStreams& bindingPoseInverses,
+        Matrix4* dstMatrices,
+        size_t numBones)
+    {
+        for (size_t i = 0; i < numBones; ++i)
+        {
+            const Quaternion orientation(
+                derivedTransforms.orientation[0][i],
+                derivedTransforms.orientation[1][i],
+                derivedTransforms.orientation[2][i],
+                derivedTransforms.orientation[3][i]);
+            const Quaternion inverseOrientation(
+                bindingPoseInverses.orientation[0][i],
+                bindingPoseInverses.orientation[1][i],
+                bindingPoseInverses.orientation[2][i],
+                bindingPoseInverses.orientation[3][i]);
+            const Vector3 scale(
+                derivedTransforms.scale[0][i] * bindingPoseInverses.scale[0][i],
+                derivedTransforms.scale[1][i] * bindingPoseInverses.scale[1][i],
+                derivedTransforms.scale[2][i] * bindingPoseInverses.scale[2][i]);
+            const Vector3 inversePosition(
+                bindingPoseInverses.position[0][i],
+                bindingPoseInverses.position[1][i],
+                bindingPoseInverses.position[2][i]);
+
+            // Same combination as Bone::_getOffsetTransform
+            const Quaternion rotate = orientation * inverseOrientation;
+            const Vector3 translate = Vector3(
+                derivedTransforms.position[0][i],
+                derivedTransforms.position[1][i],
+                derivedTransforms.position[2][i]) + rotate * (scale * inversePosition);
+
+            dstMatrices[i].makeTransform(translate, scale, rotate);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateBoxesVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* const centres[3],
+        const Real* const halfSizes[3],
+        char* visibilities,
+        size_t numBoxes)
+    {
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            Vector3 centre(centres[0][i], centres[1][i], centres[2][i]);
+            Vector3 halfSize(halfSizes[0][i], halfSizes[1][i], halfSizes[2][i]);
+
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                if (planes[p].getSide(centre, halfSize) == Plane::NEGATIVE_SIDE)
+                {
+                    visible = false;
+                    break;
+                }
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilGeneral::calculateSpheresVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* const centres[3],
+        const Real* radii,
+        char* visibilities,
+        size_t numSpheres)
+    {
+        for (size_t i = 0; i < numSpheres; ++i)
+        {
+            Vector3 centre(centres[0][i], centres[1][i], centres[2][i]);
+
+            bool visible = true;
+            for (size_t p = 0; p < numPlanes; ++p)
+            {
+                if (planes[p].getDistance(centre) < -radii[i])
+                {
+                    visible = false;
+                    break;
+                }
+            }
+            visibilities[i] = visible;
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilGeneral(void)
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #if __OGRE_HAVE_SSE
 
 #include "OgreMatrix4.h"
+#include "OgrePlane.h"
 
 // Should keep this includes at latest to avoid potential "xmmintrin.h" included by
 // other header file on some platform for some reason.
@@ -65,6 +66,8 @@ THE SOFTWARE.
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -132,6 +135,40 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes);
+
+        /// @copydoc OptimisedUtil::calculateBoneMatrices
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones);
+
+        /// @copydoc OptimisedUtil::calculateBoxesVisibility
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes);
+
+        /// @copydoc OptimisedUtil::calculateSpheresVisibility
+        virtual void __OGRE_SIMD_ALIGN_ATTRIBUTE calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres);
     };
 
 #if defined(__OGRE_SIMD_ALIGN_STACK)
@@ -271,6 +308,82 @@ namespace Ogre {
                 destPositions,
                 numVertices);
         }
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->concatenateNodeTransforms(
+                parentTransforms,
+                localTransforms,
+                inheritOrientation,
+                inheritScale,
+                derivedTransforms,
+                numNodes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoneMatrices
+        virtual void calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateBoneMatrices(
+                derivedTransforms,
+                bindingPoseInverses,
+                dstMatrices,
+                numBones);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoxesVisibility
+        virtual void calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateBoxesVisibility(
+                planes,
+                numPlanes,
+                centres,
+                halfSizes,
+                visibilities,
+                numBoxes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateSpheresVisibility
+        virtual void calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres)
+        {
+            __OGRE_SIMD_ALIGN_STACK();
+
+            mImpl->calculateSpheresVisibility(
+                planes,
+                numPlanes,
+                centres,
+                radii,
+                visibilities,
+                numSpheres);
+        }
     };
 #endif  // !defined(__OGRE_SIMD_ALIGN_STACK)
 
@@ -1293,6 +1406,16 @@ namespace Ogre {
     {	
         __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
 
+        // The code below only deals with packed vertices, leave any other
+        // layout to the general implementation
+        size_t packedVSize = (morphNormals ? 6 : 3) * sizeof(float);
+        if (pos1VSize != packedVSize || pos2VSize != packedVSize || dstVSize != packedVSize)
+        {
+            _getOptimisedUtilGeneral()->softwareVertexMorph(t, pSrc1, pSrc2, pDst,
+                pos1VSize, pos2VSize, dstVSize, numVertices, morphNormals);
+            return;
+        }
+
         __m128 src01, src02, src11, src12, src21, src22;
         __m128 dst0, dst1, dst2;
 
@@ -1501,14 +1624,13 @@ namespace Ogre {
 				__m128 tmp = _mm_mul_ps(norm, norm);
 				// Add - for this we want this effect:
 				// orig   3 | 2 | 1 | 0
-				// add1   0 | 0 | 0 | 2
-				// add2   2 | 3 | 0 | 3
-				// This way elements 0, 2 and 3 have the sum of all entries (except 1 which is unused)
+				// add1   2 | 3 | 0 | 1
+				// add2   1 | 0 | 3 | 2
+				// This way every element has the sum of all entries (1 is zero)
 				
-				tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(0,0,0,2)));
+				tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(2,3,0,1)));
 				// Add final combination & sqrt 
-				// bottom 3 elements of l will have length, we don't care about 4
-				tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(2,3,0,3)));
+				tmp = _mm_add_ps(tmp, _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(1,0,3,2)));
 				// Then divide to normalise
 				norm = _mm_div_ps(norm, _mm_sqrt_ps(tmp));
 				
@@ -1893,8 +2015,9 @@ namespace Ogre {
             // by use subtract instruction instead later.
             __m128 tmp = _mm_mul_ps(lp, lp);
             tmp = _mm_add_ss(_mm_add_ss(tmp, _mm_shuffle_ps(tmp, tmp, 1)), _mm_movehl_ps(tmp, tmp));
-            // Looks like VC7.1 generate a bit inefficient code for 'rsqrtss', so use 'rsqrtps' instead
-            tmp = _mm_mul_ss(_mm_rsqrt_ps(tmp), _mm_load_ss(&extrudeDist));
+            // Looks like VC7.1 generate a bit inefficient code for 'rsqrtss', so use 'rsqrtps' instead,
+            // refined, since the error of 'rsqrtps' alone gets scaled by the extrusion distance
+            tmp = _mm_mul_ss(__mm_rsqrt_nr_ps(tmp), _mm_load_ss(&extrudeDist));
             __m128 dir = _mm_mul_ps(lp, __MM_SELECT(tmp, 0));               // X Y Z -
 
             // Prepare extrude direction for extruding 4 vertices parallelly
@@ -2019,7 +2142,7 @@ namespace Ogre {
 
                 // Normalise extrusion direction and multiply by extrude distance
                 __m128 tmp = __MM_DOT3x3_PS(dx, dy, dz, dx, dy, dz);
-                tmp = _mm_mul_ps(_mm_rsqrt_ps(tmp), extrudeDist4);
+                tmp = _mm_mul_ps(__mm_rsqrt_nr_ps(tmp), extrudeDist4);
                 dx = _mm_mul_ps(dx, tmp);
                 dy = _mm_mul_ps(dy, tmp);
                 dz = _mm_mul_ps(dz, tmp);
@@ -2053,7 +2176,7 @@ namespace Ogre {
                 __m128 tmp = _mm_mul_ps(dir, dir);
                 tmp = _mm_add_ss(_mm_add_ss(tmp, _mm_movehl_ps(tmp, tmp)), _mm_shuffle_ps(tmp, tmp, 3));
                 // Looks like VC7.1 generate a bit inefficient code for 'rsqrtss', so use 'rsqrtps' instead
-                tmp = _mm_mul_ss(_mm_rsqrt_ps(tmp), extrudeDist4);
+                tmp = _mm_mul_ss(__mm_rsqrt_nr_ps(tmp), extrudeDist4);
                 dir = _mm_mul_ps(dir, __MM_SELECT(tmp, 0));
 
                 // Calculate extruded position
@@ -2132,6 +2255,585 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    // Combine the transforms of four nodes at one time, starting at the given
+    // index of each stream.
+    template <bool aligned>
+    static FORCEINLINE void _concatenateFourNodeTransforms(
+        const TransformStreams& parent,
+        const TransformStreams& local,
+        const uint32* inheritOrientation,
+        const uint32* inheritScale,
+        const TransformStreams& derived,
+        size_t index)
+    {
+        typedef SSEMemoryAccessor<aligned> Accessor;
+
+        // Load parent transforms
+        __m128 ppx = Accessor::load(parent.position[0] + index);
+        __m128 ppy = Accessor::load(parent.position[1] + index);
+        __m128 ppz = Accessor::load(parent.position[2] + index);
+        __m128 pqw = Accessor::load(parent.orientation[0] + index);
+        __m128 pqx = Accessor::load(parent.orientation[1] + index);
+        __m128 pqy = Accessor::load(parent.orientation[2] + index);
+        __m128 pqz = Accessor::load(parent.orientation[3] + index);
+        __m128 psx = Accessor::load(parent.scale[0] + index);
+        __m128 psy = Accessor::load(parent.scale[1] + index);
+        __m128 psz = Accessor::load(parent.scale[2] + index);
+
+        // Load local transforms
+        __m128 lqw = Accessor::load(local.orientation[0] + index);
+        __m128 lqx = Accessor::load(local.orientation[1] + index);
+        __m128 lqy = Accessor::load(local.orientation[2] + index);
+        __m128 lqz = Accessor::load(local.orientation[3] + index);
+        __m128 lsx = Accessor::load(local.scale[0] + index);
+        __m128 lsy = Accessor::load(local.scale[1] + index);
+        __m128 lsz = Accessor::load(local.scale[2] + index);
+
+        // Inheritance masks, bit patterns only
+        __m128 inheritQ = Accessor::load((const float*)(inheritOrientation + index));
+        __m128 inheritS = Accessor::load((const float*)(inheritScale + index));
+
+        // Orientation: parent * local
+        __m128 qw = _mm_sub_ps(_mm_mul_ps(pqw, lqw),
+            __MM_ACCUM3_PS(_mm_mul_ps(pqx, lqx), _mm_mul_ps(pqy, lqy), _mm_mul_ps(pqz, lqz)));
+        __m128 qx = _mm_sub_ps(
+            __MM_ACCUM3_PS(_mm_mul_ps(pqw, lqx), _mm_mul_ps(pqx, lqw), _mm_mul_ps(pqy, lqz)),
+            _mm_mul_ps(pqz, lqy));
+        __m128 qy = _mm_sub_ps(
+            __MM_ACCUM3_PS(_mm_mul_ps(pqw, lqy), _mm_mul_ps(pqy, lqw), _mm_mul_ps(pqz, lqx)),
+            _mm_mul_ps(pqx, lqz));
+        __m128 qz = _mm_sub_ps(
+            __MM_ACCUM3_PS(_mm_mul_ps(pqw, lqz), _mm_mul_ps(pqz, lqw), _mm_mul_ps(pqx, lqy)),
+            _mm_mul_ps(pqy, lqx));
+
+        // Select combined or local orientation
+        Accessor::store(derived.orientation[0] + index,
+            _mm_or_ps(_mm_and_ps(inheritQ, qw), _mm_andnot_ps(inheritQ, lqw)));
+        Accessor::store(derived.orientation[1] + index,
+            _mm_or_ps(_mm_and_ps(inheritQ, qx), _mm_andnot_ps(inheritQ, lqx)));
+        Accessor::store(derived.orientation[2] + index,
+            _mm_or_ps(_mm_and_ps(inheritQ, qy), _mm_andnot_ps(inheritQ, lqy)));
+        Accessor::store(derived.orientation[3] + index,
+            _mm_or_ps(_mm_and_ps(inheritQ, qz), _mm_andnot_ps(inheritQ, lqz)));
+
+        // Select combined or local scale
+        Accessor::store(derived.scale[0] + index,
+            _mm_or_ps(_mm_and_ps(inheritS, _mm_mul_ps(psx, lsx)), _mm_andnot_ps(inheritS, lsx)));
+        Accessor::store(derived.scale[1] + index,
+            _mm_or_ps(_mm_and_ps(inheritS, _mm_mul_ps(psy, lsy)), _mm_andnot_ps(inheritS, lsy)));
+        Accessor::store(derived.scale[2] + index,
+            _mm_or_ps(_mm_and_ps(inheritS, _mm_mul_ps(psz, lsz)), _mm_andnot_ps(inheritS, lsz)));
+
+        // Position scaled by parent scale
+        __m128 vx = _mm_mul_ps(psx, Accessor::load(local.position[0] + index));
+        __m128 vy = _mm_mul_ps(psy, Accessor::load(local.position[1] + index));
+        __m128 vz = _mm_mul_ps(psz, Accessor::load(local.position[2] + index));
+
+        // Rotate by parent orientation, as Quaternion::operator*(const Vector3&)
+        __m128 uvx = _mm_sub_ps(_mm_mul_ps(pqy, vz), _mm_mul_ps(pqz, vy));
+        __m128 uvy = _mm_sub_ps(_mm_mul_ps(pqz, vx), _mm_mul_ps(pqx, vz));
+        __m128 uvz = _mm_sub_ps(_mm_mul_ps(pqx, vy), _mm_mul_ps(pqy, vx));
+        __m128 uuvx = _mm_sub_ps(_mm_mul_ps(pqy, uvz), _mm_mul_ps(pqz, uvy));
+        __m128 uuvy = _mm_sub_ps(_mm_mul_ps(pqz, uvx), _mm_mul_ps(pqx, uvz));
+        __m128 uuvz = _mm_sub_ps(_mm_mul_ps(pqx, uvy), _mm_mul_ps(pqy, uvx));
+        __m128 w2 = _mm_add_ps(pqw, pqw);
+
+        // v + 2w * uv + 2 * uuv + parent position
+        Accessor::store(derived.position[0] + index, __MM_ACCUM4_PS(
+            vx, _mm_mul_ps(w2, uvx), _mm_add_ps(uuvx, uuvx), ppx));
+        Accessor::store(derived.position[1] + index, __MM_ACCUM4_PS(
+            vy, _mm_mul_ps(w2, uvy), _mm_add_ps(uuvy, uuvy), ppy));
+        Accessor::store(derived.position[2] + index, __MM_ACCUM4_PS(
+            vz, _mm_mul_ps(w2, uvz), _mm_add_ps(uuvz, uuvz), ppz));
+    }
+    //---------------------------------------------------------------------
+    static FORCEINLINE bool _isAlignedForSSE(const TransformStreams& streams)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            if (!_isAlignedForSSE(streams.position[i]) || !_isAlignedForSSE(streams.scale[i]))
+                return false;
+        }
+        for (size_t i = 0; i < 4; ++i)
+        {
+            if (!_isAlignedForSSE(streams.orientation[i]))
+                return false;
+        }
+        return true;
+    }
+    //---------------------------------------------------------------------
+    // Access a stream by component index, in position, orientation, scale order.
+    static FORCEINLINE float*& _getTransformStream(TransformStreams& streams, size_t component)
+    {
+        return component < 3 ? streams.position[component] :
+            component < 7 ? streams.orientation[component - 3] : streams.scale[component - 7];
+    }
+    static FORCEINLINE float* _getTransformStream(const TransformStreams& streams, size_t component)
+    {
+        return component < 3 ? streams.position[component] :
+            component < 7 ? streams.orientation[component - 3] : streams.scale[component - 7];
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::concatenateNodeTransforms(
+        const TransformStreams& parentTransforms,
+        const TransformStreams& localTransforms,
+        const uint32* inheritOrientation,
+        const uint32* inheritScale,
+        const TransformStreams& derivedTransforms,
+        size_t numNodes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        size_t numPacked = numNodes & ~3;
+        if (_isAlignedForSSE(parentTransforms) && _isAlignedForSSE(localTransforms) &&
+            _isAlignedForSSE(derivedTransforms) &&
+            _isAlignedForSSE(inheritOrientation) && _isAlignedForSSE(inheritScale))
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                _concatenateFourNodeTransforms<true>(
+                    parentTransforms, localTransforms,
+                    inheritOrientation, inheritScale,
+                    derivedTransforms, i);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                _concatenateFourNodeTransforms<false>(
+                    parentTransforms, localTransforms,
+                    inheritOrientation, inheritScale,
+                    derivedTransforms, i);
+            }
+        }
+
+        size_t numLeft = numNodes - numPacked;
+        if (numLeft)
+        {
+            // Copy the remaining nodes to a padded block on the stack, so the
+            // same code path can handle them. Padding lanes are identity.
+            enum { NUM_COMPONENTS = 10 };
+            OGRE_SIMD_ALIGNED_DECL(float, parentBlock[NUM_COMPONENTS * 4]);
+            OGRE_SIMD_ALIGNED_DECL(float, localBlock[NUM_COMPONENTS * 4]);
+            OGRE_SIMD_ALIGNED_DECL(float, derivedBlock[NUM_COMPONENTS * 4]);
+            OGRE_SIMD_ALIGNED_DECL(uint32, inheritBlock[8]);
+            TransformStreams parent, local, derived;
+            for (size_t c = 0; c < NUM_COMPONENTS; ++c)
+            {
+                const float* srcParent = _getTransformStream(parentTransforms, c);
+                const float* srcLocal = _getTransformStream(localTransforms, c);
+                // Position 0, orientation (1, 0, 0, 0), scale 1
+                float identity = (c == 3 || c >= 7) ? 1.0f : 0.0f;
+
+                _getTransformStream(parent, c) = parentBlock + c * 4;
+                _getTransformStream(local, c) = localBlock + c * 4;
+                _getTransformStream(derived, c) = derivedBlock + c * 4;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    parentBlock[c * 4 + i] = i < numLeft ? srcParent[numPacked + i] : identity;
+                    localBlock[c * 4 + i] = i < numLeft ? srcLocal[numPacked + i] : identity;
+                }
+            }
+            for (size_t i = 0; i < 4; ++i)
+            {
+                inheritBlock[i] = i < numLeft ? inheritOrientation[numPacked + i] : 0;
+                inheritBlock[4 + i] = i < numLeft ? inheritScale[numPacked + i] : 0;
+            }
+
+            _concatenateFourNodeTransforms<true>(
+                parent, local, inheritBlock, inheritBlock + 4, derived, 0);
+
+            for (size_t c = 0; c < NUM_COMPONENTS; ++c)
+            {
+                float* dst = _getTransformStream(derivedTransforms, c);
+                for (size_t i = 0; i < numLeft; ++i)
+                {
+                    dst[numPacked + i] = derivedBlock[c * 4 + i];
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    /// Calculate the skinning matrices of four bones starting at index
+    template <bool aligned>
+    static FORCEINLINE void _calculateFourBoneMatrices(
+        const TransformStreams& derived,
+        const TransformStreams& inverse,
+        Matrix4* dstMatrices,
+        size_t index)
+    {
+        typedef SSEMemoryAccessor<aligned> Accessor;
+
+        // Load derived orientations
+        __m128 dqw = Accessor::load(derived.orientation[0] + index);
+        __m128 dqx = Accessor::load(derived.orientation[1] + index);
+        __m128 dqy = Accessor::load(derived.orientation[2] + index);
+        __m128 dqz = Accessor::load(derived.orientation[3] + index);
+
+        // Load binding pose inverse orientations
+        __m128 iqw = Accessor::load(inverse.orientation[0] + index);
+        __m128 iqx = Accessor::load(inverse.orientation[1] + index);
+        __m128 iqy = Accessor::load(inverse.orientation[2] + index);
+        __m128 iqz = Accessor::load(inverse.orientation[3] + index);
+
+        // Scale: derived * inverse, component-wise
+        __m128 sx = _mm_mul_ps(Accessor::load(derived.scale[0] + index), Accessor::load(inverse.scale[0] + index));
+        __m128 sy = _mm_mul_ps(Accessor::load(derived.scale[1] + index), Accessor::load(inverse.scale[1] + index));
+        __m128 sz = _mm_mul_ps(Accessor::load(derived.scale[2] + index), Accessor::load(inverse.scale[2] + index));
+
+        // Orientation: derived * inverse
+        __m128 qw = _mm_sub_ps(_mm_mul_ps(dqw, iqw),
+            __MM_ACCUM3_PS(_mm_mul_ps(dqx, iqx), _mm_mul_ps(dqy, iqy), _mm_mul_ps(dqz, iqz)));
+        __m128 qx = _mm_sub_ps(
+            __MM_ACCUM3_PS(_mm_mul_ps(dqw, iqx), _mm_mul_ps(dqx, iqw), _mm_mul_ps(dqy, iqz)),
+            _mm_mul_ps(dqz, iqy));
+        __m128 qy = _mm_sub_ps(
+            __MM_ACCUM3_PS(_mm_mul_ps(dqw, iqy), _mm_mul_ps(dqy, iqw), _mm_mul_ps(dqz, iqx)),
+            _mm_mul_ps(dqx, iqz));
+        __m128 qz = _mm_sub_ps(
+            __MM_ACCUM3_PS(_mm_mul_ps(dqw, iqz), _mm_mul_ps(dqz, iqw), _mm_mul_ps(dqx, iqy)),
+            _mm_mul_ps(dqy, iqx));
+
+        // Inverse position scaled by the combined scale
+        __m128 vx = _mm_mul_ps(sx, Accessor::load(inverse.position[0] + index));
+        __m128 vy = _mm_mul_ps(sy, Accessor::load(inverse.position[1] + index));
+        __m128 vz = _mm_mul_ps(sz, Accessor::load(inverse.position[2] + index));
+
+        // Rotate by the combined orientation, as Quaternion::operator*(const Vector3&)
+        __m128 uvx = _mm_sub_ps(_mm_mul_ps(qy, vz), _mm_mul_ps(qz, vy));
+        __m128 uvy = _mm_sub_ps(_mm_mul_ps(qz, vx), _mm_mul_ps(qx, vz));
+        __m128 uvz = _mm_sub_ps(_mm_mul_ps(qx, vy), _mm_mul_ps(qy, vx));
+        __m128 uuvx = _mm_sub_ps(_mm_mul_ps(qy, uvz), _mm_mul_ps(qz, uvy));
+        __m128 uuvy = _mm_sub_ps(_mm_mul_ps(qz, uvx), _mm_mul_ps(qx, uvz));
+        __m128 uuvz = _mm_sub_ps(_mm_mul_ps(qx, uvy), _mm_mul_ps(qy, uvx));
+        __m128 w2 = _mm_add_ps(qw, qw);
+
+        // v + 2w * uv + 2 * uuv + derived position
+        __m128 tx = __MM_ACCUM4_PS(vx, _mm_mul_ps(w2, uvx), _mm_add_ps(uuvx, uuvx),
+            Accessor::load(derived.position[0] + index));
+        __m128 ty = __MM_ACCUM4_PS(vy, _mm_mul_ps(w2, uvy), _mm_add_ps(uuvy, uuvy),
+            Accessor::load(derived.position[1] + index));
+        __m128 tz = __MM_ACCUM4_PS(vz, _mm_mul_ps(w2, uvz), _mm_add_ps(uuvz, uuvz),
+            Accessor::load(derived.position[2] + index));
+
+        // Rotation matrix, as Quaternion::ToRotationMatrix
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 tx2 = _mm_add_ps(qx, qx);
+        __m128 ty2 = _mm_add_ps(qy, qy);
+        __m128 tz2 = _mm_add_ps(qz, qz);
+        __m128 twx = _mm_mul_ps(tx2, qw);
+        __m128 twy = _mm_mul_ps(ty2, qw);
+        __m128 twz = _mm_mul_ps(tz2, qw);
+        __m128 txx = _mm_mul_ps(tx2, qx);
+        __m128 txy = _mm_mul_ps(ty2, qx);
+        __m128 txz = _mm_mul_ps(tz2, qx);
+        __m128 tyy = _mm_mul_ps(ty2, qy);
+        __m128 tyz = _mm_mul_ps(tz2, qy);
+        __m128 tzz = _mm_mul_ps(tz2, qz);
+
+        // Rows of the affine part, with columns scaled as Matrix4::makeTransform
+        __m128 r0c0 = _mm_mul_ps(sx, _mm_sub_ps(one, _mm_add_ps(tyy, tzz)));
+        __m128 r0c1 = _mm_mul_ps(sy, _mm_sub_ps(txy, twz));
+        __m128 r0c2 = _mm_mul_ps(sz, _mm_add_ps(txz, twy));
+        __m128 r1c0 = _mm_mul_ps(sx, _mm_add_ps(txy, twz));
+        __m128 r1c1 = _mm_mul_ps(sy, _mm_sub_ps(one, _mm_add_ps(txx, tzz)));
+        __m128 r1c2 = _mm_mul_ps(sz, _mm_sub_ps(tyz, twx));
+        __m128 r2c0 = _mm_mul_ps(sx, _mm_sub_ps(txz, twy));
+        __m128 r2c1 = _mm_mul_ps(sy, _mm_add_ps(tyz, twx));
+        __m128 r2c2 = _mm_mul_ps(sz, _mm_sub_ps(one, _mm_add_ps(txx, tyy)));
+
+        // Transpose to one row per bone
+        __MM_TRANSPOSE4x4_PS(r0c0, r0c1, r0c2, tx);
+        __MM_TRANSPOSE4x4_PS(r1c0, r1c1, r1c2, ty);
+        __MM_TRANSPOSE4x4_PS(r2c0, r2c1, r2c2, tz);
+
+        __m128 r3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        Matrix4* dst = dstMatrices + index;
+        _mm_storeu_ps(dst[0][0], r0c0);
+        _mm_storeu_ps(dst[0][1], r1c0);
+        _mm_storeu_ps(dst[0][2], r2c0);
+        _mm_storeu_ps(dst[0][3], r3);
+        _mm_storeu_ps(dst[1][0], r0c1);
+        _mm_storeu_ps(dst[1][1], r1c1);
+        _mm_storeu_ps(dst[1][2], r2c1);
+        _mm_storeu_ps(dst[1][3], r3);
+        _mm_storeu_ps(dst[2][0], r0c2);
+        _mm_storeu_ps(dst[2][1], r1c2);
+        _mm_storeu_ps(dst[2][2], r2c2);
+        _mm_storeu_ps(dst[2][3], r3);
+        _mm_storeu_ps(dst[3][0], tx);
+        _mm_storeu_ps(dst[3][1], ty);
+        _mm_storeu_ps(dst[3][2], tz);
+        _mm_storeu_ps(dst[3][3], r3);
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateBoneMatrices(
+        const TransformStreams& derivedTransforms,
+        const TransformStreams& bindingPoseInverses,
+        Matrix4* dstMatrices,
+        size_t numBones)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        size_t numPacked = numBones & ~3;
+        if (_isAlignedForSSE(derivedTransforms) && _isAlignedForSSE(bindingPoseInverses))
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                _calculateFourBoneMatrices<true>(
+                    derivedTransforms, bindingPoseInverses, dstMatrices, i);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                _calculateFourBoneMatrices<false>(
+                    derivedTransforms, bindingPoseInverses, dstMatrices, i);
+            }
+        }
+
+        size_t numLeft = numBones - numPacked;
+        if (numLeft)
+        {
+            // Same padding scheme as concatenateNodeTransforms, the matrices
+            // of the padding lanes are discarded
+            enum { NUM_COMPONENTS = 10 };
+            OGRE_SIMD_ALIGNED_DECL(float, derivedBlock[NUM_COMPONENTS * 4]);
+            OGRE_SIMD_ALIGNED_DECL(float, inverseBlock[NUM_COMPONENTS * 4]);
+            Matrix4 matrixBlock[4];
+            TransformStreams derived, inverse;
+            for (size_t c = 0; c < NUM_COMPONENTS; ++c)
+            {
+                const float* srcDerived = _getTransformStream(derivedTransforms, c);
+                const float* srcInverse = _getTransformStream(bindingPoseInverses, c);
+                float identity = (c == 3 || c >= 7) ? 1.0f : 0.0f;
+
+                _getTransformStream(derived, c) = derivedBlock + c * 4;
+                _getTransformStream(inverse, c) = inverseBlock + c * 4;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    derivedBlock[c * 4 + i] = i < numLeft ? srcDerived[numPacked + i] : identity;
+                    inverseBlock[c * 4 + i] = i < numLeft ? srcInverse[numPacked + i] : identity;
+                }
+            }
+
+            _calculateFourBoneMatrices<true>(derived, inverse, matrixBlock, 0);
+
+            for (size_t i = 0; i < numLeft; ++i)
+            {
+                dstMatrices[numPacked + i] = matrixBlock[i];
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    // Map to convert 4-bits mask to 4 byte values
+    static const char msVisibilityMaskMapping[16][4] =
+    {
+        {0, 0, 0, 0},   {1, 0, 0, 0},   {0, 1, 0, 0},   {1, 1, 0, 0},
+        {0, 0, 1, 0},   {1, 0, 1, 0},   {0, 1, 1, 0},   {1, 1, 1, 0},
+        {0, 0, 0, 1},   {1, 0, 0, 1},   {0, 1, 0, 1},   {1, 1, 0, 1},
+        {0, 0, 1, 1},   {1, 0, 1, 1},   {0, 1, 1, 1},   {1, 1, 1, 1},
+    };
+    //---------------------------------------------------------------------
+    // Distance of four points to the plane, in the same operation order as
+    // Plane::getDistance so that the results match the scalar code.
+    static FORCEINLINE __m128 _calculatePlaneDistances(const Plane& plane,
+        const __m128& x, const __m128& y, const __m128& z)
+    {
+        __m128 dist = _mm_add_ps(
+            _mm_mul_ps(_mm_load_ps1(&plane.normal.x), x),
+            _mm_mul_ps(_mm_load_ps1(&plane.normal.y), y));
+        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_load_ps1(&plane.normal.z), z));
+        return _mm_add_ps(dist, _mm_load_ps1(&plane.d));
+    }
+    //---------------------------------------------------------------------
+    /// Returns the visibility of four boxes starting at index as a 4-bits mask
+    template <bool aligned>
+    static FORCEINLINE int _calculateFourBoxesVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* const centres[3],
+        const Real* const halfSizes[3],
+        size_t index)
+    {
+        typedef SSEMemoryAccessor<aligned> Accessor;
+
+        __m128 cx = Accessor::load(centres[0] + index);
+        __m128 cy = Accessor::load(centres[1] + index);
+        __m128 cz = Accessor::load(centres[2] + index);
+        __m128 hx = Accessor::load(halfSizes[0] + index);
+        __m128 hy = Accessor::load(halfSizes[1] + index);
+        __m128 hz = Accessor::load(halfSizes[2] + index);
+
+        __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 culled = _mm_setzero_ps();
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            const Plane& plane = planes[p];
+            __m128 dist = _calculatePlaneDistances(plane, cx, cy, cz);
+
+            // Projected half size onto the plane normal, which is
+            // |nx * hx| + |ny * hy| + |nz * hz| as in Plane::getSide
+            __m128 maxAbsDist = _mm_add_ps(
+                _mm_andnot_ps(signMask, _mm_mul_ps(_mm_load_ps1(&plane.normal.x), hx)),
+                _mm_andnot_ps(signMask, _mm_mul_ps(_mm_load_ps1(&plane.normal.y), hy)));
+            maxAbsDist = _mm_add_ps(maxAbsDist,
+                _mm_andnot_ps(signMask, _mm_mul_ps(_mm_load_ps1(&plane.normal.z), hz)));
+
+            // Culled when entirely on the negative side
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, _mm_xor_ps(maxAbsDist, signMask)));
+
+            // Early out once all boxes are culled
+            if (_mm_movemask_ps(culled) == 15)
+                break;
+        }
+
+        return ~_mm_movemask_ps(culled) & 15;
+    }
+    //---------------------------------------------------------------------
+    /// Returns the visibility of four spheres starting at index as a 4-bits mask
+    template <bool aligned>
+    static FORCEINLINE int _calculateFourSpheresVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* const centres[3],
+        const Real* radii,
+        size_t index)
+    {
+        typedef SSEMemoryAccessor<aligned> Accessor;
+
+        __m128 cx = Accessor::load(centres[0] + index);
+        __m128 cy = Accessor::load(centres[1] + index);
+        __m128 cz = Accessor::load(centres[2] + index);
+        __m128 negRadii = _mm_xor_ps(Accessor::load(radii + index), _mm_set1_ps(-0.0f));
+
+        __m128 culled = _mm_setzero_ps();
+        for (size_t p = 0; p < numPlanes; ++p)
+        {
+            __m128 dist = _calculatePlaneDistances(planes[p], cx, cy, cz);
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, negRadii));
+
+            // Early out once all spheres are culled
+            if (_mm_movemask_ps(culled) == 15)
+                break;
+        }
+
+        return ~_mm_movemask_ps(culled) & 15;
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateBoxesVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* const centres[3],
+        const Real* const halfSizes[3],
+        char* visibilities,
+        size_t numBoxes)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        size_t numPacked = numBoxes & ~3;
+        if (_isAlignedForSSE(centres[0]) && _isAlignedForSSE(centres[1]) &&
+            _isAlignedForSSE(centres[2]) && _isAlignedForSSE(halfSizes[0]) &&
+            _isAlignedForSSE(halfSizes[1]) && _isAlignedForSSE(halfSizes[2]))
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                int bitmask = _calculateFourBoxesVisibility<true>(
+                    planes, numPlanes, centres, halfSizes, i);
+                memcpy(visibilities + i, msVisibilityMaskMapping[bitmask], 4);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                int bitmask = _calculateFourBoxesVisibility<false>(
+                    planes, numPlanes, centres, halfSizes, i);
+                memcpy(visibilities + i, msVisibilityMaskMapping[bitmask], 4);
+            }
+        }
+
+        size_t numLeft = numBoxes - numPacked;
+        if (numLeft)
+        {
+            // Copy the remaining boxes to a padded block on the stack, so the
+            // same code path can handle them. Padding lanes are ignored.
+            OGRE_SIMD_ALIGNED_DECL(float, block[6 * 4]);
+            const Real* blockCentres[3] = { block, block + 4, block + 8 };
+            const Real* blockHalfSizes[3] = { block + 12, block + 16, block + 20 };
+            for (size_t c = 0; c < 3; ++c)
+            {
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    block[c * 4 + i] = i < numLeft ? centres[c][numPacked + i] : 0.0f;
+                    block[12 + c * 4 + i] = i < numLeft ? halfSizes[c][numPacked + i] : 0.0f;
+                }
+            }
+
+            int bitmask = _calculateFourBoxesVisibility<true>(
+                planes, numPlanes, blockCentres, blockHalfSizes, 0);
+            memcpy(visibilities + numPacked, msVisibilityMaskMapping[bitmask], numLeft);
+        }
+    }
+    //---------------------------------------------------------------------
+    void OptimisedUtilSSE::calculateSpheresVisibility(
+        const Plane* planes,
+        size_t numPlanes,
+        const Real* const centres[3],
+        const Real* radii,
+        char* visibilities,
+        size_t numSpheres)
+    {
+        __OGRE_CHECK_STACK_ALIGNED_FOR_SSE();
+
+        size_t numPacked = numSpheres & ~3;
+        if (_isAlignedForSSE(centres[0]) && _isAlignedForSSE(centres[1]) &&
+            _isAlignedForSSE(centres[2]) && _isAlignedForSSE(radii))
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                int bitmask = _calculateFourSpheresVisibility<true>(
+                    planes, numPlanes, centres, radii, i);
+                memcpy(visibilities + i, msVisibilityMaskMapping[bitmask], 4);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < numPacked; i += 4)
+            {
+                int bitmask = _calculateFourSpheresVisibility<false>(
+                    planes, numPlanes, centres, radii, i);
+                memcpy(visibilities + i, msVisibilityMaskMapping[bitmask], 4);
+            }
+        }
+
+        size_t numLeft = numSpheres - numPacked;
+        if (numLeft)
+        {
+            // Copy the remaining spheres to a padded block on the stack, so the
+            // same code path can handle them. Padding lanes are ignored.
+            OGRE_SIMD_ALIGNED_DECL(float, block[4 * 4]);
+            const Real* blockCentres[3] = { block, block + 4, block + 8 };
+            for (size_t c = 0; c < 3; ++c)
+            {
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    block[c * 4 + i] = i < numLeft ? centres[c][numPacked + i] : 0.0f;
+                }
+            }
+            for (size_t i = 0; i < 4; ++i)
+            {
+                block[12 + i] = i < numLeft ? radii[numPacked + i] : 0.0f;
+            }
+
+            int bitmask = _calculateFourSpheresVisibility<true>(
+                planes, numPlanes, blockCentres, block + 12, 0);
+            memcpy(visibilities + numPacked, msVisibilityMaskMapping[bitmask], numLeft);
+        }
+    }
+    //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     extern OptimisedUtil* _getOptimisedUtilSSE(void)
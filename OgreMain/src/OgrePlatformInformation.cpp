@@ -36,6 +36,9 @@ THE SOFTWARE.
 	#if _MSC_VER >= 1400
 		#include <intrin.h>
 	#endif
+	#if _MSC_VER >= 1600
+		#include <immintrin.h>  // For _xgetbv
+	#endif
 #elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_NACL
 #include <signal.h>
 #include <setjmp.h>
@@ -146,11 +149,20 @@ namespace Ogre {
     }
 
     //---------------------------------------------------------------------
-    // Performs CPUID instruction with 'query', fill the results, and return value of eax.
-    static uint _performCpuid(int query, CpuidResult& result)
+    // Performs CPUID instruction with 'query' and 'subQuery' (for the queries
+    // which have sub-leaves), fill the results, and return value of eax.
+    static uint _performCpuid(int query, CpuidResult& result, int subQuery = 0)
     {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
-	#if _MSC_VER >= 1400 
+	#if _MSC_VER >= 1500
+		int CPUInfo[4];
+		__cpuidex(CPUInfo, query, subQuery);
+		result._eax = CPUInfo[0];
+		result._ebx = CPUInfo[1];
+		result._ecx = CPUInfo[2];
+		result._edx = CPUInfo[3];
+		return result._eax;
+	#elif _MSC_VER >= 1400 
 		int CPUInfo[4];
 		__cpuid(CPUInfo, query);
 		result._eax = CPUInfo[0];
@@ -163,6 +175,7 @@ namespace Ogre {
         {
             mov     edi, result
             mov     eax, query
+            mov     ecx, subQuery
             cpuid
             mov     [edi]._eax, eax
             mov     [edi]._ebx, ebx
@@ -175,7 +188,7 @@ namespace Ogre {
         #if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (subQuery)
         );
         #else
         __asm__
@@ -185,7 +198,7 @@ namespace Ogre {
             "movl   %%ebx, %%edi    \n\t"
             "popl   %%ebx           \n\t"
             : "=a" (result._eax), "=D" (result._ebx), "=c" (result._ecx), "=d" (result._edx)
-            : "a" (query)
+            : "a" (query), "c" (subQuery)
         );
        #endif // OGRE_ARCHITECTURE_64
         return result._eax;
@@ -200,6 +213,31 @@ namespace Ogre {
 #pragma warning(pop)
 #endif
 
+    //---------------------------------------------------------------------
+    // Reads the extended control register 0, which tells the register states the
+    // os saves on context switches. Only valid if CPUID reports OSXSAVE.
+    static uint _getExtendedControlRegister(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+	#if _MSC_VER >= 1600
+		return (uint)_xgetbv(0);
+	#else
+		return 0;
+	#endif
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_NACL
+        uint eax, edx;
+        // xgetbv, encoded for the assemblers which don't know it
+        __asm__ __volatile__
+        (
+            ".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0)
+        );
+        return eax;
+#else
+        // TODO: Supports other compiler
+        return 0;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Detect whether or not os support Streaming SIMD Extension.
 #if (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_NACL
@@ -287,6 +325,13 @@ namespace Ogre {
 #define CPUID_STD_HTT               (1<<28)     // EDX[28] - Bit 28 set indicates  Hyper-Threading Technology is supported in hardware.
 
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0] - Bit 0 of standard function 1 indicate SSE3 supported
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - Bit 12 of standard function 1 indicate FMA supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate xgetbv usable
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+
+#define CPUID_STD7_AVX2             (1<<5)      // EBX[5] - Bit 5 of standard function 7 indicate AVX2 supported
+
+#define XCR0_SSE_AVX_STATE          0x06        // Bits 1 and 2 set when the os saves the XMM and YMM registers
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -304,7 +349,8 @@ namespace Ogre {
             CpuidResult result;
 
             // Has standard feature ?
-            if (_performCpuid(0, result))
+            uint maxStdQuery = _performCpuid(0, result);
+            if (maxStdQuery)
             {
                 // Check vendor strings
                 if (memcmp(&result._ebx, "GenuineIntel", 12) == 0)
@@ -377,6 +423,25 @@ namespace Ogre {
                             features |= PlatformInformation::CPU_FEATURE_MMXEXT;
                     }
                 }
+
+                // AVX can only be used if the os saves the YMM registers too
+                _performCpuid(1, result);
+                if ((result._ecx & CPUID_STD_OSXSAVE) && (result._ecx & CPUID_STD_AVX) &&
+                    (_getExtendedControlRegister() & XCR0_SSE_AVX_STATE) == XCR0_SSE_AVX_STATE)
+                {
+                    features |= PlatformInformation::CPU_FEATURE_AVX;
+
+                    if (result._ecx & CPUID_STD_FMA)
+                        features |= PlatformInformation::CPU_FEATURE_FMA;
+
+                    if (maxStdQuery >= 7)
+                    {
+                        _performCpuid(7, result, 0);
+
+                        if (result._ebx & CPUID_STD7_AVX2)
+                            features |= PlatformInformation::CPU_FEATURE_AVX2;
+                    }
+                }
             }
         }
 
@@ -616,6 +681,12 @@ namespace Ogre {
 				" *     SSE2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE2), true));
 			pLog->logMessage(
 				" *     SSE3: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE3), true));
+			pLog->logMessage(
+				" *      AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+			pLog->logMessage(
+				" *     AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+			pLog->logMessage(
+				" *      FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
 			pLog->logMessage(
 				" *      MMX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_MMX), true));
 			pLog->logMessage(
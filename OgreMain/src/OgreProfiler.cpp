@@ -60,11 +60,11 @@ namespace Ogre {
         assert( msSingleton );  return ( *msSingleton );  
     }
     //-----------------------------------------------------------------------
-    Profile::Profile(const String& profileName, uint32 groupID) 
+    Profile::Profile(const String& profileName, uint32 groupID, uint32* traceScope) 
 		: mName(profileName)
 		, mGroupID(groupID)
 	{
-        Ogre::Profiler::getSingleton().beginProfile(profileName, groupID);
+        Ogre::Profiler::getSingleton().beginProfile(profileName, groupID, traceScope);
     }
     //-----------------------------------------------------------------------
     Profile::~Profile()
@@ -74,6 +74,85 @@ namespace Ogre {
     //-----------------------------------------------------------------------
 
 
+    //-----------------------------------------------------------------------
+    // TRACE DEFINITIONS
+    //-----------------------------------------------------------------------
+    struct Profiler::TraceThread : public ProfilerAlloc
+    {
+        /// A completed profile
+        struct Event
+        {
+            uint32 scope;
+            uint32 group;
+            ulong start;
+            ulong duration;
+        };
+        /// A profile which has begun but not ended yet
+        struct OpenProfile
+        {
+            uint32 scope;
+            ulong start;
+        };
+
+        /// Position of the thread in the list of trace threads
+        size_t index;
+        /// Name of the thread in traces, set by the thread itself
+        String name;
+        /// Capture the events and open profiles belong to
+        uint32 capture;
+        /// Ring buffer of completed profiles
+        vector<Event>::type events;
+        /// Total number of profiles completed, may exceed the size of the ring
+        size_t recorded;
+        /// Profiles begun but not ended yet, innermost last
+        vector<OpenProfile>::type openProfiles;
+        /// Identifiers of the profile names already used by the thread
+        HashMap<String, uint32> scopeIds;
+        /// Taken by the thread while recording, and by exportTrace
+        OGRE_MUTEX(mutex);
+
+        TraceThread() : index(0), capture(0), recorded(0) {}
+    };
+    //-----------------------------------------------------------------------
+    struct Profiler::TraceThreadHandle : public ProfilerAlloc
+    {
+        // Owned by the Profiler, so that the trace of a thread can still be
+        // exported after it exits
+        TraceThread* thread;
+    };
+    //-----------------------------------------------------------------------
+    vector<String>::type Profiler::msTraceScopeNames;
+    HashMap<String, uint32> Profiler::msTraceScopeIds;
+    OGRE_STATIC_MUTEX_INSTANCE(Profiler::msTraceScopeMutex)
+    //-----------------------------------------------------------------------
+    static const char* getTraceCategory(uint32 groupID)
+    {
+        if (groupID & OGREPROF_CULLING)
+            return "culling";
+        if (groupID & OGREPROF_RENDERING)
+            return "rendering";
+        if (groupID & OGREPROF_GENERAL)
+            return "general";
+        return "user";
+    }
+    //-----------------------------------------------------------------------
+    static void writeTraceString(std::ostream& stream, const String& str)
+    {
+        stream << '"';
+        for (String::const_iterator i = str.begin(); i != str.end(); ++i)
+        {
+            const unsigned char c = *i;
+            if (c == '"' || c == '\\')
+                stream << '\\' << c;
+            else if (c < 0x20)
+                stream << "\\u00" << std::hex << std::setw(2) << std::setfill('0') << (int)c << std::dec;
+            else
+                stream << c;
+        }
+        stream << '"';
+    }
+
+
     //-----------------------------------------------------------------------
     // PROFILER DEFINITIONS
     //-----------------------------------------------------------------------
@@ -92,8 +171,16 @@ namespace Ogre {
 		, mMaxTotalFrameTime(0)
 		, mAverageFrameTime(0)
 		, mResetExtents(false)
+		, mMainTraceThread(0)
+		, OGRE_THREAD_POINTER_INIT(mTraceThreadHandle)
+		, mTraceCapturing(false)
+		, mTraceCapture(0)
+		, mTraceBufferSize(65536)
 	{
 		mRoot.hierarchicalLvl = 0 - 1;
+
+		mMainTraceThread = getTraceThread();
+		mMainTraceThread->name = "Main";
     }
 	//-----------------------------------------------------------------------
 	ProfileInstance::ProfileInstance(void)
@@ -136,6 +223,11 @@ namespace Ogre {
 
         // clear all our lists
         mDisabledProfiles.clear();
+
+        OGRE_THREAD_POINTER_DELETE(mTraceThreadHandle);
+        for (TraceThreadList::iterator i = mTraceThreads.begin(); i != mTraceThreads.end(); ++i)
+            OGRE_DELETE *i;
+        mTraceThreads.clear();
     }
     //-----------------------------------------------------------------------
     void Profiler::setTimer(Timer* t)
@@ -195,8 +287,20 @@ namespace Ogre {
 		mDisabledProfiles.erase(profileName);
     }
     //-----------------------------------------------------------------------
-    void Profiler::beginProfile(const String& profileName, uint32 groupID) 
+    void Profiler::beginProfile(const String& profileName, uint32 groupID, uint32* traceScope) 
 	{
+		const bool traceCapturing = mTraceCapturing.get();
+		if (traceCapturing || mEnabled)
+		{
+			TraceThread* thread = getTraceThread();
+			if (traceCapturing && (groupID & mProfileMask))
+				beginTraceProfile(thread, profileName, traceScope);
+
+			// The frame statistics only follow the thread the profiler was created on
+			if (thread != mMainTraceThread)
+				return;
+		}
+
 		// regardless of whether or not we are enabled, we need the application's root profile (ie the first profile started each frame)
 		// we need this so bogus profiles don't show up when users enable profiling mid frame
 		// so we check
@@ -256,6 +360,18 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Profiler::endProfile(const String& profileName, uint32 groupID) 
 	{
+		const bool traceCapturing = mTraceCapturing.get();
+		if (traceCapturing || mEnabled || mNewEnableState)
+		{
+			TraceThread* thread = getTraceThread();
+			if (traceCapturing && (groupID & mProfileMask))
+				endTraceProfile(thread, groupID);
+
+			// The frame statistics only follow the thread the profiler was created on
+			if (thread != mMainTraceThread)
+				return;
+		}
+
 		if(!mEnabled) 
 		{
 			// if the profiler received a request to be enabled or disabled
@@ -379,6 +495,186 @@ namespace Ogre {
     {
         Root::getSingleton().getRenderSystem()->markProfileEvent(event);
     }
+	//-----------------------------------------------------------------------
+	Profiler::TraceThread* Profiler::getTraceThread(void)
+	{
+		TraceThreadHandle* handle = OGRE_THREAD_POINTER_GET(mTraceThreadHandle);
+		if (!handle)
+		{
+			handle = OGRE_NEW TraceThreadHandle();
+			handle->thread = OGRE_NEW TraceThread();
+			{
+				OGRE_LOCK_MUTEX(mTraceMutex)
+				handle->thread->index = mTraceThreads.size();
+				mTraceThreads.push_back(handle->thread);
+			}
+			OGRE_THREAD_POINTER_SET(mTraceThreadHandle, handle);
+		}
+		return handle->thread;
+	}
+	//-----------------------------------------------------------------------
+	uint32 Profiler::registerTraceScope(const String& profileName)
+	{
+		OGRE_LOCK_MUTEX(msTraceScopeMutex)
+		HashMap<String, uint32>::iterator i = msTraceScopeIds.find(profileName);
+		if (i != msTraceScopeIds.end())
+			return i->second;
+
+		uint32 id = static_cast<uint32>(msTraceScopeNames.size());
+		msTraceScopeNames.push_back(profileName);
+		msTraceScopeIds[profileName] = id;
+		return id;
+	}
+	//-----------------------------------------------------------------------
+	uint32 Profiler::getTraceScopeId(TraceThread* thread, const String& profileName)
+	{
+		// Look in the names already used by the thread first, to avoid the lock
+		HashMap<String, uint32>::iterator i = thread->scopeIds.find(profileName);
+		if (i != thread->scopeIds.end())
+			return i->second;
+
+		uint32 id = registerTraceScope(profileName);
+		thread->scopeIds[profileName] = id;
+		return id;
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::beginTraceProfile(TraceThread* thread, const String& profileName, uint32* traceScope)
+	{
+		TraceThread::OpenProfile profile;
+		if (traceScope)
+		{
+			// The cache holds the identifier plus one, so that zero means unknown.
+			// Threads using the call site for the first time at once all store
+			// the same value.
+			if (!*traceScope)
+				*traceScope = registerTraceScope(profileName) + 1;
+			profile.scope = *traceScope - 1;
+		}
+		else
+		{
+			profile.scope = getTraceScopeId(thread, profileName);
+		}
+
+		OGRE_LOCK_MUTEX(thread->mutex)
+		const uint32 capture = mTraceCapture.get();
+		if (thread->capture != capture)
+		{
+			// First profile of this thread in a new capture
+			thread->capture = capture;
+			thread->recorded = 0;
+			thread->openProfiles.clear();
+			thread->events.resize(mTraceBufferSize);
+		}
+
+		profile.start = mTimer->getMicroseconds();
+		thread->openProfiles.push_back(profile);
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::endTraceProfile(TraceThread* thread, uint32 groupID)
+	{
+		const ulong endTime = mTimer->getMicroseconds();
+
+		OGRE_LOCK_MUTEX(thread->mutex)
+		// Ignore the profiles begun before the capture
+		if (thread->capture != mTraceCapture.get() || thread->openProfiles.empty())
+			return;
+
+		const TraceThread::OpenProfile& profile = thread->openProfiles.back();
+		TraceThread::Event& event = thread->events[thread->recorded % thread->events.size()];
+		event.scope = profile.scope;
+		event.group = groupID;
+		event.start = profile.start;
+		event.duration = endTime - profile.start;
+		++thread->recorded;
+		thread->openProfiles.pop_back();
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::beginTraceCapture(void)
+	{
+		assert (mTimer && "Timer not set!");
+
+		// Threads reset their own buffers when they notice the new capture
+		++mTraceCapture;
+		mTraceCapturing.set(true);
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::endTraceCapture(void)
+	{
+		mTraceCapturing.set(false);
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::setTraceBufferSize(size_t profiles)
+	{
+		mTraceBufferSize = std::max(profiles, (size_t)1);
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::setTraceThreadName(const String& name)
+	{
+		TraceThread* thread = getTraceThread();
+		OGRE_LOCK_MUTEX(thread->mutex)
+		thread->name = name;
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::exportTrace(std::ostream& stream)
+	{
+		if (mTraceCapturing.get())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+				"Cannot export a trace while it is being captured",
+				"Profiler::exportTrace");
+		}
+
+		OGRE_LOCK_MUTEX(mTraceMutex)
+		OGRE_LOCK_MUTEX_NAMED(msTraceScopeMutex, scopeLock)
+
+		const uint32 capture = mTraceCapture.get();
+		stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		bool first = true;
+		for (TraceThreadList::iterator i = mTraceThreads.begin(); i != mTraceThreads.end(); ++i)
+		{
+			const TraceThread* thread = *i;
+			// Threads may still be ending the profiles they begun during the capture
+			OGRE_LOCK_MUTEX_NAMED(thread->mutex, threadLock)
+			if (thread->capture != capture || capture == 0)
+				continue;
+
+			stream << (first ? "\n" : ",\n");
+			first = false;
+			stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread->index
+				<< ",\"args\":{\"name\":";
+			writeTraceString(stream, thread->name.empty() ?
+				"Thread " + StringConverter::toString(thread->index) : thread->name);
+			stream << "}}";
+
+			// Oldest events first, once the ring has wrapped
+			const size_t size = thread->events.size();
+			const size_t count = std::min(thread->recorded, size);
+			const size_t begin = thread->recorded > size ? thread->recorded % size : 0;
+			for (size_t e = 0; e < count; ++e)
+			{
+				const TraceThread::Event& event = thread->events[(begin + e) % size];
+				stream << ",\n{\"name\":";
+				writeTraceString(stream, msTraceScopeNames[event.scope]);
+				stream << ",\"cat\":\"" << getTraceCategory(event.group)
+					<< "\",\"ph\":\"X\",\"ts\":" << event.start
+					<< ",\"dur\":" << event.duration
+					<< ",\"pid\":0,\"tid\":" << thread->index << "}";
+			}
+		}
+		stream << "\n]}\n";
+	}
+	//-----------------------------------------------------------------------
+	void Profiler::exportTrace(const String& filename)
+	{
+		std::ofstream stream(filename.c_str());
+		if (!stream)
+		{
+			OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+				"Unable to open trace file '" + filename + "'",
+				"Profiler::exportTrace");
+		}
+		exportTrace(stream);
+	}
 	//-----------------------------------------------------------------------
 	void Profiler::processFrameStats(ProfileInstance* instance, Real& maxFrameTime)
 	{
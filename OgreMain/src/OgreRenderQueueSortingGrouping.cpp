@@ -32,9 +32,7 @@ THE SOFTWARE.
 namespace Ogre {
     // Init statics
     RadixSort<QueuedRenderableCollection::RenderablePassList,
-        RenderablePass, uint32> QueuedRenderableCollection::msRadixSorter1;
-    RadixSort<QueuedRenderableCollection::RenderablePassList,
-        RenderablePass, float> QueuedRenderableCollection::msRadixSorter2;
+        RenderablePass, uint64> QueuedRenderableCollection::msRadixSorter;
 
 
 	//-----------------------------------------------------------------------
@@ -305,8 +303,9 @@ namespace Ogre {
             i->second->clear();
         }
 
-		// Clear sorted list
+		// Clear sorted lists
 		mSortedDescending.clear();
+		mSortedByKey.clear();
 	}
     //-----------------------------------------------------------------------
 	void QueuedRenderableCollection::removePassGroup(Pass* p)
@@ -322,6 +321,31 @@ namespace Ogre {
             mGrouped.erase(i);
         }
 	}
+    //-----------------------------------------------------------------------
+	uint32 QueuedRenderableCollection::getOrderedBits(float value)
+	{
+		uint32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		// Flip all bits of negatives so they order in reverse, and the
+		// sign bit of positives so they follow the negatives
+		return bits ^ ((bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000);
+	}
+    //-----------------------------------------------------------------------
+	uint64 QueuedRenderableCollection::RadixSortFunctorDistance::operator()(
+		const RenderablePass& p) const
+	{
+		// Sort DESCENDING by depth (ie far objects first), then by pass
+		float depth = static_cast<float>(p.renderable->getSquaredViewDepth(camera));
+		return (static_cast<uint64>(~getOrderedBits(depth)) << 32) | p.pass->getHash();
+	}
+    //-----------------------------------------------------------------------
+	uint64 QueuedRenderableCollection::RadixSortFunctorPassDistance::operator()(
+		const RenderablePass& p) const
+	{
+		// Group by pass, then ascending depth within the pass
+		float depth = static_cast<float>(p.renderable->getSquaredViewDepth(camera));
+		return (static_cast<uint64>(p.pass->getHash()) << 32) | getOrderedBits(depth);
+	}
     //-----------------------------------------------------------------------
 	void QueuedRenderableCollection::sort(const Camera* cam)
     {
@@ -332,8 +356,7 @@ namespace Ogre {
 		{
 			
 			// We can either use a stable_sort and the 'less' implementation,
-			// or a 2-pass radix sort (once by pass, then by distance, since
-			// radix sorting is inherently stable this will work)
+			// or a radix sort on a key packing the distance above the pass
 			// We use stable_sort if the number of items is 512 or less, since
 			// the complexity of the radix sort is approximately O(10N), since 
 			// each sort is O(5N) (1 pass histograms, 4 passes sort)
@@ -344,10 +367,7 @@ namespace Ogre {
 			
 			if (mSortedDescending.size() > 2000)
 			{
-				// sort by pass
-				msRadixSorter1.sort(mSortedDescending, RadixSortFunctorPass());
-				// sort by depth
-				msRadixSorter2.sort(mSortedDescending, RadixSortFunctorDistance(cam));
+				msRadixSorter.sort(mSortedDescending, RadixSortFunctorDistance(cam));
 			}
 			else
 			{
@@ -357,6 +377,23 @@ namespace Ogre {
 			}
 		}
 
+		if (mOrganisationMode & OM_SORT_KEY)
+		{
+			// The keys are computed once per item by the radix sort, which
+			// skips its sort passes when the items were queued in key order;
+			// only tiny lists are cheaper to sort by comparison
+			if (mSortedByKey.size() > 64)
+			{
+				msRadixSorter.sort(mSortedByKey, RadixSortFunctorPassDistance(cam));
+			}
+			else
+			{
+				std::stable_sort(
+					mSortedByKey.begin(), mSortedByKey.end(), 
+					PassDistanceLess(cam));
+			}
+		}
+
 		// Nothing needs to be done for pass groups, they auto-organise
 
     }
@@ -369,6 +406,11 @@ namespace Ogre {
 			mSortedDescending.push_back(RenderablePass(rend, pass));
 		}
 
+		if (mOrganisationMode & OM_SORT_KEY)
+		{
+			mSortedByKey.push_back(RenderablePass(rend, pass));
+		}
+
 		if (mOrganisationMode & OM_PASS_GROUP)
 		{
             PassGroupRenderableMap::iterator i = mGrouped.find(pass);
@@ -401,6 +443,8 @@ namespace Ogre {
 			// try to fall back
 			if (OM_PASS_GROUP & mOrganisationMode)
 				om = OM_PASS_GROUP;
+			else if (OM_SORT_KEY & mOrganisationMode)
+				om = OM_SORT_KEY;
 			else if (OM_SORT_ASCENDING & mOrganisationMode)
 				om = OM_SORT_ASCENDING;
 			else if (OM_SORT_DESCENDING & mOrganisationMode)
@@ -423,6 +467,9 @@ namespace Ogre {
 		case OM_SORT_ASCENDING:
 			acceptVisitorAscending(visitor);
 			break;
+		case OM_SORT_KEY:
+			acceptVisitorSortKey(visitor);
+			break;
 		}
 		
 	}
@@ -479,10 +526,35 @@ namespace Ogre {
 		}
 
 	}
+    //-----------------------------------------------------------------------
+	void QueuedRenderableCollection::acceptVisitorSortKey(
+		QueuedRenderableVisitor* visitor) const
+	{
+		// Items sharing a pass are adjacent after sorting, so visit the pass
+		// each time it changes
+		const Pass* currentPass = 0;
+		bool skipPass = false;
+
+		RenderablePassList::const_iterator i, iend;
+		iend = mSortedByKey.end();
+		for (i = mSortedByKey.begin(); i != iend; ++i)
+		{
+			if (i->pass != currentPass)
+			{
+				currentPass = i->pass;
+				// Visit Pass - allow skip
+				skipPass = !visitor->visit(currentPass);
+			}
+
+			if (!skipPass)
+				visitor->visit(i->renderable);
+		}
+	}
     //-----------------------------------------------------------------------
 	void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
 	{
 		mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
+		mSortedByKey.insert( mSortedByKey.end(), rhs.mSortedByKey.begin(), rhs.mSortedByKey.end() );
 
 		PassGroupRenderableMap::const_iterator srcGroup;
 		for( srcGroup = rhs.mGrouped.begin(); srcGroup != rhs.mGrouped.end(); ++srcGroup )
@@ -36,8 +36,10 @@ THE SOFTWARE.
 
 namespace Ogre {
 
-	// Note, no locks are required here anymore because all of the parallelisation
-	// is now contained in WorkQueue - this class is entirely single-threaded
+	// Note, the parallelisation is contained in WorkQueue, the only lock needed
+	// here guards the bookkeeping of requests, as worker threads hand the
+	// queued requests to the WorkQueue as soon as they have processed one. It
+	// is never held while loading resources or calling listeners.
 	//------------------------------------------------------------------------
     //-----------------------------------------------------------------------
     template<> ResourceBackgroundQueue* Singleton<ResourceBackgroundQueue>::msSingleton = 0;
@@ -52,6 +54,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------	
 	//------------------------------------------------------------------------
 	ResourceBackgroundQueue::ResourceBackgroundQueue()
+		: mNumRunningRequests(0), mMaxActiveRequests(0)
+		, mLoadTimeBudget(0), mLoadSizeBudget(0), mNextTicket(1)
 	{
 	}
 	//------------------------------------------------------------------------
@@ -70,6 +74,21 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	void ResourceBackgroundQueue::shutdown()
 	{
+		{
+			OGRE_LOCK_MUTEX(mRequestMutex)
+
+			for (ResourceRequestList::iterator i = mQueuedRequests.begin(); i != mQueuedRequests.end(); ++i)
+			{
+				mOutstandingRequestSet.erase(i->ticket);
+				discardRequest(*i);
+			}
+			mQueuedRequests.clear();
+			for (ResourceResponseList::iterator i = mPendingLoads.begin(); i != mPendingLoads.end(); ++i)
+				mOutstandingRequestSet.erase(i->request.ticket);
+			mPendingLoads.clear();
+		}
+
+		// not locked, a worker thread may be waiting for the lock in handleRequest
 		WorkQueue* wq = Root::getSingleton().getWorkQueue();
 		wq->abortRequestsByChannel(mWorkQueueChannel);
 		wq->removeRequestHandler(mWorkQueueChannel, this);
@@ -77,7 +96,7 @@ namespace Ogre {
 	}
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::initialiseResourceGroup(
-		const String& name, ResourceBackgroundQueue::Listener* listener)
+		const String& name, ResourceBackgroundQueue::Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -85,6 +104,7 @@ namespace Ogre {
 		req.type = RT_INITIALISE_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -95,13 +115,14 @@ namespace Ogre {
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket 
 	ResourceBackgroundQueue::initialiseAllResourceGroups( 
-		ResourceBackgroundQueue::Listener* listener)
+		ResourceBackgroundQueue::Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
 		ResourceRequest req;
 		req.type = RT_INITIALISE_ALL_GROUPS;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -111,7 +132,7 @@ namespace Ogre {
 	}
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::prepareResourceGroup(
-		const String& name, ResourceBackgroundQueue::Listener* listener)
+		const String& name, ResourceBackgroundQueue::Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -119,6 +140,7 @@ namespace Ogre {
 		req.type = RT_PREPARE_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -128,7 +150,7 @@ namespace Ogre {
 	}
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::loadResourceGroup(
-		const String& name, ResourceBackgroundQueue::Listener* listener)
+		const String& name, ResourceBackgroundQueue::Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -136,6 +158,7 @@ namespace Ogre {
 		req.type = RT_LOAD_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -149,7 +172,7 @@ namespace Ogre {
 		const String& group, bool isManual, 
 		ManualResourceLoader* loader, 
 		const NameValuePairList* loadParams, 
-		ResourceBackgroundQueue::Listener* listener)
+		ResourceBackgroundQueue::Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -163,6 +186,7 @@ namespace Ogre {
 		// Make instance copy of loadParams for thread independence
 		req.loadParams = ( loadParams ? OGRE_NEW_T(NameValuePairList, MEMCATEGORY_GENERAL)( *loadParams ) : 0 );
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -178,7 +202,7 @@ namespace Ogre {
 		const String& group, bool isManual, 
 		ManualResourceLoader* loader, 
 		const NameValuePairList* loadParams, 
-		ResourceBackgroundQueue::Listener* listener)
+		ResourceBackgroundQueue::Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -192,6 +216,7 @@ namespace Ogre {
 		// Make instance copy of loadParams for thread independence
 		req.loadParams = ( loadParams ? OGRE_NEW_T(NameValuePairList, MEMCATEGORY_GENERAL)( *loadParams ) : 0 );
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -203,7 +228,7 @@ namespace Ogre {
 	}
 	//---------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::unload(
-		const String& resType, const String& name, Listener* listener)
+		const String& resType, const String& name, Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -212,6 +237,7 @@ namespace Ogre {
 		req.resourceType = resType;
 		req.resourceName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -224,7 +250,7 @@ namespace Ogre {
 	}
 	//---------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::unload(
-		const String& resType, ResourceHandle handle, Listener* listener)
+		const String& resType, ResourceHandle handle, Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -233,6 +259,7 @@ namespace Ogre {
 		req.resourceType = resType;
 		req.resourceHandle = handle;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -245,7 +272,7 @@ namespace Ogre {
 	}
 	//---------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::unloadResourceGroup(
-		const String& name, Listener* listener)
+		const String& name, Listener* listener, uint8 priority)
 	{
 #if OGRE_THREAD_SUPPORT
 		// queue a request
@@ -253,6 +280,7 @@ namespace Ogre {
 		req.type = RT_UNLOAD_GROUP;
 		req.groupName = name;
 		req.listener = listener;
+		req.priority = priority;
 		return addRequest(req);
 #else
 		// synchronous
@@ -265,29 +293,257 @@ namespace Ogre {
 	bool ResourceBackgroundQueue::isProcessComplete(
 			BackgroundProcessTicket ticket)
 	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
 		return mOutstandingRequestSet.find(ticket) == mOutstandingRequestSet.end();
 	}
 	//------------------------------------------------------------------------
+	BackgroundProcessState ResourceBackgroundQueue::getProcessState(
+		BackgroundProcessTicket ticket)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		if (mOutstandingRequestSet.find(ticket) == mOutstandingRequestSet.end())
+			return BPS_COMPLETE;
+
+		for (ResourceRequestList::iterator i = mQueuedRequests.begin(); i != mQueuedRequests.end(); ++i)
+		{
+			if (i->ticket == ticket)
+				return BPS_QUEUED;
+		}
+		for (ResourceResponseList::iterator i = mPendingLoads.begin(); i != mPendingLoads.end(); ++i)
+		{
+			if (i->request.ticket == ticket)
+				return BPS_WAITING_FOR_LOAD;
+		}
+		return BPS_PROCESSING;
+	}
+	//------------------------------------------------------------------------
     void ResourceBackgroundQueue::abortRequest( BackgroundProcessTicket ticket )
     {
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		for (ResourceRequestList::iterator i = mQueuedRequests.begin(); i != mQueuedRequests.end(); ++i)
+		{
+			if (i->ticket == ticket)
+			{
+				discardRequest(*i);
+				mQueuedRequests.erase(i);
+				mOutstandingRequestSet.erase(ticket);
+				return;
+			}
+		}
+		for (ResourceResponseList::iterator i = mPendingLoads.begin(); i != mPendingLoads.end(); ++i)
+		{
+			if (i->request.ticket == ticket)
+			{
+				mPendingLoads.erase(i);
+				mOutstandingRequestSet.erase(ticket);
+				return;
+			}
+		}
+		// the ticket is dropped once the WorkQueue returns the aborted request
+		for (ActiveRequestMap::iterator i = mActiveRequests.begin(); i != mActiveRequests.end(); ++i)
+		{
+			if (i->second.ticket == ticket)
+			{
+				Root::getSingleton().getWorkQueue()->abortRequest(i->first);
+				return;
+			}
+		}
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::abortRequestsBelowPriority(uint8 priority)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		for (ResourceRequestList::iterator i = mQueuedRequests.begin(); i != mQueuedRequests.end(); )
+		{
+			if (i->priority < priority)
+			{
+				discardRequest(*i);
+				mOutstandingRequestSet.erase(i->ticket);
+				i = mQueuedRequests.erase(i);
+			}
+			else
+				++i;
+		}
+		for (ResourceResponseList::iterator i = mPendingLoads.begin(); i != mPendingLoads.end(); )
+		{
+			if (i->request.priority < priority)
+			{
+				mOutstandingRequestSet.erase(i->request.ticket);
+				i = mPendingLoads.erase(i);
+			}
+			else
+				++i;
+		}
 		WorkQueue* queue = Root::getSingleton().getWorkQueue();
+		for (ActiveRequestMap::iterator i = mActiveRequests.begin(); i != mActiveRequests.end(); ++i)
+		{
+			if (i->second.priority < priority)
+				queue->abortRequest(i->first);
+		}
+	}
+	//------------------------------------------------------------------------
+	bool ResourceBackgroundQueue::setRequestPriority(BackgroundProcessTicket ticket, uint8 priority)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		for (ResourceRequestList::iterator i = mQueuedRequests.begin(); i != mQueuedRequests.end(); ++i)
+		{
+			if (i->ticket == ticket)
+			{
+				ResourceRequest req = *i;
+				mQueuedRequests.erase(i);
+				req.priority = priority;
+				queueRequest(req);
+				return true;
+			}
+		}
+		for (ResourceResponseList::iterator i = mPendingLoads.begin(); i != mPendingLoads.end(); ++i)
+		{
+			if (i->request.ticket == ticket)
+			{
+				ResourceResponse resresp = *i;
+				mPendingLoads.erase(i);
+				resresp.request.priority = priority;
+				queuePendingLoad(resresp);
+				return true;
+			}
+		}
+		for (ActiveRequestMap::iterator i = mActiveRequests.begin(); i != mActiveRequests.end(); ++i)
+		{
+			if (i->second.ticket == ticket)
+			{
+				// still applies to abortRequestsBelowPriority
+				i->second.priority = priority;
+				break;
+			}
+		}
+		return false;
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::setMaxActiveRequests(size_t count)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+		mMaxActiveRequests = count;
+		dispatchRequests();
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::setLoadTimeBudget(unsigned long ms)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+		mLoadTimeBudget = ms;
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::setLoadSizeBudget(size_t bytes)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+		mLoadSizeBudget = bytes;
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::_processPendingLoads(void)
+	{
+		Timer* timer = Root::getSingleton().getTimer();
+		unsigned long msStart = timer->getMilliseconds();
+		size_t bytesLoaded = 0;
 
-		queue->abortRequest( ticket );
+		while (true)
+		{
+			// take the next response out of the list to run it unlocked
+			ResourceResponseList next;
+			{
+				OGRE_LOCK_MUTEX(mRequestMutex)
+				if (mPendingLoads.empty())
+					break;
+				next.splice(next.end(), mPendingLoads, mPendingLoads.begin());
+			}
+
+			ResourceResponse& resresp = next.front();
+			completeRequest(resresp);
+
+			// at least one load is run per call, however long it takes
+			if (!resresp.resource.isNull())
+				bytesLoaded += resresp.resource->getSize();
+			if (mLoadSizeBudget && bytesLoaded >= mLoadSizeBudget)
+				break;
+			if (mLoadTimeBudget && timer->getMilliseconds() - msStart >= mLoadTimeBudget)
+				break;
+		}
 	}
 	//------------------------------------------------------------------------
 	BackgroundProcessTicket ResourceBackgroundQueue::addRequest(ResourceRequest& req)
 	{
 		WorkQueue* queue = Root::getSingleton().getWorkQueue();
+		if (!queue->getRequestsAccepted())
+		{
+			discardRequest(req);
+			return 0;
+		}
 
-		Any data(req);
+		OGRE_LOCK_MUTEX(mRequestMutex)
 
-		WorkQueue::RequestID requestID = 
-			queue->addRequest(mWorkQueueChannel, (uint16)req.type, data);
+		req.ticket = mNextTicket++;
+		mOutstandingRequestSet.insert(req.ticket);
+		queueRequest(req);
+		dispatchRequests();
+
+		return req.ticket;
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::queueRequest(const ResourceRequest& req)
+	{
+		ResourceRequestList::iterator i = mQueuedRequests.begin();
+		while (i != mQueuedRequests.end() && i->priority >= req.priority)
+			++i;
+		mQueuedRequests.insert(i, req);
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::queuePendingLoad(const ResourceResponse& resresp)
+	{
+		ResourceResponseList::iterator i = mPendingLoads.begin();
+		while (i != mPendingLoads.end() && i->request.priority >= resresp.request.priority)
+			++i;
+		mPendingLoads.insert(i, resresp);
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::dispatchRequests(void)
+	{
+		WorkQueue* queue = Root::getSingleton().getWorkQueue();
 
+		while (!mQueuedRequests.empty() &&
+			(!mMaxActiveRequests || mNumRunningRequests < mMaxActiveRequests))
+		{
+			ResourceRequest& req = mQueuedRequests.front();
 
-		mOutstandingRequestSet.insert(requestID);
+			Any data(req);
+			WorkQueue::RequestID requestID =
+				queue->addRequest(mWorkQueueChannel, (uint16)req.type, data);
 
-		return requestID;
+			if (requestID)
+			{
+				ActiveRequest& active = mActiveRequests[requestID];
+				active.ticket = req.ticket;
+				active.priority = req.priority;
+				++mNumRunningRequests;
+			}
+			else
+			{
+				// the queue stopped accepting requests since this one was added
+				discardRequest(req);
+				mOutstandingRequestSet.erase(req.ticket);
+			}
+			mQueuedRequests.pop_front();
+		}
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::discardRequest(ResourceRequest& req)
+	{
+		if( req.type == RT_PREPARE_RESOURCE || req.type == RT_LOAD_RESOURCE )
+		{
+			OGRE_DELETE_T(req.loadParams, NameValuePairList, MEMCATEGORY_GENERAL);
+			req.loadParams = 0;
+		}
 	}
 	//-----------------------------------------------------------------------
 	bool ResourceBackgroundQueue::canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
@@ -296,6 +552,18 @@ namespace Ogre {
 	}
 	//-----------------------------------------------------------------------
 	WorkQueue::Response* ResourceBackgroundQueue::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+	{
+		WorkQueue::Response* response = processRequest(req);
+
+		// make room for the next queued request
+		OGRE_LOCK_MUTEX(mRequestMutex)
+		--mNumRunningRequests;
+		dispatchRequests();
+
+		return response;
+	}
+	//-----------------------------------------------------------------------
+	WorkQueue::Response* ResourceBackgroundQueue::processRequest(const WorkQueue::Request* req)
 	{
 
 		ResourceRequest resreq = any_cast<ResourceRequest>(req->getData());
@@ -405,20 +673,51 @@ namespace Ogre {
 	//------------------------------------------------------------------------
 	void ResourceBackgroundQueue::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
 	{
-		if( res->getRequest()->getAborted() )
+		BackgroundProcessTicket ticket = 0;
 		{
-			mOutstandingRequestSet.erase(res->getRequest()->getID());
-			return ;
+			OGRE_LOCK_MUTEX(mRequestMutex)
+
+			ActiveRequestMap::iterator i = mActiveRequests.find(res->getRequest()->getID());
+			if (i != mActiveRequests.end())
+			{
+				ticket = i->second.ticket;
+				mActiveRequests.erase(i);
+			}
+
+			// the data of aborted requests is gone already
+			if (res->getRequest()->getAborted())
+			{
+				mOutstandingRequestSet.erase(ticket);
+				return;
+			}
 		}
 
-		if (res->succeeded())
-		{
-			ResourceResponse resresp = any_cast<ResourceResponse>(res->getData());
+		ResourceResponse resresp = any_cast<ResourceResponse>(res->getData());
 
+#if OGRE_THREAD_SUPPORT == 2
+		// Leave the load commands, which would have been downgraded to prepare()
+		// for the background, to _processPendingLoads if their time is limited
+		const ResourceRequest& req = resresp.request;
+		if (res->succeeded() && (req.type == RT_LOAD_RESOURCE || req.type == RT_LOAD_GROUP))
+		{
+			OGRE_LOCK_MUTEX(mRequestMutex)
+			if (mLoadTimeBudget || mLoadSizeBudget)
+			{
+				queuePendingLoad(resresp);
+				return;
+			}
+		}
+#endif
+		completeRequest(resresp);
+	}
+	//------------------------------------------------------------------------
+	void ResourceBackgroundQueue::completeRequest(ResourceResponse& resresp)
+	{
+		const ResourceRequest& req = resresp.request;
+		if (!req.result.error)
+		{
 			// Complete full loading in main thread if semithreading
-			const ResourceRequest& req = resresp.request;
 #if OGRE_THREAD_SUPPORT == 2
-			// These load commands would have been downgraded to prepare() for the background
 			if (req.type == RT_LOAD_RESOURCE)
 			{
 				ResourceManager *rm = ResourceGroupManager::getSingleton()
@@ -430,27 +729,30 @@ namespace Ogre {
 				ResourceGroupManager::getSingleton().loadResourceGroup(req.groupName);
 			}
 #endif
-			mOutstandingRequestSet.erase(res->getRequest()->getID());
+		}
 
-			// Call resource listener
-			if (!resresp.resource.isNull()) 
-			{
+		{
+			OGRE_LOCK_MUTEX(mRequestMutex)
+			mOutstandingRequestSet.erase(req.ticket);
+		}
 
-				if (req.type == RT_LOAD_RESOURCE) 
-				{
-					resresp.resource->_fireLoadingComplete( true );
-				} 
-				else 
-				{
-					resresp.resource->_firePreparingComplete( true );
-				}
-			} 
+		// Call resource listener
+		if (!req.result.error && !resresp.resource.isNull()) 
+		{
 
-			// Call queue listener
-			if (req.listener)
-				req.listener->operationCompleted(res->getRequest()->getID(), req.result);
+			if (req.type == RT_LOAD_RESOURCE) 
+			{
+				resresp.resource->_fireLoadingComplete( true );
+			} 
+			else 
+			{
+				resresp.resource->_firePreparingComplete( true );
+			}
+		} 
 
-		}
+		// Call queue listener
+		if (req.listener)
+			req.listener->operationCompleted(req.ticket, req.result);
 	}
 	//------------------------------------------------------------------------
 
@@ -55,7 +55,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mCurrentGroup(0), mPrepareTaskGroup(0), mScriptTaskGroup(0)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME);
@@ -69,6 +69,9 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ResourceGroupManager::~ResourceGroupManager()
     {
+        OGRE_DELETE mPrepareTaskGroup;
+        OGRE_DELETE mScriptTaskGroup;
+
         // delete all resource groups
         ResourceGroupMap::iterator i, iend;
         iend = mResourceGroupMap.end();
@@ -159,6 +162,12 @@ namespace Ogre {
     void ResourceGroupManager::prepareResourceGroup(const String& name, 
 		bool prepareMainResources, bool prepareWorldGeom)
     {
+		if (mPrepareTaskGroup && prepareMainResources)
+		{
+			processResourceGroupInParallel(name, false, prepareMainResources, prepareWorldGeom);
+			return;
+		}
+
 		// Can only bulk-load one group at a time (reasonable limitation I think)
 		OGRE_LOCK_AUTO_MUTEX
 
@@ -256,6 +265,12 @@ namespace Ogre {
     void ResourceGroupManager::loadResourceGroup(const String& name, 
 		bool loadMainResources, bool loadWorldGeom)
     {
+		if (mPrepareTaskGroup && loadMainResources)
+		{
+			processResourceGroupInParallel(name, true, loadMainResources, loadWorldGeom);
+			return;
+		}
+
 		// Can only bulk-load one group at a time (reasonable limitation I think)
 		OGRE_LOCK_AUTO_MUTEX
 
@@ -352,6 +367,164 @@ namespace Ogre {
 		
 		LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
+	//-----------------------------------------------------------------------
+	void ResourceGroupManager::setParallelLoadingEnabled(bool enabled)
+	{
+		OGRE_LOCK_MUTEX(mParallelLoadMutex)
+		OGRE_LOCK_AUTO_MUTEX
+
+		if (enabled && !mPrepareTaskGroup)
+		{
+			mPrepareTaskGroup = OGRE_NEW TaskGroup("Ogre/ResourcePrepare");
+			mScriptTaskGroup = OGRE_NEW TaskGroup("Ogre/ScriptParse");
+		}
+		else if (!enabled && mPrepareTaskGroup)
+		{
+			OGRE_DELETE mPrepareTaskGroup;
+			mPrepareTaskGroup = 0;
+			OGRE_DELETE mScriptTaskGroup;
+			mScriptTaskGroup = 0;
+		}
+	}
+	//-----------------------------------------------------------------------
+	void ResourceGroupManager::ResourcePrepareTask::execute(void)
+	{
+		if (resource->isPrepared() || resource->isLoaded())
+			return;
+		try
+		{
+			resource->prepare();
+		}
+		catch (...)
+		{
+			// The resource is left unprepared, preparing it again on the
+			// calling thread reports the error
+		}
+	}
+	//-----------------------------------------------------------------------
+	void ResourceGroupManager::processResourceGroupInParallel(const String& name,
+		bool load, bool mainResources, bool worldGeom)
+	{
+		// Can only bulk-load one group at a time, and mPrepareTaskGroup
+		// can only run one list of tasks at a time
+		OGRE_LOCK_MUTEX(mParallelLoadMutex)
+
+		const char* func = load ? "ResourceGroupManager::loadResourceGroup" :
+			"ResourceGroupManager::prepareResourceGroup";
+		ResourceGroup* grp;
+		vector<ResourcePtr>::type resources;
+		size_t resourceCount = 0;
+		{
+			OGRE_LOCK_AUTO_MUTEX
+
+			LogManager::getSingleton().stream()
+				<< (load ? "Loading" : "Preparing") << " resource group '" << name
+				<< "' in parallel - Resources: " << mainResources
+				<< " World Geometry: " << worldGeom;
+			grp = getResourceGroup(name);
+			if (!grp)
+			{
+				OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+					"Cannot find a group named " + name, func);
+			}
+
+			OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex 
+			// Set current group
+			mCurrentGroup = grp;
+
+			// Take the resources in loading order, the lists may change
+			// once the group is unlocked
+			ResourceGroup::LoadResourceOrderMap::iterator oi;
+			for (oi = grp->loadResourceOrderMap.begin(); oi != grp->loadResourceOrderMap.end(); ++oi)
+			{
+				resources.insert(resources.end(), oi->second->begin(), oi->second->end());
+			}
+			resourceCount = resources.size();
+			// Estimate world geometry size
+			if (grp->worldGeometrySceneManager && worldGeom)
+			{
+				resourceCount += 
+					grp->worldGeometrySceneManager->estimateWorldGeometry(
+						grp->worldGeometry);
+			}
+		}
+
+		if (load)
+			fireResourceGroupLoadStarted(name, resourceCount);
+		else
+			fireResourceGroupPrepareStarted(name, resourceCount);
+
+		// Batches of a few resources per thread, so that progress is reported
+		// regularly and threads done early can help with the rest of a batch
+		size_t batchSize = mPrepareTaskGroup->getConcurrency() * 4;
+		vector<ResourcePrepareTask>::type tasks(batchSize);
+		TaskGroup::TaskList taskList;
+		for (size_t batchBegin = 0; batchBegin < resources.size(); batchBegin += batchSize)
+		{
+			size_t batchEnd = std::min(batchBegin + batchSize, resources.size());
+
+			taskList.clear();
+			for (size_t i = batchBegin; i < batchEnd; ++i)
+			{
+				ResourcePrepareTask& task = tasks[i - batchBegin];
+				task.resource = resources[i].get();
+				taskList.push_back(&task);
+			}
+			// Returns once the whole batch has been prepared
+			mPrepareTaskGroup->run(taskList);
+
+			for (size_t i = batchBegin; i < batchEnd; ++i)
+			{
+				const ResourcePtr& res = resources[i];
+				// Fire resource events no matter whether resource needs
+				// processing or not, as in the serial case; preparing or
+				// loading skips the work already done
+				if (load)
+				{
+					fireResourceLoadStarted(res);
+					res->load();
+					fireResourceLoadEnded();
+				}
+				else
+				{
+					fireResourcePrepareStarted(res);
+					res->prepare();
+					fireResourcePrepareEnded();
+				}
+			}
+		}
+
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME) // lock group mutex 
+
+			// Load World Geometry
+			if (grp->worldGeometrySceneManager && worldGeom)
+			{
+				if (load)
+					grp->worldGeometrySceneManager->setWorldGeometry(grp->worldGeometry);
+				else
+					grp->worldGeometrySceneManager->prepareWorldGeometry(grp->worldGeometry);
+			}
+		}
+
+		if (load)
+			fireResourceGroupLoadEnded(name);
+		else
+			fireResourceGroupPrepareEnded(name);
+
+		{
+			OGRE_LOCK_AUTO_MUTEX
+			// group is loaded
+			if (load)
+				grp->groupStatus = ResourceGroup::LOADED;
+			// reset current group
+			mCurrentGroup = 0;
+		}
+
+		LogManager::getSingleton().logMessage(String("Finished ") +
+			(load ? "loading" : "preparing") + " resource group " + name);
+	}
     //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
@@ -1052,48 +1225,76 @@ namespace Ogre {
 		// Fire scripting event
 		fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
-		// Iterate over scripts and parse
+		// Put the scripts in parsing order
 		// Note we respect original ordering
+		typedef std::pair<ScriptLoader*, const FileInfo*> ScriptFile;
+		vector<ScriptFile>::type scripts;
+		scripts.reserve(scriptCount);
         for (ScriptLoaderFileList::iterator slfli = scriptLoaderFileList.begin();
             slfli != scriptLoaderFileList.end(); ++slfli)
         {
-			ScriptLoader* su = slfli->first;
             // Iterate over each list
             for (FileListList::iterator flli = slfli->second->begin(); flli != slfli->second->end(); ++flli)
             {
 			    // Iterate over each item in the list
 			    for (FileInfoList::iterator fii = (*flli)->begin(); fii != (*flli)->end(); ++fii)
 			    {
-					bool skipScript = false;
-                    fireScriptStarted(fii->filename, skipScript);
-					if(skipScript)
+					scripts.push_back(ScriptFile(slfli->first, &*fii));
+				}
+			}
+		}
+
+		// When parsing in parallel, the scripts are taken in batches which are
+		// opened and pre-parsed across threads before being parsed in order
+		size_t batchSize = mScriptTaskGroup ?
+			mScriptTaskGroup->getConcurrency() * 4 : scripts.size();
+		vector<ScriptPreParseTask>::type tasks(mScriptTaskGroup ? batchSize : 0);
+		TaskGroup::TaskList taskList;
+		for (size_t batchBegin = 0; batchBegin < scripts.size(); batchBegin += batchSize)
+		{
+			size_t batchEnd = std::min(batchBegin + batchSize, scripts.size());
+
+			if (mScriptTaskGroup)
+			{
+				taskList.clear();
+				for (size_t i = batchBegin; i < batchEnd; ++i)
+				{
+					ScriptPreParseTask& task = tasks[i - batchBegin];
+					task.loader = scripts[i].first;
+					task.stream = openResourceGroupScript(*scripts[i].second, grp);
+					task.groupName = grp->name;
+					if (!task.stream.isNull())
+						taskList.push_back(&task);
+				}
+				mScriptTaskGroup->run(taskList);
+			}
+
+			for (size_t i = batchBegin; i < batchEnd; ++i)
+			{
+				ScriptLoader* su = scripts[i].first;
+				const FileInfo* fii = scripts[i].second;
+				bool skipScript = false;
+				fireScriptStarted(fii->filename, skipScript);
+				if(skipScript)
+				{
+					LogManager::getSingleton().logMessage(
+						"Skipping script " + fii->filename);
+				}
+				else
+				{
+					LogManager::getSingleton().logMessage(
+						"Parsing script " + fii->filename);
+					DataStreamPtr stream = mScriptTaskGroup ?
+						tasks[i - batchBegin].stream : openResourceGroupScript(*fii, grp);
+					if (!stream.isNull())
 					{
-						LogManager::getSingleton().logMessage(
-							"Skipping script " + fii->filename);
+						su->parseScript(stream, grp->name);
 					}
-					else
-					{
-						LogManager::getSingleton().logMessage(
-							"Parsing script " + fii->filename);
-                        DataStreamPtr stream = fii->archive->open(fii->filename);
-                        if (!stream.isNull())
-                        {
-							if (mLoadingListener)
-								mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
-
-							if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
-							{
-								DataStreamPtr cachedCopy;
-								cachedCopy.bind(OGRE_NEW MemoryDataStream(stream->getName(), stream));
-								su->parseScript(cachedCopy, grp->name);
-							}
-							else
-                            	su->parseScript(stream, grp->name);
-                        }
-                    }
-					fireScriptEnded(fii->filename, skipScript);
-			    }
-            }
+				}
+				fireScriptEnded(fii->filename, skipScript);
+				if (mScriptTaskGroup)
+					tasks[i - batchBegin].stream.setNull();
+			}
 		}
 
 		fireResourceGroupScriptingEnded(grp->name);
@@ -1101,6 +1302,30 @@ namespace Ogre {
 			"Finished parsing scripts for resource group " + grp->name);
 	}
 	//-----------------------------------------------------------------------
+	DataStreamPtr ResourceGroupManager::openResourceGroupScript(const FileInfo& fileInfo,
+		ResourceGroup* grp)
+	{
+		DataStreamPtr stream = fileInfo.archive->open(fileInfo.filename);
+		if (!stream.isNull())
+		{
+			if (mLoadingListener)
+				mLoadingListener->resourceStreamOpened(fileInfo.filename, grp->name, 0, stream);
+
+			if(fileInfo.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+			{
+				DataStreamPtr cachedCopy;
+				cachedCopy.bind(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+				return cachedCopy;
+			}
+		}
+		return stream;
+	}
+	//-----------------------------------------------------------------------
+	void ResourceGroupManager::ScriptPreParseTask::execute(void)
+	{
+		loader->preParseScript(stream, groupName);
+	}
+	//-----------------------------------------------------------------------
 	void ResourceGroupManager::createDeclaredResources(ResourceGroup* grp)
 	{
 
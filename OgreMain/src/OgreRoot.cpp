@@ -364,6 +364,7 @@ namespace Ogre {
 
 
         StringInterface::cleanupDictionary ();
+		FrameArena::releaseMemory();
     }
 
     //-----------------------------------------------------------------------
@@ -884,6 +885,8 @@ namespace Ogre {
 
 		// Tell the queue to process responses
 		mWorkQueue->processResponses();
+		// and run the resource loads left for the end of the frame
+		mResourceBackgroundQueue->_processPendingLoads();
 
 		OgreProfileEndGroup("Frame", OGREPROF_GENERAL);
 
@@ -993,7 +996,13 @@ namespace Ogre {
 		if (!_updateAllRenderTargets())
 			return false;
 
-        return _fireFrameEnded();
+        bool ret = _fireFrameEnded();
+		// Per-frame temporaries are no longer needed
+		FrameArena::reset();
+#if OGRE_MEMORY_STATS
+		MemoryStats::_frameEnded();
+#endif
+		return ret;
     }
 	//---------------------------------------------------------------------
 	bool Root::renderOneFrame(Real timeSinceLastFrame)
@@ -1013,7 +1022,13 @@ namespace Ogre {
 		now = mTimer->getMilliseconds();
 		evt.timeSinceLastEvent = calculateEventTime(now, FETT_ANY);
 
-		return _fireFrameEnded(evt);
+		bool ret = _fireFrameEnded(evt);
+		// Per-frame temporaries are no longer needed
+		FrameArena::reset();
+#if OGRE_MEMORY_STATS
+		MemoryStats::_frameEnded();
+#endif
+		return ret;
 	}
     //-----------------------------------------------------------------------
     void Root::shutdown(void)
@@ -100,12 +100,11 @@ namespace Ogre {
     root for high precision, or use SSE rsqrt instruction directly, based
     on profile to pick up perfect one.
 @note:
-    Prefer to never use NewtonRaphson reciprocal square root at all, since
-    speed test indicate performance loss 10% for unrolled version, and loss
-    %25 for general version (P4 3.0G HT). A slight loss in precision not
-    that important in case of normalise normals.
+    The NewtonRaphson step is used, so that the normals match the ones of
+    the general implementation to float precision. The rsqrt instruction
+    alone is only accurate to about 1e-3.
 */
-#if 1
+#if 0
 #define __MM_RSQRT_PS(x)    _mm_rsqrt_ps(x)
 #else
 #define __MM_RSQRT_PS(x)    __mm_rsqrt_nr_ps(x) // Implemented below
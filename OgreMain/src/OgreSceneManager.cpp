@@ -71,12 +71,51 @@ THE SOFTWARE.
 #include "OgreCompositorChain.h"
 #include "OgreInstanceBatch.h"
 #include "OgreInstancedEntity.h"
+#include "OgreTransformHierarchy.h"
+#include "OgreTimer.h"
 // This class implements the most basic scene manager
 
 #include <cstdio>
 
 namespace Ogre {
 
+namespace {
+	// Sum of the timings which can be measured within prepareShadowTextures
+	unsigned long getNestedTime(const SceneManager::FrameStatistics& stats)
+	{
+		return stats.updateSceneGraphTime + stats.findVisibleObjectsTime +
+			stats.sortQueueTime + stats.gpuParametersTime;
+	}
+
+	// Adds the time spent in its scope to a FrameStatistics timing, if enabled.
+	// When given the statistics the timing belongs to, the time measured by the
+	// nested timings is left out.
+	class FrameStatisticsTimer
+	{
+	public:
+		FrameStatisticsTimer(bool enabled, unsigned long& total,
+			const SceneManager::FrameStatistics* nested = 0)
+			: mTimer(enabled ? Root::getSingleton().getTimer() : 0),
+			mTotal(total), mStart(mTimer ? mTimer->getMicroseconds() : 0),
+			mNested(mTimer ? nested : 0), mNestedStart(mNested ? getNestedTime(*mNested) : 0)
+		{
+		}
+		~FrameStatisticsTimer()
+		{
+			if (mTimer)
+				mTotal += mTimer->getMicroseconds() - mStart;
+			if (mNested)
+				mTotal -= getNestedTime(*mNested) - mNestedStart;
+		}
+	private:
+		Timer* mTimer;
+		unsigned long& mTotal;
+		unsigned long mStart;
+		const SceneManager::FrameStatistics* mNested;
+		unsigned long mNestedStart;
+	};
+}
+
 //-----------------------------------------------------------------------
 uint32 SceneManager::WORLD_GEOMETRY_TYPE_MASK	= 0x80000000;
 uint32 SceneManager::ENTITY_TYPE_MASK			= 0x40000000;
@@ -149,6 +188,11 @@ mShadowTextureCustomCasterPass(0),
 mShadowTextureCustomReceiverPass(0),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mTransformHierarchy(0),
+mSceneGraphTaskGroup(0),
+mCullingTaskGroup(0),
+mAnimationTaskGroup(0),
+mFrameTimingEnabled(false),
 mSuppressRenderStateChanges(false),
 mSuppressShadows(false),
 mCameraRelativeRendering(false),
@@ -164,6 +208,9 @@ mGpuParamsDirty((uint16)GPV_ALL)
         mSkyDomeEntity[i] = 0;
     }
 
+	for (size_t i = 0; i <= GPT_COMPUTE_PROGRAM; ++i)
+		mBoundGpuPrograms[i] = 0;
+
 	mShadowCasterQueryListener = OGRE_NEW ShadowCasterSceneQueryListener(this);
 
     Root *root = Root::getSingletonPtr();
@@ -191,6 +238,8 @@ mGpuParamsDirty((uint16)GPV_ALL)
 //-----------------------------------------------------------------------
 SceneManager::~SceneManager()
 {
+	// Writes the frame in progress
+	setFrameStatisticsLogFile(StringUtil::BLANK);
 	fireSceneManagerDestroyed();
 	destroyShadowTextures();
     clearScene();
@@ -216,6 +265,10 @@ SceneManager::~SceneManager()
     OGRE_DELETE mShadowCasterAABBQuery;
     OGRE_DELETE mRenderQueue;
 	OGRE_DELETE mAutoParamDataSource;
+	OGRE_DELETE mTransformHierarchy;
+	OGRE_DELETE mSceneGraphTaskGroup;
+	OGRE_DELETE mCullingTaskGroup;
+	OGRE_DELETE mAnimationTaskGroup;
 }
 //-----------------------------------------------------------------------
 RenderQueue* SceneManager::getRenderQueue(void)
@@ -944,6 +997,8 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 
 	if (!mSuppressRenderStateChanges || evenIfSuppressed)
 	{
+		++mFrameStatistics.passesApplied;
+
 		if (mIlluminationStage == IRS_RENDER_TO_TEXTURE && shadowDerivation)
 		{
 			// Derive a special shadow caster pass from this one
@@ -972,7 +1027,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			// Unbind program?
 			if (mDestRenderSystem->isGpuProgramBound(GPT_VERTEX_PROGRAM))
 			{
-				mDestRenderSystem->unbindGpuProgram(GPT_VERTEX_PROGRAM);
+				unbindGpuProgram(GPT_VERTEX_PROGRAM);
 			}
 			// Set fixed-function vertex parameters
 		}
@@ -987,7 +1042,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			// Unbind program?
 			if (mDestRenderSystem->isGpuProgramBound(GPT_GEOMETRY_PROGRAM))
 			{
-				mDestRenderSystem->unbindGpuProgram(GPT_GEOMETRY_PROGRAM);
+				unbindGpuProgram(GPT_GEOMETRY_PROGRAM);
 			}
 			// Set fixed-function vertex parameters
 		}
@@ -1001,7 +1056,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			// Unbind program?
 			if (mDestRenderSystem->isGpuProgramBound(GPT_HULL_PROGRAM))
 			{
-				mDestRenderSystem->unbindGpuProgram(GPT_HULL_PROGRAM);
+				unbindGpuProgram(GPT_HULL_PROGRAM);
 			}
 			// Set fixed-function tesselation control parameters
 		}
@@ -1016,7 +1071,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			// Unbind program?
 			if (mDestRenderSystem->isGpuProgramBound(GPT_DOMAIN_PROGRAM))
 			{
-				mDestRenderSystem->unbindGpuProgram(GPT_DOMAIN_PROGRAM);
+				unbindGpuProgram(GPT_DOMAIN_PROGRAM);
 			}
 			// Set fixed-function tesselation evaluation parameters
 		}
@@ -1052,7 +1107,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			// Unbind program?
 			if (mDestRenderSystem->isGpuProgramBound(GPT_FRAGMENT_PROGRAM))
 			{
-				mDestRenderSystem->unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
+				unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
 			}
 
 			// Set fixed-function fragment settings
@@ -1231,6 +1286,7 @@ const Pass* SceneManager::_setPass(const Pass* pass, bool evenIfSuppressed,
 			mDestRenderSystem->_setTextureUnitSettings(unit, *pTex);
 			++unit;
 		}
+		mFrameStatistics.textureUnitsApplied += unit;
 		// Disable remaining texture units
 		mDestRenderSystem->_disableTextureUnitsFrom(pass->getNumTextureUnitStates());
 
@@ -1355,6 +1411,13 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 	// However don't call setViewport just yet (see below)
 	mCurrentViewport = vp;
 
+	updateFrameStatistics();
+	++mFrameStatistics.scenesRendered;
+
+	// Other scene managers may have bound programs since the last scene
+	for (size_t i = 0; i <= GPT_COMPUTE_PROGRAM; ++i)
+		mBoundGpuPrograms[i] = 0;
+
 	// reset light hash so even if light list is the same, we refresh the content every frame
 	LightList emptyLightList;
 	useLights(emptyLightList, 0);
@@ -1401,6 +1464,7 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 		// Update scene graph for this camera (can happen multiple times per frame)
 		{
 			OgreProfileGroup("_updateSceneGraph", OGREPROF_GENERAL);
+			FrameStatisticsTimer statsTimer(mFrameTimingEnabled, mFrameStatistics.updateSceneGraphTime);
 			_updateSceneGraph(camera);
 
 			// Auto-track nodes
@@ -1414,6 +1478,13 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 			camera->_autoTrack();
 		}
 
+		// Evaluate the skeletal animation ahead of culling, in one batch
+		if (mAnimationTaskGroup)
+		{
+			OgreProfileGroup("updateAnimationsInParallel", OGREPROF_GENERAL);
+			updateAnimationsInParallel();
+		}
+
 		if (mIlluminationStage != IRS_RENDER_TO_TEXTURE && mFindVisibleObjects)
 		{
 			// Locate any lights which could be affecting the frustum
@@ -1427,6 +1498,8 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 				if (isShadowTechniqueTextureBased())
 				{
 					OgreProfileGroup("prepareShadowTextures", OGREPROF_GENERAL);
+					FrameStatisticsTimer statsTimer(mFrameTimingEnabled,
+						mFrameStatistics.prepareShadowTexturesTime, &mFrameStatistics);
 
 					// *******
 					// WARNING
@@ -1506,8 +1579,11 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
 			// Parse the scene and tag visibles
 			firePreFindVisibleObjects(vp);
-			_findVisibleObjects(camera, &(camVisObjIt->second),
-				mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+			{
+				FrameStatisticsTimer statsTimer(mFrameTimingEnabled, mFrameStatistics.findVisibleObjectsTime);
+				_findVisibleObjects(camera, &(camVisObjIt->second),
+					mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+			}
 			firePostFindVisibleObjects(vp);
 
 			mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -2224,24 +2300,286 @@ void SceneManager::_updateSceneGraph(Camera* cam)
 	// Process queued needUpdate calls 
 	Node::processQueuedUpdates();
 
-    // Cascade down the graph updating transforms & world bounds
-    // In this implementation, just update from the root
-    // Smarter SceneManager subclasses may choose to update only
-    //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+	// Cascade down the graph updating transforms & world bounds
+	// In this implementation, just update from the root
+	// Smarter SceneManager subclasses may choose to update only
+	//   certain scene graph branches
+	if (mTransformHierarchy)
+		mTransformHierarchy->_update(getRootSceneNode());
+	else if (mSceneGraphTaskGroup)
+		updateSceneGraphInParallel();
+	else
+		getRootSceneNode()->_update(true, false);
 
 	firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+void SceneManager::setTransformHierarchyEnabled(bool enabled)
+{
+    if (enabled && !mTransformHierarchy)
+    {
+        mTransformHierarchy = OGRE_NEW TransformHierarchy();
+    }
+    else if (!enabled && mTransformHierarchy)
+    {
+        OGRE_DELETE mTransformHierarchy;
+        mTransformHierarchy = 0;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::setParallelSceneGraphUpdateEnabled(bool enabled)
+{
+    if (enabled && !mSceneGraphTaskGroup)
+    {
+        mSceneGraphTaskGroup = OGRE_NEW TaskGroup("Ogre/SceneGraphUpdate");
+    }
+    else if (!enabled && mSceneGraphTaskGroup)
+    {
+        OGRE_DELETE mSceneGraphTaskGroup;
+        mSceneGraphTaskGroup = 0;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateSceneGraphInParallel(void)
+{
+    // Make a few more tasks than there are threads, so that the threads
+    // which are done early can pick up the remaining subtrees
+    size_t maxTasks = mSceneGraphTaskGroup->getConcurrency() * 4;
+
+    mSceneGraphUpdateSubtrees.clear();
+    mSceneGraphSplitNodes.clear();
+    SceneGraphSubtree rootSubtree = { getRootSceneNode(), false };
+    mSceneGraphUpdateSubtrees.push_back(rootSubtree);
+
+    // Split the subtrees a level at a time until there are enough of them
+    SceneGraphSubtreeList level;
+    vector<Node*>::type children;
+    while (mSceneGraphUpdateSubtrees.size() < maxTasks)
+    {
+        level.swap(mSceneGraphUpdateSubtrees);
+        mSceneGraphUpdateSubtrees.clear();
+        bool split = false;
+        for (SceneGraphSubtreeList::iterator i = level.begin(); i != level.end(); ++i)
+        {
+            if (!i->node->numChildren())
+            {
+                mSceneGraphUpdateSubtrees.push_back(*i);
+                continue;
+            }
+
+            children.clear();
+            SceneGraphSubtree child;
+            child.parentHasChanged = i->node->_updateAndGatherChildren(children, i->parentHasChanged);
+            for (vector<Node*>::type::iterator c = children.begin(); c != children.end(); ++c)
+            {
+                child.node = *c;
+                mSceneGraphUpdateSubtrees.push_back(child);
+            }
+            mSceneGraphSplitNodes.push_back(static_cast<SceneNode*>(i->node));
+            split = true;
+        }
+        if (!split)
+            break;
+    }
+
+    size_t numSubtrees = mSceneGraphUpdateSubtrees.size();
+    size_t numTasks = std::min(numSubtrees, maxTasks);
+    mSceneGraphUpdateTasks.resize(numTasks);
+    mSceneGraphUpdateTaskList.resize(numTasks);
+    for (size_t i = 0; i < numTasks; ++i)
+    {
+        SceneGraphUpdateTask& task = mSceneGraphUpdateTasks[i];
+        task.subtrees = &mSceneGraphUpdateSubtrees;
+        task.begin = numSubtrees * i / numTasks;
+        task.end = numSubtrees * (i + 1) / numTasks;
+        mSceneGraphUpdateTaskList[i] = &task;
+    }
+
+    // Returns once every subtree is up to date
+    mSceneGraphTaskGroup->run(mSceneGraphUpdateTaskList);
+
+    // The split nodes were found parents first, so update their bounds
+    // children first
+    for (vector<SceneNode*>::type::reverse_iterator i = mSceneGraphSplitNodes.rbegin();
+        i != mSceneGraphSplitNodes.rend(); ++i)
+    {
+        (*i)->_updateBounds();
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::SceneGraphUpdateTask::execute(void)
+{
+    for (size_t i = begin; i != end; ++i)
+    {
+        const SceneGraphSubtree& subtree = (*subtrees)[i];
+        subtree.node->_update(true, subtree.parentHasChanged);
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
 	Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    if (mCullingTaskGroup)
+    {
+        findVisibleObjectsInParallel(cam, visibleBounds, onlyShadowCasters);
+        return;
+    }
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
 
 }
 //-----------------------------------------------------------------------
+void SceneManager::setParallelCullingEnabled(bool enabled)
+{
+    if (enabled && !mCullingTaskGroup)
+    {
+        mCullingTaskGroup = OGRE_NEW TaskGroup("Ogre/Culling");
+    }
+    else if (!enabled && mCullingTaskGroup)
+    {
+        OGRE_DELETE mCullingTaskGroup;
+        mCullingTaskGroup = 0;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::findVisibleObjectsInParallel(
+	Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
+{
+    SceneNode* root = getRootSceneNode();
+    RenderQueue* queue = getRenderQueue();
+
+    // Testing bounds against the camera may update it, so the threads
+    // cull against a copy of its planes taken here
+    cam->getCullingPlanes(mCullingPlanes);
+    if (!mCullingPlanes.isVisible(root->_getWorldAABB()))
+        return;
+
+    root->_addObjectsToRenderQueue(cam, queue, visibleBounds, mDisplayNodes, onlyShadowCasters);
+
+    mCullingSubtrees.clear();
+    SceneNode::ChildNodeIterator it = root->getChildIterator();
+    while (it.hasMoreElements())
+    {
+        mCullingSubtrees.push_back(static_cast<SceneNode*>(it.getNext()));
+    }
+
+    // Make a few more tasks than there are threads, so that the threads
+    // which are done early can pick up the remaining subtrees
+    size_t numNodes = mCullingSubtrees.size();
+    size_t numTasks = std::min(numNodes, mCullingTaskGroup->getConcurrency() * 4);
+    mCullingTasks.resize(numTasks);
+    mCullingTaskList.resize(numTasks);
+    for (size_t i = 0; i < numTasks; ++i)
+    {
+        FindVisibleNodesTask& task = mCullingTasks[i];
+        task.planes = &mCullingPlanes;
+        task.nodes = &mCullingSubtrees;
+        task.begin = numNodes * i / numTasks;
+        task.end = numNodes * (i + 1) / numTasks;
+        task.visibleNodes.clear();
+        mCullingTaskList[i] = &task;
+    }
+
+    mCullingTaskGroup->run(mCullingTaskList);
+
+    // Queue the results in task order, which is the scene graph order
+    for (size_t i = 0; i < numTasks; ++i)
+    {
+        const vector<SceneNode*>::type& visibleNodes = mCullingTasks[i].visibleNodes;
+        for (size_t n = 0; n < visibleNodes.size(); ++n)
+        {
+            visibleNodes[n]->_addObjectsToRenderQueue(cam, queue, visibleBounds, 
+                mDisplayNodes, onlyShadowCasters);
+        }
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::FindVisibleNodesTask::execute(void)
+{
+    for (size_t i = begin; i != end; ++i)
+    {
+        (*nodes)[i]->_findVisibleNodes(*planes, visibleNodes);
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::setParallelAnimationEnabled(bool enabled)
+{
+    if (enabled && !mAnimationTaskGroup)
+    {
+        mAnimationTaskGroup = OGRE_NEW TaskGroup("Ogre/Animation");
+    }
+    else if (!enabled && mAnimationTaskGroup)
+    {
+        OGRE_DELETE mAnimationTaskGroup;
+        mAnimationTaskGroup = 0;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateAnimationsInParallel(void)
+{
+    mAnimationUpdateEntities.clear();
+    {
+        MovableObjectCollection* objectMap = 
+            getMovableObjectCollection(EntityFactory::FACTORY_TYPE_NAME);
+        OGRE_LOCK_MUTEX(objectMap->mutex)
+        MovableObjectMap::iterator i, iend;
+        iend = objectMap->map.end();
+        for (i = objectMap->map.begin(); i != iend; ++i)
+        {
+            Entity* ent = static_cast<Entity*>(i->second);
+            if (ent->_isBoneMatricesUpdatePending())
+                mAnimationUpdateEntities.push_back(ent);
+        }
+    }
+
+    // Entities sharing a skeleton instance share its bone matrices too, so
+    // only one of them may update it
+    set<SkeletonInstance*, std::less<SkeletonInstance*>,
+        STLAllocator<SkeletonInstance*, FrameAllocPolicy> >::type sharedSkeletons;
+    vector<Entity*>::type::iterator e = mAnimationUpdateEntities.begin();
+    while (e != mAnimationUpdateEntities.end())
+    {
+        Entity* ent = *e;
+        if (ent->sharesSkeletonInstance() && 
+            !sharedSkeletons.insert(ent->getSkeleton()).second)
+        {
+            e = mAnimationUpdateEntities.erase(e);
+        }
+        else
+        {
+            ent->_prepareBoneMatricesUpdate();
+            ++e;
+        }
+    }
+
+    // Make a few more tasks than there are threads, so that the threads
+    // which are done early can pick up the remaining entities
+    size_t numEntities = mAnimationUpdateEntities.size();
+    size_t numTasks = std::min(numEntities, mAnimationTaskGroup->getConcurrency() * 4);
+    mAnimationUpdateTasks.resize(numTasks);
+    mAnimationUpdateTaskList.resize(numTasks);
+    for (size_t i = 0; i < numTasks; ++i)
+    {
+        AnimationUpdateTask& task = mAnimationUpdateTasks[i];
+        task.entities = &mAnimationUpdateEntities;
+        task.begin = numEntities * i / numTasks;
+        task.end = numEntities * (i + 1) / numTasks;
+        mAnimationUpdateTaskList[i] = &task;
+    }
+
+    mAnimationTaskGroup->run(mAnimationUpdateTaskList);
+}
+//-----------------------------------------------------------------------
+void SceneManager::AnimationUpdateTask::execute(void)
+{
+    for (size_t i = begin; i != end; ++i)
+    {
+        (*entities)[i]->_updateBoneMatrices();
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::_renderVisibleObjects(void)
 {
 	RenderQueueInvocationSequence* invocationSequence = 
@@ -2374,7 +2712,7 @@ void SceneManager::renderAdditiveStencilShadowedQueueGroupObjects(
         RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
         // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+        sortPriorityGroup(pPriorityGrp);
 
         // Clear light list
         lightList.clear();
@@ -2479,7 +2817,7 @@ void SceneManager::renderModulativeStencilShadowedQueueGroupObjects(
         RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
         // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+        sortPriorityGroup(pPriorityGrp);
 
         // Do (shadowable) solids
         renderObjects(pPriorityGrp->getSolidsBasic(), om, true, true);
@@ -2572,7 +2910,7 @@ void SceneManager::renderTextureShadowCasterQueueGroupObjects(
         RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
         // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+        sortPriorityGroup(pPriorityGrp);
 
         // Do solids, override light list incase any vertex programs use them
         renderObjects(pPriorityGrp->getSolidsBasic(), om, false, false, &mShadowTextureCurrentCasterLightList);
@@ -2613,7 +2951,7 @@ void SceneManager::renderModulativeTextureShadowedQueueGroupObjects(
         RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
         // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+        sortPriorityGroup(pPriorityGrp);
 
         // Do solids
         renderObjects(pPriorityGrp->getSolidsBasic(), om, true, true);
@@ -2745,7 +3083,7 @@ void SceneManager::renderAdditiveTextureShadowedQueueGroupObjects(
 		RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
 		// Sort the queue first
-		pPriorityGrp->sort(mCameraInProgress);
+		sortPriorityGroup(pPriorityGrp);
 
 		// Clear light list
 		lightList.clear();
@@ -2913,6 +3251,7 @@ bool SceneManager::SceneMgrQueuedRenderableVisitor::visit(const Pass* p)
 
 	// Set pass, store the actual one used
 	mUsedPass = targetSceneMgr->_setPass(p);
+	mLastSortedPass = 0;
 
 
 	return true;
@@ -2930,7 +3269,19 @@ void SceneManager::SceneMgrQueuedRenderableVisitor::visit(RenderablePass* rp)
 	// Give SM a chance to eliminate
 	if (targetSceneMgr->validateRenderableForRendering(rp->pass, rp->renderable))
 	{
-		mUsedPass = targetSceneMgr->_setPass(rp->pass);
+		// A renderable using the pass of the previous one only needs its own
+		// state to be set, as when the renderables are grouped by pass
+		if (rp->pass != mLastSortedPass || targetSceneMgr->mSuppressRenderStateChanges)
+		{
+			mUsedPass = targetSceneMgr->_setPass(rp->pass);
+			mLastSortedPass = rp->pass;
+		}
+		else
+		{
+			FrameStatistics& stats = targetSceneMgr->mFrameStatistics;
+			++stats.passesAvoided;
+			stats.textureUnitsAvoided += mUsedPass->getNumTextureUnitStates();
+		}
 		targetSceneMgr->renderSingleObject(rp->renderable, mUsedPass, scissoring, 
 			autoLights, manualLightList);
 	}
@@ -3001,6 +3352,7 @@ void SceneManager::renderObjects(const QueuedRenderableCollection& objs,
 	mActiveQueuedRenderableVisitor->manualLightList = manualLightList;
 	mActiveQueuedRenderableVisitor->transparentShadowCastersMode = false;
 	mActiveQueuedRenderableVisitor->scissoring = lightScissoringClipping;
+	mActiveQueuedRenderableVisitor->resetLastPass();
 	// Use visitor
 	objs.acceptVisitor(mActiveQueuedRenderableVisitor, om);
 }
@@ -3077,7 +3429,7 @@ void SceneManager::renderBasicQueueGroupObjects(RenderQueueGroup* pGroup,
         RenderPriorityGroup* pPriorityGrp = groupIt.getNext();
 
         // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+        sortPriorityGroup(pPriorityGrp);
 
         // Do solids
         renderObjects(pPriorityGrp->getSolidsBasic(), om, true, true);
@@ -3101,6 +3453,7 @@ void SceneManager::renderTransparentShadowCasterObjects(
 	mActiveQueuedRenderableVisitor->autoLights = doLightIteration;
 	mActiveQueuedRenderableVisitor->manualLightList = manualLightList;
 	mActiveQueuedRenderableVisitor->scissoring = lightScissoringClipping;
+	mActiveQueuedRenderableVisitor->resetLastPass();
 	
 	// Sort descending (transparency)
 	objs.acceptVisitor(mActiveQueuedRenderableVisitor, 
@@ -5465,7 +5818,7 @@ void SceneManager::renderShadowVolumesToStencil(const Light* light,
 			return; // nothing to do
 	}
 
-    mDestRenderSystem->unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
+    unbindGpuProgram(GPT_FRAGMENT_PROGRAM);
 
     // Can we do a 2-sided stencil?
     bool stencil2sided = false;
@@ -5526,7 +5879,7 @@ void SceneManager::renderShadowVolumesToStencil(const Light* light,
     }
     else
     {
-        mDestRenderSystem->unbindGpuProgram(GPT_VERTEX_PROGRAM);
+        unbindGpuProgram(GPT_VERTEX_PROGRAM);
     }
 
     // Turn off colour writing and depth writing
@@ -5657,7 +6010,7 @@ void SceneManager::renderShadowVolumesToStencil(const Light* light,
 
     mDestRenderSystem->setStencilCheckEnabled(false);
 
-    mDestRenderSystem->unbindGpuProgram(GPT_VERTEX_PROGRAM);
+    unbindGpuProgram(GPT_VERTEX_PROGRAM);
 
     if (scissored == CLIPPED_SOME)
     {
@@ -6658,6 +7011,8 @@ void SceneManager::destroyInstancedEntity( InstancedEntity *instancedEntity )
 //---------------------------------------------------------------------
 void SceneManager::_addDirtyInstanceManager( InstanceManager *dirtyManager )
 {
+	// May be called from several threads by the parallel scene graph update
+	OGRE_LOCK_MUTEX(mDirtyInstanceManagersMutex)
 	mDirtyInstanceManagers.push_back( dirtyManager );
 }
 //---------------------------------------------------------------------
@@ -7211,12 +7566,127 @@ void SceneManager::bindGpuProgram(GpuProgram* prog)
 	// Hash == 1 is almost impossible to achieve otherwise
 	mLastLightHashGpuProgram = 1;
 	mGpuParamsDirty = (uint16)GPV_ALL;
+
+	// Consecutive passes often share their programs
+	GpuProgramType gptype = prog->getType();
+	if (mBoundGpuPrograms[gptype] == prog && mDestRenderSystem->isGpuProgramBound(gptype))
+	{
+		++mFrameStatistics.programBindsAvoided;
+		return;
+	}
+
 	mDestRenderSystem->bindGpuProgram(prog);
+	mBoundGpuPrograms[gptype] = prog;
+	++mFrameStatistics.programsBound;
+}
+//---------------------------------------------------------------------
+void SceneManager::unbindGpuProgram(GpuProgramType gptype)
+{
+	mDestRenderSystem->unbindGpuProgram(gptype);
+	mBoundGpuPrograms[gptype] = 0;
+	++mFrameStatistics.programsUnbound;
 }
 //---------------------------------------------------------------------
 void SceneManager::_markGpuParamsDirty(uint16 mask)
 {
 	mGpuParamsDirty |= mask;
+	// The caller may have changed state the data source can't see
+	mAutoParamDataSource->invalidateInputs();
+}
+//---------------------------------------------------------------------
+void SceneManager::sortPriorityGroup(RenderPriorityGroup* group)
+{
+	FrameStatisticsTimer statsTimer(mFrameTimingEnabled, mFrameStatistics.sortQueueTime);
+	group->sort(mCameraInProgress);
+}
+//---------------------------------------------------------------------
+void SceneManager::updateFrameStatistics(void)
+{
+	unsigned long frameNumber = Root::getSingleton().getNextFrameNumber();
+	if (frameNumber == mFrameStatistics.frameNumber)
+		return;
+
+	if (mFrameStatistics.scenesRendered)
+	{
+		mLastFrameStatistics = mFrameStatistics;
+		writeFrameStatistics(mLastFrameStatistics);
+	}
+
+	mFrameStatistics = FrameStatistics();
+	mFrameStatistics.frameNumber = frameNumber;
+}
+//---------------------------------------------------------------------
+void SceneManager::writeFrameStatistics(const FrameStatistics& s)
+{
+	if (!mFrameStatisticsLog.is_open())
+		return;
+
+	mFrameStatisticsLog << s.frameNumber << ',' << s.scenesRendered << ','
+		<< s.updateSceneGraphTime << ',' << s.findVisibleObjectsTime << ','
+		<< s.sortQueueTime << ',' << s.prepareShadowTexturesTime << ','
+		<< s.gpuParametersTime << ',' << s.passesApplied << ','
+		<< s.passesAvoided << ',' << s.programsBound << ','
+		<< s.programBindsAvoided << ',' << s.programsUnbound << ','
+		<< s.textureUnitsApplied << ',' << s.textureUnitsAvoided << ','
+		<< s.gpuParametersApplied << ',' << s.gpuParametersAvoided << '\n';
+}
+//---------------------------------------------------------------------
+void SceneManager::setFrameStatisticsLogFile(const String& filename)
+{
+	if (mFrameStatisticsLog.is_open())
+	{
+		// No later frame will complete the one in progress for this file
+		if (mFrameStatistics.scenesRendered)
+			writeFrameStatistics(mFrameStatistics);
+		mFrameStatisticsLog.close();
+	}
+	mFrameStatisticsLogName = filename;
+	if (filename.empty())
+		return;
+
+	mFrameStatisticsLog.open(filename.c_str());
+	if (!mFrameStatisticsLog.is_open())
+	{
+		mFrameStatisticsLogName.clear();
+		OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+			"Unable to open frame statistics file '" + filename + "'",
+			"SceneManager::setFrameStatisticsLogFile");
+	}
+
+	mFrameStatisticsLog << "frame,scenes,updateSceneGraphTime,findVisibleObjectsTime,"
+		"sortQueueTime,prepareShadowTexturesTime,gpuParametersTime,passesApplied,"
+		"passesAvoided,programsBound,programBindsAvoided,programsUnbound,"
+		"textureUnitsApplied,textureUnitsAvoided,gpuParametersApplied,gpuParametersAvoided\n";
+}
+//---------------------------------------------------------------------
+SceneManager::FrameStatistics::FrameStatistics()
+	: frameNumber(0), scenesRendered(0),
+	updateSceneGraphTime(0), findVisibleObjectsTime(0), sortQueueTime(0),
+	prepareShadowTexturesTime(0), gpuParametersTime(0),
+	passesApplied(0), passesAvoided(0), programsBound(0), programBindsAvoided(0),
+	programsUnbound(0), textureUnitsApplied(0), textureUnitsAvoided(0),
+	gpuParametersApplied(0), gpuParametersAvoided(0)
+{
+}
+//---------------------------------------------------------------------
+void SceneManager::bindGpuProgramParameters(GpuProgramType gptype, 
+	const GpuProgramParametersSharedPtr& params)
+{
+	// Everything is uploaded once the pass or program changes, after that only
+	// the automatic parameters which were recalculated can differ
+	uint16 mask = mGpuParamsDirty;
+	if (!(mask & GPV_GLOBAL))
+		mask &= params->_getUpdatedVariability();
+
+	if (mask)
+	{
+		mDestRenderSystem->bindGpuProgramParameters(gptype, params, mask);
+		++mFrameStatistics.gpuParametersApplied;
+	}
+	else
+	{
+		++mFrameStatistics.gpuParametersAvoided;
+	}
 }
 //---------------------------------------------------------------------
 void SceneManager::updateGpuProgramParameters(const Pass* pass)
@@ -7225,40 +7695,30 @@ void SceneManager::updateGpuProgramParameters(const Pass* pass)
 	{
 
 		if (!mGpuParamsDirty)
+		{
+			++mFrameStatistics.gpuParametersAvoided;
 			return;
+		}
+
+		FrameStatisticsTimer statsTimer(mFrameTimingEnabled, mFrameStatistics.gpuParametersTime);
 
 		if (mGpuParamsDirty)
 			pass->_updateAutoParams(mAutoParamDataSource, mGpuParamsDirty);
 
 		if (pass->hasVertexProgram())
-		{
-			mDestRenderSystem->bindGpuProgramParameters(GPT_VERTEX_PROGRAM, 
-				pass->getVertexProgramParameters(), mGpuParamsDirty);
-		}
+			bindGpuProgramParameters(GPT_VERTEX_PROGRAM, pass->getVertexProgramParameters());
 
 		if (pass->hasGeometryProgram())
-		{
-			mDestRenderSystem->bindGpuProgramParameters(GPT_GEOMETRY_PROGRAM,
-				pass->getGeometryProgramParameters(), mGpuParamsDirty);
-		}
+			bindGpuProgramParameters(GPT_GEOMETRY_PROGRAM, pass->getGeometryProgramParameters());
 
 		if (pass->hasFragmentProgram())
-		{
-			mDestRenderSystem->bindGpuProgramParameters(GPT_FRAGMENT_PROGRAM, 
-				pass->getFragmentProgramParameters(), mGpuParamsDirty);
-		}
+			bindGpuProgramParameters(GPT_FRAGMENT_PROGRAM, pass->getFragmentProgramParameters());
 
 		if (pass->hasTesselationHullProgram())
-		{
-			mDestRenderSystem->bindGpuProgramParameters(GPT_HULL_PROGRAM, 
-				pass->getTesselationHullProgramParameters(), mGpuParamsDirty);
-		}
+			bindGpuProgramParameters(GPT_HULL_PROGRAM, pass->getTesselationHullProgramParameters());
 
 		if (pass->hasTesselationHullProgram())
-		{
-			mDestRenderSystem->bindGpuProgramParameters(GPT_DOMAIN_PROGRAM, 
-				pass->getTesselationDomainProgramParameters(), mGpuParamsDirty);
-		}
+			bindGpuProgramParameters(GPT_DOMAIN_PROGRAM, pass->getTesselationDomainProgramParameters());
 
 		mGpuParamsDirty = 0;
 	}
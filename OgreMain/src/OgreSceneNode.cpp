@@ -322,6 +322,63 @@ namespace Ogre {
 		}
 
 
+    }
+
+    void SceneNode::_findVisibleNodes(const CullingPlanes& planes, vector<SceneNode*>::type& visibleNodes,
+        bool boundsVisible)
+    {
+        if (!boundsVisible && !planes.isVisible(mWorldAABB))
+            return;
+
+        visibleNodes.push_back(this);
+
+        // Test the children a batch at a time, then descend into the visible ones
+        const size_t BATCH_SIZE = 16;
+        SceneNode* children[BATCH_SIZE];
+        const AxisAlignedBox* bounds[BATCH_SIZE];
+        char visibilities[BATCH_SIZE];
+
+        ChildNodeMap::iterator child = mChildren.begin();
+        ChildNodeMap::iterator childend = mChildren.end();
+        while (child != childend)
+        {
+            size_t count = 0;
+            for (; child != childend && count < BATCH_SIZE; ++child, ++count)
+            {
+                children[count] = static_cast<SceneNode*>(child->second);
+                bounds[count] = &children[count]->mWorldAABB;
+            }
+
+            planes.isVisible(bounds, count, visibilities);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (visibilities[i])
+                    children[i]->_findVisibleNodes(planes, visibleNodes, true);
+            }
+        }
+    }
+
+    void SceneNode::_addObjectsToRenderQueue(Camera* cam, RenderQueue* queue, 
+		VisibleObjectsBoundsInfo* visibleBounds, bool displayNodes, bool onlyShadowCasters)
+    {
+        ObjectMap::iterator iobj;
+        ObjectMap::iterator iobjend = mObjectsByName.end();
+        for (iobj = mObjectsByName.begin(); iobj != iobjend; ++iobj)
+        {
+			queue->processVisibleObject(iobj->second, cam, onlyShadowCasters, visibleBounds);
+        }
+
+        if (displayNodes)
+        {
+            queue->addRenderable(getDebugRenderable());
+        }
+
+		if ( !mHideBoundingBox &&
+             (mShowBoundingBox || (mCreator && mCreator->getShowBoundingBoxes())) )
+		{ 
+			_addBoundingBoxToQueue(queue);
+		}
     }
 
 	Node::DebugRenderable* SceneNode::getDebugRenderable()
@@ -361,6 +418,11 @@ namespace Ogre {
         Node::updateFromParentImpl();
 
         // Notify objects that it has been moved
+        notifyObjectsMoved();
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::notifyObjectsMoved(void) const
+    {
         ObjectMap::const_iterator i;
         for (i = mObjectsByName.begin(); i != mObjectsByName.end(); ++i)
         {
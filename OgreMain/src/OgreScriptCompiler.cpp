@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgreScriptLexer.h"
 #include "OgreScriptParser.h"
 #include "OgreScriptTranslator.h"
+#include "OgreStreamSerialiser.h"
 
 namespace Ogre
 {
@@ -1674,9 +1675,266 @@ namespace Ogre
 			OGRE_LOCK_AUTO_MUTEX
 			OGRE_THREAD_POINTER_GET(mScriptCompiler)->setListener(mListener);
 		}
-        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(stream->getAsString(), stream->getName(), groupName);
+        // Use the nodes from preParseScript if there are any
+        ConcreteNodeListPtr nodes;
+        {
+            OGRE_LOCK_MUTEX(mParsedScriptsMutex)
+            ParsedScriptMap::iterator i = mParsedScripts.begin();
+            while (i != mParsedScripts.end())
+            {
+                if (i->first == stream.get())
+                {
+                    nodes = i->second.second;
+                    mParsedScripts.erase(i++);
+                }
+                else if (i->second.first.useCount() == 1)
+                {
+                    // Nobody else has the stream anymore, the script was skipped
+                    mParsedScripts.erase(i++);
+                }
+                else
+                    ++i;
+            }
+        }
+        if (nodes.isNull())
+            nodes = parseScriptText(stream->getAsString(), stream->getName());
+        OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(nodes, groupName);
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::preParseScript(DataStreamPtr& stream, const String& groupName)
+    {
+        // Tokenising and parsing only depend on the text of the script, so
+        // these are safe to do on any thread
+        ConcreteNodeListPtr nodes;
+        try
+        {
+            nodes = parseScriptText(stream->getAsString(), stream->getName());
+        }
+        catch (Exception&)
+        {
+            // Let parseScript start over and report the error
+            stream->seek(0);
+            return;
+        }
+
+        OGRE_LOCK_MUTEX(mParsedScriptsMutex)
+        mParsedScripts[stream.get()] = ParsedScript(stream, nodes);
     }
 
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::setScriptCacheLocation(const String& path)
+    {
+        OGRE_LOCK_AUTO_MUTEX
+        mScriptCacheLocation = path;
+        if (!path.empty() && *path.rbegin() != '/' && *path.rbegin() != '\\')
+            mScriptCacheLocation += '/';
+    }
+    //-----------------------------------------------------------------------
+    String ScriptCompilerManager::getScriptCacheLocation(void)
+    {
+        OGRE_LOCK_AUTO_MUTEX
+        return mScriptCacheLocation;
+    }
+    //-----------------------------------------------------------------------
+    ConcreteNodeListPtr ScriptCompilerManager::parseScriptText(const String& text, const String& source)
+    {
+        String location = getScriptCacheLocation();
+        if (!location.empty())
+        {
+            ConcreteNodeListPtr nodes = loadCachedScript(location, text, source);
+            if (!nodes.isNull())
+                return nodes;
+        }
+
+        ScriptLexer lexer;
+        ScriptParser parser;
+        ConcreteNodeListPtr nodes = parser.parse(lexer.tokenize(text, source));
+
+        if (!location.empty())
+            saveCachedScript(location, text, nodes);
+        return nodes;
+    }
+    //-----------------------------------------------------------------------
+    namespace
+    {
+        const uint32 SCRIPT_CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("OSCN");
+        const uint16 SCRIPT_CACHE_CHUNK_VERSION = 1;
+
+        /// Identifies the text of a script, with two hashes to make collisions unlikely
+        struct ScriptCacheKey
+        {
+            uint32 size;
+            uint32 hash1;
+            uint32 hash2;
+
+            ScriptCacheKey()
+                : size(0), hash1(0), hash2(0)
+            {
+            }
+
+            explicit ScriptCacheKey(const String& text)
+                : size(static_cast<uint32>(text.size()))
+                , hash1(FastHash(text.c_str(), static_cast<int>(text.size())))
+                , hash2(FastHash(text.c_str(), static_cast<int>(text.size()), 0x9e3779b9 ^ size))
+            {
+            }
+
+            String getFileName(void) const
+            {
+                StringUtil::StrStreamType str;
+                str << std::hex << std::setfill('0') << std::setw(8) << hash1
+                    << std::setw(8) << hash2 << ".scriptcache";
+                return str.str();
+            }
+
+            bool operator==(const ScriptCacheKey& rhs) const
+            {
+                return size == rhs.size && hash1 == rhs.hash1 && hash2 == rhs.hash2;
+            }
+        };
+
+        void writeConcreteNodes(StreamSerialiser& ser, const ConcreteNodeList& nodes)
+        {
+            uint32 count = static_cast<uint32>(nodes.size());
+            ser.write(&count);
+            for (ConcreteNodeList::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+            {
+                const ConcreteNode* node = i->get();
+                uint8 type = static_cast<uint8>(node->type);
+                uint32 line = node->line;
+                ser.write(&type);
+                ser.write(&line);
+                ser.write(&node->token);
+                writeConcreteNodes(ser, node->children);
+            }
+        }
+
+        void readConcreteNodes(StreamSerialiser& ser, ConcreteNodeList& nodes,
+            ConcreteNode* parent, const String& source)
+        {
+            uint32 count;
+            ser.read(&count);
+            for (uint32 n = 0; n < count; ++n)
+            {
+                if (ser.eof())
+                {
+                    OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unexpected end of script cache file",
+                        "ScriptCompilerManager::loadCachedScript");
+                }
+                ConcreteNodePtr node(OGRE_NEW ConcreteNode());
+                uint8 type;
+                uint32 line;
+                ser.read(&type);
+                ser.read(&line);
+                ser.read(&node->token);
+                if (type > CNT_COLON)
+                {
+                    OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid node type in script cache",
+                        "ScriptCompilerManager::loadCachedScript");
+                }
+                node->type = static_cast<ConcreteNodeType>(type);
+                node->line = line;
+                node->file = source;
+                node->parent = parent;
+                readConcreteNodes(ser, node->children, node.get(), source);
+                nodes.push_back(node);
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    ConcreteNodeListPtr ScriptCompilerManager::loadCachedScript(const String& location,
+        const String& text, const String& source)
+    {
+        ScriptCacheKey key(text);
+        String fileName = location + key.getFileName();
+
+        std::ifstream* fs = OGRE_NEW_T(std::ifstream, MEMCATEGORY_GENERAL);
+        fs->open(fileName.c_str(), std::ios::in | std::ios::binary);
+        if (!*fs)
+        {
+            OGRE_DELETE_T(fs, basic_ifstream, MEMCATEGORY_GENERAL);
+            return ConcreteNodeListPtr();
+        }
+
+        ConcreteNodeListPtr nodes;
+        try
+        {
+            // Reading the nodes takes many small reads, do them from memory
+            DataStreamPtr fileStream(OGRE_NEW FileStreamDataStream(fileName, fs));
+            DataStreamPtr stream(OGRE_NEW MemoryDataStream(fileName, fileStream));
+            fileStream->close();
+
+            StreamSerialiser ser(stream);
+            const StreamSerialiser::Chunk* chunk =
+                ser.readChunkBegin(SCRIPT_CACHE_CHUNK_ID, SCRIPT_CACHE_CHUNK_VERSION);
+            if (!chunk)
+                return nodes;
+
+            // Reading past the end isn't an error for the serialiser, so make
+            // sure the file holds the whole chunk
+            bool valid = chunk->length == stream->size() - stream->tell();
+            if (valid)
+            {
+                ScriptCacheKey storedKey;
+                ser.read(&storedKey.size);
+                ser.read(&storedKey.hash1);
+                ser.read(&storedKey.hash2);
+                valid = storedKey == key;
+            }
+            if (valid)
+            {
+                ConcreteNodeListPtr readNodes(OGRE_NEW_T(ConcreteNodeList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+                readConcreteNodes(ser, *readNodes, 0, source);
+                if (ser.isEndOfChunk(SCRIPT_CACHE_CHUNK_ID))
+                    nodes = readNodes;
+            }
+            ser.readChunkEnd(SCRIPT_CACHE_CHUNK_ID);
+        }
+        catch (Exception&)
+        {
+            // A damaged file is just a miss, it gets written again
+            LogManager::getSingleton().logMessage(
+                "Ignoring damaged script cache file " + fileName + " for " + source);
+        }
+        return nodes;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::saveCachedScript(const String& location,
+        const String& text, const ConcreteNodeListPtr& nodes)
+    {
+        ScriptCacheKey key(text);
+        String fileName = location + key.getFileName();
+        // Written under another name then renamed, so that other threads
+        // never read a file which is only partly written
+        String tempFileName = fileName + ".tmp";
+
+        OGRE_LOCK_MUTEX(mScriptCacheMutex)
+
+        std::fstream* fs = OGRE_NEW_T(std::fstream, MEMCATEGORY_GENERAL);
+        fs->open(tempFileName.c_str(), std::ios::out | std::ios::binary);
+        if (!*fs)
+        {
+            OGRE_DELETE_T(fs, basic_fstream, MEMCATEGORY_GENERAL);
+            LogManager::getSingleton().logMessage(
+                "Can't write script cache file " + tempFileName, LML_CRITICAL);
+            return;
+        }
+
+        {
+            DataStreamPtr stream(OGRE_NEW FileStreamDataStream(tempFileName, fs));
+            StreamSerialiser ser(stream);
+            ser.writeChunkBegin(SCRIPT_CACHE_CHUNK_ID, SCRIPT_CACHE_CHUNK_VERSION);
+            ser.write(&key.size);
+            ser.write(&key.hash1);
+            ser.write(&key.hash2);
+            writeConcreteNodes(ser, *nodes);
+            ser.writeChunkEnd(SCRIPT_CACHE_CHUNK_ID);
+        }
+
+        // rename won't replace an existing file everywhere
+        std::remove(fileName.c_str());
+        std::rename(tempFileName.c_str(), fileName.c_str());
+    }
 	//-------------------------------------------------------------------------
 	String PreApplyTextureAliasesScriptCompilerEvent::eventType = "preApplyTextureAliases";
 	//-------------------------------------------------------------------------
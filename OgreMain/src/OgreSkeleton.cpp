@@ -28,9 +28,12 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreSkeleton.h"
 #include "OgreBone.h"
+#include "OgreBoneHierarchy.h"
+#include "OgreCompressedTransformKeys.h"
 #include "OgreAnimationState.h"
 #include "OgreException.h"
 #include "OgreLogManager.h"
+#include "OgreLodStrategyManager.h"
 #include "OgreSkeletonManager.h"
 #include "OgreSkeletonSerializer.h"
 #include "OgreStringConverter.h"
@@ -46,16 +49,21 @@ namespace Ogre {
 		: Resource(),
         mBlendState(ANIMBLEND_AVERAGE),
 		mNextAutoHandle(0),
-		mManualBonesDirty(false)
+		mManualBonesDirty(false),
+		mBoneHierarchy(0),
+		mAnimationLodStrategy(0)
 	{
+		removeAllAnimationLodLevels();
 	}
 	//---------------------------------------------------------------------
     Skeleton::Skeleton(ResourceManager* creator, const String& name, ResourceHandle handle,
         const String& group, bool isManual, ManualResourceLoader* loader) 
         : Resource(creator, name, handle, group, isManual, loader), 
-        mBlendState(ANIMBLEND_AVERAGE), mNextAutoHandle(0)
+        mBlendState(ANIMBLEND_AVERAGE), mNextAutoHandle(0), mBoneHierarchy(0),
+        mAnimationLodStrategy(0)
         // set animation blending to weighted, not cumulative
     {
+        removeAllAnimationLodLevels();
         if (createParamDictionary("Skeleton"))
         {
             // no custom params
@@ -67,6 +75,7 @@ namespace Ogre {
         // have to call this here reather than in Resource destructor
         // since calling virtual methods in base destructors causes crash
         unload(); 
+        OGRE_DELETE mBoneHierarchy;
     }
     //---------------------------------------------------------------------
     void Skeleton::loadImpl(void)
@@ -204,6 +213,12 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     void Skeleton::setAnimationState(const AnimationStateSet& animSet)
+    {
+        _setAnimationState(animSet, 0);
+    }
+    //---------------------------------------------------------------------
+    void Skeleton::_setAnimationState(const AnimationStateSet& animSet,
+        unsigned short animationLodIndex)
     {
         /* 
         Algorithm:
@@ -214,6 +229,15 @@ namespace Ogre {
         // Reset bones
         reset();
 
+        // Bones left out by the level of detail are not animated
+        const AnimationState::BoneBlendMask* lodMask = 0;
+        if (animationLodIndex)
+        {
+            lodMask = &getAnimationLodLevel(animationLodIndex).boneMask;
+            if (lodMask->empty())
+                lodMask = 0;
+        }
+
 		Real weightFactor = 1.0f;
 		if (mBlendState == ANIMBLEND_AVERAGE)
 		{
@@ -250,7 +274,21 @@ namespace Ogre {
             // tolerate state entries for animations we're not aware of
             if (anim)
             {
-              if(animState->hasBlendMask())
+              if (lodMask)
+              {
+                size_t numBones = getNumBones();
+                mAnimationLodBlendMask.resize(numBones);
+                for (size_t b = 0; b < numBones; ++b)
+                {
+                  float weight = b < lodMask->size() ? (*lodMask)[b] : 0.0f;
+                  if (animState->hasBlendMask())
+                    weight *= animState->getBlendMaskEntry(b);
+                  mAnimationLodBlendMask[b] = weight;
+                }
+                anim->apply(this, animState->getTimePosition(), animState->getWeight() * weightFactor,
+                  &mAnimationLodBlendMask, linked ? linked->scale : 1.0f);
+              }
+              else if(animState->hasBlendMask())
               {
                 anim->apply(this, animState->getTimePosition(), animState->getWeight() * weightFactor,
                   animState->getBlendMask(), linked ? linked->scale : 1.0f);
@@ -463,6 +501,13 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     void Skeleton::_getBoneMatrices(Matrix4* pMatrices)
     {
+        // Derived transforms and matrices of all bones in one go
+        if (mBoneHierarchy && mBoneHierarchy->_update(mBoneList, pMatrices))
+        {
+            mManualBonesDirty = false;
+            return;
+        }
+
         // Update derived transforms
         _updateTransforms();
 
@@ -598,6 +643,11 @@ namespace Ogre {
                 of << "  -- AnimationTrack " << ti << " --" << std::endl;
                 of << "  Affects bone: " << ((Bone*)track->getAssociatedNode())->getHandle() << std::endl;
                 of << "  Number of keyframes: " << track->getNumKeyFrames() << std::endl;
+                if (track->isCompressed())
+                {
+                    of << "  Number of compressed keys: "
+                        << track->getCompressedKeys()->getNumKeys() << std::endl;
+                }
 
                 for (unsigned short ki = 0; ki < track->getNumKeyFrames(); ++ki)
                 {
@@ -645,14 +695,30 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void Skeleton::_updateTransforms(void)
     {
-        BoneList::iterator i, iend;
-        iend = mRootBones.end();
-        for (i = mRootBones.begin(); i != iend; ++i)
+        if (!mBoneHierarchy || !mBoneHierarchy->_update(mBoneList, 0))
         {
-            (*i)->_update(true, false);
+            BoneList::iterator i, iend;
+            iend = mRootBones.end();
+            for (i = mRootBones.begin(); i != iend; ++i)
+            {
+                (*i)->_update(true, false);
+            }
         }
 		mManualBonesDirty = false;
     }
+    //---------------------------------------------------------------------
+	void Skeleton::setBoneHierarchyEnabled(bool enabled)
+	{
+		if (enabled && !mBoneHierarchy)
+		{
+			mBoneHierarchy = OGRE_NEW BoneHierarchy();
+		}
+		else if (!enabled && mBoneHierarchy)
+		{
+			OGRE_DELETE mBoneHierarchy;
+			mBoneHierarchy = 0;
+		}
+	}
     //---------------------------------------------------------------------
 	void Skeleton::optimiseAllAnimations(bool preservingIdentityNodeTracks)
 	{
@@ -690,6 +756,113 @@ namespace Ogre {
 		}
 	}
 	//---------------------------------------------------------------------
+	void Skeleton::compressAllAnimations(Real translateTolerance,
+		const Radian& rotateTolerance, Real scaleTolerance)
+	{
+		for (AnimationList::iterator ai = mAnimationsList.begin();
+			ai != mAnimationsList.end(); ++ai)
+		{
+			Animation::NodeTrackIterator ti = ai->second->getNodeTrackIterator();
+			while (ti.hasMoreElements())
+			{
+				ti.getNext()->compress(translateTolerance, rotateTolerance, scaleTolerance);
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void Skeleton::addAnimationLodLevel(Real lodValue, unsigned short updateInterval,
+		const BoneHandleList* animatedBones)
+	{
+		const LodStrategy* strategy = getAnimationLodStrategy();
+
+		AnimationLodUsage lod;
+		lod.userValue = lodValue;
+		lod.value = strategy->transformUserValue(lodValue);
+		lod.updateInterval = std::max(updateInterval, (unsigned short)1);
+		if (animatedBones)
+		{
+			lod.boneMask.resize(getNumBones(), 0.0f);
+			for (BoneHandleList::const_iterator i = animatedBones->begin();
+				i != animatedBones->end(); ++i)
+			{
+				if (*i >= lod.boneMask.size())
+				{
+					OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+						"Bone handle " + StringConverter::toString(*i) + " is out of range",
+						"Skeleton::addAnimationLodLevel");
+				}
+				lod.boneMask[*i] = 1.0f;
+			}
+		}
+
+		vector<Real>::type values(mAnimationLodValues);
+		values.push_back(lod.value);
+		if (!strategy->isSorted(values))
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Animation LOD levels must be added from highest to lowest detail",
+				"Skeleton::addAnimationLodLevel");
+		}
+
+		mAnimationLodUsageList.push_back(lod);
+		mAnimationLodValues.swap(values);
+	}
+	//---------------------------------------------------------------------
+	void Skeleton::removeAllAnimationLodLevels(void)
+	{
+		AnimationLodUsage lod;
+		lod.userValue = 0;
+		lod.value = mAnimationLodStrategy ? mAnimationLodStrategy->getBaseValue() : 0;
+		lod.updateInterval = 1;
+
+		mAnimationLodUsageList.assign(1, lod);
+		mAnimationLodValues.assign(1, lod.value);
+	}
+	//---------------------------------------------------------------------
+	unsigned short Skeleton::getNumAnimationLodLevels(void) const
+	{
+		return static_cast<unsigned short>(mAnimationLodUsageList.size());
+	}
+	//---------------------------------------------------------------------
+	const Skeleton::AnimationLodUsage& Skeleton::getAnimationLodLevel(unsigned short index) const
+	{
+		assert(index < mAnimationLodUsageList.size());
+		return mAnimationLodUsageList[index];
+	}
+	//---------------------------------------------------------------------
+	unsigned short Skeleton::getAnimationLodIndex(Real value) const
+	{
+		if (mAnimationLodUsageList.size() == 1)
+			return 0;
+		return getAnimationLodStrategy()->getIndex(value, mAnimationLodValues);
+	}
+	//---------------------------------------------------------------------
+	void Skeleton::setAnimationLodStrategy(const LodStrategy* strategy)
+	{
+		mAnimationLodStrategy = strategy;
+
+		// Re-transform the values given by the user
+		mAnimationLodUsageList[0].value = strategy->getBaseValue();
+		mAnimationLodValues[0] = mAnimationLodUsageList[0].value;
+		for (size_t i = 1; i < mAnimationLodUsageList.size(); ++i)
+		{
+			mAnimationLodUsageList[i].value =
+				strategy->transformUserValue(mAnimationLodUsageList[i].userValue);
+			mAnimationLodValues[i] = mAnimationLodUsageList[i].value;
+		}
+	}
+	//---------------------------------------------------------------------
+	const LodStrategy* Skeleton::getAnimationLodStrategy(void) const
+	{
+		if (!mAnimationLodStrategy)
+		{
+			mAnimationLodStrategy = LodStrategyManager::getSingleton().getDefaultStrategy();
+			mAnimationLodUsageList[0].value = mAnimationLodStrategy->getBaseValue();
+			mAnimationLodValues[0] = mAnimationLodUsageList[0].value;
+		}
+		return mAnimationLodStrategy;
+	}
+	//---------------------------------------------------------------------
 	void Skeleton::addLinkedSkeletonAnimationSource(const String& skelName, 
 		Real scale)
 	{
@@ -953,26 +1126,49 @@ namespace Ogre {
                     NodeAnimationTrack* dstTrack = dstAnimation->createNodeTrack(dstHandle, this->getBone(dstHandle));
                     dstTrack->setUseShortestRotationPath(srcTrack->getUseShortestRotationPath());
 
-                    ushort numKeyFrames = srcTrack->getNumKeyFrames();
+                    const CompressedTransformKeys* srcKeys = srcTrack->getCompressedKeys();
+                    ushort numKeyFrames = srcKeys ?
+                        static_cast<ushort>(srcKeys->getNumKeys()) : srcTrack->getNumKeyFrames();
                     for (ushort k = 0; k < numKeyFrames; ++k)
                     {
-                        const TransformKeyFrame* srcKeyFrame = srcTrack->getNodeKeyFrame(k);
-                        TransformKeyFrame* dstKeyFrame = dstTrack->createNodeKeyFrame(srcKeyFrame->getTime());
+                        Real time;
+                        Quaternion rotate;
+                        Vector3 translate, scale;
+                        if (srcKeys)
+                        {
+                            time = srcKeys->getTime(k);
+                            srcKeys->getKey(k, rotate, translate, scale);
+                        }
+                        else
+                        {
+                            const TransformKeyFrame* srcKeyFrame = srcTrack->getNodeKeyFrame(k);
+                            time = srcKeyFrame->getTime();
+                            rotate = srcKeyFrame->getRotation();
+                            translate = srcKeyFrame->getTranslate();
+                            scale = srcKeyFrame->getScale();
+                        }
+                        TransformKeyFrame* dstKeyFrame = dstTrack->createNodeKeyFrame(time);
 
                         // Adjust keyframes to match target binding pose
                         if (deltaTransform.isIdentity)
                         {
-                            dstKeyFrame->setTranslate(srcKeyFrame->getTranslate());
-                            dstKeyFrame->setRotation(srcKeyFrame->getRotation());
-                            dstKeyFrame->setScale(srcKeyFrame->getScale());
+                            dstKeyFrame->setTranslate(translate);
+                            dstKeyFrame->setRotation(rotate);
+                            dstKeyFrame->setScale(scale);
                         }
                         else
                         {
-                            dstKeyFrame->setTranslate(deltaTransform.translate + srcKeyFrame->getTranslate());
-                            dstKeyFrame->setRotation(deltaTransform.rotate * srcKeyFrame->getRotation());
-                            dstKeyFrame->setScale(deltaTransform.scale * srcKeyFrame->getScale());
+                            dstKeyFrame->setTranslate(deltaTransform.translate + translate);
+                            dstKeyFrame->setRotation(deltaTransform.rotate * rotate);
+                            dstKeyFrame->setScale(deltaTransform.scale * scale);
                         }
                     }
+
+                    if (srcKeys)
+                    {
+                        dstTrack->compress(srcKeys->getTranslateTolerance(),
+                            srcKeys->getRotateTolerance(), srcKeys->getScaleTolerance());
+                    }
                 }
                 else if (!deltaTransform.isIdentity)
                 {
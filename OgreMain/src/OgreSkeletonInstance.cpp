@@ -107,6 +107,42 @@ namespace Ogre {
 	{
 		mSkeleton->_refreshAnimationState(animSet);
 	}
+	//-------------------------------------------------------------------------
+	void SkeletonInstance::addAnimationLodLevel(Real lodValue, unsigned short updateInterval,
+		const BoneHandleList* animatedBones)
+	{
+		mSkeleton->addAnimationLodLevel(lodValue, updateInterval, animatedBones);
+	}
+	//-------------------------------------------------------------------------
+	void SkeletonInstance::removeAllAnimationLodLevels(void)
+	{
+		mSkeleton->removeAllAnimationLodLevels();
+	}
+	//-------------------------------------------------------------------------
+	unsigned short SkeletonInstance::getNumAnimationLodLevels(void) const
+	{
+		return mSkeleton->getNumAnimationLodLevels();
+	}
+	//-------------------------------------------------------------------------
+	const Skeleton::AnimationLodUsage& SkeletonInstance::getAnimationLodLevel(unsigned short index) const
+	{
+		return mSkeleton->getAnimationLodLevel(index);
+	}
+	//-------------------------------------------------------------------------
+	unsigned short SkeletonInstance::getAnimationLodIndex(Real value) const
+	{
+		return mSkeleton->getAnimationLodIndex(value);
+	}
+	//-------------------------------------------------------------------------
+	void SkeletonInstance::setAnimationLodStrategy(const LodStrategy* strategy)
+	{
+		mSkeleton->setAnimationLodStrategy(strategy);
+	}
+	//-------------------------------------------------------------------------
+	const LodStrategy* SkeletonInstance::getAnimationLodStrategy(void) const
+	{
+		return mSkeleton->getAnimationLodStrategy();
+	}
     //-------------------------------------------------------------------------
     void SkeletonInstance::cloneBoneAndChildren(Bone* source, Bone* parent)
     {
@@ -145,6 +181,7 @@ namespace Ogre {
         mNextTagPointAutoHandle = 0;
         // construct self from master
         mBlendState = mSkeleton->mBlendState;
+        setBoneHierarchyEnabled(mSkeleton->isBoneHierarchyEnabled());
         // Copy bones
         BoneIterator i = mSkeleton->getRootBoneIterator();
         while (i.hasMoreElements())
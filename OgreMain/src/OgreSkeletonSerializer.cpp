@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "OgreAnimation.h"
 #include "OgreAnimationTrack.h"
 #include "OgreKeyFrame.h"
+#include "OgreCompressedTransformKeys.h"
 #include "OgreBone.h"
 #include "OgreString.h"
 #include "OgreDataStream.h"
@@ -167,7 +168,9 @@ namespace Ogre {
 	{
 		if (ver == SKELETON_VERSION_1_0)
 			mVersion = "[Serializer_v1.10]";
-		else mVersion = "[Serializer_v1.80]";
+		else if (ver == SKELETON_VERSION_1_8)
+			mVersion = "[Serializer_v1.80]";
+		else mVersion = "[Serializer_v1.90]";
 	}
 	//---------------------------------------------------------------------
     void SkeletonSerializer::writeSkeleton(const Skeleton* pSkel, SkeletonVersion ver)
@@ -236,7 +239,7 @@ namespace Ogre {
     void SkeletonSerializer::writeAnimation(const Skeleton* pSkel, 
         const Animation* anim, SkeletonVersion ver)
     {
-        writeChunkHeader(SKELETON_ANIMATION, calcAnimationSize(pSkel, anim));
+        writeChunkHeader(SKELETON_ANIMATION, calcAnimationSize(pSkel, anim, ver));
 
         // char* name                       : Name of the animation
         writeString(anim->getName());
@@ -269,25 +272,42 @@ namespace Ogre {
         Animation::NodeTrackIterator trackIt = anim->getNodeTrackIterator();
         while(trackIt.hasMoreElements())
         {
-            writeAnimationTrack(pSkel, trackIt.getNext());
+            writeAnimationTrack(pSkel, trackIt.getNext(), ver);
         }
 
     }
     //---------------------------------------------------------------------
     void SkeletonSerializer::writeAnimationTrack(const Skeleton* pSkel, 
-        const NodeAnimationTrack* track)
+        const NodeAnimationTrack* track, SkeletonVersion ver)
     {
-        writeChunkHeader(SKELETON_ANIMATION_TRACK, calcAnimationTrackSize(pSkel, track));
+        writeChunkHeader(SKELETON_ANIMATION_TRACK, calcAnimationTrackSize(pSkel, track, ver));
 
         // unsigned short boneIndex     : Index of bone to apply to
         Bone* bone = (Bone*)track->getAssociatedNode();
         unsigned short boneid = bone->getHandle();
         writeShorts(&boneid, 1);
 
-        // Write all keyframes
-        for (unsigned short i = 0; i < track->getNumKeyFrames(); ++i)
+        const CompressedTransformKeys* keys = track->getCompressedKeys();
+        if (keys && (int)ver > (int)SKELETON_VERSION_1_8)
         {
-            writeKeyFrame(pSkel, track->getNodeKeyFrame(i));
+            writeCompressedKeys(pSkel, keys);
+        }
+        else if (keys)
+        {
+            // Older versions get the decoded keys as keyframes
+            for (size_t i = 0; i < keys->getNumKeys(); ++i)
+            {
+                writeKeyFrame(pSkel, keys->getTime(i), keys->getRotation(i),
+                    keys->getTranslate(i), keys->getScale(i));
+            }
+        }
+        else
+        {
+            // Write all keyframes
+            for (unsigned short i = 0; i < track->getNumKeyFrames(); ++i)
+            {
+                writeKeyFrame(pSkel, track->getNodeKeyFrame(i));
+            }
         }
 
     }
@@ -295,24 +315,68 @@ namespace Ogre {
     void SkeletonSerializer::writeKeyFrame(const Skeleton* pSkel, 
         const TransformKeyFrame* key)
     {
+        writeKeyFrame(pSkel, key->getTime(), key->getRotation(),
+            key->getTranslate(), key->getScale());
+    }
+    //---------------------------------------------------------------------
+    void SkeletonSerializer::writeKeyFrame(const Skeleton* pSkel, Real time,
+        const Quaternion& rotate, const Vector3& translate, const Vector3& scale)
+    {
 
         writeChunkHeader(SKELETON_ANIMATION_TRACK_KEYFRAME, 
-            calcKeyFrameSize(pSkel, key));
+            calcKeyFrameSize(pSkel, scale));
 
         // float time                    : The time position (seconds)
-        float time = key->getTime();
         writeFloats(&time, 1);
         // Quaternion rotate            : Rotation to apply at this keyframe
-        writeObject(key->getRotation());
+        writeObject(rotate);
         // Vector3 translate            : Translation to apply at this keyframe
-        writeObject(key->getTranslate());
+        writeObject(translate);
         // Vector3 scale                : Scale to apply at this keyframe
-        if (key->getScale() != Vector3::UNIT_SCALE)
+        if (scale != Vector3::UNIT_SCALE)
         {
-            writeObject(key->getScale());
+            writeObject(scale);
         }
     }
     //---------------------------------------------------------------------
+    void SkeletonSerializer::writeCompressedKeys(const Skeleton* pSkel,
+        const CompressedTransformKeys* keys)
+    {
+        writeChunkHeader(SKELETON_ANIMATION_TRACK_COMPRESSED,
+            calcCompressedKeysSize(pSkel, keys));
+
+        // unsigned short numKeys        : Number of keys
+        uint16 numKeys = static_cast<uint16>(keys->getNumKeys());
+        writeShorts(&numKeys, 1);
+        // float times[numKeys]          : The time positions (seconds)
+        if (numKeys)
+            writeFloats(&keys->mTimes[0], numKeys);
+        // float translateTolerance, rotateTolerance, scaleTolerance
+        Real tolerances[3] = { keys->mTranslateTolerance,
+            keys->mRotateTolerance.valueRadians(), keys->mScaleTolerance };
+        writeFloats(tolerances, 3);
+        // unsigned short animated       : Bit 0 rotation, 1 translation, 2 scale vary per key
+        uint16 animated = (keys->mRotations.empty() ? 0 : 1) |
+            (keys->mTranslates.values.empty() ? 0 : 2) |
+            (keys->mScales.values.empty() ? 0 : 4);
+        writeShorts(&animated, 1);
+        // Quaternion rotation or unsigned short rotations[numKeys * 3]
+        if (keys->mRotations.empty())
+            writeObject(keys->mRotation);
+        else
+            writeShorts(&keys->mRotations[0], keys->mRotations.size());
+        // Vector3 translateBase, translateExtent, unsigned short translates[numKeys * 3]
+        writeObject(keys->mTranslates.base);
+        writeObject(keys->mTranslates.extent);
+        if (!keys->mTranslates.values.empty())
+            writeShorts(&keys->mTranslates.values[0], keys->mTranslates.values.size());
+        // Vector3 scaleBase, scaleExtent, unsigned short scales[numKeys * 3]
+        writeObject(keys->mScales.base);
+        writeObject(keys->mScales.extent);
+        if (!keys->mScales.values.empty())
+            writeShorts(&keys->mScales.values[0], keys->mScales.values.size());
+    }
+    //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcBoneSize(const Skeleton* pSkel, 
         const Bone* pBone)
     {
@@ -367,7 +431,7 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcAnimationSize(const Skeleton* pSkel, 
-        const Animation* pAnim)
+        const Animation* pAnim, SkeletonVersion ver)
     {
         size_t size = SSTREAM_OVERHEAD_SIZE;
 
@@ -380,24 +444,39 @@ namespace Ogre {
 		Animation::NodeTrackIterator trackIt = pAnim->getNodeTrackIterator();
 		while(trackIt.hasMoreElements())
 		{
-            size += calcAnimationTrackSize(pSkel, trackIt.getNext());
+            size += calcAnimationTrackSize(pSkel, trackIt.getNext(), ver);
         }
 
         return size;
     }
     //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcAnimationTrackSize(const Skeleton* pSkel, 
-        const NodeAnimationTrack* pTrack)
+        const NodeAnimationTrack* pTrack, SkeletonVersion ver)
     {
         size_t size = SSTREAM_OVERHEAD_SIZE;
 
         // unsigned short boneIndex     : Index of bone to apply to
         size += sizeof(unsigned short);
 
-        // Nested keyframes
-        for (unsigned short i = 0; i < pTrack->getNumKeyFrames(); ++i)
+        const CompressedTransformKeys* keys = pTrack->getCompressedKeys();
+        if (keys && (int)ver > (int)SKELETON_VERSION_1_8)
         {
-            size += calcKeyFrameSize(pSkel, pTrack->getNodeKeyFrame(i));
+            size += calcCompressedKeysSize(pSkel, keys);
+        }
+        else if (keys)
+        {
+            for (size_t i = 0; i < keys->getNumKeys(); ++i)
+            {
+                size += calcKeyFrameSize(pSkel, keys->getScale(i));
+            }
+        }
+        else
+        {
+            // Nested keyframes
+            for (unsigned short i = 0; i < pTrack->getNumKeyFrames(); ++i)
+            {
+                size += calcKeyFrameSize(pSkel, pTrack->getNodeKeyFrame(i));
+            }
         }
 
         return size;
@@ -405,6 +484,12 @@ namespace Ogre {
     //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcKeyFrameSize(const Skeleton* pSkel, 
         const TransformKeyFrame* pKey)
+    {
+        return calcKeyFrameSize(pSkel, pKey->getScale());
+    }
+    //---------------------------------------------------------------------
+    size_t SkeletonSerializer::calcKeyFrameSize(const Skeleton* pSkel, 
+        const Vector3& scale)
     {
         size_t size = SSTREAM_OVERHEAD_SIZE;
 
@@ -415,7 +500,7 @@ namespace Ogre {
         // Vector3 translate            : Translation to apply at this keyframe
         size += sizeof(float) * 3;
         // Vector3 scale                : Scale to apply at this keyframe
-        if (pKey->getScale() != Vector3::UNIT_SCALE)
+        if (scale != Vector3::UNIT_SCALE)
         {
             size += sizeof(float) * 3;
         }
@@ -423,6 +508,31 @@ namespace Ogre {
         return size;
     }
     //---------------------------------------------------------------------
+    size_t SkeletonSerializer::calcCompressedKeysSize(const Skeleton* pSkel,
+        const CompressedTransformKeys* keys)
+    {
+        size_t size = SSTREAM_OVERHEAD_SIZE;
+
+        // unsigned short numKeys
+        size += sizeof(uint16);
+        // float times[numKeys]
+        size += sizeof(float) * keys->getNumKeys();
+        // float tolerances[3]
+        size += sizeof(float) * 3;
+        // unsigned short animated
+        size += sizeof(uint16);
+        // Quaternion rotation or unsigned short rotations[numKeys * 3]
+        if (keys->mRotations.empty())
+            size += sizeof(float) * 4;
+        else
+            size += sizeof(uint16) * keys->mRotations.size();
+        // Vector3 base and extent, unsigned short values[numKeys * 3]
+        size += sizeof(float) * 12;
+        size += sizeof(uint16) * (keys->mTranslates.values.size() + keys->mScales.values.size());
+
+        return size;
+    }
+    //---------------------------------------------------------------------
     size_t SkeletonSerializer::calcKeyFrameSizeWithoutScale(const Skeleton* pSkel, 
         const TransformKeyFrame* pKey)
     {
@@ -450,7 +560,8 @@ namespace Ogre {
 			// Read version
 			String ver = readString(stream);
 			if ((ver != "[Serializer_v1.10]") &&
-				(ver != "[Serializer_v1.80]"))
+				(ver != "[Serializer_v1.80]") &&
+				(ver != "[Serializer_v1.90]"))
 			{
 				OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, 
 					"Invalid file: version incompatible, file reports " + String(ver),
@@ -585,6 +696,16 @@ namespace Ogre {
         if (!stream->eof())
         {
             unsigned short streamID = readChunk(stream);
+            if (streamID == SKELETON_ANIMATION_TRACK_COMPRESSED)
+            {
+                readCompressedKeys(stream, pTrack, pSkel);
+
+                if (!stream->eof())
+                {
+                    // Get next stream
+                    streamID = readChunk(stream);
+                }
+            }
             while(streamID == SKELETON_ANIMATION_TRACK_KEYFRAME && !stream->eof())
             {
                 readKeyFrame(stream, pTrack, pSkel);
@@ -630,6 +751,57 @@ namespace Ogre {
             readObject(stream, scale);
             kf->setScale(scale);
         }
+    }
+    //---------------------------------------------------------------------
+    void SkeletonSerializer::readCompressedKeys(DataStreamPtr& stream,
+        NodeAnimationTrack* track, Skeleton* pSkel)
+    {
+        CompressedTransformKeys* keys = OGRE_NEW CompressedTransformKeys();
+
+        // unsigned short numKeys        : Number of keys
+        uint16 numKeys;
+        readShorts(stream, &numKeys, 1);
+        // float times[numKeys]          : The time positions (seconds)
+        keys->mTimes.resize(numKeys);
+        if (numKeys)
+            readFloats(stream, &keys->mTimes[0], numKeys);
+        // float translateTolerance, rotateTolerance, scaleTolerance
+        Real tolerances[3];
+        readFloats(stream, tolerances, 3);
+        keys->mTranslateTolerance = tolerances[0];
+        keys->mRotateTolerance = Radian(tolerances[1]);
+        keys->mScaleTolerance = tolerances[2];
+        // unsigned short animated       : Bit 0 rotation, 1 translation, 2 scale vary per key
+        uint16 animated;
+        readShorts(stream, &animated, 1);
+        // Quaternion rotation or unsigned short rotations[numKeys * 3]
+        if (animated & 1)
+        {
+            keys->mRotations.resize(numKeys * 3);
+            readShorts(stream, &keys->mRotations[0], keys->mRotations.size());
+        }
+        else
+        {
+            readObject(stream, keys->mRotation);
+        }
+        // Vector3 translateBase, translateExtent, unsigned short translates[numKeys * 3]
+        readObject(stream, keys->mTranslates.base);
+        readObject(stream, keys->mTranslates.extent);
+        if (animated & 2)
+        {
+            keys->mTranslates.values.resize(numKeys * 3);
+            readShorts(stream, &keys->mTranslates.values[0], keys->mTranslates.values.size());
+        }
+        // Vector3 scaleBase, scaleExtent, unsigned short scales[numKeys * 3]
+        readObject(stream, keys->mScales.base);
+        readObject(stream, keys->mScales.extent);
+        if (animated & 4)
+        {
+            keys->mScales.values.resize(numKeys * 3);
+            readShorts(stream, &keys->mScales.values[0], keys->mScales.values.size());
+        }
+
+        track->_setCompressedKeys(keys);
     }
 	//---------------------------------------------------------------------
 	void SkeletonSerializer::writeSkeletonAnimationLink(const Skeleton* pSkel, 
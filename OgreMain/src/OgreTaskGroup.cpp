@@ -0,0 +1,153 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreTaskGroup.h"
+#include "OgreRoot.h"
+#include "OgreProfiler.h"
+
+namespace Ogre {
+
+	//-----------------------------------------------------------------------
+	TaskGroup::TaskGroup(const String& channelName)
+		: mWorkQueue(Root::getSingleton().getWorkQueue())
+		, mChannel(0)
+		, mTasks(0)
+		, mNextTask(0)
+		, mCompletedTasks(0)
+		, mPendingHelpers(0)
+	{
+		mChannel = mWorkQueue->getChannel(channelName);
+		mWorkQueue->addRequestHandler(mChannel, this);
+	}
+	//-----------------------------------------------------------------------
+	TaskGroup::~TaskGroup()
+	{
+		// Helpers which have not started yet have nothing left to do
+		mWorkQueue->abortPendingRequestsByChannel(mChannel);
+		// This waits for the helpers being processed to return
+		mWorkQueue->removeRequestHandler(mChannel, this);
+	}
+	//-----------------------------------------------------------------------
+	size_t TaskGroup::getConcurrency(void) const
+	{
+#if OGRE_THREAD_SUPPORT
+		const DefaultWorkQueueBase* queue = dynamic_cast<const DefaultWorkQueueBase*>(mWorkQueue);
+		if (queue)
+			return queue->getWorkerThreadCount() + 1;
+#endif
+		return 1;
+	}
+	//-----------------------------------------------------------------------
+	void TaskGroup::run(const TaskList& tasks)
+	{
+		if (tasks.empty())
+			return;
+
+		size_t helpers = std::min(getConcurrency() - 1, tasks.size() - 1);
+		{
+			OGRE_LOCK_MUTEX(mTaskMutex)
+			mTasks = &tasks;
+			mNextTask = 0;
+			mCompletedTasks = 0;
+
+			// Helpers still queued from a previous run will take tasks from
+			// this list, so only top up to the number of worker threads
+			helpers = helpers > mPendingHelpers ? helpers - mPendingHelpers : 0;
+			mPendingHelpers += helpers;
+		}
+
+#if OGRE_THREAD_SUPPORT
+		for (size_t i = 0; i < helpers; ++i)
+		{
+			if (!mWorkQueue->addRequest(mChannel, 0, Any()))
+			{
+				// Not accepting requests, the calling thread will do the work
+				OGRE_LOCK_MUTEX(mTaskMutex)
+				mPendingHelpers -= helpers - i;
+				break;
+			}
+		}
+#endif
+
+		executePendingTasks();
+
+		OGRE_LOCK_MUTEX_NAMED(mTaskMutex, taskLock)
+#if OGRE_THREAD_SUPPORT
+		// Wait for the tasks started by worker threads to complete
+		while (mCompletedTasks < tasks.size())
+			OGRE_THREAD_WAIT(mTaskSync, mTaskMutex, taskLock)
+#endif
+		mTasks = 0;
+	}
+	//-----------------------------------------------------------------------
+	void TaskGroup::executePendingTasks(void)
+	{
+		while (true)
+		{
+			Task* task = 0;
+			{
+				OGRE_LOCK_MUTEX(mTaskMutex)
+				if (!mTasks || mNextTask == mTasks->size())
+					return;
+				task = (*mTasks)[mNextTask++];
+			}
+
+			{
+				OgreProfileGroup("TaskGroup::Task", OGREPROF_GENERAL);
+				task->execute();
+			}
+
+			OGRE_LOCK_MUTEX(mTaskMutex)
+			if (++mCompletedTasks == mTasks->size())
+			{
+				OGRE_THREAD_NOTIFY_ALL(mTaskSync)
+			}
+		}
+	}
+	//-----------------------------------------------------------------------
+	bool TaskGroup::canHandleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+	{
+		(void)req;
+		(void)srcQ;
+		return true;
+	}
+	//-----------------------------------------------------------------------
+	WorkQueue::Response* TaskGroup::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+	{
+		(void)srcQ;
+		if (!req->getAborted())
+			executePendingTasks();
+
+		OGRE_LOCK_MUTEX(mTaskMutex)
+		--mPendingHelpers;
+
+		// the caller of run() waits on mCompletedTasks, there is nothing to respond
+		return 0;
+	}
+
+}
@@ -0,0 +1,265 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+#include "OgreTransformHierarchy.h"
+#include "OgreSceneNode.h"
+
+namespace Ogre {
+
+	const size_t TransformHierarchy::NO_PARENT = ~static_cast<size_t>(0);
+	//-----------------------------------------------------------------------
+	TransformHierarchy::TransformHierarchy()
+		: mRoot(0)
+		, mRevision(0)
+		, mBlockCapacity(0)
+		, mBlockBuffer(0)
+		, mInheritOrientation(0)
+		, mInheritScale(0)
+	{
+	}
+	//-----------------------------------------------------------------------
+	TransformHierarchy::~TransformHierarchy()
+	{
+		if (mBlockBuffer)
+			OGRE_FREE_SIMD(mBlockBuffer, MEMCATEGORY_SCENE_CONTROL);
+	}
+	//-----------------------------------------------------------------------
+	void TransformHierarchy::buildLayout(SceneNode* root)
+	{
+		mNodes.clear();
+		mParentSlots.clear();
+		mLevelStarts.clear();
+
+		// Breadth first traversal, so that every level is contiguous and
+		// parents always come before their children
+		mNodes.push_back(root);
+		mParentSlots.push_back(NO_PARENT);
+		size_t levelStart = 0;
+		size_t maxLevelSize = 0;
+		while (levelStart < mNodes.size())
+		{
+			size_t levelEnd = mNodes.size();
+			mLevelStarts.push_back(levelStart);
+			maxLevelSize = std::max(maxLevelSize, levelEnd - levelStart);
+
+			for (size_t slot = levelStart; slot < levelEnd; ++slot)
+			{
+				Node::ChildNodeMap::const_iterator i, iend;
+				iend = mNodes[slot]->mChildren.end();
+				for (i = mNodes[slot]->mChildren.begin(); i != iend; ++i)
+				{
+					mNodes.push_back(static_cast<SceneNode*>(i->second));
+					mParentSlots.push_back(slot);
+				}
+			}
+			levelStart = levelEnd;
+		}
+		mLevelStarts.push_back(mNodes.size());
+
+		mChanged.resize(mNodes.size());
+		mVisited.resize(mNodes.size());
+		mBlockSlots.resize(maxLevelSize);
+		reserveBlock(maxLevelSize);
+
+		mRoot = root;
+		mRevision = Node::_getHierarchyRevision();
+	}
+	//-----------------------------------------------------------------------
+	void TransformHierarchy::reserveBlock(size_t numNodes)
+	{
+		if (numNodes <= mBlockCapacity)
+			return;
+
+		// Round up so that every stream stays aligned
+		size_t capacity = (numNodes + 3) & ~static_cast<size_t>(3);
+		size_t streamSize = capacity * sizeof(Real);
+		void* buffer = OGRE_MALLOC_SIMD(streamSize * 30 + capacity * sizeof(uint32) * 2,
+			MEMCATEGORY_SCENE_CONTROL);
+		if (mBlockBuffer)
+			OGRE_FREE_SIMD(mBlockBuffer, MEMCATEGORY_SCENE_CONTROL);
+		mBlockBuffer = buffer;
+		mBlockCapacity = capacity;
+
+		Real* stream = static_cast<Real*>(buffer);
+		TransformStreams* allStreams[3] = { &mParentTransforms, &mLocalTransforms, &mDerivedTransforms };
+		for (size_t s = 0; s < 3; ++s)
+		{
+			for (size_t c = 0; c < 3; ++c, stream += capacity)
+				allStreams[s]->position[c] = stream;
+			for (size_t c = 0; c < 4; ++c, stream += capacity)
+				allStreams[s]->orientation[c] = stream;
+			for (size_t c = 0; c < 3; ++c, stream += capacity)
+				allStreams[s]->scale[c] = stream;
+		}
+		mInheritOrientation = reinterpret_cast<uint32*>(stream);
+		mInheritScale = mInheritOrientation + capacity;
+	}
+	//-----------------------------------------------------------------------
+	void TransformHierarchy::gatherNode(size_t index, const SceneNode* node, size_t parentSlot)
+	{
+		Vector3 parentPosition, parentScale;
+		Quaternion parentOrientation;
+		if (parentSlot != NO_PARENT)
+		{
+			// Already brought up to date while processing the previous level
+			const SceneNode* parent = mNodes[parentSlot];
+			parentPosition = parent->mDerivedPosition;
+			parentOrientation = parent->mDerivedOrientation;
+			parentScale = parent->mDerivedScale;
+		}
+		else if (node->mParent)
+		{
+			parentPosition = node->mParent->_getDerivedPosition();
+			parentOrientation = node->mParent->_getDerivedOrientation();
+			parentScale = node->mParent->_getDerivedScale();
+		}
+		else
+		{
+			parentPosition = Vector3::ZERO;
+			parentOrientation = Quaternion::IDENTITY;
+			parentScale = Vector3::UNIT_SCALE;
+		}
+
+		mParentTransforms.position[0][index] = parentPosition.x;
+		mParentTransforms.position[1][index] = parentPosition.y;
+		mParentTransforms.position[2][index] = parentPosition.z;
+		mParentTransforms.orientation[0][index] = parentOrientation.w;
+		mParentTransforms.orientation[1][index] = parentOrientation.x;
+		mParentTransforms.orientation[2][index] = parentOrientation.y;
+		mParentTransforms.orientation[3][index] = parentOrientation.z;
+		mParentTransforms.scale[0][index] = parentScale.x;
+		mParentTransforms.scale[1][index] = parentScale.y;
+		mParentTransforms.scale[2][index] = parentScale.z;
+
+		mLocalTransforms.position[0][index] = node->mPosition.x;
+		mLocalTransforms.position[1][index] = node->mPosition.y;
+		mLocalTransforms.position[2][index] = node->mPosition.z;
+		mLocalTransforms.orientation[0][index] = node->mOrientation.w;
+		mLocalTransforms.orientation[1][index] = node->mOrientation.x;
+		mLocalTransforms.orientation[2][index] = node->mOrientation.y;
+		mLocalTransforms.orientation[3][index] = node->mOrientation.z;
+		mLocalTransforms.scale[0][index] = node->mScale.x;
+		mLocalTransforms.scale[1][index] = node->mScale.y;
+		mLocalTransforms.scale[2][index] = node->mScale.z;
+
+		mInheritOrientation[index] = node->mInheritOrientation ? 0xFFFFFFFF : 0;
+		mInheritScale[index] = node->mInheritScale ? 0xFFFFFFFF : 0;
+	}
+	//-----------------------------------------------------------------------
+	void TransformHierarchy::scatterNode(size_t index, SceneNode* node)
+	{
+		node->mDerivedPosition.x = mDerivedTransforms.position[0][index];
+		node->mDerivedPosition.y = mDerivedTransforms.position[1][index];
+		node->mDerivedPosition.z = mDerivedTransforms.position[2][index];
+		node->mDerivedOrientation.w = mDerivedTransforms.orientation[0][index];
+		node->mDerivedOrientation.x = mDerivedTransforms.orientation[1][index];
+		node->mDerivedOrientation.y = mDerivedTransforms.orientation[2][index];
+		node->mDerivedOrientation.z = mDerivedTransforms.orientation[3][index];
+		node->mDerivedScale.x = mDerivedTransforms.scale[0][index];
+		node->mDerivedScale.y = mDerivedTransforms.scale[1][index];
+		node->mDerivedScale.z = mDerivedTransforms.scale[2][index];
+		node->mCachedTransformOutOfDate = true;
+		node->mNeedParentUpdate = false;
+
+		// Same notifications as Node::_updateFromParent
+		node->notifyObjectsMoved();
+		if (node->mListener)
+		{
+			node->mListener->nodeUpdated(node);
+		}
+	}
+	//-----------------------------------------------------------------------
+	void TransformHierarchy::_update(SceneNode* root)
+	{
+		if (root != mRoot || mRevision != Node::_getHierarchyRevision())
+		{
+			buildLayout(root);
+		}
+
+		OptimisedUtil* util = OptimisedUtil::getImplementation();
+		size_t numLevels = mLevelStarts.size() - 1;
+
+		// Top-down: derived transforms, one level at a time
+		for (size_t level = 0; level < numLevels; ++level)
+		{
+			size_t numBlockNodes = 0;
+			size_t levelEnd = mLevelStarts[level + 1];
+			for (size_t slot = mLevelStarts[level]; slot < levelEnd; ++slot)
+			{
+				SceneNode* node = mNodes[slot];
+				size_t parentSlot = mParentSlots[slot];
+
+				// Own transform changed (or was brought up to date lazily
+				// without updating its children), or parent moved
+				bool changed = node->mNeedParentUpdate || node->mNeedChildUpdate ||
+					(parentSlot != NO_PARENT && mChanged[parentSlot]);
+				mChanged[slot] = changed;
+				mVisited[slot] = changed || !node->mChildrenToUpdate.empty();
+
+				if (changed)
+				{
+					gatherNode(numBlockNodes, node, parentSlot);
+					mBlockSlots[numBlockNodes++] = slot;
+				}
+			}
+
+			if (numBlockNodes)
+			{
+				util->concatenateNodeTransforms(
+					mParentTransforms, mLocalTransforms,
+					mInheritOrientation, mInheritScale,
+					mDerivedTransforms, numBlockNodes);
+
+				for (size_t i = 0; i < numBlockNodes; ++i)
+				{
+					scatterNode(i, mNodes[mBlockSlots[i]]);
+				}
+			}
+		}
+
+		// Bottom-up: bounds, so that children are merged into their parents
+		// once they are final. The root is always updated, like _update does.
+		mVisited[0] = true;
+		for (size_t slot = mNodes.size(); slot-- > 0; )
+		{
+			if (!mVisited[slot])
+				continue;
+
+			SceneNode* node = mNodes[slot];
+			node->mParentNotified = false;
+			node->mNeedChildUpdate = false;
+			node->mChildrenToUpdate.clear();
+			node->_updateBounds();
+
+			size_t parentSlot = mParentSlots[slot];
+			if (parentSlot != NO_PARENT)
+				mVisited[parentSlot] = true;
+		}
+	}
+
+}
@@ -30,8 +30,26 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreRoot.h"
 #include "OgreRenderSystem.h"
+#include "OgreProfiler.h"
 
 namespace Ogre {
+	namespace
+	{
+		bool higherPriority(const WorkQueue::Request* a, const WorkQueue::Request* b)
+		{
+			return a->getPriority() > b->getPriority();
+		}
+
+		/// Insert a request behind all requests of the same or a higher priority
+		template <typename Queue>
+		void insertRequest(Queue& queue, WorkQueue::Request* r)
+		{
+			if (queue.empty() || queue.back()->getPriority() >= r->getPriority())
+				queue.push_back(r);
+			else
+				queue.insert(std::upper_bound(queue.begin(), queue.end(), r, higherPriority), r);
+		}
+	}
 	//---------------------------------------------------------------------
 	uint16 WorkQueue::getChannel(const String& channelName)
 	{
@@ -45,8 +63,9 @@ namespace Ogre {
 		return i->second;
 	}
 	//---------------------------------------------------------------------
-	WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
+	WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid, uint8 priority)
 		: mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
+		, mPriority(priority)
 	{
 
 	}
@@ -75,6 +94,14 @@ namespace Ogre {
 		, mWorkerRenderSystemAccess(false)
 		, mIsRunning(false)
 		, mResposeTimeLimitMS(8)
+		, mNumStealableRequests(0)
+		, mNumRegisteredWorkers(0)
+		, OGRE_THREAD_POINTER_INIT(mWorkerHandle)
+#if OGRE_WORK_QUEUE_STEALING
+		, mRequestScheduling(RS_WORK_STEALING)
+#else
+		, mRequestScheduling(RS_SHARED_QUEUE)
+#endif
 		, mWorkerFunc(0)
 		, mRequestCount(0)
 		, mPaused(false)
@@ -108,6 +135,268 @@ namespace Ogre {
 		mWorkerRenderSystemAccess = access;
 	}
 	//---------------------------------------------------------------------
+	DefaultWorkQueueBase::RequestScheduling DefaultWorkQueueBase::getRequestScheduling() const
+	{
+		return mRequestScheduling;
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::setRequestScheduling(RequestScheduling scheduling)
+	{
+		mRequestScheduling = scheduling;
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::setChannelPriority(uint16 channel, uint8 priority)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		if (priority)
+			mChannelPriorities[channel] = priority;
+		else
+			mChannelPriorities.erase(channel);
+	}
+	//---------------------------------------------------------------------
+	uint8 DefaultWorkQueueBase::getChannelPriority(uint16 channel) const
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		ChannelPriorityMap::const_iterator i = mChannelPriorities.find(channel);
+		return i != mChannelPriorities.end() ? i->second : 0;
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::setChannelAffinity(uint16 channel, size_t workerIndex)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		mChannelAffinities[channel] = workerIndex;
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::clearChannelAffinity(uint16 channel)
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+
+		mChannelAffinities.erase(channel);
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::getChannelScheduling(uint16 channel, uint8& priority, size_t& boundWorker) const
+	{
+		ChannelPriorityMap::const_iterator p = mChannelPriorities.find(channel);
+		priority = p != mChannelPriorities.end() ? p->second : 0;
+
+		ChannelAffinityMap::const_iterator a = mChannelAffinities.find(channel);
+		boundWorker = a != mChannelAffinities.end() ? a->second : std::numeric_limits<size_t>::max();
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::setupRequestQueues()
+	{
+		// Gather the requests still waiting, in order of priority
+		RequestQueue waiting;
+		waiting.swap(mRequestQueue);
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			WorkerRequests* worker = *w;
+			assert(worker->mProcessQueue.empty() && "Requests still processed while setting up the queues");
+			for (RequestQueue::iterator i = worker->mBoundQueue.begin(); i != worker->mBoundQueue.end(); ++i)
+				insertRequest(waiting, *i);
+			for (RequestQueue::iterator i = worker->mQueue.begin(); i != worker->mQueue.end(); ++i)
+				insertRequest(waiting, *i);
+			OGRE_DELETE worker;
+		}
+		mWorkerRequests.clear();
+		mNumStealableRequests = 0;
+		mNumRegisteredWorkers = 0;
+
+#if OGRE_THREAD_SUPPORT
+		if (mRequestScheduling == RS_WORK_STEALING)
+		{
+			size_t count = std::max(mWorkerThreadCount, static_cast<size_t>(1));
+			for (size_t i = 0; i < count; ++i)
+				mWorkerRequests.push_back(OGRE_NEW WorkerRequests());
+		}
+#endif
+
+		// Affinities are only known when adding, so these are just spread
+		for (RequestQueue::iterator i = waiting.begin(); i != waiting.end(); ++i)
+			queueRequest(*i, std::numeric_limits<size_t>::max());
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::registerWorkerThread()
+	{
+		WorkerHandle* handle = OGRE_NEW WorkerHandle();
+		handle->index = mNumRegisteredWorkers++;
+		OGRE_THREAD_POINTER_SET(mWorkerHandle, handle);
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::queueRequest(Request* r, size_t boundWorker)
+	{
+		if (mWorkerRequests.empty())
+		{
+			OGRE_LOCK_MUTEX(mRequestMutex)
+			insertRequest(mRequestQueue, r);
+			return;
+		}
+
+		bool bound = boundWorker != std::numeric_limits<size_t>::max();
+		size_t index;
+		if (bound)
+		{
+			index = boundWorker % mWorkerRequests.size();
+		}
+		else
+		{
+			// Workers keep what they add to themselves, other threads spread
+			// requests in turn
+			WorkerHandle* handle = OGRE_THREAD_POINTER_GET(mWorkerHandle);
+			if (handle)
+				index = handle->index;
+			else
+				index = static_cast<size_t>(r->getID());
+			index %= mWorkerRequests.size();
+		}
+
+		WorkerRequests* worker = mWorkerRequests[index];
+		OGRE_LOCK_MUTEX(worker->mMutex)
+		if (bound)
+		{
+			insertRequest(worker->mBoundQueue, r);
+		}
+		else
+		{
+			insertRequest(worker->mQueue, r);
+			++mNumStealableRequests;
+		}
+	}
+	//---------------------------------------------------------------------
+	WorkQueue::Request* DefaultWorkQueueBase::takeNextRequest()
+	{
+		Request* request = 0;
+		if (mWorkerRequests.empty())
+		{
+			OGRE_LOCK_MUTEX(mRequestMutex)
+
+			if (!mRequestQueue.empty())
+			{
+				request = mRequestQueue.front();
+				mRequestQueue.pop_front();
+				mProcessQueue.push_back( request );
+			}
+			return request;
+		}
+
+		size_t count = mWorkerRequests.size();
+		size_t home = 0;
+		WorkerHandle* handle = OGRE_THREAD_POINTER_GET(mWorkerHandle);
+		if (handle)
+		{
+			home = handle->index % count;
+
+			// Own requests first, bound or not, in order of priority
+			WorkerRequests* worker = mWorkerRequests[home];
+			OGRE_LOCK_MUTEX(worker->mMutex)
+			RequestQueue* queue = 0;
+			if (!worker->mBoundQueue.empty())
+				queue = &worker->mBoundQueue;
+			if (!worker->mQueue.empty() && (!queue || higherPriority(worker->mQueue.front(), queue->front())))
+				queue = &worker->mQueue;
+			if (queue)
+			{
+				request = queue->front();
+				queue->pop_front();
+				if (queue == &worker->mQueue)
+					--mNumStealableRequests;
+				worker->mProcessQueue.push_back(request);
+				return request;
+			}
+		}
+
+		// Steal from the others; the request is processed on behalf of the
+		// worker it came from, so that it is found there when aborting
+		for (size_t i = handle ? 1 : 0; i < count && mNumStealableRequests.get(); ++i)
+		{
+			WorkerRequests* victim = mWorkerRequests[(home + i) % count];
+			OGRE_LOCK_MUTEX(victim->mMutex)
+			if (!victim->mQueue.empty())
+			{
+				request = victim->mQueue.front();
+				victim->mQueue.pop_front();
+				--mNumStealableRequests;
+				victim->mProcessQueue.push_back(request);
+				return request;
+			}
+		}
+		return 0;
+	}
+	//---------------------------------------------------------------------
+	bool DefaultWorkQueueBase::hasPendingRequests() const
+	{
+		if (mWorkerRequests.empty())
+		{
+			OGRE_LOCK_MUTEX(mRequestMutex)
+			return !mRequestQueue.empty();
+		}
+
+		if (mNumStealableRequests.get())
+			return true;
+
+		WorkerHandle* handle = OGRE_THREAD_POINTER_GET(mWorkerHandle);
+		if (handle)
+		{
+			WorkerRequests* worker = mWorkerRequests[handle->index % mWorkerRequests.size()];
+			OGRE_LOCK_MUTEX(worker->mMutex)
+			return !worker->mBoundQueue.empty();
+		}
+		return false;
+	}
+	//---------------------------------------------------------------------
+	bool DefaultWorkQueueBase::WorkerRequests::abortRequest(RequestID id)
+	{
+		OGRE_LOCK_MUTEX(mMutex)
+
+		RequestQueue* queues[] = { &mProcessQueue, &mQueue, &mBoundQueue };
+		for (size_t q = 0; q < 3; ++q)
+		{
+			for (RequestQueue::iterator i = queues[q]->begin(); i != queues[q]->end(); ++i)
+			{
+				if ((*i)->getID() == id)
+				{
+					(*i)->abortRequest();
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::WorkerRequests::abortRequestsByChannel(uint16 channel, bool includeProcessing)
+	{
+		OGRE_LOCK_MUTEX(mMutex)
+
+		RequestQueue* queues[] = { &mQueue, &mBoundQueue, &mProcessQueue };
+		for (size_t q = 0; q < (includeProcessing ? 3 : 2); ++q)
+		{
+			for (RequestQueue::iterator i = queues[q]->begin(); i != queues[q]->end(); ++i)
+			{
+				if ((*i)->getChannel() == channel)
+				{
+					(*i)->abortRequest();
+				}
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueueBase::WorkerRequests::abortAllRequests()
+	{
+		OGRE_LOCK_MUTEX(mMutex)
+
+		RequestQueue* queues[] = { &mQueue, &mBoundQueue, &mProcessQueue };
+		for (size_t q = 0; q < 3; ++q)
+		{
+			for (RequestQueue::iterator i = queues[q]->begin(); i != queues[q]->end(); ++i)
+			{
+				(*i)->abortRequest();
+			}
+		}
+	}
+	//---------------------------------------------------------------------
 	DefaultWorkQueueBase::~DefaultWorkQueueBase()
 	{
 		//shutdown(); // can't call here; abstract function
@@ -118,6 +407,17 @@ namespace Ogre {
 		}
 		mRequestQueue.clear();
 
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			WorkerRequests* worker = *w;
+			for (RequestQueue::iterator i = worker->mQueue.begin(); i != worker->mQueue.end(); ++i)
+				OGRE_DELETE (*i);
+			for (RequestQueue::iterator i = worker->mBoundQueue.begin(); i != worker->mBoundQueue.end(); ++i)
+				OGRE_DELETE (*i);
+			OGRE_DELETE worker;
+		}
+		mWorkerRequests.clear();
+
 		for (ResponseQueue::iterator i = mResponseQueue.begin(); i != mResponseQueue.end(); ++i)
 		{
 			OGRE_DELETE (*i);
@@ -202,35 +502,42 @@ namespace Ogre {
 	{
 		Request* req = 0;
 		RequestID rid = 0;
+		uint8 priority;
+		size_t boundWorker;
 
 		{
-			// lock to acquire rid and push request to the queue
+			// lock only to acquire rid, the request is built and queued outside
 			OGRE_LOCK_MUTEX(mRequestMutex)
 
 			if (!mAcceptRequests || mShuttingDown)
 				return 0;
 
 			rid = ++mRequestCount;
-			req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+			getChannelScheduling(channel, priority, boundWorker);
+		}
+
+		req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid, priority);
 
-			LogManager::getSingleton().stream(LML_TRIVIAL) << 
-				"DefaultWorkQueueBase('" << mName << "') - QUEUED(thread:" <<
+		LogManager::getSingleton().stream(LML_TRIVIAL) << 
+			"DefaultWorkQueueBase('" << mName << "') - QUEUED(thread:" <<
 #if OGRE_THREAD_SUPPORT
-				OGRE_THREAD_CURRENT_ID
+			OGRE_THREAD_CURRENT_ID
 #else
-				"main"
+			"main"
 #endif
-				<< "): ID=" << rid
-			    << " channel=" << channel << " requestType=" << requestType;
+			<< "): ID=" << rid
+			<< " channel=" << channel << " requestType=" << requestType;
 #if OGRE_THREAD_SUPPORT
-			if (!forceSynchronous&& !idleThread)
-			{
-				mRequestQueue.push_back(req);
+		if (!forceSynchronous&& !idleThread)
+		{
+			queueRequest(req, boundWorker);
+			if (boundWorker != std::numeric_limits<size_t>::max() && !mWorkerRequests.empty())
+				notifyAllWorkers();
+			else
 				notifyWorkers();
-				return rid;
-			}
-#endif
+			return rid;
 		}
+#endif
 		if(idleThread){
 			OGRE_LOCK_MUTEX(mIdleMutex);
 			mIdleRequestQueue.push_back(req);
@@ -254,7 +561,10 @@ namespace Ogre {
 		if (mShuttingDown)
 			return;
 
-		Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid);
+		uint8 priority;
+		size_t boundWorker;
+		getChannelScheduling(channel, priority, boundWorker);
+		Request* req = OGRE_NEW Request(channel, requestType, rData, retryCount, rid, priority);
 
 		LogManager::getSingleton().stream(LML_TRIVIAL) << 
 			"DefaultWorkQueueBase('" << mName << "') - REQUEUED(thread:" <<
@@ -266,8 +576,11 @@ namespace Ogre {
 			<< "): ID=" << rid
 				   << " channel=" << channel << " requestType=" << requestType;
 #if OGRE_THREAD_SUPPORT
-		mRequestQueue.push_back(req);
-		notifyWorkers();
+		queueRequest(req, boundWorker);
+		if (boundWorker != std::numeric_limits<size_t>::max() && !mWorkerRequests.empty())
+			notifyAllWorkers();
+		else
+			notifyWorkers();
 #else
 		processRequestResponse(req, true);
 #endif
@@ -302,6 +615,12 @@ namespace Ogre {
 			}
 		}
 
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			if ((*w)->abortRequest(id))
+				break;
+		}
+
 		{
 			if(mIdleProcessed)
 			{
@@ -352,6 +671,10 @@ namespace Ogre {
 				}
 			}
 		}
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			(*w)->abortRequestsByChannel(channel, true);
+		}
 		{
 			if (mIdleProcessed && mIdleProcessed->getChannel() == channel)
 			{
@@ -394,6 +717,10 @@ namespace Ogre {
 				}
 			}
 		}
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			(*w)->abortRequestsByChannel(channel, false);
+		}
 		{
 			OGRE_LOCK_MUTEX(mIdleMutex)
 
@@ -427,6 +754,11 @@ namespace Ogre {
 			}
 		}
 
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			(*w)->abortAllRequests();
+		}
+
 		{
 
 			if(mIdleProcessed)
@@ -484,19 +816,16 @@ namespace Ogre {
 			return;
 		}
 		Request* request = 0;
+		if (mWorkerRequests.empty())
 		{
 			// scoped to only lock while retrieving the next request
 			OGRE_LOCK_MUTEX(mProcessMutex)
-			{
-				OGRE_LOCK_MUTEX(mRequestMutex)
-
-				if (!mRequestQueue.empty())
-				{
-					request = mRequestQueue.front();
-					mRequestQueue.pop_front();
-					mProcessQueue.push_back( request );
-				}
-			}
+			request = takeNextRequest();
+		}
+		else
+		{
+			// the worker queues keep note of the requests taken from them
+			request = takeNextRequest();
 		}
 
 		if (request)
@@ -509,7 +838,8 @@ namespace Ogre {
 	//---------------------------------------------------------------------
 	void DefaultWorkQueueBase::processRequestResponse(Request* r, bool synchronous)
 	{
-		Response* response = processRequest(r);
+		bool handled = false;
+		Response* response = processRequest(r, handled);
 
 		OGRE_LOCK_MUTEX(mProcessMutex)
 
@@ -522,6 +852,16 @@ namespace Ogre {
 				break;
 			}
 		}
+		for (WorkerRequestsList::iterator w = mWorkerRequests.begin(); w != mWorkerRequests.end(); ++w)
+		{
+			OGRE_LOCK_MUTEX((*w)->mMutex)
+			it = std::find((*w)->mProcessQueue.begin(), (*w)->mProcessQueue.end(), r);
+			if (it != (*w)->mProcessQueue.end())
+			{
+				(*w)->mProcessQueue.erase(it);
+				break;
+			}
+		}
 		if( mIdleProcessed == r )
 		{
 			mIdleProcessed = 0;
@@ -563,10 +903,13 @@ namespace Ogre {
 		else
 		{
 			// no response, delete request
-			LogManager::getSingleton().stream() << 
-				"DefaultWorkQueueBase('" << mName << "') warning: no handler processed request "
-				<< r->getID() << ", channel " << r->getChannel()
-				<< ", type " << r->getType();
+			if (!handled)
+			{
+				LogManager::getSingleton().stream() << 
+					"DefaultWorkQueueBase('" << mName << "') warning: no handler processed request "
+					<< r->getID() << ", channel " << r->getChannel()
+					<< ", type " << r->getType();
+			}
 			OGRE_DELETE r;
 		}
 
@@ -611,14 +954,19 @@ namespace Ogre {
 		}
 	}
 	//---------------------------------------------------------------------
-	WorkQueue::Response* DefaultWorkQueueBase::processRequest(Request* r)
+	WorkQueue::Response* DefaultWorkQueueBase::processRequest(Request* r, bool& handled)
 	{
-		RequestHandlerListByChannel handlerListCopy;
+		OgreProfileGroup("WorkQueue::processRequest", OGREPROF_GENERAL);
+
+		RequestHandlerList handlerListCopy;
 		{
-			// lock the list only to make a copy of it, to maximise parallelism
+			// lock the list only to make a copy of the handlers of the channel,
+			// to maximise parallelism
 			OGRE_LOCK_RW_MUTEX_READ(mRequestHandlerMutex);
 			
-			handlerListCopy = mRequestHandlers;
+			RequestHandlerListByChannel::iterator i = mRequestHandlers.find(r->getChannel());
+			if (i != mRequestHandlers.end())
+				handlerListCopy = i->second;
 			
 		}
 
@@ -637,23 +985,18 @@ namespace Ogre {
 		LogManager::getSingleton().stream(LML_TRIVIAL) << 
 			"DefaultWorkQueueBase('" << mName << "') - PROCESS_REQUEST_START(" << dbgMsg.str();
 
-		RequestHandlerListByChannel::iterator i = handlerListCopy.find(r->getChannel());
-		if (i != handlerListCopy.end())
+		for (RequestHandlerList::reverse_iterator j = handlerListCopy.rbegin(); j != handlerListCopy.rend(); ++j)
 		{
-			RequestHandlerList& handlers = i->second;
-			for (RequestHandlerList::reverse_iterator j = handlers.rbegin(); j != handlers.rend(); ++j)
-			{
-				// threadsafe call which tests canHandleRequest and calls it if so 
-				response = (*j)->handleRequest(r, this);
+			// threadsafe call which tests canHandleRequest and calls it if so 
+			response = (*j)->handleRequest(r, this, handled);
 
-				if (response)
-					break;
-			}
+			if (handled)
+				break;
 		}
 
 		LogManager::getSingleton().stream(LML_TRIVIAL) << 
 			"DefaultWorkQueueBase('" << mName << "') - PROCESS_REQUEST_END(" << dbgMsg.str()
-			<< " processed=" << (response!=0);
+			<< " processed=" << handled;
 
 		return response;
 
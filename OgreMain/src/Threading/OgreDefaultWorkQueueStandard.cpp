@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreRoot.h"
 #include "OgreRenderSystem.h"
+#include "OgreProfiler.h"
 
 namespace Ogre
 {
@@ -56,6 +57,8 @@ namespace Ogre
 
 		mShuttingDown = false;
 
+		setupRequestQueues();
+
 		mWorkerFunc = OGRE_NEW_T(WorkerFunc(this), MEMCATEGORY_GENERAL);
 
 		LogManager::getSingleton().stream() <<
@@ -147,9 +150,18 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	void DefaultWorkQueue::notifyWorkers()
 	{
+		// lock so that a thread about to wait can't miss the notification
+		OGRE_LOCK_MUTEX(mRequestMutex)
 		// wake up waiting thread
 		OGRE_THREAD_NOTIFY_ONE(mRequestCondition)
 	}
+	//---------------------------------------------------------------------
+	void DefaultWorkQueue::notifyAllWorkers()
+	{
+		OGRE_LOCK_MUTEX(mRequestMutex)
+		// wake up all waiting threads, only the right one will find the request
+		OGRE_THREAD_NOTIFY_ALL(mRequestCondition)
+	}
 
 	//---------------------------------------------------------------------
 	void DefaultWorkQueue::waitForNextRequest()
@@ -157,7 +169,7 @@ namespace Ogre
 #if OGRE_THREAD_SUPPORT
 		// Lock; note that OGRE_THREAD_WAIT will free the lock
 		OGRE_LOCK_MUTEX_NAMED(mRequestMutex, queueLock);
-		if (mRequestQueue.empty())
+		if (!hasPendingRequests())
 		{
 			// frees lock and suspends the thread
 			OGRE_THREAD_WAIT(mRequestCondition, mRequestMutex, queueLock);
@@ -178,6 +190,10 @@ namespace Ogre
 			"DefaultWorkQueue('" << getName() << "')::WorkerFunc - thread " 
 			<< OGRE_THREAD_CURRENT_ID << " starting.";
 
+		OgreProfileThreadName("WorkQueue '" + getName() + "' worker");
+
+		registerWorkerThread();
+
 		// Initialise the thread for RS if necessary
 		if (mWorkerRenderSystemAccess)
 		{
@@ -44,6 +44,8 @@ using namespace DirectX;
 
 namespace Ogre {
 
+    extern OptimisedUtil* _getOptimisedUtilGeneral(void);
+
 //-------------------------------------------------------------------------
 // Local classes
 //-------------------------------------------------------------------------
@@ -104,6 +106,62 @@ namespace Ogre {
             const float* srcPositions,
             float* destPositions,
             size_t numVertices);
+
+        /// @copydoc OptimisedUtil::concatenateNodeTransforms
+        virtual void concatenateNodeTransforms(
+            const TransformStreams& parentTransforms,
+            const TransformStreams& localTransforms,
+            const uint32* inheritOrientation,
+            const uint32* inheritScale,
+            const TransformStreams& derivedTransforms,
+            size_t numNodes)
+        {
+            // No DirectXMath version yet, use the general one
+            _getOptimisedUtilGeneral()->concatenateNodeTransforms(
+                parentTransforms, localTransforms,
+                inheritOrientation, inheritScale,
+                derivedTransforms, numNodes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoneMatrices
+        virtual void calculateBoneMatrices(
+            const TransformStreams& derivedTransforms,
+            const TransformStreams& bindingPoseInverses,
+            Matrix4* dstMatrices,
+            size_t numBones)
+        {
+            // No DirectXMath version yet, use the general one
+            _getOptimisedUtilGeneral()->calculateBoneMatrices(
+                derivedTransforms, bindingPoseInverses, dstMatrices, numBones);
+        }
+
+        /// @copydoc OptimisedUtil::calculateBoxesVisibility
+        virtual void calculateBoxesVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* const halfSizes[3],
+            char* visibilities,
+            size_t numBoxes)
+        {
+            // No DirectXMath version yet, use the general one
+            _getOptimisedUtilGeneral()->calculateBoxesVisibility(
+                planes, numPlanes, centres, halfSizes, visibilities, numBoxes);
+        }
+
+        /// @copydoc OptimisedUtil::calculateSpheresVisibility
+        virtual void calculateSpheresVisibility(
+            const Plane* planes,
+            size_t numPlanes,
+            const Real* const centres[3],
+            const Real* radii,
+            char* visibilities,
+            size_t numSpheres)
+        {
+            // No DirectXMath version yet, use the general one
+            _getOptimisedUtilGeneral()->calculateSpheresVisibility(
+                planes, numPlanes, centres, radii, visibilities, numSpheres);
+        }
     };
 
 //---------------------------------------------------------------------
@@ -67,6 +67,8 @@ namespace Ogre {
 
         // World geometry
         BspLevelPtr mLevel;
+        // Serialises moved object notifications from a parallel scene graph update
+        OGRE_MUTEX(mLevelObjectsMutex)
 
         // State variables for rendering WIP
         // Set of face groups (by index) already included
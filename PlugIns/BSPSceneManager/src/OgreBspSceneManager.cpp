@@ -608,6 +608,7 @@ namespace Ogre {
     {
 		if (!mLevel.isNull())
 		{
+			OGRE_LOCK_MUTEX(mLevelObjectsMutex)
 			mLevel->_notifyObjectMoved(mov, pos);
 		}
     }
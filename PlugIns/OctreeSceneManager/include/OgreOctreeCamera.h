@@ -81,6 +81,12 @@ public:
     */
     OctreeCamera::Visibility getVisibility( const AxisAlignedBox &bound );
 
+    /** Returns the visibility of the box against a copy of the culling planes
+        of a camera, which can be used from several threads at once.
+    */
+    static OctreeCamera::Visibility getVisibility( const CullingPlanes &planes, 
+        const AxisAlignedBox &bound );
+
 };
 
 }
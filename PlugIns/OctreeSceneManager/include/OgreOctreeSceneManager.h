@@ -127,6 +127,31 @@ public:
 		VisibleObjectsBoundsInfo* visibleBounds, bool foundvisible, 
 		bool onlyShadowCasters);
 
+    typedef vector< OctreeNode * >::type OctreeNodeVector;
+    typedef vector< Octree * >::type OctantVector;
+
+    /** Walks through the octree like walkOctree, but only lists the visible
+        nodes and octants instead of adding them to the render queue.
+    @remarks
+    This does not modify the octree, the nodes nor the camera, so separate
+    octants can be walked from several threads at once.
+    @param planes The culling planes of the camera, see Frustum::getCullingPlanes
+    @param includeChildren Whether to walk the children of the octant too
+    */
+    void findVisibleNodes( const CullingPlanes & planes, Octree * octant, 
+        bool foundvisible, bool includeChildren, 
+        OctreeNodeVector& visibleNodes, OctantVector& visibleOctants ) const;
+
+    /** Appends the nodes of a partially visible octant whose bounds are
+        visible to the list, testing their bounds a batch at a time.
+    */
+    void findVisibleOctantNodes( const CullingPlanes & planes, Octree * octant, 
+        OctreeNodeVector& visibleNodes ) const;
+
+    /** Adds a node found visible by walking the octree to the render queue. */
+    void addVisibleNode( OctreeNode * node, OctreeCamera * camera, RenderQueue * queue, 
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
+
     /** Checks the given OctreeNode, and determines if it needs to be moved
     * to a different octant.
     */
@@ -200,11 +225,49 @@ public:
 
 protected:
 
+    /** Task walking part of the octree, used by the parallel visibility culling. */
+    class OctreeCullingTask : public TaskGroup::Task
+    {
+    public:
+        const OctreeSceneManager* sceneManager;
+        /// The planes of the camera to cull against
+        const CullingPlanes* planes;
+        /// The octant to walk, see findVisibleNodes
+        Octree* octant;
+        bool foundVisible;
+        bool includeChildren;
+        /// Visible nodes found by the task, in walk order
+        OctreeNodeVector visibleNodes;
+        /// Visible octants found by the task, in walk order
+        OctantVector visibleOctants;
+
+        void execute( void );
+    };
+    typedef vector< OctreeCullingTask >::type OctreeCullingTaskList;
+
+    /// Parallel culling tasks, kept to avoid allocating every frame
+    OctreeCullingTaskList mOctreeCullingTasks;
+    /// Pointers to the used mOctreeCullingTasks, as passed to mCullingTaskGroup
+    TaskGroup::TaskList mOctreeCullingTaskList;
+
+    /** Finds the visible objects by walking the octants below the root of
+        the octree on the threads of mCullingTaskGroup.
+    @remarks
+    The octants two levels below the root are walked by separate tasks;
+    the results are queued on the calling thread in walk order.
+    */
+    virtual void findVisibleObjectsInParallel( Camera * cam, 
+        VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters );
 
 	Octree::NodeList mVisible;
 
+    /// Visible nodes of the partially visible octant walkOctree is at
+    OctreeNodeVector mVisibleOctantNodes;
+
     /// The root octree
     Octree *mOctree;
+    /// Serialises octree changes made from a parallel scene graph update
+    OGRE_MUTEX(mOctreeMutex)
 
     /// List of boxes to be rendered
     BoxList mBoxes;
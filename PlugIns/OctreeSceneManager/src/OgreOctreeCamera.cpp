@@ -51,6 +51,16 @@ OctreeCamera::~OctreeCamera()
 }
 
 OctreeCamera::Visibility OctreeCamera::getVisibility( const AxisAlignedBox &bound )
+{
+    // This updates frustum planes and deals with cull frustum
+    CullingPlanes planes;
+    getCullingPlanes( planes );
+
+    return getVisibility( planes, bound );
+}
+
+OctreeCamera::Visibility OctreeCamera::getVisibility( const CullingPlanes &planes, 
+    const AxisAlignedBox &bound )
 {
 
     // Null boxes always invisible
@@ -64,15 +74,10 @@ OctreeCamera::Visibility OctreeCamera::getVisibility( const AxisAlignedBox &boun
 
     bool all_inside = true;
 
-    for ( int plane = 0; plane < 6; ++plane )
+    // The far plane of an infinite view frustum is already left out
+    for ( size_t plane = 0; plane < planes.numPlanes; ++plane )
     {
-
-        // Skip far plane if infinite view frustum
-        if (plane == FRUSTUM_PLANE_FAR && mFarDist == 0)
-            continue;
-
-		// This updates frustum planes and deals with cull frustum
-        Plane::Side side = getFrustumPlane(plane).getSide(centre, halfSize);
+        Plane::Side side = planes.planes[ plane ].getSide(centre, halfSize);
         if(side == Plane::NEGATIVE_SIDE) return NONE;
         // We can't return now as the box could be later on the negative side of a plane.
         if(side == Plane::BOTH_SIDE) 
@@ -85,7 +90,6 @@ OctreeCamera::Visibility OctreeCamera::getVisibility( const AxisAlignedBox &boun
         return PARTIAL;
 
 }
-
 }
 
 
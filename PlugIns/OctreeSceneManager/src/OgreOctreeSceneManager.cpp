@@ -418,6 +418,7 @@ void OctreeSceneManager::_updateOctreeNode( OctreeNode * onode )
 
     if ( onode -> getOctant() == 0 )
     {
+        OGRE_LOCK_MUTEX(mOctreeMutex)
         //if outside the octree, force into the root node.
         if ( ! onode -> _isIn( mOctree -> mBox ) )
             mOctree->_addNode( onode );
@@ -428,6 +429,7 @@ void OctreeSceneManager::_updateOctreeNode( OctreeNode * onode )
 
     if ( ! onode -> _isIn( onode -> getOctant() -> mBox ) )
     {
+        OGRE_LOCK_MUTEX(mOctreeMutex)
         _removeOctreeNode( onode );
 
         //if outside the octree, force into the root node.
@@ -574,7 +576,10 @@ void OctreeSceneManager::_findVisibleObjects(Camera * cam,
     mNumObjects = 0;
 
     //walk the octree, adding all visible Octreenodes nodes to the render queue.
-    walkOctree( static_cast < OctreeCamera * > ( cam ), getRenderQueue(), mOctree, 
+    if ( mCullingTaskGroup )
+        findVisibleObjectsInParallel( cam, visibleBounds, onlyShadowCasters );
+    else
+        walkOctree( static_cast < OctreeCamera * > ( cam ), getRenderQueue(), mOctree, 
 				visibleBounds, false, onlyShadowCasters );
 
     // Show the octree boxes & cull camera if required
@@ -621,42 +626,35 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
     {
 
         //Add stuff to be rendered;
-        Octree::NodeList::iterator it = octant -> mNodes.begin();
-
         if ( mShowBoxes )
         {
             mBoxes.push_back( octant->getWireBoundingBox() );
         }
 
-        bool vis = true;
-
-        while ( it != octant -> mNodes.end() )
+        if ( v == OctreeCamera::PARTIAL )
         {
-            OctreeNode * sn = *it;
-
             // if this octree is partially visible, manually cull all
             // scene nodes attached directly to this level.
+            CullingPlanes planes;
+            camera -> getCullingPlanes( planes );
+            mVisibleOctantNodes.clear();
+            findVisibleOctantNodes( planes, octant, mVisibleOctantNodes );
 
-            if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
-
-            if ( vis )
+            OctreeNodeVector::iterator it = mVisibleOctantNodes.begin();
+            while ( it != mVisibleOctantNodes.end() )
             {
-
-                mNumObjects++;
-                sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
-
-                mVisible.push_back( sn );
-
-                if ( mDisplayNodes )
-                    queue -> addRenderable( sn->getDebugRenderable() );
-
-                // check if the scene manager or this node wants the bounding box shown.
-                if (sn->getShowBoundingBox() || mShowBoundingBoxes)
-                    sn->_addBoundingBoxToQueue(queue);
+                addVisibleNode( *it, camera, queue, visibleBounds, onlyShadowCasters );
+                ++it;
+            }
+        }
+        else
+        {
+            Octree::NodeList::iterator it = octant -> mNodes.begin();
+            while ( it != octant -> mNodes.end() )
+            {
+                addVisibleNode( *it, camera, queue, visibleBounds, onlyShadowCasters );
+                ++it;
             }
-
-            ++it;
         }
 
         Octree* child;
@@ -689,6 +687,191 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
 
 }
 
+void OctreeSceneManager::findVisibleOctantNodes( const CullingPlanes & planes, Octree * octant, 
+    OctreeNodeVector& visibleNodes ) const
+{
+    const size_t BATCH_SIZE = 16;
+    OctreeNode* nodes[ BATCH_SIZE ];
+    const AxisAlignedBox* bounds[ BATCH_SIZE ];
+    char visibilities[ BATCH_SIZE ];
+
+    Octree::NodeList::iterator it = octant -> mNodes.begin();
+    while ( it != octant -> mNodes.end() )
+    {
+        size_t count = 0;
+        for ( ; it != octant -> mNodes.end() && count < BATCH_SIZE; ++it, ++count )
+        {
+            nodes[ count ] = *it;
+            bounds[ count ] = &( *it ) -> _getWorldAABB();
+        }
+
+        planes.isVisible( bounds, count, visibilities );
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( visibilities[ i ] )
+                visibleNodes.push_back( nodes[ i ] );
+        }
+    }
+}
+
+void OctreeSceneManager::addVisibleNode( OctreeNode * sn, OctreeCamera * camera, 
+    RenderQueue * queue, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters )
+{
+    mNumObjects++;
+    sn -> _addToRenderQueue(camera, queue, onlyShadowCasters, visibleBounds );
+
+    mVisible.push_back( sn );
+
+    if ( mDisplayNodes )
+        queue -> addRenderable( sn->getDebugRenderable() );
+
+    // check if the scene manager or this node wants the bounding box shown.
+    if (sn->getShowBoundingBox() || mShowBoundingBoxes)
+        sn->_addBoundingBoxToQueue(queue);
+}
+
+void OctreeSceneManager::findVisibleNodes( const CullingPlanes & planes, Octree * octant, 
+    bool foundvisible, bool includeChildren, 
+    OctreeNodeVector& visibleNodes, OctantVector& visibleOctants ) const
+{
+    // Same logic as walkOctree
+    if ( octant -> numNodes() == 0 )
+        return ;
+
+    OctreeCamera::Visibility v = OctreeCamera::NONE;
+
+    if ( foundvisible )
+    {
+        v = OctreeCamera::FULL;
+    }
+    else if ( octant == mOctree )
+    {
+        v = OctreeCamera::PARTIAL;
+    }
+    else
+    {
+        AxisAlignedBox box;
+        octant -> _getCullBounds( &box );
+        v = OctreeCamera::getVisibility( planes, box );
+    }
+
+    if ( v == OctreeCamera::NONE )
+        return ;
+
+    visibleOctants.push_back( octant );
+
+    if ( v == OctreeCamera::PARTIAL )
+    {
+        findVisibleOctantNodes( planes, octant, visibleNodes );
+    }
+    else
+    {
+        visibleNodes.insert( visibleNodes.end(), octant -> mNodes.begin(), octant -> mNodes.end() );
+    }
+
+    if ( !includeChildren )
+        return ;
+
+    // Same order as walkOctree
+    bool childfoundvisible = (v == OctreeCamera::FULL);
+    for ( int z = 0; z < 2; ++z )
+    {
+        for ( int y = 0; y < 2; ++y )
+        {
+            for ( int x = 0; x < 2; ++x )
+            {
+                Octree* child = octant -> mChildren[ x ][ y ][ z ];
+                if ( child )
+                    findVisibleNodes( planes, child, childfoundvisible, true, 
+                        visibleNodes, visibleOctants );
+            }
+        }
+    }
+}
+
+void OctreeSceneManager::findVisibleObjectsInParallel( Camera * cam, 
+    VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters )
+{
+    OctreeCamera * camera = static_cast < OctreeCamera * > ( cam );
+    RenderQueue * queue = getRenderQueue();
+
+    // Testing bounds against the camera may update it, so the threads cull
+    // against a copy of its planes taken here. The root octant and the
+    // visibility of its children are handled here too. Each child then gets
+    // a task for its own nodes and a task for each of its children, so that
+    // the tasks come in walk order.
+    camera -> getCullingPlanes( mCullingPlanes );
+    size_t numTasks = 0;
+    for ( int level1 = -1; level1 < 8; ++level1 )
+    {
+        Octree* octant = mOctree;
+        bool foundvisible = false;
+        if ( level1 >= 0 )
+        {
+            octant = mOctree -> mChildren[ level1 & 1 ][ ( level1 >> 1 ) & 1 ][ level1 >> 2 ];
+            if ( !octant || octant -> numNodes() == 0 )
+                continue;
+            AxisAlignedBox box;
+            octant -> _getCullBounds( &box );
+            OctreeCamera::Visibility v = OctreeCamera::getVisibility( mCullingPlanes, box );
+            if ( v == OctreeCamera::NONE )
+                continue;
+            foundvisible = (v == OctreeCamera::FULL);
+        }
+
+        for ( int level2 = -1; level2 < 8; ++level2 )
+        {
+            Octree* taskOctant = octant;
+            if ( level2 >= 0 )
+            {
+                if ( level1 < 0 )
+                    break;
+                taskOctant = octant -> mChildren[ level2 & 1 ][ ( level2 >> 1 ) & 1 ][ level2 >> 2 ];
+                if ( !taskOctant || taskOctant -> numNodes() == 0 )
+                    continue;
+            }
+
+            if ( mOctreeCullingTasks.size() == numTasks )
+                mOctreeCullingTasks.push_back( OctreeCullingTask() );
+            OctreeCullingTask& task = mOctreeCullingTasks[ numTasks++ ];
+            task.sceneManager = this;
+            task.planes = &mCullingPlanes;
+            task.octant = taskOctant;
+            task.foundVisible = foundvisible;
+            task.includeChildren = level2 >= 0;
+            task.visibleNodes.clear();
+            task.visibleOctants.clear();
+        }
+    }
+
+    mOctreeCullingTaskList.resize( numTasks );
+    for ( size_t i = 0; i < numTasks; ++i )
+        mOctreeCullingTaskList[ i ] = &mOctreeCullingTasks[ i ];
+
+    mCullingTaskGroup -> run( mOctreeCullingTaskList );
+
+    // Queue the results in walk order
+    for ( size_t i = 0; i < numTasks; ++i )
+    {
+        const OctreeCullingTask& task = mOctreeCullingTasks[ i ];
+        for ( size_t n = 0; n < task.visibleNodes.size(); ++n )
+            addVisibleNode( task.visibleNodes[ n ], camera, queue, visibleBounds, onlyShadowCasters );
+
+        if ( mShowBoxes )
+        {
+            for ( size_t o = 0; o < task.visibleOctants.size(); ++o )
+                mBoxes.push_back( task.visibleOctants[ o ] -> getWireBoundingBox() );
+        }
+    }
+}
+
+void OctreeSceneManager::OctreeCullingTask::execute( void )
+{
+    sceneManager -> findVisibleNodes( *planes, octant, foundVisible, includeChildren, 
+        visibleNodes, visibleOctants );
+}
+
 // --- non template versions
 void _findNodes( const AxisAlignedBox &t, list< SceneNode * >::type &list, SceneNode *exclude, bool full, Octree *octant )
 {
@@ -78,6 +78,9 @@ namespace Ogre
 		/* Overridden isVisible function for aabb */
 		virtual bool isVisible( const AxisAlignedBox &bound, FrustumPlane *culledBy=0) const;
 
+		/* Overridden batch isVisible function for aabbs, so the extra culling planes are used */
+		virtual void isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const;
+
 		/* isVisible() function for portals */
 		bool isVisible(PortalBase* portal, FrustumPlane* culledBy = 0) const;
 
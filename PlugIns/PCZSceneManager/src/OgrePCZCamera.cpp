@@ -89,6 +89,14 @@ namespace Ogre
 		return true;
    }
 
+    void PCZCamera::isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            visibilities[i] = isVisible(*bounds[i]);
+        }
+    }
+
 	/* A 'more detailed' check for visibility of an AAB.  This function returns
 	  none, partial, or full for visibility of the box.  This is useful for 
 	  stuff like Octree leaf culling */
@@ -151,6 +151,8 @@ namespace Ogre {
 		// that cg adds to the hlsl 4 output. This is to solve the issue that
 		// in some cases cg changes the name of the var to a new name.
 		void fixVariableNameFromCg(const ShaderVarWithPosInBuf& newVar);
+		// Orders shader variables by their offset in the constant buffer
+		static bool shaderVarOffsetLess(const ShaderVarWithPosInBuf& a, const ShaderVarWithPosInBuf& b);
 		//ShaderVars mShaderVars;
 		
 		// HACK: Multi-index emulation container to store constant buffer information by index and name at same time
@@ -164,11 +166,13 @@ namespace Ogre {
 			String mName;
 			mutable HardwareUniformBufferSharedPtr mUniformBuffer;
 			mutable ShaderVars mShaderVars;
+			// Index of the buffer in the layouts of the constant definitions
+			mutable size_t mLayoutIndex;
 				
 			// Default constructor
-			BufferInfo() : mIdx(0), mName("") { mUniformBuffer.setNull(); }
+			BufferInfo() : mIdx(0), mName(""), mLayoutIndex(INVALID_IDX) { mUniformBuffer.setNull(); }
 			BufferInfo(unsigned int index, const String& name)
-				: mIdx(index), mName(name)
+				: mIdx(index), mName(name), mLayoutIndex(INVALID_IDX)
 			{
 				mUniformBuffer.setNull();
 			}
@@ -179,6 +183,7 @@ namespace Ogre {
 				, mName(info.mName)
 				, mUniformBuffer(info.mUniformBuffer)
 				, mShaderVars(info.mShaderVars)
+				, mLayoutIndex(info.mLayoutIndex)
 			{
 
 			}
@@ -190,12 +195,13 @@ namespace Ogre {
 				this->mName = info.mName;
 				mUniformBuffer = info.mUniformBuffer;
 				mShaderVars = info.mShaderVars;
+				mLayoutIndex = info.mLayoutIndex;
 				return *this;
 			}
 			
 			// Constructors and operators used for search
-			BufferInfo(unsigned int index) : mIdx(index), mName("") { }
-			BufferInfo(const String& name) : mIdx(INVALID_IDX), mName(name) { }
+			BufferInfo(unsigned int index) : mIdx(index), mName(""), mLayoutIndex(INVALID_IDX) { }
+			BufferInfo(const String& name) : mIdx(INVALID_IDX), mName(name), mLayoutIndex(INVALID_IDX) { }
 			BufferInfo& operator=(unsigned int index) { this->mIdx = index; return *this; }
 			BufferInfo& operator=(const String& name) { this->mName = name; return *this; }	
 			
@@ -232,6 +238,9 @@ namespace Ogre {
 		typedef std::set<BufferInfo>::iterator BufferInfoIterator;
 		BufferInfoMap mBufferInfoMap;
 
+		// Copies the variables of a constant buffer from the parameters into mapped memory
+		void fillConstantBuffer(const BufferInfo& info, const GpuProgramParametersSharedPtr& params, void* pMappedData);
+
 		// Map to store interface slot position. 
 		// Number of interface slots is size of this map.
 		typedef std::map<std::string, unsigned int> SlotMap;
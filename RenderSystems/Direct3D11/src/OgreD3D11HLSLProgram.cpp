@@ -65,6 +65,11 @@ namespace Ogre {
         }
     }
 	//-----------------------------------------------------------------------
+	bool D3D11HLSLProgram::shaderVarOffsetLess(const ShaderVarWithPosInBuf& a, const ShaderVarWithPosInBuf& b)
+	{
+		return a.startOffset < b.startOffset;
+	}
+	//-----------------------------------------------------------------------------
 	void D3D11HLSLProgram::fixVariableNameFromCg(const ShaderVarWithPosInBuf& newVar)
 	{
 		String varForSearch = String(" :  : ") + newVar.name;
@@ -1027,6 +1032,30 @@ namespace Ogre {
             // Now deal with arrays
             mConstantDefs->generateConstantDefinitionArrayEntries(def.Name, def);
         }
+
+        // Describe the constant buffers, so that getConstantBuffer can fill them
+        // a block at a time rather than looking up each variable by name
+        for (BufferInfoIterator it = mBufferInfoMap.begin(); it != mBufferInfoMap.end(); ++it)
+        {
+            if (it->mUniformBuffer.isNull())
+                continue;
+
+            // Constants must be added in order of offset
+            ShaderVars vars = it->mShaderVars;
+            std::sort(vars.begin(), vars.end(), shaderVarOffsetLess);
+
+            it->mLayoutIndex = mConstantDefs->addBufferLayout(it->mUniformBuffer->getSizeInBytes());
+            for (ShaderVarsConstIter v = vars.begin(); v != vars.end(); ++v)
+            {
+                if (mConstantDefs->map.find(v->name) != mConstantDefs->map.end())
+                    mConstantDefs->addBufferConstant(it->mLayoutIndex, v->name, v->startOffset, v->size);
+            }
+        }
+        if (!mBufferInfoMap.empty())
+        {
+            mConstantDefs->mirrorBufferLayouts(mFloatLogicalToPhysical.get(),
+                mDoubleLogicalToPhysical.get(), mIntLogicalToPhysical.get());
+        }
     }
 	//-----------------------------------------------------------------------
 
@@ -1624,6 +1653,35 @@ namespace Ogre {
 		return it->second;
 	}
 	//-----------------------------------------------------------------------------
+	void D3D11HLSLProgram::fillConstantBuffer(const BufferInfo& info, 
+		const GpuProgramParametersSharedPtr& params, void* pMappedData)
+	{
+		// The layout describes the buffer once the constant definitions are built
+		if (info.mLayoutIndex != INVALID_IDX)
+		{
+			params->_copyConstantBuffer(info.mLayoutIndex, pMappedData);
+			return;
+		}
+
+		// Only iterate through parsed variables (getting size of list)
+		void* src = 0;
+		ShaderVarsConstIter iter = info.mShaderVars.begin();
+		for (; iter != info.mShaderVars.end(); ++iter)
+		{
+			const GpuConstantDefinition& def = params->getConstantDefinition(iter->name);
+			if(def.isFloat())
+			{
+				src = (void *)&(*(params->getFloatConstantList().begin() + def.physicalIndex));
+			}
+			else
+			{
+				src = (void *)&(*(params->getIntConstantList().begin() + def.physicalIndex));
+			}
+
+			memcpy( &(((char *)(pMappedData))[iter->startOffset]), src , iter->size);
+		}
+	}
+	//-----------------------------------------------------------------------------
 	ID3D11Buffer* D3D11HLSLProgram::getConstantBuffer(GpuProgramParametersSharedPtr params, uint16 variabilityMask)
 	{
 		// Update the Constant Buffer
@@ -1633,31 +1691,9 @@ namespace Ogre {
 			if (!it->mUniformBuffer.isNull())
 			{
 				void* pMappedData = it->mUniformBuffer->lock(HardwareBuffer::HBL_DISCARD);
-
-				// Only iterate through parsed variables (getting size of list)
-				void* src = 0;
-				ShaderVarWithPosInBuf* iter = &(it->mShaderVars[0]);
-				unsigned int lSize = it->mShaderVars.size();
-				for (size_t i = 0 ; i < lSize; i++, iter++)
-				{
-					const GpuConstantDefinition& def = params->getConstantDefinition(iter->name);
-					// Since we are mapping with write discard, contents of the buffer are undefined.
-					// We must set every variable, even if it has not changed.
-					//if (def.variability & variabilityMask)
-					{
-						if(def.isFloat())
-						{
-							src = (void *)&(*(params->getFloatConstantList().begin() + def.physicalIndex));
-						}
-						else
-						{
-							src = (void *)&(*(params->getIntConstantList().begin() + def.physicalIndex));
-						}
-
-						memcpy( &(((char *)(pMappedData))[iter->startOffset]), src , iter->size);
-					}
-				}
-
+				// Since we are mapping with write discard, contents of the buffer are undefined.
+				// We must set every variable, even if it has not changed.
+				fillConstantBuffer(*it, params, pMappedData);
 				it->mUniformBuffer->unlock();
 
 				return static_cast<D3D11HardwareUniformBuffer*>(it->mUniformBuffer.get())->getD3DConstantBuffer();
@@ -1679,31 +1715,9 @@ namespace Ogre {
 			if (!it->mUniformBuffer.isNull())
 			{
 				void* pMappedData = it->mUniformBuffer->lock(HardwareBuffer::HBL_DISCARD);
-
-				// Only iterate through parsed variables (getting size of list)
-				void* src = 0;
-				ShaderVarWithPosInBuf* iter = &(it->mShaderVars[0]);
-				unsigned int lSize = it->mShaderVars.size();
-				for (size_t i = 0 ; i < lSize; i++, iter++)
-				{
-					const GpuConstantDefinition& def = params->getConstantDefinition(iter->name);
-					// Since we are mapping with write discard, contents of the buffer are undefined.
-					// We must set every variable, even if it has not changed.
-					//if (def.variability & variabilityMask)
-					{
-						if(def.isFloat())
-						{
-							src = (void *)&(*(params->getFloatConstantList().begin() + def.physicalIndex));
-						}
-						else
-						{
-							src = (void *)&(*(params->getIntConstantList().begin() + def.physicalIndex));
-						}
-
-						memcpy( &(((char *)(pMappedData))[iter->startOffset]), src , iter->size);
-					}
-				}
-
+				// Since we are mapping with write discard, contents of the buffer are undefined.
+				// We must set every variable, even if it has not changed.
+				fillConstantBuffer(*it, params, pMappedData);
 				it->mUniformBuffer->unlock();
 
 				// Add buffer to list
@@ -0,0 +1,123 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwareBufferManager_H__
+#define __NullHardwareBufferManager_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreDefaultHardwareBufferManager.h"
+
+namespace Ogre {
+
+	/** System memory vertex buffer which reports every write to the
+		NullRenderSystem, so the bytes a real device would have been sent
+		can be measured.
+	*/
+	class _OgreNullExport NullHardwareVertexBuffer : public DefaultHardwareVertexBuffer
+	{
+	protected:
+		NullRenderSystem* mRenderSystem;
+		LockOptions mLockOptions;
+		size_t mLockLength;
+
+	public:
+		NullHardwareVertexBuffer(NullRenderSystem* renderSystem, HardwareBufferManagerBase* mgr,
+			size_t vertexSize, size_t numVertices, HardwareBuffer::Usage usage);
+
+		/// @copydoc HardwareBuffer::writeData
+		void writeData(size_t offset, size_t length, const void* pSource,
+			bool discardWholeBuffer = false);
+		/// @copydoc HardwareBuffer::lock
+		void* lock(size_t offset, size_t length, LockOptions options);
+		/// @copydoc HardwareBuffer::unlock
+		void unlock(void);
+	};
+
+	/** System memory index buffer which reports every write to the
+		NullRenderSystem.
+	*/
+	class _OgreNullExport NullHardwareIndexBuffer : public DefaultHardwareIndexBuffer
+	{
+	protected:
+		NullRenderSystem* mRenderSystem;
+		LockOptions mLockOptions;
+		size_t mLockLength;
+
+	public:
+		NullHardwareIndexBuffer(NullRenderSystem* renderSystem, IndexType idxType,
+			size_t numIndexes, HardwareBuffer::Usage usage);
+
+		/// @copydoc HardwareBuffer::writeData
+		void writeData(size_t offset, size_t length, const void* pSource,
+			bool discardWholeBuffer = false);
+		/// @copydoc HardwareBuffer::lock
+		void* lock(size_t offset, size_t length, LockOptions options);
+		/// @copydoc HardwareBuffer::unlock
+		void unlock(void);
+	};
+
+	/** Buffer manager for the Null render system.
+	@remarks
+		Built on DefaultHardwareBufferManagerBase, so every buffer lives in
+		system memory; vertex and index buffers are tracked like those of a
+		real render system and count the bytes written to them.
+	*/
+	class _OgreNullExport NullHardwareBufferManagerBase : public DefaultHardwareBufferManagerBase
+	{
+	protected:
+		NullRenderSystem* mRenderSystem;
+
+	public:
+		NullHardwareBufferManagerBase(NullRenderSystem* renderSystem);
+		/// Creates a vertex buffer
+		HardwareVertexBufferSharedPtr
+			createVertexBuffer(size_t vertexSize, size_t numVerts,
+				HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+		/// Create a hardware index buffer
+		HardwareIndexBufferSharedPtr
+			createIndexBuffer(HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+				HardwareBuffer::Usage usage, bool useShadowBuffer = false);
+	};
+
+	/// NullHardwareBufferManagerBase as a Singleton
+	class _OgreNullExport NullHardwareBufferManager : public HardwareBufferManager
+	{
+	public:
+		NullHardwareBufferManager(NullRenderSystem* renderSystem)
+			: HardwareBufferManager(OGRE_NEW NullHardwareBufferManagerBase(renderSystem))
+		{
+
+		}
+		~NullHardwareBufferManager()
+		{
+			OGRE_DELETE mImpl;
+		}
+	};
+
+}
+
+#endif
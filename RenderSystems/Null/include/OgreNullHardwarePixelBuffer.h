@@ -0,0 +1,78 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullHardwarePixelBuffer_H__
+#define __NullHardwarePixelBuffer_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreHardwarePixelBuffer.h"
+
+namespace Ogre {
+
+	/** Texture surface kept in system memory.
+	@remarks
+		The memory is only allocated the first time the surface is written
+		to or locked, so render targets and textures which are never read
+		back cost nothing beyond their description.
+	*/
+	class _OgreNullExport NullHardwarePixelBuffer : public HardwarePixelBuffer
+	{
+	protected:
+		NullRenderSystem* mRenderSystem;
+		/// Surface contents, data is null until first used
+		PixelBox mBuffer;
+		LockOptions mCurrentLockOptions;
+
+		typedef vector<RenderTexture*>::type SliceTRT;
+		SliceTRT mSliceTRT;
+
+		void allocateBuffer();
+
+		/// @copydoc HardwarePixelBuffer::lockImpl
+		PixelBox lockImpl(const Image::Box lockBox, LockOptions options);
+		/// @copydoc HardwareBuffer::unlockImpl
+		void unlockImpl(void);
+		/// @copydoc HardwarePixelBuffer::_clearSliceRTT
+		void _clearSliceRTT(size_t zoffset);
+
+	public:
+		NullHardwarePixelBuffer(NullRenderSystem* renderSystem, const String& baseName,
+			size_t width, size_t height, size_t depth, PixelFormat format, int usage,
+			bool writeGamma, uint fsaa);
+		~NullHardwarePixelBuffer();
+
+		/// @copydoc HardwarePixelBuffer::blitFromMemory
+		void blitFromMemory(const PixelBox &src, const Image::Box &dstBox);
+		/// @copydoc HardwarePixelBuffer::blitToMemory
+		void blitToMemory(const Image::Box &srcBox, const PixelBox &dst);
+		/// @copydoc HardwarePixelBuffer::getRenderTarget
+		RenderTexture* getRenderTarget(size_t slice = 0);
+	};
+
+}
+
+#endif
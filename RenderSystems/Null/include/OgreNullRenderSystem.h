@@ -0,0 +1,239 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystem_H__
+#define __NullRenderSystem_H__
+
+#include "OgreNullPrerequisites.h"
+#include "OgreRenderSystem.h"
+#include "OgreAtomicWrappers.h"
+#include "OgreNullHardwareBufferManager.h"
+
+namespace Ogre {
+
+	/** Headless render system which accepts every call and draws nothing.
+	@remarks
+		All buffers and textures live in system memory and no graphics context
+		is created, so Root::renderOneFrame can drive complete scene pipelines
+		(culling, queue sorting, animation, parameter updates) on machines
+		without a GPU. The calls a real device would have received are
+		counted and can be read back through getStatistics, which makes this
+		render system useful for CPU-side throughput measurements and tests.
+	*/
+	class _OgreNullExport NullRenderSystem : public RenderSystem
+	{
+	public:
+		/// Counters of the work submitted since the last resetStatistics
+		struct Statistics
+		{
+			/// Number of frames presented with _swapAllRenderTargetBuffers
+			size_t frames;
+			/// Number of viewports rendered between _beginFrame and _endFrame
+			size_t viewports;
+			/// Number of draw calls, pass iterations included
+			size_t drawCalls;
+			/// Number of fixed function and output merger state calls
+			size_t stateChanges;
+			/// Number of world, view, projection and texture matrix changes
+			size_t transformChanges;
+			/// Number of texture units bound or unbound
+			size_t textureChanges;
+			/// Number of GPU programs bound or unbound
+			size_t programBinds;
+			/// Number of vertex declaration and buffer binding changes
+			size_t vertexStreamChanges;
+			/// Number of frame buffer clears
+			size_t clears;
+			/// Bytes of GPU program constants which would have been uploaded
+			size_t parameterBytes;
+			/// Bytes written to vertex and index buffers
+			size_t bufferBytes;
+			/// Bytes written to texture surfaces
+			size_t textureBytes;
+
+			Statistics();
+		};
+
+	protected:
+		bool mInitialised;
+		ConfigOptionMap mOptions;
+		HardwareBufferManager* mHardwareBufferManager;
+		GpuProgramManager* mGpuProgramManager;
+
+		Statistics mStatistics;
+		/// Uploads can come from background loading threads
+		AtomicScalar<size_t> mBufferBytes;
+		AtomicScalar<size_t> mTextureBytes;
+
+		/// Adds the constants a real device would upload for the given parameters
+		size_t calculateParameterBytes(const GpuProgramParametersSharedPtr& params,
+			uint16 variabilityMask) const;
+
+		void setClipPlanesImpl(const PlaneList& clipPlanes);
+		void initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps, RenderTarget* primary);
+
+	public:
+		NullRenderSystem();
+		~NullRenderSystem();
+
+		/** Returns the counters accumulated since the last call to resetStatistics. */
+		Statistics getStatistics(void) const;
+		/** Resets all counters to zero. */
+		void resetStatistics(void);
+
+		/** Called by the Null hardware buffers when data is written to them. */
+		void _notifyBufferUpload(size_t bytes) { mBufferBytes += bytes; }
+		/** Called by the Null pixel buffers when data is written to them. */
+		void _notifyTextureUpload(size_t bytes) { mTextureBytes += bytes; }
+
+		// ----------------------------------
+		// Overridden RenderSystem functions
+		// ----------------------------------
+		const String& getName(void) const;
+		ConfigOptionMap& getConfigOptions(void);
+		void setConfigOption(const String &name, const String &value);
+		String validateConfigOptions(void);
+		RenderWindow* _initialise(bool autoCreateWindow, const String& windowTitle = "OGRE Render Window");
+		RenderSystemCapabilities* createRenderSystemCapabilities() const;
+		void reinitialise(void);
+		void shutdown(void);
+
+		RenderWindow* _createRenderWindow(const String &name, unsigned int width, unsigned int height,
+			bool fullScreen, const NameValuePairList *miscParams = 0);
+		MultiRenderTarget* createMultiRenderTarget(const String & name);
+		DepthBuffer* _createDepthBufferFor(RenderTarget *renderTarget);
+		HardwareOcclusionQuery* createHardwareOcclusionQuery(void);
+		String getErrorDescription(long errorNumber) const;
+
+		void setAmbientLight(float r, float g, float b);
+		void setShadingType(ShadeOptions so);
+		void setLightingEnabled(bool enabled);
+		void setNormaliseNormals(bool normalise);
+		void _useLights(const LightList& lights, unsigned short limit);
+
+		void _setWorldMatrix(const Matrix4 &m);
+		void _setViewMatrix(const Matrix4 &m);
+		void _setProjectionMatrix(const Matrix4 &m);
+
+		void _setSurfaceParams(const ColourValue &ambient,
+			const ColourValue &diffuse, const ColourValue &specular,
+			const ColourValue &emissive, Real shininess,
+			TrackVertexColourType tracking = TVC_NONE);
+		void _setPointSpritesEnabled(bool enabled);
+		void _setPointParameters(Real size, bool attenuationEnabled,
+			Real constant, Real linear, Real quadratic, Real minSize, Real maxSize);
+
+		void _setTexture(size_t unit, bool enabled, const TexturePtr &texPtr);
+		void _setTextureCoordSet(size_t unit, size_t index);
+		void _setTextureCoordCalculation(size_t unit, TexCoordCalcMethod m,
+			const Frustum* frustum = 0);
+		void _setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm);
+		void _setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter);
+		void _setTextureUnitCompareEnabled(size_t unit, bool compare);
+		void _setTextureUnitCompareFunction(size_t unit, CompareFunction function);
+		void _setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy);
+		void _setTextureAddressingMode(size_t unit, const TextureUnitState::UVWAddressingMode& uvw);
+		void _setTextureBorderColour(size_t unit, const ColourValue& colour);
+		void _setTextureMipmapBias(size_t unit, float bias);
+		void _setTextureMatrix(size_t unit, const Matrix4& xform);
+
+		void _setSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+			SceneBlendOperation op = SBO_ADD);
+		void _setSeparateSceneBlending(SceneBlendFactor sourceFactor, SceneBlendFactor destFactor,
+			SceneBlendFactor sourceFactorAlpha, SceneBlendFactor destFactorAlpha,
+			SceneBlendOperation op = SBO_ADD, SceneBlendOperation alphaOp = SBO_ADD);
+		void _setAlphaRejectSettings(CompareFunction func, unsigned char value, bool alphaToCoverage);
+
+		void _swapAllRenderTargetBuffers(bool waitForVsync = true);
+		void _beginFrame(void);
+		void _endFrame(void);
+		void _setViewport(Viewport *vp);
+		void _setRenderTarget(RenderTarget *target);
+		void _setCullingMode(CullingMode mode);
+		void _setDepthBufferParams(bool depthTest = true, bool depthWrite = true,
+			CompareFunction depthFunction = CMPF_LESS_EQUAL);
+		void _setDepthBufferCheckEnabled(bool enabled = true);
+		void _setDepthBufferWriteEnabled(bool enabled = true);
+		void _setDepthBufferFunction(CompareFunction func = CMPF_LESS_EQUAL);
+		void _setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha);
+		void _setDepthBias(float constantBias, float slopeScaleBias = 0.0f);
+		void _setFog(FogMode mode = FOG_NONE, const ColourValue& colour = ColourValue::White,
+			Real expDensity = 1.0, Real linearStart = 0.0, Real linearEnd = 1.0);
+		void _setPolygonMode(PolygonMode level);
+		void setStencilCheckEnabled(bool enabled);
+		void setStencilBufferParams(CompareFunction func = CMPF_ALWAYS_PASS,
+			uint32 refValue = 0, uint32 compareMask = 0xFFFFFFFF, uint32 writeMask = 0xFFFFFFFF,
+			StencilOperation stencilFailOp = SOP_KEEP,
+			StencilOperation depthFailOp = SOP_KEEP,
+			StencilOperation passOp = SOP_KEEP,
+			bool twoSidedOperation = false);
+		void setScissorTest(bool enabled, size_t left = 0, size_t top = 0,
+			size_t right = 800, size_t bottom = 600);
+
+		VertexElementType getColourVertexElementType(void) const;
+		void _convertProjectionMatrix(const Matrix4& matrix,
+			Matrix4& dest, bool forGpuProgram = false);
+		void _makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+			Matrix4& dest, bool forGpuProgram = false);
+		void _makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+			Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram = false);
+		void _makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane, Real farPlane,
+			Matrix4& dest, bool forGpuProgram = false);
+		void _applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane,
+			bool forGpuProgram);
+
+		void setVertexDeclaration(VertexDeclaration* decl);
+		void setVertexBufferBinding(VertexBufferBinding* binding);
+		void _render(const RenderOperation& op);
+
+		void bindGpuProgram(GpuProgram* prg);
+		void unbindGpuProgram(GpuProgramType gptype);
+		void bindGpuProgramParameters(GpuProgramType gptype,
+			GpuProgramParametersSharedPtr params, uint16 variabilityMask);
+		void bindGpuProgramPassIterationParameters(GpuProgramType gptype);
+
+		void clearFrameBuffer(unsigned int buffers,
+			const ColourValue& colour = ColourValue::Black,
+			Real depth = 1.0f, unsigned short stencil = 0);
+		Real getHorizontalTexelOffset(void);
+		Real getVerticalTexelOffset(void);
+		Real getMinimumDepthInputValue(void);
+		Real getMaximumDepthInputValue(void);
+
+		void preExtraThreadsStarted();
+		void postExtraThreadsStarted();
+		void registerThread();
+		void unregisterThread();
+		unsigned int getDisplayMonitorCount() const;
+		void beginProfileEvent(const String &eventName);
+		void endProfileEvent(void);
+		void markProfileEvent(const String &event);
+		bool hasAnisotropicMipMapFilter() const;
+	};
+}
+
+#endif
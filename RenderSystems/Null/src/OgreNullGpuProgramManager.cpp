@@ -0,0 +1,65 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullGpuProgramManager.h"
+#include "OgreNullGpuProgram.h"
+
+namespace Ogre {
+
+	//---------------------------------------------------------------------
+	NullGpuProgramManager::NullGpuProgramManager()
+	{
+		// Register with resource group manager
+		ResourceGroupManager::getSingleton()._registerResourceManager(mResourceType, this);
+	}
+	//---------------------------------------------------------------------
+	NullGpuProgramManager::~NullGpuProgramManager()
+	{
+		// Unregister with resource group manager
+		ResourceGroupManager::getSingleton()._unregisterResourceManager(mResourceType);
+	}
+	//---------------------------------------------------------------------
+	Resource* NullGpuProgramManager::createImpl(const String& name, ResourceHandle handle,
+		const String& group, bool isManual, ManualResourceLoader* loader,
+		const NameValuePairList* params)
+	{
+		// 'syntax' and 'type' are applied by ResourceManager::createResource
+		// through the parameter dictionary
+		return OGRE_NEW NullGpuProgram(this, name, handle, group, isManual, loader);
+	}
+	//---------------------------------------------------------------------
+	Resource* NullGpuProgramManager::createImpl(const String& name, ResourceHandle handle,
+		const String& group, bool isManual, ManualResourceLoader* loader,
+		GpuProgramType gptype, const String& syntaxCode)
+	{
+		NullGpuProgram* prg = OGRE_NEW NullGpuProgram(this, name, handle, group, isManual, loader);
+		prg->setType(gptype);
+		prg->setSyntaxCode(syntaxCode);
+		return prg;
+	}
+
+}
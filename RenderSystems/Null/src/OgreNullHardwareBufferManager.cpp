@@ -0,0 +1,119 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullRenderSystem.h"
+
+namespace Ogre {
+
+	//---------------------------------------------------------------------
+	NullHardwareVertexBuffer::NullHardwareVertexBuffer(NullRenderSystem* renderSystem,
+		HardwareBufferManagerBase* mgr, size_t vertexSize, size_t numVertices,
+		HardwareBuffer::Usage usage)
+		: DefaultHardwareVertexBuffer(mgr, vertexSize, numVertices, usage),
+		mRenderSystem(renderSystem), mLockOptions(HBL_NORMAL), mLockLength(0)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullHardwareVertexBuffer::writeData(size_t offset, size_t length, const void* pSource,
+		bool discardWholeBuffer)
+	{
+		DefaultHardwareVertexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+		mRenderSystem->_notifyBufferUpload(length);
+	}
+	//---------------------------------------------------------------------
+	void* NullHardwareVertexBuffer::lock(size_t offset, size_t length, LockOptions options)
+	{
+		mLockOptions = options;
+		mLockLength = length;
+		return DefaultHardwareVertexBuffer::lock(offset, length, options);
+	}
+	//---------------------------------------------------------------------
+	void NullHardwareVertexBuffer::unlock(void)
+	{
+		DefaultHardwareVertexBuffer::unlock();
+		if (mLockOptions != HBL_READ_ONLY)
+			mRenderSystem->_notifyBufferUpload(mLockLength);
+	}
+	//---------------------------------------------------------------------
+	NullHardwareIndexBuffer::NullHardwareIndexBuffer(NullRenderSystem* renderSystem,
+		IndexType idxType, size_t numIndexes, HardwareBuffer::Usage usage)
+		: DefaultHardwareIndexBuffer(idxType, numIndexes, usage),
+		mRenderSystem(renderSystem), mLockOptions(HBL_NORMAL), mLockLength(0)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullHardwareIndexBuffer::writeData(size_t offset, size_t length, const void* pSource,
+		bool discardWholeBuffer)
+	{
+		DefaultHardwareIndexBuffer::writeData(offset, length, pSource, discardWholeBuffer);
+		mRenderSystem->_notifyBufferUpload(length);
+	}
+	//---------------------------------------------------------------------
+	void* NullHardwareIndexBuffer::lock(size_t offset, size_t length, LockOptions options)
+	{
+		mLockOptions = options;
+		mLockLength = length;
+		return DefaultHardwareIndexBuffer::lock(offset, length, options);
+	}
+	//---------------------------------------------------------------------
+	void NullHardwareIndexBuffer::unlock(void)
+	{
+		DefaultHardwareIndexBuffer::unlock();
+		if (mLockOptions != HBL_READ_ONLY)
+			mRenderSystem->_notifyBufferUpload(mLockLength);
+	}
+	//---------------------------------------------------------------------
+	//---------------------------------------------------------------------
+	NullHardwareBufferManagerBase::NullHardwareBufferManagerBase(NullRenderSystem* renderSystem)
+		: mRenderSystem(renderSystem)
+	{
+	}
+	//---------------------------------------------------------------------
+	HardwareVertexBufferSharedPtr NullHardwareBufferManagerBase::createVertexBuffer(
+		size_t vertexSize, size_t numVerts, HardwareBuffer::Usage usage, bool useShadowBuffer)
+	{
+		// System memory already, a shadow copy would only double the uploads
+		NullHardwareVertexBuffer* buf =
+			OGRE_NEW NullHardwareVertexBuffer(mRenderSystem, this, vertexSize, numVerts, usage);
+		{
+			OGRE_LOCK_MUTEX(mVertexBuffersMutex)
+			mVertexBuffers.insert(buf);
+		}
+		return HardwareVertexBufferSharedPtr(buf);
+	}
+	//---------------------------------------------------------------------
+	HardwareIndexBufferSharedPtr NullHardwareBufferManagerBase::createIndexBuffer(
+		HardwareIndexBuffer::IndexType itype, size_t numIndexes,
+		HardwareBuffer::Usage usage, bool useShadowBuffer)
+	{
+		NullHardwareIndexBuffer* buf =
+			OGRE_NEW NullHardwareIndexBuffer(mRenderSystem, itype, numIndexes, usage);
+		return HardwareIndexBufferSharedPtr(buf);
+	}
+
+}
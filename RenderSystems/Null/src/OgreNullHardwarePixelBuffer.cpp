@@ -0,0 +1,160 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullHardwarePixelBuffer.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreNullRenderTexture.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+
+	//---------------------------------------------------------------------
+	NullHardwarePixelBuffer::NullHardwarePixelBuffer(NullRenderSystem* renderSystem,
+		const String& baseName, size_t width, size_t height, size_t depth,
+		PixelFormat format, int usage, bool writeGamma, uint fsaa)
+		: HardwarePixelBuffer(width, height, depth, format,
+			static_cast<HardwareBuffer::Usage>(usage), true, false),
+		mRenderSystem(renderSystem),
+		mBuffer(width, height, depth, format),
+		mCurrentLockOptions(HBL_NORMAL)
+	{
+		if (mUsage & TU_RENDERTARGET)
+		{
+			// Create render target for each slice
+			mSliceTRT.reserve(mDepth);
+			for (size_t zoffset = 0; zoffset < mDepth; ++zoffset)
+			{
+				String name = "rtt/" + StringConverter::toString((size_t)this) + "/" + baseName;
+				if (mDepth > 1)
+					name += "/" + StringConverter::toString(zoffset);
+				RenderTexture *trt = OGRE_NEW NullRenderTexture(name, this, zoffset, writeGamma, fsaa);
+				mSliceTRT.push_back(trt);
+				mRenderSystem->attachRenderTarget(*trt);
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	NullHardwarePixelBuffer::~NullHardwarePixelBuffer()
+	{
+		// Delete all render targets that have not yet been deleted by the user
+		for (SliceTRT::const_iterator it = mSliceTRT.begin(); it != mSliceTRT.end(); ++it)
+		{
+			if (*it)
+				mRenderSystem->destroyRenderTarget((*it)->getName());
+		}
+
+		OGRE_FREE(mBuffer.data, MEMCATEGORY_RENDERSYS);
+	}
+	//---------------------------------------------------------------------
+	void NullHardwarePixelBuffer::allocateBuffer()
+	{
+		if (mBuffer.data)
+			// Already allocated
+			return;
+		mBuffer.data = OGRE_MALLOC(PixelUtil::getMemorySize(mWidth, mHeight, mDepth, mFormat),
+			MEMCATEGORY_RENDERSYS);
+	}
+	//---------------------------------------------------------------------
+	PixelBox NullHardwarePixelBuffer::lockImpl(const Image::Box lockBox, LockOptions options)
+	{
+		allocateBuffer();
+		mCurrentLockOptions = options;
+		mLockedBox = lockBox;
+		return mBuffer.getSubVolume(lockBox);
+	}
+	//---------------------------------------------------------------------
+	void NullHardwarePixelBuffer::unlockImpl(void)
+	{
+		if (mCurrentLockOptions != HBL_READ_ONLY)
+		{
+			mRenderSystem->_notifyTextureUpload(
+				PixelUtil::getMemorySize(mLockedBox.getWidth(), mLockedBox.getHeight(),
+					mLockedBox.getDepth(), mFormat));
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullHardwarePixelBuffer::blitFromMemory(const PixelBox &src, const Image::Box &dstBox)
+	{
+		if (!mBuffer.contains(dstBox))
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "destination box out of range",
+				"NullHardwarePixelBuffer::blitFromMemory");
+
+		allocateBuffer();
+		PixelBox dst = mBuffer.getSubVolume(dstBox);
+		if (src.getWidth() != dstBox.getWidth() ||
+			src.getHeight() != dstBox.getHeight() ||
+			src.getDepth() != dstBox.getDepth())
+		{
+			// Scale to destination size.
+			// This also does pixel format conversion if needed
+			Image::scale(src, dst, Image::FILTER_BILINEAR);
+		}
+		else
+		{
+			PixelUtil::bulkPixelConversion(src, dst);
+		}
+
+		mRenderSystem->_notifyTextureUpload(
+			PixelUtil::getMemorySize(dst.getWidth(), dst.getHeight(), dst.getDepth(), mFormat));
+	}
+	//---------------------------------------------------------------------
+	void NullHardwarePixelBuffer::blitToMemory(const Image::Box &srcBox, const PixelBox &dst)
+	{
+		if (!mBuffer.contains(srcBox))
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "source box out of range",
+				"NullHardwarePixelBuffer::blitToMemory");
+
+		allocateBuffer();
+		if (srcBox.getWidth() != dst.getWidth() ||
+			srcBox.getHeight() != dst.getHeight() ||
+			srcBox.getDepth() != dst.getDepth())
+		{
+			// We need scaling
+			Image::scale(mBuffer.getSubVolume(srcBox), dst, Image::FILTER_BILINEAR);
+		}
+		else
+		{
+			// Just copy the bit that we need
+			PixelUtil::bulkPixelConversion(mBuffer.getSubVolume(srcBox), dst);
+		}
+	}
+	//---------------------------------------------------------------------
+	RenderTexture* NullHardwarePixelBuffer::getRenderTarget(size_t zoffset)
+	{
+		assert(mUsage & TU_RENDERTARGET);
+		assert(zoffset < mDepth);
+		return mSliceTRT[zoffset];
+	}
+	//---------------------------------------------------------------------
+	void NullHardwarePixelBuffer::_clearSliceRTT(size_t zoffset)
+	{
+		// The render target has been destroyed elsewhere
+		if (zoffset < mSliceTRT.size())
+			mSliceTRT[zoffset] = 0;
+	}
+
+}
@@ -0,0 +1,923 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullRenderSystem.h"
+#include "OgreNullRenderWindow.h"
+#include "OgreNullRenderTexture.h"
+#include "OgreNullTextureManager.h"
+#include "OgreNullGpuProgramManager.h"
+#include "OgreNullHardwareBufferManager.h"
+#include "OgreNullHardwareOcclusionQuery.h"
+#include "OgreDepthBuffer.h"
+#include "OgreFrustum.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgreViewport.h"
+
+namespace Ogre {
+
+	//---------------------------------------------------------------------
+	NullRenderSystem::Statistics::Statistics()
+		: frames(0), viewports(0), drawCalls(0), stateChanges(0), transformChanges(0),
+		textureChanges(0), programBinds(0), vertexStreamChanges(0), clears(0),
+		parameterBytes(0), bufferBytes(0), textureBytes(0)
+	{
+	}
+	//---------------------------------------------------------------------
+	NullRenderSystem::NullRenderSystem()
+		: mInitialised(false),
+		mHardwareBufferManager(0),
+		mGpuProgramManager(0),
+		mBufferBytes(0),
+		mTextureBytes(0)
+	{
+		LogManager::getSingleton().logMessage(getName() + " created.");
+
+		ConfigOption optFullScreen;
+		optFullScreen.name = "Full Screen";
+		optFullScreen.possibleValues.push_back("No");
+		optFullScreen.possibleValues.push_back("Yes");
+		optFullScreen.currentValue = "No";
+		optFullScreen.immutable = false;
+
+		ConfigOption optVideoMode;
+		optVideoMode.name = "Video Mode";
+		optVideoMode.possibleValues.push_back("640 x 480");
+		optVideoMode.possibleValues.push_back("800 x 600");
+		optVideoMode.possibleValues.push_back("1024 x 768");
+		optVideoMode.possibleValues.push_back("1280 x 720");
+		optVideoMode.possibleValues.push_back("1920 x 1080");
+		optVideoMode.currentValue = "800 x 600";
+		optVideoMode.immutable = false;
+
+		mOptions[optFullScreen.name] = optFullScreen;
+		mOptions[optVideoMode.name] = optVideoMode;
+	}
+	//---------------------------------------------------------------------
+	NullRenderSystem::~NullRenderSystem()
+	{
+		shutdown();
+	}
+	//---------------------------------------------------------------------
+	NullRenderSystem::Statistics NullRenderSystem::getStatistics(void) const
+	{
+		Statistics stats = mStatistics;
+		stats.bufferBytes = mBufferBytes.get();
+		stats.textureBytes = mTextureBytes.get();
+		return stats;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::resetStatistics(void)
+	{
+		mStatistics = Statistics();
+		mBufferBytes.set(0);
+		mTextureBytes.set(0);
+	}
+	//---------------------------------------------------------------------
+	const String& NullRenderSystem::getName(void) const
+	{
+		static String strName("Null Rendering Subsystem");
+		return strName;
+	}
+	//---------------------------------------------------------------------
+	ConfigOptionMap& NullRenderSystem::getConfigOptions(void)
+	{
+		return mOptions;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setConfigOption(const String &name, const String &value)
+	{
+		ConfigOptionMap::iterator it = mOptions.find(name);
+		if (it == mOptions.end())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Option named '" + name + "' does not exist.",
+				"NullRenderSystem::setConfigOption");
+		}
+
+		it->second.currentValue = value;
+	}
+	//---------------------------------------------------------------------
+	String NullRenderSystem::validateConfigOptions(void)
+	{
+		// Any video mode can be emulated
+		return StringUtil::BLANK;
+	}
+	//---------------------------------------------------------------------
+	RenderWindow* NullRenderSystem::_initialise(bool autoCreateWindow, const String& windowTitle)
+	{
+		LogManager::getSingleton().logMessage("*** Starting Null Subsystem ***");
+
+		// Create the texture manager
+		mTextureManager = OGRE_NEW NullTextureManager(this);
+
+		RenderWindow* autoWindow = 0;
+		if (autoCreateWindow)
+		{
+			bool fullScreen = mOptions["Full Screen"].currentValue == "Yes";
+			unsigned int width = 800, height = 600;
+			String val = mOptions["Video Mode"].currentValue;
+			String::size_type pos = val.find('x');
+			if (pos != String::npos)
+			{
+				width = StringConverter::parseUnsignedInt(val.substr(0, pos));
+				height = StringConverter::parseUnsignedInt(val.substr(pos + 1));
+			}
+
+			autoWindow = _createRenderWindow(windowTitle, width, height, fullScreen);
+		}
+
+		RenderSystem::_initialise(autoCreateWindow, windowTitle);
+
+		return autoWindow;
+	}
+	//---------------------------------------------------------------------
+	RenderSystemCapabilities* NullRenderSystem::createRenderSystemCapabilities() const
+	{
+		RenderSystemCapabilities* rsc = OGRE_NEW RenderSystemCapabilities();
+
+		rsc->setDriverVersion(mDriverVersion);
+		rsc->setDeviceName("Null");
+		rsc->setRenderSystemName(getName());
+		rsc->setVendor(GPU_UNKNOWN);
+
+		// Report a capable fixed function and shader model 3 device, so the
+		// same techniques are chosen as on typical hardware
+		rsc->setCapability(RSC_FIXED_FUNCTION);
+		rsc->setCapability(RSC_AUTOMIPMAP);
+		rsc->setCapability(RSC_BLENDING);
+		rsc->setCapability(RSC_ANISOTROPY);
+		rsc->setCapability(RSC_DOT3);
+		rsc->setCapability(RSC_CUBEMAPPING);
+		rsc->setCapability(RSC_HWSTENCIL);
+		rsc->setCapability(RSC_TWO_SIDED_STENCIL);
+		rsc->setCapability(RSC_STENCIL_WRAP);
+		rsc->setCapability(RSC_VBO);
+		rsc->setCapability(RSC_VERTEX_PROGRAM);
+		rsc->setCapability(RSC_FRAGMENT_PROGRAM);
+		rsc->setCapability(RSC_SCISSOR_TEST);
+		rsc->setCapability(RSC_HWOCCLUSION);
+		rsc->setCapability(RSC_USER_CLIP_PLANES);
+		rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+		rsc->setCapability(RSC_INFINITE_FAR_PLANE);
+		rsc->setCapability(RSC_HWRENDER_TO_TEXTURE);
+		rsc->setCapability(RSC_RTT_SEPARATE_DEPTHBUFFER);
+		rsc->setCapability(RSC_TEXTURE_FLOAT);
+		rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
+		rsc->setCapability(RSC_TEXTURE_1D);
+		rsc->setCapability(RSC_TEXTURE_3D);
+		rsc->setCapability(RSC_TEXTURE_COMPRESSION);
+		rsc->setCapability(RSC_TEXTURE_COMPRESSION_DXT);
+		rsc->setCapability(RSC_POINT_SPRITES);
+		rsc->setCapability(RSC_POINT_EXTENDED_PARAMETERS);
+		rsc->setCapability(RSC_MIPMAP_LOD_BIAS);
+		rsc->setCapability(RSC_VERTEX_TEXTURE_FETCH);
+		rsc->setCapability(RSC_MRT_DIFFERENT_BIT_DEPTHS);
+		rsc->setCapability(RSC_ALPHA_TO_COVERAGE);
+
+		rsc->setNumTextureUnits(16);
+		rsc->setNumVertexTextureUnits(4);
+		rsc->setVertexTextureUnitsShared(true);
+		rsc->setNumMultiRenderTargets(4);
+		rsc->setStencilBufferBitDepth(8);
+		rsc->setMaxPointSize(256);
+
+		rsc->addShaderProfile("arbvp1");
+		rsc->addShaderProfile("arbfp1");
+		rsc->addShaderProfile("vs_1_1");
+		rsc->addShaderProfile("vs_2_0");
+		rsc->addShaderProfile("vs_3_0");
+		rsc->addShaderProfile("ps_2_0");
+		rsc->addShaderProfile("ps_3_0");
+		rsc->setVertexProgramConstantFloatCount(256);
+		rsc->setVertexProgramConstantIntCount(16);
+		rsc->setVertexProgramConstantBoolCount(16);
+		rsc->setFragmentProgramConstantFloatCount(224);
+		rsc->setFragmentProgramConstantIntCount(16);
+		rsc->setFragmentProgramConstantBoolCount(16);
+
+		return rsc;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::initialiseFromRenderSystemCapabilities(RenderSystemCapabilities* caps,
+		RenderTarget* primary)
+	{
+		if (caps->getRenderSystemName() != getName())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Trying to initialize NullRenderSystem from RenderSystemCapabilities that do not support it",
+				"NullRenderSystem::initialiseFromRenderSystemCapabilities");
+		}
+
+		mHardwareBufferManager = OGRE_NEW NullHardwareBufferManager(this);
+		mGpuProgramManager = OGRE_NEW NullGpuProgramManager();
+
+		Log* defaultLog = LogManager::getSingleton().getDefaultLog();
+		if (defaultLog)
+		{
+			caps->log(defaultLog);
+		}
+
+		mInitialised = true;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::reinitialise(void)
+	{
+		this->shutdown();
+		this->_initialise(true);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::shutdown(void)
+	{
+		RenderSystem::shutdown();
+
+		OGRE_DELETE mGpuProgramManager;
+		mGpuProgramManager = 0;
+
+		OGRE_DELETE mHardwareBufferManager;
+		mHardwareBufferManager = 0;
+
+		OGRE_DELETE mTextureManager;
+		mTextureManager = 0;
+
+		mInitialised = false;
+	}
+	//---------------------------------------------------------------------
+	RenderWindow* NullRenderSystem::_createRenderWindow(const String &name, unsigned int width,
+		unsigned int height, bool fullScreen, const NameValuePairList *miscParams)
+	{
+		if (mRenderTargets.find(name) != mRenderTargets.end())
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+				"Window with name '" + name + "' already exists",
+				"NullRenderSystem::_createRenderWindow");
+		}
+
+		NullRenderWindow* win = OGRE_NEW NullRenderWindow();
+		win->create(name, width, height, fullScreen, miscParams);
+
+		attachRenderTarget(*win);
+
+		if (!mInitialised)
+		{
+			mRealCapabilities = createRenderSystemCapabilities();
+
+			// use real capabilities if custom capabilities are not available
+			if (!mUseCustomCapabilities)
+				mCurrentCapabilities = mRealCapabilities;
+
+			fireEvent("RenderSystemCapabilitiesCreated");
+
+			initialiseFromRenderSystemCapabilities(mCurrentCapabilities, win);
+		}
+
+		if (win->getDepthBufferPool() != DepthBuffer::POOL_NO_DEPTH)
+		{
+			DepthBuffer* depthBuffer = OGRE_NEW DepthBuffer(DepthBuffer::POOL_DEFAULT, 24,
+				win->getWidth(), win->getHeight(), win->getFSAA(), win->getFSAAHint(), true);
+			mDepthBufferPool[depthBuffer->getPoolId()].push_back(depthBuffer);
+			win->attachDepthBuffer(depthBuffer);
+		}
+
+		return win;
+	}
+	//---------------------------------------------------------------------
+	MultiRenderTarget* NullRenderSystem::createMultiRenderTarget(const String & name)
+	{
+		MultiRenderTarget* retval = OGRE_NEW NullMultiRenderTarget(name);
+		attachRenderTarget(*retval);
+		return retval;
+	}
+	//---------------------------------------------------------------------
+	DepthBuffer* NullRenderSystem::_createDepthBufferFor(RenderTarget *renderTarget)
+	{
+		return OGRE_NEW DepthBuffer(DepthBuffer::POOL_DEFAULT, 24,
+			renderTarget->getWidth(), renderTarget->getHeight(),
+			renderTarget->getFSAA(), renderTarget->getFSAAHint(), false);
+	}
+	//---------------------------------------------------------------------
+	HardwareOcclusionQuery* NullRenderSystem::createHardwareOcclusionQuery(void)
+	{
+		NullHardwareOcclusionQuery* ret = OGRE_NEW NullHardwareOcclusionQuery();
+		mHwOcclusionQueries.push_back(ret);
+		return ret;
+	}
+	//---------------------------------------------------------------------
+	String NullRenderSystem::getErrorDescription(long errorNumber) const
+	{
+		return StringUtil::BLANK;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setAmbientLight(float r, float g, float b)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setShadingType(ShadeOptions so)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setLightingEnabled(bool enabled)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setNormaliseNormals(bool normalise)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_useLights(const LightList& lights, unsigned short limit)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setWorldMatrix(const Matrix4 &m)
+	{
+		++mStatistics.transformChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setViewMatrix(const Matrix4 &m)
+	{
+		++mStatistics.transformChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setProjectionMatrix(const Matrix4 &m)
+	{
+		++mStatistics.transformChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setSurfaceParams(const ColourValue &ambient,
+		const ColourValue &diffuse, const ColourValue &specular,
+		const ColourValue &emissive, Real shininess, TrackVertexColourType tracking)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setPointSpritesEnabled(bool enabled)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setPointParameters(Real size, bool attenuationEnabled,
+		Real constant, Real linear, Real quadratic, Real minSize, Real maxSize)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTexture(size_t unit, bool enabled, const TexturePtr &texPtr)
+	{
+		++mStatistics.textureChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureCoordSet(size_t unit, size_t index)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureCoordCalculation(size_t unit, TexCoordCalcMethod m,
+		const Frustum* frustum)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureBlendMode(size_t unit, const LayerBlendModeEx& bm)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureUnitFiltering(size_t unit, FilterType ftype, FilterOptions filter)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureUnitCompareEnabled(size_t unit, bool compare)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureUnitCompareFunction(size_t unit, CompareFunction function)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureLayerAnisotropy(size_t unit, unsigned int maxAnisotropy)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureAddressingMode(size_t unit,
+		const TextureUnitState::UVWAddressingMode& uvw)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureBorderColour(size_t unit, const ColourValue& colour)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureMipmapBias(size_t unit, float bias)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setTextureMatrix(size_t unit, const Matrix4& xform)
+	{
+		++mStatistics.transformChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setSceneBlending(SceneBlendFactor sourceFactor,
+		SceneBlendFactor destFactor, SceneBlendOperation op)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setSeparateSceneBlending(SceneBlendFactor sourceFactor,
+		SceneBlendFactor destFactor, SceneBlendFactor sourceFactorAlpha,
+		SceneBlendFactor destFactorAlpha, SceneBlendOperation op, SceneBlendOperation alphaOp)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setAlphaRejectSettings(CompareFunction func, unsigned char value,
+		bool alphaToCoverage)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_swapAllRenderTargetBuffers(bool waitForVsync)
+	{
+		RenderSystem::_swapAllRenderTargetBuffers(waitForVsync);
+		++mStatistics.frames;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_beginFrame(void)
+	{
+		if (!mActiveViewport)
+			OGRE_EXCEPT(Exception::ERR_INVALID_STATE,
+				"Cannot begin frame - no viewport selected.",
+				"NullRenderSystem::_beginFrame");
+
+		++mStatistics.viewports;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_endFrame(void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setViewport(Viewport *vp)
+	{
+		// Check if viewport is different
+		if (!vp)
+		{
+			mActiveViewport = NULL;
+			_setRenderTarget(NULL);
+		}
+		else if (vp != mActiveViewport || vp->_isUpdated())
+		{
+			_setRenderTarget(vp->getTarget());
+			mActiveViewport = vp;
+			vp->_clearUpdatedFlag();
+			++mStatistics.stateChanges;
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setRenderTarget(RenderTarget *target)
+	{
+		if (target != mActiveRenderTarget)
+			++mStatistics.stateChanges;
+
+		mActiveRenderTarget = target;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setCullingMode(CullingMode mode)
+	{
+		mCullingMode = mode;
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferParams(bool depthTest, bool depthWrite,
+		CompareFunction depthFunction)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferCheckEnabled(bool enabled)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferWriteEnabled(bool enabled)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBufferFunction(CompareFunction func)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setColourBufferWriteEnabled(bool red, bool green, bool blue, bool alpha)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setDepthBias(float constantBias, float slopeScaleBias)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setFog(FogMode mode, const ColourValue& colour,
+		Real expDensity, Real linearStart, Real linearEnd)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_setPolygonMode(PolygonMode level)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setStencilCheckEnabled(bool enabled)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setStencilBufferParams(CompareFunction func,
+		uint32 refValue, uint32 compareMask, uint32 writeMask,
+		StencilOperation stencilFailOp, StencilOperation depthFailOp,
+		StencilOperation passOp, bool twoSidedOperation)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setScissorTest(bool enabled, size_t left, size_t top,
+		size_t right, size_t bottom)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setClipPlanesImpl(const PlaneList& clipPlanes)
+	{
+		++mStatistics.stateChanges;
+	}
+	//---------------------------------------------------------------------
+	VertexElementType NullRenderSystem::getColourVertexElementType(void) const
+	{
+		return VET_COLOUR_ABGR;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_convertProjectionMatrix(const Matrix4& matrix,
+		Matrix4& dest, bool forGpuProgram)
+	{
+		// Same depth range as OpenGL, no conversion needed
+		dest = matrix;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_makeProjectionMatrix(const Radian& fovy, Real aspect, Real nearPlane,
+		Real farPlane, Matrix4& dest, bool forGpuProgram)
+	{
+		Radian thetaY (fovy / 2.0f);
+		Real tanThetaY = Math::Tan(thetaY);
+
+		// Calc matrix elements
+		Real w = (1.0f / tanThetaY) / aspect;
+		Real h = 1.0f / tanThetaY;
+		Real q, qn;
+		if (farPlane == 0)
+		{
+			// Infinite far plane
+			q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+			qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+		}
+		else
+		{
+			q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+			qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+		}
+
+		// NB This creates Z in range [-1,1]
+		dest = Matrix4::ZERO;
+		dest[0][0] = w;
+		dest[1][1] = h;
+		dest[2][2] = q;
+		dest[2][3] = qn;
+		dest[3][2] = -1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_makeProjectionMatrix(Real left, Real right, Real bottom, Real top,
+		Real nearPlane, Real farPlane, Matrix4& dest, bool forGpuProgram)
+	{
+		Real width = right - left;
+		Real height = top - bottom;
+		Real q, qn;
+		if (farPlane == 0)
+		{
+			// Infinite far plane
+			q = Frustum::INFINITE_FAR_PLANE_ADJUST - 1;
+			qn = nearPlane * (Frustum::INFINITE_FAR_PLANE_ADJUST - 2);
+		}
+		else
+		{
+			q = -(farPlane + nearPlane) / (farPlane - nearPlane);
+			qn = -2 * (farPlane * nearPlane) / (farPlane - nearPlane);
+		}
+		dest = Matrix4::ZERO;
+		dest[0][0] = 2 * nearPlane / width;
+		dest[0][2] = (right+left) / width;
+		dest[1][1] = 2 * nearPlane / height;
+		dest[1][2] = (top+bottom) / height;
+		dest[2][2] = q;
+		dest[2][3] = qn;
+		dest[3][2] = -1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_makeOrthoMatrix(const Radian& fovy, Real aspect, Real nearPlane,
+		Real farPlane, Matrix4& dest, bool forGpuProgram)
+	{
+		Radian thetaY (fovy / 2.0f);
+		Real tanThetaY = Math::Tan(thetaY);
+
+		Real tanThetaX = tanThetaY * aspect;
+		Real half_w = tanThetaX * nearPlane;
+		Real half_h = tanThetaY * nearPlane;
+		Real iw = 1.0 / half_w;
+		Real ih = 1.0 / half_h;
+		Real q;
+		if (farPlane == 0)
+		{
+			q = 0;
+		}
+		else
+		{
+			q = 2.0 / (farPlane - nearPlane);
+		}
+		dest = Matrix4::ZERO;
+		dest[0][0] = iw;
+		dest[1][1] = ih;
+		dest[2][2] = -q;
+		dest[2][3] = - (farPlane + nearPlane)/(farPlane - nearPlane);
+		dest[3][3] = 1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_applyObliqueDepthProjection(Matrix4& matrix, const Plane& plane,
+		bool forGpuProgram)
+	{
+		// Calculate the clip-space corner point opposite the clipping plane
+		// as (sgn(clipPlane.x), sgn(clipPlane.y), 1, 1) and
+		// transform it into camera space by multiplying it
+		// by the inverse of the projection matrix
+		Vector4 q;
+		q.x = (Math::Sign(plane.normal.x) + matrix[0][2]) / matrix[0][0];
+		q.y = (Math::Sign(plane.normal.y) + matrix[1][2]) / matrix[1][1];
+		q.z = -1.0F;
+		q.w = (1.0F + matrix[2][2]) / matrix[2][3];
+
+		// Calculate the scaled plane vector
+		Vector4 clipPlane4d(plane.normal.x, plane.normal.y, plane.normal.z, plane.d);
+		Vector4 c = clipPlane4d * (2.0F / (clipPlane4d.dotProduct(q)));
+
+		// Replace the third row of the projection matrix
+		matrix[2][0] = c.x;
+		matrix[2][1] = c.y;
+		matrix[2][2] = c.z + 1.0F;
+		matrix[2][3] = c.w;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setVertexDeclaration(VertexDeclaration* decl)
+	{
+		++mStatistics.vertexStreamChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::setVertexBufferBinding(VertexBufferBinding* binding)
+	{
+		++mStatistics.vertexStreamChanges;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::_render(const RenderOperation& op)
+	{
+		// Call super class
+		RenderSystem::_render(op);
+
+		// One draw per pass iteration, rebinding the iteration parameters
+		// in between like the real render systems do
+		do
+		{
+			++mStatistics.drawCalls;
+		} while (updatePassIterationRenderState());
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::bindGpuProgram(GpuProgram* prg)
+	{
+		++mStatistics.programBinds;
+		RenderSystem::bindGpuProgram(prg);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::unbindGpuProgram(GpuProgramType gptype)
+	{
+		switch (gptype)
+		{
+		case GPT_VERTEX_PROGRAM:
+			mActiveVertexGpuProgramParameters.setNull();
+			break;
+		case GPT_GEOMETRY_PROGRAM:
+			mActiveGeometryGpuProgramParameters.setNull();
+			break;
+		case GPT_FRAGMENT_PROGRAM:
+			mActiveFragmentGpuProgramParameters.setNull();
+			break;
+		case GPT_HULL_PROGRAM:
+			mActiveTesselationHullGpuProgramParameters.setNull();
+			break;
+		case GPT_DOMAIN_PROGRAM:
+			mActiveTesselationDomainGpuProgramParameters.setNull();
+			break;
+		case GPT_COMPUTE_PROGRAM:
+			mActiveComputeGpuProgramParameters.setNull();
+			break;
+		}
+
+		++mStatistics.programBinds;
+		RenderSystem::unbindGpuProgram(gptype);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::bindGpuProgramParameters(GpuProgramType gptype,
+		GpuProgramParametersSharedPtr params, uint16 variabilityMask)
+	{
+		if (variabilityMask & (uint16)GPV_GLOBAL)
+		{
+			// Shared parameter sets are copied in, as on the GL render systems
+			params->_copySharedParams();
+		}
+
+		switch (gptype)
+		{
+		case GPT_VERTEX_PROGRAM:
+			mActiveVertexGpuProgramParameters = params;
+			break;
+		case GPT_GEOMETRY_PROGRAM:
+			mActiveGeometryGpuProgramParameters = params;
+			break;
+		case GPT_FRAGMENT_PROGRAM:
+			mActiveFragmentGpuProgramParameters = params;
+			break;
+		case GPT_HULL_PROGRAM:
+			mActiveTesselationHullGpuProgramParameters = params;
+			break;
+		case GPT_DOMAIN_PROGRAM:
+			mActiveTesselationDomainGpuProgramParameters = params;
+			break;
+		case GPT_COMPUTE_PROGRAM:
+			mActiveComputeGpuProgramParameters = params;
+			break;
+		}
+
+		mStatistics.parameterBytes += calculateParameterBytes(params, variabilityMask);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::bindGpuProgramPassIterationParameters(GpuProgramType gptype)
+	{
+		// A single float4 holds the iteration number
+		mStatistics.parameterBytes += 4 * sizeof(float);
+	}
+	//---------------------------------------------------------------------
+	size_t NullRenderSystem::calculateParameterBytes(const GpuProgramParametersSharedPtr& params,
+		uint16 variabilityMask) const
+	{
+		size_t bytes = 0;
+
+		if (params->hasLogicalIndexedParameters())
+		{
+			// Low level programs, only the slots matching the mask are sent
+			const GpuLogicalIndexUseMap& floatMap = params->getFloatLogicalBufferStruct()->map;
+			for (GpuLogicalIndexUseMap::const_iterator i = floatMap.begin(); i != floatMap.end(); ++i)
+			{
+				if (i->second.variability & variabilityMask)
+					bytes += i->second.currentSize * sizeof(float);
+			}
+
+			const GpuLogicalIndexUseMap& intMap = params->getIntLogicalBufferStruct()->map;
+			for (GpuLogicalIndexUseMap::const_iterator i = intMap.begin(); i != intMap.end(); ++i)
+			{
+				if (i->second.variability & variabilityMask)
+					bytes += i->second.currentSize * sizeof(int);
+			}
+		}
+		else if (params->hasNamedParameters())
+		{
+			const GpuConstantDefinitionMap& defs = params->getConstantDefinitions().map;
+			for (GpuConstantDefinitionMap::const_iterator i = defs.begin(); i != defs.end(); ++i)
+			{
+				// Skip the aliases generated for individual array elements
+				if (i->first.find('[') != String::npos)
+					continue;
+
+				const GpuConstantDefinition& def = i->second;
+				if (def.variability & variabilityMask)
+				{
+					size_t elemSize = def.isDouble() ? sizeof(double) :
+						(def.isFloat() || def.isSampler()) ? sizeof(float) : sizeof(int);
+					bytes += def.elementSize * def.arraySize * elemSize;
+				}
+			}
+		}
+
+		return bytes;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::clearFrameBuffer(unsigned int buffers,
+		const ColourValue& colour, Real depth, unsigned short stencil)
+	{
+		++mStatistics.clears;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getHorizontalTexelOffset(void)
+	{
+		return 0.0f;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getVerticalTexelOffset(void)
+	{
+		return 0.0f;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getMinimumDepthInputValue(void)
+	{
+		// Range [-1.0f, 1.0f]
+		return -1.0f;
+	}
+	//---------------------------------------------------------------------
+	Real NullRenderSystem::getMaximumDepthInputValue(void)
+	{
+		// Range [-1.0f, 1.0f]
+		return 1.0f;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::preExtraThreadsStarted()
+	{
+		// No context to share
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::postExtraThreadsStarted()
+	{
+		// No context to share
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::registerThread()
+	{
+		// No context to share
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::unregisterThread()
+	{
+		// No context to share
+	}
+	//---------------------------------------------------------------------
+	unsigned int NullRenderSystem::getDisplayMonitorCount() const
+	{
+		return 1;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::beginProfileEvent(const String &eventName)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::endProfileEvent(void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void NullRenderSystem::markProfileEvent(const String &event)
+	{
+	}
+	//---------------------------------------------------------------------
+	bool NullRenderSystem::hasAnisotropicMipMapFilter() const
+	{
+		return false;
+	}
+
+}
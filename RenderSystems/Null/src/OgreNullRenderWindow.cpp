@@ -0,0 +1,137 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullRenderWindow.h"
+#include "OgreRoot.h"
+#include "OgreStringConverter.h"
+#include "OgreViewport.h"
+
+namespace Ogre {
+
+	//---------------------------------------------------------------------
+	NullRenderWindow::NullRenderWindow()
+		: mClosed(false)
+	{
+		mIsFullScreen = false;
+		mLeft = 0;
+		mTop = 0;
+	}
+	//---------------------------------------------------------------------
+	NullRenderWindow::~NullRenderWindow()
+	{
+		destroy();
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::create(const String& name, unsigned int width, unsigned int height,
+		bool fullScreen, const NameValuePairList *miscParams)
+	{
+		mName = name;
+		mWidth = width;
+		mHeight = height;
+		mIsFullScreen = fullScreen;
+		mColourDepth = 32;
+		mFSAA = 0;
+		mHwGamma = false;
+
+		if (miscParams)
+		{
+			NameValuePairList::const_iterator opt;
+			NameValuePairList::const_iterator end = miscParams->end();
+
+			if ((opt = miscParams->find("left")) != end)
+				mLeft = StringConverter::parseInt(opt->second);
+
+			if ((opt = miscParams->find("top")) != end)
+				mTop = StringConverter::parseInt(opt->second);
+
+			if ((opt = miscParams->find("colourDepth")) != end)
+				mColourDepth = StringConverter::parseUnsignedInt(opt->second);
+
+			if ((opt = miscParams->find("FSAA")) != end)
+				mFSAA = StringConverter::parseUnsignedInt(opt->second);
+
+			if ((opt = miscParams->find("gamma")) != end)
+				mHwGamma = StringConverter::parseBool(opt->second);
+		}
+
+		mClosed = false;
+		mActive = true;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::setFullscreen(bool fullScreen, unsigned int width, unsigned int height)
+	{
+		mIsFullScreen = fullScreen;
+		resize(width, height);
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::destroy(void)
+	{
+		mClosed = true;
+		mActive = false;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::resize(unsigned int width, unsigned int height)
+	{
+		mWidth = width;
+		mHeight = height;
+
+		// Notify viewports of resize
+		for (ViewportList::iterator it = mViewportList.begin(); it != mViewportList.end(); ++it)
+			it->second->_updateDimensions();
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::reposition(int left, int top)
+	{
+		mLeft = left;
+		mTop = top;
+	}
+	//---------------------------------------------------------------------
+	bool NullRenderWindow::isClosed(void) const
+	{
+		return mClosed;
+	}
+	//---------------------------------------------------------------------
+	void NullRenderWindow::copyContentsToMemory(const PixelBox &dst, FrameBuffer buffer)
+	{
+		if (dst.getWidth() > mWidth || dst.getHeight() > mHeight || dst.getDepth() != 1)
+		{
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid box.",
+				"NullRenderWindow::copyContentsToMemory");
+		}
+
+		// Nothing was ever drawn, the contents are all black
+		size_t pixelSize = PixelUtil::getNumElemBytes(dst.format);
+		for (size_t y = dst.top; y < dst.bottom; ++y)
+		{
+			uchar* row = static_cast<uchar*>(dst.data) +
+				(dst.front * dst.slicePitch + y * dst.rowPitch + dst.left) * pixelSize;
+			for (size_t x = 0; x < dst.getWidth(); ++x)
+				PixelUtil::packColour(ColourValue::Black, dst.format, row + x * pixelSize);
+		}
+	}
+
+}
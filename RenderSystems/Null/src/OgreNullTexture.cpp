@@ -0,0 +1,202 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreNullTexture.h"
+#include "OgreNullHardwarePixelBuffer.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreTextureManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreLogManager.h"
+#include "OgreCodec.h"
+#include "OgreStringConverter.h"
+
+namespace Ogre {
+
+	//---------------------------------------------------------------------
+	NullTexture::NullTexture(ResourceManager* creator, const String& name,
+		ResourceHandle handle, const String& group, bool isManual,
+		ManualResourceLoader* loader, NullRenderSystem* renderSystem)
+		: Texture(creator, name, handle, group, isManual, loader),
+		mRenderSystem(renderSystem)
+	{
+	}
+	//---------------------------------------------------------------------
+	NullTexture::~NullTexture()
+	{
+		// have to call this here rather than in Resource destructor
+		// since calling virtual methods in base destructors causes crash
+		if (isLoaded())
+		{
+			unload();
+		}
+		else
+		{
+			freeInternalResources();
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::createInternalResourcesImpl(void)
+	{
+		// Adjust format if required
+		mFormat = TextureManager::getSingleton().getNativeFormat(mTextureType, mFormat, mUsage);
+
+		// Check requested number of mipmaps
+		size_t maxMips = 0;
+		size_t width = mWidth;
+		size_t height = mHeight;
+		size_t depth = mTextureType == TEX_TYPE_3D ? mDepth : 1;
+		while (width > 1 || height > 1 || depth > 1)
+		{
+			if (width > 1) width /= 2;
+			if (height > 1) height /= 2;
+			if (depth > 1) depth /= 2;
+			++maxMips;
+		}
+		mNumMipmaps = std::min(mNumRequestedMipmaps, maxMips);
+
+		// Lower levels are never sampled, pretend they are generated for free
+		mMipmapsHardwareGenerated = (mUsage & TU_AUTOMIPMAP) != 0;
+
+		mSurfaceList.clear();
+		for (size_t face = 0; face < getNumFaces(); ++face)
+		{
+			width = mWidth;
+			height = mHeight;
+			depth = mDepth;
+			for (size_t mip = 0; mip <= mNumMipmaps; ++mip)
+			{
+				// Only the top level can be rendered to
+				int usage = mip == 0 ? mUsage : (mUsage & ~TU_RENDERTARGET);
+				mSurfaceList.push_back(HardwarePixelBufferSharedPtr(
+					OGRE_NEW NullHardwarePixelBuffer(mRenderSystem, mName, width, height, depth,
+						mFormat, usage, mHwGamma, mFSAA)));
+
+				if (width > 1) width /= 2;
+				if (height > 1) height /= 2;
+				if (depth > 1 && mTextureType != TEX_TYPE_2D_ARRAY) depth /= 2;
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::freeInternalResourcesImpl(void)
+	{
+		mSurfaceList.clear();
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::prepareImpl(void)
+	{
+		if (mUsage & TU_RENDERTARGET) return;
+
+		String baseName, ext;
+		size_t pos = mName.find_last_of(".");
+		baseName = mName.substr(0, pos);
+		if (pos != String::npos)
+			ext = mName.substr(pos + 1);
+		StringUtil::toLowerCase(ext);
+
+		if (!Codec::isCodecRegistered(ext))
+		{
+			// Without a codec the texture is created empty by loadImpl
+			LogManager::getSingleton().logMessage("NullTexture: no codec registered for '" +
+				mName + "', creating an empty texture instead.", LML_TRIVIAL);
+			return;
+		}
+
+		LoadedImages loadedImages = LoadedImages(new vector<Image>::type());
+
+		if (mTextureType == TEX_TYPE_CUBE_MAP && ext != "dds")
+		{
+			// Faces are held in separate files
+			static const String suffixes[6] = {"_rt", "_lf", "_up", "_dn", "_fr", "_bk"};
+			for (size_t i = 0; i < 6; ++i)
+			{
+				String fullName = baseName + suffixes[i];
+				if (!ext.empty())
+					fullName = fullName + "." + ext;
+				DataStreamPtr dstream =
+					ResourceGroupManager::getSingleton().openResource(fullName, mGroup, true, this);
+				loadedImages->push_back(Image());
+				loadedImages->back().load(dstream, ext);
+			}
+		}
+		else
+		{
+			DataStreamPtr dstream =
+				ResourceGroupManager::getSingleton().openResource(mName, mGroup, true, this);
+			loadedImages->push_back(Image());
+			loadedImages->back().load(dstream, ext);
+
+			// If this is a cube map, set the texture type flag accordingly.
+			if (loadedImages->back().hasFlag(IF_CUBEMAP))
+				mTextureType = TEX_TYPE_CUBE_MAP;
+			// If this is a volumetric texture set the texture type flag accordingly.
+			if (loadedImages->back().getDepth() > 1 && mTextureType != TEX_TYPE_2D_ARRAY)
+				mTextureType = TEX_TYPE_3D;
+		}
+
+		mLoadedImages = loadedImages;
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::unprepareImpl(void)
+	{
+		mLoadedImages.setNull();
+	}
+	//---------------------------------------------------------------------
+	void NullTexture::loadImpl(void)
+	{
+		if ((mUsage & TU_RENDERTARGET) || mLoadedImages.isNull())
+		{
+			createInternalResources();
+			return;
+		}
+
+		// Now the only copy is on the stack and will be cleaned in case of
+		// exceptions being thrown from _loadImages
+		LoadedImages loadedImages = mLoadedImages;
+		mLoadedImages.setNull();
+
+		ConstImagePtrList imagePtrs;
+		for (size_t i = 0; i < loadedImages->size(); ++i)
+			imagePtrs.push_back(&(*loadedImages)[i]);
+
+		_loadImages(imagePtrs);
+	}
+	//---------------------------------------------------------------------
+	HardwarePixelBufferSharedPtr NullTexture::getBuffer(size_t face, size_t mipmap)
+	{
+		if (face >= getNumFaces())
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Face index out of range",
+				"NullTexture::getBuffer");
+		if (mipmap > mNumMipmaps)
+			OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Mipmap index out of range",
+				"NullTexture::getBuffer");
+		size_t idx = face * (mNumMipmaps + 1) + mipmap;
+		assert(idx < mSurfaceList.size());
+		return mSurfaceList[idx];
+	}
+
+}
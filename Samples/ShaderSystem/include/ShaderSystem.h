@@ -42,6 +42,8 @@ public:
 	virtual bool isVisible(const AxisAlignedBox& bound, FrustumPlane* culledBy = 0) const {return true;};
 	virtual bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const {return true;};
 	virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const {return true;};
+	virtual void isVisible(const AxisAlignedBox* const* bounds, size_t count, char* visibilities) const {memset(visibilities, 1, count);};
+	virtual void isVisible(const Sphere* const* bounds, size_t count, char* visibilities) const {memset(visibilities, 1, count);};
 	bool projectSphere(const Sphere& sphere, 
 		Real* left, Real* top, Real* right, Real* bottom) const {*left = *bottom = -1.0f; *right = *top = 1.0f; return true;};
 	Real getNearClipDistance(void) const {return 1.0;};
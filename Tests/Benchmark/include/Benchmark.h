@@ -0,0 +1,135 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Benchmark_H__
+#define __Benchmark_H__
+
+#include "OgrePrerequisites.h"
+
+#include <iosfwd>
+
+/** A single timed operation.
+@remarks
+    Each call to run() must process getSize() elements, so that results can
+    be reported per element and compared across sizes and variants. The
+    variant names the implementation being measured, e.g. "SSE" for the
+    OptimisedUtil benchmarks, and is empty when there is only one.
+*/
+class Benchmark
+{
+public:
+    Benchmark(const Ogre::String& name, const Ogre::String& variant, size_t size)
+        : mName(name), mVariant(variant), mSize(size) {}
+    virtual ~Benchmark() {}
+
+    /// Allocate and fill the input data, not timed
+    virtual void setUp() {}
+    /// Process getSize() elements once
+    virtual void run() = 0;
+    /// Release the data allocated by setUp(), not timed
+    virtual void tearDown() {}
+
+    const Ogre::String& getName() const { return mName; }
+    const Ogre::String& getVariant() const { return mVariant; }
+    size_t getSize() const { return mSize; }
+
+protected:
+    Ogre::String mName;
+    Ogre::String mVariant;
+    size_t mSize;
+};
+
+/// The timings of one benchmark
+struct BenchmarkResult
+{
+    Ogre::String name;
+    Ogre::String variant;
+    size_t size;
+    /// Number of calls to Benchmark::run() per sample
+    size_t iterations;
+    /// Fastest and median sample, in nanoseconds per element
+    double minNs;
+    double medianNs;
+};
+
+typedef std::vector<BenchmarkResult> BenchmarkResultList;
+
+/** Runs the registered benchmarks and writes their results.
+@remarks
+    The number of iterations of each benchmark is calibrated so that a sample
+    lasts at least the minimum sample time, then several samples are taken.
+    The fastest sample is the most stable figure to compare builds, the
+    median one shows how noisy the measurement was.
+*/
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner();
+    ~BenchmarkRunner();
+
+    /// Adds a benchmark, the runner takes ownership of it
+    void add(Benchmark* benchmark);
+
+    /// Only run the benchmarks whose "name/variant" contains the given string
+    void setFilter(const Ogre::String& filter) { mFilter = filter; }
+    void setMinSampleTime(unsigned long microseconds) { mMinSampleTime = microseconds; }
+    void setSampleCount(size_t count) { mSampleCount = count; }
+
+    /// Runs the benchmarks, printing progress to the given stream
+    void run(std::ostream& log);
+
+    const BenchmarkResultList& getResults() const { return mResults; }
+
+    void writeCsv(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+
+private:
+    BenchmarkResult runBenchmark(Benchmark* benchmark);
+
+    typedef std::vector<Benchmark*> BenchmarkList;
+    BenchmarkList mBenchmarks;
+    BenchmarkResultList mResults;
+    Ogre::String mFilter;
+    unsigned long mMinSampleTime;
+    size_t mSampleCount;
+};
+
+/** Keeps the compiler from optimising away a computation whose result is
+    otherwise unused. Defined in another translation unit on purpose.
+*/
+void benchmarkSink(const void* data);
+
+/// Element counts used by most benchmarks, from a small mesh to a big batch
+extern const size_t BENCHMARK_SIZES[];
+extern const size_t BENCHMARK_SIZE_COUNT;
+
+void addMathBenchmarks(BenchmarkRunner& runner);
+void addOptimisedUtilBenchmarks(BenchmarkRunner& runner);
+void addRadixSortBenchmarks(BenchmarkRunner& runner);
+void addPixelUtilBenchmarks(BenchmarkRunner& runner);
+
+#endif
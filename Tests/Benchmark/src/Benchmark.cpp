@@ -0,0 +1,173 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgreTimer.h"
+#include "OgrePlatformInformation.h"
+#include "OgreOptimisedUtil.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+using namespace Ogre;
+
+const size_t BENCHMARK_SIZES[] = { 64, 1024, 16384 };
+const size_t BENCHMARK_SIZE_COUNT = sizeof(BENCHMARK_SIZES) / sizeof(BENCHMARK_SIZES[0]);
+
+//--------------------------------------------------------------------------
+void benchmarkSink(const void* data)
+{
+    static const void* volatile sink;
+    sink = data;
+}
+//--------------------------------------------------------------------------
+static String escapeJson(const String& str)
+{
+    String result;
+    for (String::const_iterator i = str.begin(); i != str.end(); ++i)
+    {
+        if (*i == '"' || *i == '\\')
+            result += '\\';
+        result += *i;
+    }
+    return result;
+}
+//--------------------------------------------------------------------------
+BenchmarkRunner::BenchmarkRunner()
+    : mMinSampleTime(20000)
+    , mSampleCount(7)
+{
+}
+//--------------------------------------------------------------------------
+BenchmarkRunner::~BenchmarkRunner()
+{
+    for (BenchmarkList::iterator i = mBenchmarks.begin(); i != mBenchmarks.end(); ++i)
+        delete *i;
+}
+//--------------------------------------------------------------------------
+void BenchmarkRunner::add(Benchmark* benchmark)
+{
+    mBenchmarks.push_back(benchmark);
+}
+//--------------------------------------------------------------------------
+void BenchmarkRunner::run(std::ostream& log)
+{
+    mResults.clear();
+    for (BenchmarkList::iterator i = mBenchmarks.begin(); i != mBenchmarks.end(); ++i)
+    {
+        Benchmark* benchmark = *i;
+        String fullName = benchmark->getName() + "/" + benchmark->getVariant();
+        if (!mFilter.empty() && fullName.find(mFilter) == String::npos)
+            continue;
+
+        BenchmarkResult result = runBenchmark(benchmark);
+        mResults.push_back(result);
+
+        log << std::left << std::setw(64) << fullName
+            << std::right << std::setw(8) << result.size
+            << std::fixed << std::setprecision(3)
+            << std::setw(12) << result.minNs << " ns"
+            << std::setw(12) << result.medianNs << " ns" << std::endl;
+    }
+}
+//--------------------------------------------------------------------------
+BenchmarkResult BenchmarkRunner::runBenchmark(Benchmark* benchmark)
+{
+    Timer timer;
+    benchmark->setUp();
+
+    // Warm up the caches, then double the iterations until a sample is long
+    // enough for the timer resolution not to matter
+    benchmark->run();
+    size_t iterations = 1;
+    for (;;)
+    {
+        timer.reset();
+        for (size_t i = 0; i < iterations; ++i)
+            benchmark->run();
+        if (timer.getMicroseconds() >= mMinSampleTime)
+            break;
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    double elements = static_cast<double>(iterations) * std::max<size_t>(benchmark->getSize(), 1);
+    for (size_t s = 0; s < mSampleCount; ++s)
+    {
+        timer.reset();
+        for (size_t i = 0; i < iterations; ++i)
+            benchmark->run();
+        samples.push_back(timer.getMicroseconds() * 1000.0 / elements);
+    }
+
+    benchmark->tearDown();
+
+    std::sort(samples.begin(), samples.end());
+    BenchmarkResult result;
+    result.name = benchmark->getName();
+    result.variant = benchmark->getVariant();
+    result.size = benchmark->getSize();
+    result.iterations = iterations;
+    result.minNs = samples.front();
+    result.medianNs = samples[samples.size() / 2];
+    return result;
+}
+//--------------------------------------------------------------------------
+void BenchmarkRunner::writeCsv(std::ostream& out) const
+{
+    out << "name,variant,size,iterations,min_ns,median_ns\n";
+    for (BenchmarkResultList::const_iterator i = mResults.begin(); i != mResults.end(); ++i)
+    {
+        out << i->name << ',' << i->variant << ',' << i->size << ',' << i->iterations << ','
+            << std::setprecision(6) << i->minNs << ',' << i->medianNs << '\n';
+    }
+}
+//--------------------------------------------------------------------------
+void BenchmarkRunner::writeJson(std::ostream& out) const
+{
+    out << "{\n";
+    out << "  \"cpu\": \"" << escapeJson(PlatformInformation::getCpuIdentifier()) << "\",\n";
+    out << "  \"implementations\": [";
+    OptimisedUtil::NamedImplementationList implementations = OptimisedUtil::getAvailableImplementations();
+    for (size_t i = 0; i < implementations.size(); ++i)
+        out << (i ? ", \"" : "\"") << implementations[i].first << '"';
+    out << "],\n";
+    out << "  \"results\": [\n";
+    for (BenchmarkResultList::const_iterator i = mResults.begin(); i != mResults.end(); ++i)
+    {
+        out << "    { \"name\": \"" << escapeJson(i->name)
+            << "\", \"variant\": \"" << escapeJson(i->variant)
+            << "\", \"size\": " << i->size
+            << ", \"iterations\": " << i->iterations
+            << std::setprecision(6)
+            << ", \"min_ns\": " << i->minNs
+            << ", \"median_ns\": " << i->medianNs << " }"
+            << (i + 1 != mResults.end() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
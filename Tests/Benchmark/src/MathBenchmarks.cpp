@@ -0,0 +1,201 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgreMatrix4.h"
+#include "OgreQuaternion.h"
+#include "OgreVector3.h"
+#include "OgreMath.h"
+
+using namespace Ogre;
+
+namespace {
+
+    /// Inputs and outputs shared by the math benchmarks
+    struct MathData
+    {
+        vector<Vector3>::type vectors[2];
+        vector<Quaternion>::type quaternions[2];
+        vector<Matrix4>::type matrices[2];
+        vector<Vector3>::type vectorResults;
+        vector<Quaternion>::type quaternionResults;
+        vector<Matrix4>::type matrixResults;
+    };
+
+    typedef void (*MathKernel)(MathData& data, size_t count);
+
+    class MathBenchmark : public Benchmark
+    {
+    public:
+        MathBenchmark(const String& name, size_t size, MathKernel kernel)
+            : Benchmark(name, "", size), mKernel(kernel) {}
+
+        void setUp()
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                mData.vectors[i].resize(mSize);
+                mData.quaternions[i].resize(mSize);
+                mData.matrices[i].resize(mSize);
+                for (size_t j = 0; j < mSize; ++j)
+                {
+                    Vector3 axis(Math::SymmetricRandom(), Math::SymmetricRandom(), Math::SymmetricRandom());
+                    axis.normalise();
+                    mData.vectors[i][j] = axis * Math::RangeRandom(1, 100);
+                    mData.quaternions[i][j].FromAngleAxis(Radian(Math::RangeRandom(0, Math::TWO_PI)), axis);
+                    mData.matrices[i][j].makeTransform(mData.vectors[i][j],
+                        Vector3(Math::RangeRandom(0.5, 2)), mData.quaternions[i][j]);
+                }
+            }
+            mData.vectorResults.resize(mSize);
+            mData.quaternionResults.resize(mSize);
+            mData.matrixResults.resize(mSize);
+        }
+
+        void run()
+        {
+            mKernel(mData, mSize);
+            benchmarkSink(&mData);
+        }
+
+        void tearDown()
+        {
+            mData = MathData();
+        }
+
+    private:
+        MathKernel mKernel;
+        MathData mData;
+    };
+
+    void vector3Normalise(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.vectorResults[i] = data.vectors[0][i].normalisedCopy();
+    }
+
+    void vector3CrossProduct(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.vectorResults[i] = data.vectors[0][i].crossProduct(data.vectors[1][i]);
+    }
+
+    void quaternionMultiply(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.quaternionResults[i] = data.quaternions[0][i] * data.quaternions[1][i];
+    }
+
+    void quaternionRotate(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.vectorResults[i] = data.quaternions[0][i] * data.vectors[0][i];
+    }
+
+    void quaternionSlerp(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            data.quaternionResults[i] = Quaternion::Slerp(0.3f,
+                data.quaternions[0][i], data.quaternions[1][i], true);
+        }
+    }
+
+    void quaternionNlerp(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            data.quaternionResults[i] = Quaternion::nlerp(0.3f,
+                data.quaternions[0][i], data.quaternions[1][i], true);
+        }
+    }
+
+    void matrix4Concatenate(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.matrixResults[i] = data.matrices[0][i] * data.matrices[1][i];
+    }
+
+    void matrix4ConcatenateAffine(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.matrixResults[i] = data.matrices[0][i].concatenateAffine(data.matrices[1][i]);
+    }
+
+    void matrix4TransformAffine(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.vectorResults[i] = data.matrices[0][i].transformAffine(data.vectors[0][i]);
+    }
+
+    void matrix4Inverse(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.matrixResults[i] = data.matrices[0][i].inverse();
+    }
+
+    void matrix4InverseAffine(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            data.matrixResults[i] = data.matrices[0][i].inverseAffine();
+    }
+
+    void matrix4MakeTransform(MathData& data, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            data.matrixResults[i].makeTransform(data.vectors[0][i],
+                data.vectors[1][i], data.quaternions[0][i]);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+void addMathBenchmarks(BenchmarkRunner& runner)
+{
+    struct { const char* name; MathKernel kernel; } kernels[] =
+    {
+        { "Vector3::normalisedCopy", vector3Normalise },
+        { "Vector3::crossProduct", vector3CrossProduct },
+        { "Quaternion::operator*(Quaternion)", quaternionMultiply },
+        { "Quaternion::operator*(Vector3)", quaternionRotate },
+        { "Quaternion::Slerp", quaternionSlerp },
+        { "Quaternion::nlerp", quaternionNlerp },
+        { "Matrix4::operator*", matrix4Concatenate },
+        { "Matrix4::concatenateAffine", matrix4ConcatenateAffine },
+        { "Matrix4::transformAffine", matrix4TransformAffine },
+        { "Matrix4::inverse", matrix4Inverse },
+        { "Matrix4::inverseAffine", matrix4InverseAffine },
+        { "Matrix4::makeTransform", matrix4MakeTransform },
+    };
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k)
+    {
+        for (size_t s = 0; s < BENCHMARK_SIZE_COUNT; ++s)
+            runner.add(new MathBenchmark(kernels[k].name, BENCHMARK_SIZES[s], kernels[k].kernel));
+    }
+}
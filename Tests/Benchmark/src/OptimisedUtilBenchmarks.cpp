@@ -0,0 +1,441 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreMatrix4.h"
+#include "OgreVector4.h"
+#include "OgrePlane.h"
+#include "OgreMath.h"
+
+using namespace Ogre;
+
+namespace {
+
+    /// Base of the benchmarks measuring one implementation of OptimisedUtil
+    class OptimisedUtilBenchmark : public Benchmark
+    {
+    public:
+        OptimisedUtilBenchmark(const String& name,
+            const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : Benchmark("OptimisedUtil::" + name, implementation.first, size)
+            , mUtil(implementation.second)
+        {
+        }
+
+        void tearDown()
+        {
+            for (size_t i = 0; i < mAllocations.size(); ++i)
+                OGRE_FREE_SIMD(mAllocations[i], MEMCATEGORY_GENERAL);
+            mAllocations.clear();
+        }
+
+    protected:
+        /// Allocates a SIMD aligned buffer, released by tearDown()
+        template <typename T>
+        T* allocate(size_t count)
+        {
+            void* data = OGRE_MALLOC_SIMD(sizeof(T) * count, MEMCATEGORY_GENERAL);
+            mAllocations.push_back(data);
+            return static_cast<T*>(data);
+        }
+
+        float* allocateRandom(size_t count, Real range)
+        {
+            float* data = allocate<float>(count);
+            for (size_t i = 0; i < count; ++i)
+                data[i] = Math::RangeRandom(-range, range);
+            return data;
+        }
+
+        /// Allocates the streams of mSize transforms, with random values if fill is set
+        void setUpStreams(TransformStreams& streams, bool fill)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                streams.position[c] = allocateRandom(mSize, 100);
+                streams.scale[c] = allocate<Real>(mSize);
+            }
+            for (int c = 0; c < 4; ++c)
+                streams.orientation[c] = allocate<Real>(mSize);
+            if (!fill)
+                return;
+
+            for (size_t i = 0; i < mSize; ++i)
+            {
+                Vector3 axis(Math::SymmetricRandom(), Math::SymmetricRandom(), Math::SymmetricRandom());
+                Quaternion q(Radian(Math::RangeRandom(0, Math::TWO_PI)), axis.normalisedCopy());
+                for (int c = 0; c < 4; ++c)
+                    streams.orientation[c][i] = q[c];
+                for (int c = 0; c < 3; ++c)
+                    streams.scale[c][i] = Math::RangeRandom(0.5, 2);
+            }
+        }
+
+        OptimisedUtil* mUtil;
+        vector<void*>::type mAllocations;
+    };
+
+    Matrix4 randomAffineMatrix(void)
+    {
+        Vector3 axis(Math::SymmetricRandom(), Math::SymmetricRandom(), Math::SymmetricRandom());
+        Matrix4 m;
+        m.makeTransform(axis * 10, Vector3(Math::RangeRandom(0.5, 2)),
+            Quaternion(Radian(Math::RangeRandom(0, Math::TWO_PI)), axis.normalisedCopy()));
+        return m;
+    }
+
+    class SkinningBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        SkinningBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("softwareVertexSkinning", implementation, size) {}
+
+        void setUp()
+        {
+            // Shared buffers of interleaved positions and normals, like the
+            // ones software skinned entities use, with 32 bones and 2 weights
+            mSource = allocateRandom(mSize * 6, 10);
+            mDest = allocate<float>(mSize * 6);
+            mWeights = allocate<float>(mSize * 2);
+            mIndices = allocate<unsigned char>(mSize * 2);
+            for (size_t i = 0; i < mSize; ++i)
+            {
+                mWeights[i * 2] = Math::UnitRandom();
+                mWeights[i * 2 + 1] = 1 - mWeights[i * 2];
+                mIndices[i * 2] = static_cast<unsigned char>(Math::UnitRandom() * 31);
+                mIndices[i * 2 + 1] = static_cast<unsigned char>(Math::UnitRandom() * 31);
+            }
+            Matrix4* matrices = allocate<Matrix4>(NUM_BONES);
+            for (size_t i = 0; i < NUM_BONES; ++i)
+            {
+                matrices[i] = randomAffineMatrix();
+                mMatrices[i] = &matrices[i];
+            }
+        }
+
+        void run()
+        {
+            mUtil->softwareVertexSkinning(mSource, mDest, mSource + 3, mDest + 3,
+                mWeights, mIndices, mMatrices,
+                sizeof(float) * 6, sizeof(float) * 6, sizeof(float) * 6, sizeof(float) * 6,
+                sizeof(float) * 2, 2, 2, mSize);
+            benchmarkSink(mDest);
+        }
+
+    private:
+        enum { NUM_BONES = 32 };
+        float* mSource;
+        float* mDest;
+        float* mWeights;
+        unsigned char* mIndices;
+        const Matrix4* mMatrices[NUM_BONES];
+    };
+
+    class MorphBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        MorphBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("softwareVertexMorph", implementation, size) {}
+
+        void setUp()
+        {
+            mSource1 = allocateRandom(mSize * 3, 10);
+            mSource2 = allocateRandom(mSize * 3, 10);
+            mDest = allocate<float>(mSize * 3);
+        }
+
+        void run()
+        {
+            size_t vertexSize = sizeof(float) * 3;
+            mUtil->softwareVertexMorph(0.3f, mSource1, mSource2, mDest,
+                vertexSize, vertexSize, vertexSize, mSize, false);
+            benchmarkSink(mDest);
+        }
+
+    private:
+        float* mSource1;
+        float* mSource2;
+        float* mDest;
+    };
+
+    class ConcatenateAffineMatricesBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        ConcatenateAffineMatricesBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("concatenateAffineMatrices", implementation, size) {}
+
+        void setUp()
+        {
+            mSource = allocate<Matrix4>(mSize);
+            mDest = allocate<Matrix4>(mSize);
+            for (size_t i = 0; i < mSize; ++i)
+                mSource[i] = randomAffineMatrix();
+            mBase = randomAffineMatrix();
+        }
+
+        void run()
+        {
+            mUtil->concatenateAffineMatrices(mBase, mSource, mDest, mSize);
+            benchmarkSink(mDest);
+        }
+
+    private:
+        Matrix4 mBase;
+        Matrix4* mSource;
+        Matrix4* mDest;
+    };
+
+    class FaceNormalsBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        FaceNormalsBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("calculateFaceNormals", implementation, size) {}
+
+        void setUp()
+        {
+            // About two triangles per vertex, as in a closed mesh
+            size_t numVertices = mSize / 2 + 3;
+            mPositions = allocateRandom(numVertices * 3, 10);
+            mTriangles = allocate<EdgeData::Triangle>(mSize);
+            for (size_t i = 0; i < mSize; ++i)
+            {
+                for (size_t v = 0; v < 3; ++v)
+                    mTriangles[i].vertIndex[v] = (i / 2 + v) % numVertices;
+            }
+            mFaceNormals = allocate<Vector4>(mSize);
+        }
+
+        void run()
+        {
+            mUtil->calculateFaceNormals(mPositions, mTriangles, mFaceNormals, mSize);
+            benchmarkSink(mFaceNormals);
+        }
+
+    private:
+        float* mPositions;
+        EdgeData::Triangle* mTriangles;
+        Vector4* mFaceNormals;
+    };
+
+    class LightFacingBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        LightFacingBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("calculateLightFacing", implementation, size) {}
+
+        void setUp()
+        {
+            mFaceNormals = reinterpret_cast<Vector4*>(allocateRandom(mSize * 4, 1));
+            mLightFacings = allocate<char>(mSize);
+        }
+
+        void run()
+        {
+            mUtil->calculateLightFacing(Vector4(50, 100, -20, 1), mFaceNormals, mLightFacings, mSize);
+            benchmarkSink(mLightFacings);
+        }
+
+    private:
+        Vector4* mFaceNormals;
+        char* mLightFacings;
+    };
+
+    class ExtrudeVerticesBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        ExtrudeVerticesBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("extrudeVertices", implementation, size) {}
+
+        void setUp()
+        {
+            mSource = allocateRandom(mSize * 3, 10);
+            mDest = allocate<float>(mSize * 3);
+        }
+
+        void run()
+        {
+            // Point light, the more expensive case
+            mUtil->extrudeVertices(Vector4(50, 100, -20, 1), 1000, mSource, mDest, mSize);
+            benchmarkSink(mDest);
+        }
+
+    private:
+        float* mSource;
+        float* mDest;
+    };
+
+    class NodeTransformsBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        NodeTransformsBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("concatenateNodeTransforms", implementation, size) {}
+
+        void setUp()
+        {
+            setUpStreams(mParent, true);
+            setUpStreams(mLocal, true);
+            setUpStreams(mDerived, false);
+            mInheritOrientation = allocate<uint32>(mSize);
+            mInheritScale = allocate<uint32>(mSize);
+            for (size_t i = 0; i < mSize; ++i)
+            {
+                mInheritOrientation[i] = 0xFFFFFFFF;
+                mInheritScale[i] = 0xFFFFFFFF;
+            }
+        }
+
+        void run()
+        {
+            mUtil->concatenateNodeTransforms(mParent, mLocal,
+                mInheritOrientation, mInheritScale, mDerived, mSize);
+            benchmarkSink(mDerived.position[0]);
+        }
+
+    private:
+        TransformStreams mParent;
+        TransformStreams mLocal;
+        TransformStreams mDerived;
+        uint32* mInheritOrientation;
+        uint32* mInheritScale;
+    };
+
+    class BoneMatricesBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        BoneMatricesBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark("calculateBoneMatrices", implementation, size) {}
+
+        void setUp()
+        {
+            setUpStreams(mDerived, true);
+            setUpStreams(mBindingPoseInverses, true);
+            mMatrices = allocate<Matrix4>(mSize);
+        }
+
+        void run()
+        {
+            mUtil->calculateBoneMatrices(mDerived, mBindingPoseInverses, mMatrices, mSize);
+            benchmarkSink(mMatrices);
+        }
+
+    private:
+        TransformStreams mDerived;
+        TransformStreams mBindingPoseInverses;
+        Matrix4* mMatrices;
+    };
+
+    /// Base of the culling benchmarks, with the planes of a 90 degrees frustum
+    class VisibilityBenchmark : public OptimisedUtilBenchmark
+    {
+    public:
+        VisibilityBenchmark(const String& name, const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : OptimisedUtilBenchmark(name, implementation, size)
+        {
+            const Real h = Math::Sqrt(0.5f);
+            mPlanes[0] = Plane(Vector3(0, 0, -1), -1);
+            mPlanes[1] = Plane(Vector3(0, 0, 1), 500);
+            mPlanes[2] = Plane(Vector3(h, 0, -h), 0);
+            mPlanes[3] = Plane(Vector3(-h, 0, -h), 0);
+            mPlanes[4] = Plane(Vector3(0, h, -h), 0);
+            mPlanes[5] = Plane(Vector3(0, -h, -h), 0);
+        }
+
+        void setUp()
+        {
+            // Spread around the camera, so that most objects are culled
+            // against different planes
+            for (int c = 0; c < 3; ++c)
+                mCentres[c] = allocateRandom(mSize, 500);
+            mSizes = allocate<Real>(mSize);
+            for (size_t i = 0; i < mSize; ++i)
+                mSizes[i] = Math::RangeRandom(0.5, 20);
+            mVisibilities = allocate<char>(mSize);
+        }
+
+    protected:
+        Plane mPlanes[6];
+        Real* mCentres[3];
+        Real* mSizes;
+        char* mVisibilities;
+    };
+
+    class BoxesVisibilityBenchmark : public VisibilityBenchmark
+    {
+    public:
+        BoxesVisibilityBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : VisibilityBenchmark("calculateBoxesVisibility", implementation, size) {}
+
+        void run()
+        {
+            // Cubes, the half sizes of the three axes share the same stream
+            const Real* halfSizes[3] = { mSizes, mSizes, mSizes };
+            mUtil->calculateBoxesVisibility(mPlanes, 6, mCentres, halfSizes, mVisibilities, mSize);
+            benchmarkSink(mVisibilities);
+        }
+    };
+
+    class SpheresVisibilityBenchmark : public VisibilityBenchmark
+    {
+    public:
+        SpheresVisibilityBenchmark(const OptimisedUtil::NamedImplementation& implementation, size_t size)
+            : VisibilityBenchmark("calculateSpheresVisibility", implementation, size) {}
+
+        void run()
+        {
+            mUtil->calculateSpheresVisibility(mPlanes, 6, mCentres, mSizes, mVisibilities, mSize);
+            benchmarkSink(mVisibilities);
+        }
+    };
+
+    template <typename T>
+    void addBenchmarks(BenchmarkRunner& runner, const OptimisedUtil::NamedImplementationList& implementations)
+    {
+        for (size_t s = 0; s < BENCHMARK_SIZE_COUNT; ++s)
+        {
+            for (size_t i = 0; i < implementations.size(); ++i)
+                runner.add(new T(implementations[i], BENCHMARK_SIZES[s]));
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+void addOptimisedUtilBenchmarks(BenchmarkRunner& runner)
+{
+    OptimisedUtil::NamedImplementationList implementations = OptimisedUtil::getAvailableImplementations();
+
+    addBenchmarks<SkinningBenchmark>(runner, implementations);
+    addBenchmarks<MorphBenchmark>(runner, implementations);
+    addBenchmarks<ConcatenateAffineMatricesBenchmark>(runner, implementations);
+    addBenchmarks<FaceNormalsBenchmark>(runner, implementations);
+    addBenchmarks<LightFacingBenchmark>(runner, implementations);
+    addBenchmarks<ExtrudeVerticesBenchmark>(runner, implementations);
+    addBenchmarks<NodeTransformsBenchmark>(runner, implementations);
+    addBenchmarks<BoneMatricesBenchmark>(runner, implementations);
+    addBenchmarks<BoxesVisibilityBenchmark>(runner, implementations);
+    addBenchmarks<SpheresVisibilityBenchmark>(runner, implementations);
+}
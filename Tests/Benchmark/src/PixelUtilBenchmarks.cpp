@@ -0,0 +1,105 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgrePixelFormat.h"
+#include "OgreMath.h"
+
+using namespace Ogre;
+
+namespace {
+
+    class PixelConversionBenchmark : public Benchmark
+    {
+    public:
+        PixelConversionBenchmark(PixelFormat srcFormat, PixelFormat dstFormat, size_t size)
+            : Benchmark("PixelUtil::bulkPixelConversion(" + PixelUtil::getFormatName(srcFormat) +
+                "->" + PixelUtil::getFormatName(dstFormat) + ")", "", size)
+            , mSrcFormat(srcFormat)
+            , mDstFormat(dstFormat)
+        {
+        }
+
+        void setUp()
+        {
+            mSource.resize(mSize * PixelUtil::getNumElemBytes(mSrcFormat));
+            mDest.resize(mSize * PixelUtil::getNumElemBytes(mDstFormat));
+            if (PixelUtil::isFloatingPoint(mSrcFormat))
+            {
+                float* values = reinterpret_cast<float*>(&mSource[0]);
+                for (size_t i = 0; i < mSource.size() / sizeof(float); ++i)
+                    values[i] = Math::UnitRandom();
+            }
+            else
+            {
+                for (size_t i = 0; i < mSource.size(); ++i)
+                    mSource[i] = static_cast<uchar>(Math::UnitRandom() * 255);
+            }
+        }
+
+        void run()
+        {
+            PixelUtil::bulkPixelConversion(&mSource[0], mSrcFormat, &mDest[0], mDstFormat,
+                static_cast<unsigned int>(mSize));
+            benchmarkSink(&mDest[0]);
+        }
+
+        void tearDown()
+        {
+            mSource.clear();
+            mDest.clear();
+        }
+
+    private:
+        PixelFormat mSrcFormat;
+        PixelFormat mDstFormat;
+        vector<uchar>::type mSource;
+        vector<uchar>::type mDest;
+    };
+}
+
+//--------------------------------------------------------------------------
+void addPixelUtilBenchmarks(BenchmarkRunner& runner)
+{
+    // Swizzles with an optimised path, then the generic unpack/pack path
+    const PixelFormat conversions[][2] =
+    {
+        { PF_A8R8G8B8, PF_A8B8G8R8 },
+        { PF_R8G8B8, PF_A8R8G8B8 },
+        { PF_A8R8G8B8, PF_R5G6B5 },
+        { PF_FLOAT32_RGBA, PF_A8R8G8B8 },
+        { PF_A8R8G8B8, PF_FLOAT16_RGBA },
+    };
+    // From a 64x64 texture to a 1024x1024 one
+    const size_t sizes[] = { 64 * 64, 256 * 256, 1024 * 1024 };
+
+    for (size_t c = 0; c < sizeof(conversions) / sizeof(conversions[0]); ++c)
+    {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+            runner.add(new PixelConversionBenchmark(conversions[c][0], conversions[c][1], sizes[s]));
+    }
+}
@@ -0,0 +1,98 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgreRadixSort.h"
+#include "OgreMath.h"
+
+#include <algorithm>
+
+using namespace Ogre;
+
+namespace {
+
+    template <typename T>
+    struct IdentityFunctor
+    {
+        T operator()(const T& value) const { return value; }
+    };
+
+    /** Sorts a random array of the given type with RadixSort, or with
+        std::sort for reference. Each run copies the unsorted input first,
+        which RadixSort::sort does internally anyway.
+    */
+    template <typename T>
+    class SortBenchmark : public Benchmark
+    {
+    public:
+        SortBenchmark(const String& name, bool radix, size_t size)
+            : Benchmark(name, radix ? "RadixSort" : "std::sort", size), mRadix(radix) {}
+
+        void setUp()
+        {
+            mInput.resize(mSize);
+            for (size_t i = 0; i < mSize; ++i)
+                mInput[i] = static_cast<T>(Math::RangeRandom(-1000000, 1000000));
+        }
+
+        void run()
+        {
+            mWork = mInput;
+            if (mRadix)
+                mSorter.sort(mWork, IdentityFunctor<T>());
+            else
+                std::sort(mWork.begin(), mWork.end());
+            benchmarkSink(&mWork[0]);
+        }
+
+        void tearDown()
+        {
+            mInput.clear();
+            mWork.clear();
+        }
+
+    private:
+        typedef std::vector<T> Container;
+        bool mRadix;
+        Container mInput;
+        Container mWork;
+        RadixSort<Container, T, T> mSorter;
+    };
+}
+
+//--------------------------------------------------------------------------
+void addRadixSortBenchmarks(BenchmarkRunner& runner)
+{
+    for (size_t s = 0; s < BENCHMARK_SIZE_COUNT; ++s)
+    {
+        for (int radix = 1; radix >= 0; --radix)
+        {
+            runner.add(new SortBenchmark<float>("sort<float>", radix != 0, BENCHMARK_SIZES[s]));
+            runner.add(new SortBenchmark<int>("sort<int>", radix != 0, BENCHMARK_SIZES[s]));
+        }
+    }
+}
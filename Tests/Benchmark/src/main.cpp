@@ -0,0 +1,105 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "OgreLogManager.h"
+#include "OgrePlatformInformation.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreStringConverter.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace Ogre;
+
+static void printUsage()
+{
+    std::cout <<
+        "Usage: Test_OgreBenchmark [options]\n"
+        "  -f <filter>    only run benchmarks whose name/variant contains <filter>\n"
+        "  -t <ms>        minimum duration of a sample, 20 by default\n"
+        "  -n <count>     number of samples per benchmark, 7 by default\n"
+        "  -csv <file>    write the results as CSV to <file>\n"
+        "  -json <file>   write the results as JSON to <file>\n"
+        "Timings are in nanoseconds per element, fastest and median sample.\n";
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkRunner runner;
+    String csvFile, jsonFile;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        String arg = argv[i];
+        if (i + 1 < argc && arg == "-f")
+            runner.setFilter(argv[++i]);
+        else if (i + 1 < argc && arg == "-t")
+            runner.setMinSampleTime(StringConverter::parseUnsignedLong(argv[++i]) * 1000);
+        else if (i + 1 < argc && arg == "-n")
+            runner.setSampleCount(std::max<size_t>(StringConverter::parseUnsignedInt(argv[++i]), 1));
+        else if (i + 1 < argc && arg == "-csv")
+            csvFile = argv[++i];
+        else if (i + 1 < argc && arg == "-json")
+            jsonFile = argv[++i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Keep the engine quiet, the results go to the standard output
+    LogManager logManager;
+    logManager.createLog("OgreBenchmark.log", true, false, false);
+
+    std::cout << "CPU: " << PlatformInformation::getCpuIdentifier() << "\n";
+    std::cout << "OptimisedUtil implementations:";
+    OptimisedUtil::NamedImplementationList implementations = OptimisedUtil::getAvailableImplementations();
+    for (size_t i = 0; i < implementations.size(); ++i)
+        std::cout << " " << implementations[i].first;
+    std::cout << std::endl;
+
+    addMathBenchmarks(runner);
+    addOptimisedUtilBenchmarks(runner);
+    addRadixSortBenchmarks(runner);
+    addPixelUtilBenchmarks(runner);
+    runner.run(std::cout);
+
+    if (!csvFile.empty())
+    {
+        std::ofstream out(csvFile.c_str());
+        runner.writeCsv(out);
+    }
+    if (!jsonFile.empty())
+    {
+        std::ofstream out(jsonFile.c_str());
+        runner.writeJson(out);
+    }
+
+    return 0;
+}
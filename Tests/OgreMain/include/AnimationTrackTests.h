@@ -0,0 +1,62 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreSkeleton.h"
+
+class AnimationTrackTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( AnimationTrackTests );
+    CPPUNIT_TEST(testTimeIndex);
+    CPPUNIT_TEST(testCompressedInterpolation);
+    CPPUNIT_TEST(testKeyReduction);
+    CPPUNIT_TEST(testCompressedSerialisation);
+    CPPUNIT_TEST(testAnimationLodLevels);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    Ogre::Skeleton* mSkeleton;
+    Ogre::Animation* mAnimation;
+
+    void createTrack(unsigned short handle, size_t numKeys);
+    void compareTracks(const Ogre::NodeAnimationTrack* expected,
+        const Ogre::NodeAnimationTrack* actual, Ogre::Real tolerance);
+public:
+    void setUp();
+    void tearDown();
+    // The global keyframe index matches a binary search
+    void testTimeIndex();
+    // Compressed tracks interpolate like the original ones
+    void testCompressedInterpolation();
+    // Keys and channels which can be interpolated are removed
+    void testKeyReduction();
+    // Compressed tracks are saved and loaded as such
+    void testCompressedSerialisation();
+    // Levels of animation detail are picked by distance and leave bones out
+    void testAnimationLodLevels();
+};
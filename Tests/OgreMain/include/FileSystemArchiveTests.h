@@ -45,6 +45,7 @@ class FileSystemArchiveTests : public CppUnit::TestFixture
     CPPUNIT_TEST(testFindFileInfoRecursive);
     CPPUNIT_TEST(testFileRead);
     CPPUNIT_TEST(testReadInterleave);
+    CPPUNIT_TEST(testMemoryMappedRead);
 	CPPUNIT_TEST(testCreateAndRemoveFile);
     CPPUNIT_TEST_SUITE_END();
 protected:
@@ -63,6 +64,7 @@ public:
     void testFindFileInfoRecursive();
     void testFileRead();
     void testReadInterleave();
+    void testMemoryMappedRead();
 	void testCreateAndRemoveFile();
 
 };
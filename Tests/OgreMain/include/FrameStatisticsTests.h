@@ -0,0 +1,59 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgrePrerequisites.h"
+#include "NullRenderSystemFixture.h"
+
+class FrameStatisticsTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( FrameStatisticsTests );
+    CPPUNIT_TEST(testLastFrameStatistics);
+    CPPUNIT_TEST(testPassesAvoided);
+    CPPUNIT_TEST(testProgramBindsAvoided);
+    CPPUNIT_TEST(testLogFile);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    NullRenderSystemFixture mFixture;
+    Ogre::SceneManager* mSceneMgr;
+
+    /// Adds a triangle at the given depth, using the given material
+    void addTriangle(const Ogre::String& materialName, Ogre::Real z);
+public:
+    void setUp();
+    void tearDown();
+    // The statistics of a frame are available once the next one is rendered
+    void testLastFrameStatistics();
+    // Sorted renderables sharing a pass only set it once
+    void testPassesAvoided();
+    // Passes sharing a GPU program only bind it once
+    void testProgramBindsAvoided();
+    // The log file gets a line for every frame, the last one included
+    void testLogFile();
+};
@@ -0,0 +1,69 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __NullRenderSystemFixture_H__
+#define __NullRenderSystemFixture_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+    class NullPlugin;
+    class NullRenderSystem;
+}
+
+/** Root using the headless Null render system, shared by the tests which
+    need a render system, e.g. to update a camera or to render a frame.
+*/
+class NullRenderSystemFixture
+{
+public:
+    NullRenderSystemFixture();
+
+    /** Creates the Root and selects the Null render system.
+    @remarks
+        The Root is not initialised yet, so that the tests can configure
+        anything which is set up on initialisation, e.g. the WorkQueue.
+    */
+    void setUp();
+    /// Initialises the Root, creating a render window
+    void initialise();
+    /// Destroys the Root and the render system
+    void tearDown();
+
+    Ogre::Root* getRoot() const { return mRoot; }
+    Ogre::NullRenderSystem* getRenderSystem() const { return mRenderSystem; }
+    Ogre::RenderWindow* getWindow() const { return mWindow; }
+
+protected:
+    Ogre::Root* mRoot;
+    Ogre::NullPlugin* mPlugin;
+    Ogre::NullRenderSystem* mRenderSystem;
+    Ogre::RenderWindow* mWindow;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgrePrerequisites.h"
+#include "NullRenderSystemFixture.h"
+
+class NullRenderSystemTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( NullRenderSystemTests );
+    CPPUNIT_TEST(testResetStatistics);
+    CPPUNIT_TEST(testStateCounters);
+    CPPUNIT_TEST(testParameterBytes);
+    CPPUNIT_TEST(testBufferBytes);
+    CPPUNIT_TEST(testTextureBytes);
+    CPPUNIT_TEST(testTextureUnitSettings);
+    CPPUNIT_TEST(testRenderOneFrame);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    NullRenderSystemFixture mFixture;
+public:
+    void setUp();
+    void tearDown();
+    // resetStatistics sets every counter back to zero
+    void testResetStatistics();
+    // Each render state call adds one to its own counter
+    void testStateCounters();
+    // Pass iteration parameters count as one float4 upload
+    void testParameterBytes();
+    // Writes to vertex and index buffers count the bytes written
+    void testBufferBytes();
+    // Writes to texture surfaces count the bytes written
+    void testTextureBytes();
+    // Texture units can be set up from a pass, as SceneManager does
+    void testTextureUnitSettings();
+    // A rendered frame counts its frame, viewport, clear and draw call
+    void testRenderOneFrame();
+};
@@ -0,0 +1,76 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgreOptimisedUtil.h"
+
+class OptimisedUtilTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( OptimisedUtilTests );
+    CPPUNIT_TEST(testSoftwareVertexSkinning);
+    CPPUNIT_TEST(testSoftwareVertexMorph);
+    CPPUNIT_TEST(testSoftwareVertexMorphMixedLayouts);
+    CPPUNIT_TEST(testSoftwareVertexMorphNormalAlongZ);
+    CPPUNIT_TEST(testConcatenateAffineMatrices);
+    CPPUNIT_TEST(testCalculateFaceNormals);
+    CPPUNIT_TEST(testCalculateLightFacing);
+    CPPUNIT_TEST(testExtrudeVertices);
+    CPPUNIT_TEST(testCalculateBoneMatrices);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    typedef void (OptimisedUtilTests::*Check)(Ogre::OptimisedUtil* util);
+    // Runs the check against every implementation usable on this CPU
+    void checkAllImplementations(Check check);
+
+    void checkSoftwareVertexSkinning(Ogre::OptimisedUtil* util);
+    void checkSoftwareVertexMorph(Ogre::OptimisedUtil* util);
+    void checkSoftwareVertexMorphMixedLayouts(Ogre::OptimisedUtil* util);
+    void checkSoftwareVertexMorphNormalAlongZ(Ogre::OptimisedUtil* util);
+    void checkConcatenateAffineMatrices(Ogre::OptimisedUtil* util);
+    void checkCalculateFaceNormals(Ogre::OptimisedUtil* util);
+    void checkCalculateLightFacing(Ogre::OptimisedUtil* util);
+    void checkExtrudeVertices(Ogre::OptimisedUtil* util);
+    void checkCalculateBoneMatrices(Ogre::OptimisedUtil* util);
+public:
+    void setUp();
+    void tearDown();
+    // The functions of each implementation give the same results as the
+    // equivalent Ogre math, within rounding
+    void testSoftwareVertexSkinning();
+    void testSoftwareVertexMorph();
+    // Each buffer of a morph can have its own vertex size
+    void testSoftwareVertexMorphMixedLayouts();
+    // Morphed normals are renormalised using all three components
+    void testSoftwareVertexMorphNormalAlongZ();
+    void testConcatenateAffineMatrices();
+    void testCalculateFaceNormals();
+    void testCalculateLightFacing();
+    void testExtrudeVertices();
+    void testCalculateBoneMatrices();
+};
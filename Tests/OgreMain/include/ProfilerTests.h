@@ -0,0 +1,58 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgrePrerequisites.h"
+
+class ProfilerTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( ProfilerTests );
+    CPPUNIT_TEST(testTraceExport);
+    CPPUNIT_TEST(testTraceRingBuffer);
+    CPPUNIT_TEST(testTraceGroupMask);
+    CPPUNIT_TEST(testTraceThreads);
+    CPPUNIT_TEST(testTraceScopeCache);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    Ogre::Timer* mTimer;
+    Ogre::Profiler* mProfiler;
+public:
+    void setUp();
+    void tearDown();
+    // Nested profiles are exported as Chrome trace complete events
+    void testTraceExport();
+    // Only the most recent profiles are kept once the buffer is full
+    void testTraceRingBuffer();
+    // Profiles of masked groups are not recorded
+    void testTraceGroupMask();
+    // Profiles of other threads are exported under their own thread
+    void testTraceThreads();
+    // Cached profile names stay valid for later profilers
+    void testTraceScopeCache();
+};
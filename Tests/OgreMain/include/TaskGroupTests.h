@@ -0,0 +1,68 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "OgrePrerequisites.h"
+#include "NullRenderSystemFixture.h"
+
+class TaskGroupTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE( TaskGroupTests );
+    CPPUNIT_TEST(testRunTasks);
+    CPPUNIT_TEST(testRunEmptyList);
+    CPPUNIT_TEST(testParallelSceneGraphUpdate);
+    CPPUNIT_TEST(testParallelSceneGraphUpdateDeepGraph);
+    CPPUNIT_TEST(testParallelCulling);
+    CPPUNIT_TEST(testParallelCullingNodeOverride);
+    CPPUNIT_TEST(testParallelResourceLoading);
+    CPPUNIT_TEST(testScriptPreParsing);
+    CPPUNIT_TEST_SUITE_END();
+protected:
+    NullRenderSystemFixture mFixture;
+    Ogre::Root* mRoot;
+public:
+    void setUp();
+    void tearDown();
+    // Every task of a list is run exactly once per run
+    void testRunTasks();
+    // Running an empty list returns straight away
+    void testRunEmptyList();
+    // The parallel scene graph update gives the same transforms as the serial one
+    void testParallelSceneGraphUpdate();
+    // A graph with a single child below the root is split deeper, with the same result
+    void testParallelSceneGraphUpdateDeepGraph();
+    // Parallel culling queues the same objects in the same order as the serial one
+    void testParallelCulling();
+    // Parallel culling lets scene node subclasses cull their own subtree
+    void testParallelCullingNodeOverride();
+    // Parallel group loading loads every resource once and reports them in order
+    void testParallelResourceLoading();
+    // Scripts pre-parsed on worker threads are compiled from the parsed nodes
+    void testScriptPreParsing();
+};
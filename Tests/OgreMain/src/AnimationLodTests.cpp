@@ -0,0 +1,179 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "AnimationLodTests.h"
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreCamera.h"
+#include "OgreRenderWindow.h"
+#include "OgreEntity.h"
+#include "OgreSkeletonManager.h"
+#include "OgreSkeletonInstance.h"
+#include "OgreMeshManager.h"
+#include "OgreSubMesh.h"
+#include "OgreAnimation.h"
+#include "OgreKeyFrame.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreAnimationState.h"
+#include "OgreStringConverter.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( AnimationLodTests );
+
+using namespace Ogre;
+
+namespace {
+    const Real SpinAngle = 160;
+
+    Matrix4 spinMatrix(Real time)
+    {
+        Matrix4 m;
+        m.makeTransform(Vector3::ZERO, Vector3::UNIT_SCALE,
+            Quaternion(Degree(SpinAngle * time), Vector3::UNIT_Z));
+        return m;
+    }
+
+    bool matrixEquals(const Matrix4& a, const Matrix4& b, Real tolerance)
+    {
+        for (size_t row = 0; row < 4; ++row)
+            for (size_t col = 0; col < 4; ++col)
+                if (!Math::RealEqual(a[row][col], b[row][col], tolerance))
+                    return false;
+        return true;
+    }
+}
+
+void AnimationLodTests::setUp()
+{
+    mFixture.setUp();
+    mFixture.initialise();
+
+    mSceneMgr = mFixture.getRoot()->createSceneManager(ST_GENERIC);
+    Camera* camera = mSceneMgr->createCamera("Camera");
+    camera->setPosition(0, 0, 200);
+    camera->lookAt(0, 0, 0);
+    camera->setNearClipDistance(1);
+    mFixture.getWindow()->addViewport(camera);
+}
+
+void AnimationLodTests::tearDown()
+{
+    mFixture.tearDown();
+}
+
+void AnimationLodTests::createSpinningMesh()
+{
+    const String& group = ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME;
+    SkeletonPtr skeleton = SkeletonManager::getSingleton().create("Spinning", group, true);
+    Bone* bone = skeleton->createBone("Spin", 0);
+    skeleton->setBindingPose();
+    // The camera is beyond the level, which evaluates every 4 frames
+    skeleton->addAnimationLodLevel(100, 4);
+    Animation* anim = skeleton->createAnimation("Spin", 1);
+    anim->setRotationInterpolationMode(Animation::RIM_SPHERICAL);
+    NodeAnimationTrack* track = anim->createNodeTrack(0, bone);
+    track->createNodeKeyFrame(0);
+    track->createNodeKeyFrame(1)->setRotation(Quaternion(Degree(SpinAngle), Vector3::UNIT_Z));
+
+    MeshPtr mesh = MeshManager::getSingleton().createManual("Spinning", group);
+    SubMesh* subMesh = mesh->createSubMesh();
+    subMesh->useSharedVertices = false;
+    subMesh->vertexData = OGRE_NEW VertexData();
+    subMesh->vertexData->vertexCount = 3;
+    subMesh->vertexData->vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vertices = HardwareBufferManager::getSingleton().createVertexBuffer(
+        3 * sizeof(float), 3, HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+    float positions[9] = { 0, 0, 0, 10, 0, 0, 0, 10, 0 };
+    vertices->writeData(0, sizeof(positions), positions, true);
+    subMesh->vertexData->vertexBufferBinding->setBinding(0, vertices);
+    subMesh->indexData->indexCount = 3;
+    subMesh->indexData->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, 3, HardwareBuffer::HBU_STATIC_WRITE_ONLY, true);
+    uint16 indices[3] = { 0, 1, 2 };
+    subMesh->indexData->indexBuffer->writeData(0, sizeof(indices), indices, true);
+    for (size_t v = 0; v < 3; ++v)
+    {
+        VertexBoneAssignment assignment;
+        assignment.vertexIndex = static_cast<unsigned int>(v);
+        assignment.boneIndex = 0;
+        assignment.weight = 1;
+        subMesh->addBoneAssignment(assignment);
+    }
+    subMesh->setMaterialName("BaseWhiteNoLighting");
+    mesh->_setBounds(AxisAlignedBox(-10, -10, -10, 10, 10, 10));
+    mesh->_setBoundingSphereRadius(20);
+    mesh->setSkeletonName("Spinning");
+    mesh->load();
+}
+
+void AnimationLodTests::testInterpolatedBones()
+{
+    createSpinningMesh();
+    // Entities evaluate in different frames, depending on their names
+    vector<Entity*>::type entities;
+    for (int i = 0; i < 8; ++i)
+    {
+        Entity* entity = mSceneMgr->createEntity("Spinning" + StringConverter::toString(i), "Spinning");
+        mSceneMgr->getRootSceneNode()->attachObject(entity);
+        AnimationState* state = entity->getAnimationState("Spin");
+        state->setEnabled(true);
+        state->setLoop(false);
+        entities.push_back(entity);
+    }
+
+    size_t laggingFrames = 0;
+    for (int frame = 0; frame < 16; ++frame)
+    {
+        for (size_t i = 0; i < entities.size(); ++i)
+            entities[i]->getAnimationState("Spin")->addTime(0.05f);
+        mFixture.getRoot()->renderOneFrame();
+
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            // Interpolating the matrices themselves would scale the bone down
+            const Matrix4& m = entities[i]->_getBoneMatrices()[0];
+            for (size_t col = 0; col < 3; ++col)
+            {
+                Vector3 axis(m[0][col], m[1][col], m[2][col]);
+                CPPUNIT_ASSERT(Math::RealEqual(axis.length(), 1, 1e-4f));
+            }
+            if (!matrixEquals(m, spinMatrix(entities[i]->getAnimationState("Spin")->getTimePosition()), 1e-3f))
+                ++laggingFrames;
+        }
+    }
+    // The animation is only evaluated every few frames
+    CPPUNIT_ASSERT(laggingFrames > 0);
+
+    // The bones reach the pose of the animation once it stops
+    for (int frame = 0; frame < 8; ++frame)
+        mFixture.getRoot()->renderOneFrame();
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        CPPUNIT_ASSERT(matrixEquals(entities[i]->_getBoneMatrices()[0],
+            spinMatrix(entities[i]->getAnimationState("Spin")->getTimePosition()), 1e-3f));
+    }
+}
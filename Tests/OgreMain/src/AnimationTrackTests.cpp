@@ -0,0 +1,305 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "AnimationTrackTests.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreBone.h"
+#include "OgreCompressedTransformKeys.h"
+#include "OgreException.h"
+#include "OgreKeyFrame.h"
+#include "OgreLodStrategyManager.h"
+#include "OgreMath.h"
+#include "OgreSkeletonSerializer.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( AnimationTrackTests );
+
+using namespace Ogre;
+
+namespace {
+    /// Skeleton built by hand, which is never loaded so has to destroy its bones itself
+    class ManualSkeleton : public Skeleton
+    {
+    public:
+        ManualSkeleton() : Skeleton(0, "ManualSkeleton", 0, "Tests", true) {}
+        ~ManualSkeleton() { unloadImpl(); }
+    };
+
+    const Real ANIMATION_LENGTH = 10;
+}
+
+void AnimationTrackTests::setUp()
+{
+    srand(1234);
+    mSkeleton = OGRE_NEW ManualSkeleton();
+    for (unsigned short handle = 0; handle < 4; ++handle)
+    {
+        Bone* bone = mSkeleton->createBone(handle);
+        if (handle)
+            mSkeleton->getBone(handle - 1)->addChild(bone);
+    }
+    mSkeleton->setBindingPose();
+    mAnimation = mSkeleton->createAnimation("Test", ANIMATION_LENGTH);
+}
+
+void AnimationTrackTests::tearDown()
+{
+    OGRE_DELETE mSkeleton;
+}
+
+void AnimationTrackTests::createTrack(unsigned short handle, size_t numKeys)
+{
+    // Keys unevenly spread over the length, first and last at the ends
+    NodeAnimationTrack* track = mAnimation->createNodeTrack(handle, mSkeleton->getBone(handle));
+    Real time = 0;
+    for (size_t k = 0; k < numKeys; ++k)
+    {
+        TransformKeyFrame* kf = track->createNodeKeyFrame(time);
+        kf->setTranslate(Vector3(Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10)));
+        kf->setRotation(Quaternion(Radian(Math::RangeRandom(-Math::PI, Math::PI)),
+            Vector3(Math::RangeRandom(-1, 1), Math::RangeRandom(-1, 1), 1).normalisedCopy()));
+        kf->setScale(Vector3(Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2)));
+        time = k + 2 == numKeys ? ANIMATION_LENGTH :
+            std::min(ANIMATION_LENGTH * 0.99f, time + Math::RangeRandom(0.001f, 2.0f * ANIMATION_LENGTH / numKeys));
+    }
+}
+
+void AnimationTrackTests::compareTracks(const NodeAnimationTrack* expected,
+    const NodeAnimationTrack* actual, Real tolerance)
+{
+    for (Real time = 0; time <= ANIMATION_LENGTH; time += 0.0137f)
+    {
+        TransformKeyFrame expectedKey(0, time), actualKey(0, time);
+        expected->getInterpolatedKeyFrame(expected->getParent()->_getTimeIndex(time), &expectedKey);
+        actual->getInterpolatedKeyFrame(actual->getParent()->_getTimeIndex(time), &actualKey);
+
+        CPPUNIT_ASSERT(expectedKey.getTranslate().positionEquals(actualKey.getTranslate(), tolerance));
+        // Quaternion::equals is limited by the precision of acos near 1
+        Quaternion expectedRot = expectedKey.getRotation(), actualRot = actualKey.getRotation();
+        if (expectedRot.Dot(actualRot) < 0)
+            actualRot = -actualRot;
+        for (size_t i = 0; i < 4; ++i)
+            CPPUNIT_ASSERT(Math::RealEqual(expectedRot[i], actualRot[i], tolerance));
+        CPPUNIT_ASSERT(expectedKey.getScale().positionEquals(actualKey.getScale(), tolerance));
+    }
+}
+
+void AnimationTrackTests::testTimeIndex()
+{
+    createTrack(0, 50);
+    createTrack(1, 7);
+    createTrack(2, 200);
+
+    vector<Real>::type times;
+    Animation::NodeTrackIterator it = mAnimation->getNodeTrackIterator();
+    while (it.hasMoreElements())
+    {
+        NodeAnimationTrack* track = it.getNext();
+        for (unsigned short k = 0; k < track->getNumKeyFrames(); ++k)
+            times.push_back(track->getKeyFrame(k)->getTime());
+    }
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+
+    // Random times and exact key times
+    vector<Real>::type positions(times);
+    for (size_t i = 0; i < 1000; ++i)
+        positions.push_back(Math::RangeRandom(0, ANIMATION_LENGTH));
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        size_t expected = std::distance(times.begin(),
+            std::lower_bound(times.begin(), times.end(), positions[i]));
+        CPPUNIT_ASSERT_EQUAL(expected, static_cast<size_t>(mAnimation->_getTimeIndex(positions[i]).getKeyIndex()));
+    }
+}
+
+void AnimationTrackTests::testCompressedInterpolation()
+{
+    createTrack(0, 100);
+    createTrack(1, 1);
+    Animation* reference = mAnimation->clone("Reference");
+
+    mAnimation->getNodeTrack(0)->compress();
+    mAnimation->getNodeTrack(1)->compress();
+    CPPUNIT_ASSERT(mAnimation->getNodeTrack(0)->isCompressed());
+    CPPUNIT_ASSERT_EQUAL((unsigned short)0, mAnimation->getNodeTrack(0)->getNumKeyFrames());
+
+    compareTracks(reference->getNodeTrack(0), mAnimation->getNodeTrack(0), 2e-3f);
+    compareTracks(reference->getNodeTrack(1), mAnimation->getNodeTrack(1), 2e-3f);
+
+    // Splines are built from the decoded keys
+    mAnimation->setInterpolationMode(Animation::IM_SPLINE);
+    reference->setInterpolationMode(Animation::IM_SPLINE);
+    compareTracks(reference->getNodeTrack(0), mAnimation->getNodeTrack(0), 5e-3f);
+
+    OGRE_DELETE reference;
+}
+
+void AnimationTrackTests::testKeyReduction()
+{
+    mAnimation->setRotationInterpolationMode(Animation::RIM_SPHERICAL);
+
+    // Constant motion, only the end keys are needed
+    NodeAnimationTrack* track = mAnimation->createNodeTrack(0, mSkeleton->getBone(0));
+    for (size_t k = 0; k <= 10; ++k)
+    {
+        TransformKeyFrame* kf = track->createNodeKeyFrame(k * ANIMATION_LENGTH / 10);
+        kf->setTranslate(Vector3(k * 0.5f, 1, -2.0f * k));
+        kf->setRotation(Quaternion(Degree(k * 10.0f), Vector3::UNIT_Y));
+    }
+    // A change of direction half way needs a key there
+    NodeAnimationTrack* bent = mAnimation->createNodeTrack(1, mSkeleton->getBone(1));
+    for (size_t k = 0; k <= 10; ++k)
+    {
+        TransformKeyFrame* kf = bent->createNodeKeyFrame(k * ANIMATION_LENGTH / 10);
+        kf->setTranslate(Vector3(std::min<Real>(k, 10 - k), 0, 0));
+    }
+
+    Animation* reference = mAnimation->clone("Reference");
+    track->compress();
+    bent->compress();
+
+    const CompressedTransformKeys* keys = track->getCompressedKeys();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, keys->getNumKeys());
+    CPPUNIT_ASSERT_EQUAL(ANIMATION_LENGTH, keys->getTime(1));
+    CPPUNIT_ASSERT(keys->getScale(1).positionEquals(Vector3::UNIT_SCALE, 1e-3f));
+    CPPUNIT_ASSERT_EQUAL((size_t)3, bent->getCompressedKeys()->getNumKeys());
+    compareTracks(reference->getNodeTrack(0), track, 2e-3f);
+    compareTracks(reference->getNodeTrack(1), bent, 2e-3f);
+
+    // Keyframes can only be edited once decompressed
+    try
+    {
+        track->createNodeKeyFrame(1);
+        CPPUNIT_FAIL("Expected InvalidParametersException!");
+    }
+    catch (const InvalidParametersException&)
+    {
+        // ok
+    }
+    track->decompress();
+    CPPUNIT_ASSERT(!track->isCompressed());
+    CPPUNIT_ASSERT_EQUAL((unsigned short)2, track->getNumKeyFrames());
+    compareTracks(reference->getNodeTrack(0), track, 2e-3f);
+
+    OGRE_DELETE reference;
+}
+
+void AnimationTrackTests::testCompressedSerialisation()
+{
+    createTrack(0, 40);
+    createTrack(2, 40);
+    mSkeleton->compressAllAnimations();
+
+    SkeletonSerializer serializer;
+    SkeletonVersion versions[2] = { SKELETON_VERSION_LATEST, SKELETON_VERSION_1_8 };
+    size_t sizes[2];
+    for (size_t v = 0; v < 2; ++v)
+    {
+        MemoryDataStream* buffer = OGRE_NEW MemoryDataStream(1 << 20);
+        DataStreamPtr stream(buffer);
+        serializer.exportSkeleton(mSkeleton, stream, versions[v]);
+        sizes[v] = stream->tell();
+
+        DataStreamPtr written(OGRE_NEW MemoryDataStream(buffer->getPtr(), sizes[v]));
+        ManualSkeleton loaded;
+        serializer.importSkeleton(written, &loaded);
+
+        Animation* animation = loaded.getAnimation("Test");
+        CPPUNIT_ASSERT_EQUAL((unsigned short)2, animation->getNumNodeTracks());
+        for (unsigned short handle = 0; handle < 4; handle += 2)
+        {
+            const NodeAnimationTrack* original = mAnimation->getNodeTrack(handle);
+            const NodeAnimationTrack* track = animation->getNodeTrack(handle);
+            // Older versions have no compressed tracks and get keyframes instead
+            CPPUNIT_ASSERT_EQUAL(v == 0, track->isCompressed());
+            compareTracks(original, track, 1e-4f);
+        }
+    }
+    CPPUNIT_ASSERT(sizes[0] < sizes[1]);
+}
+
+void AnimationTrackTests::testAnimationLodLevels()
+{
+    LodStrategyManager* lodStrategyManager = OGRE_NEW LodStrategyManager();
+    for (unsigned short handle = 0; handle < 4; ++handle)
+        createTrack(handle, 10);
+
+    // Only the first two bones of the chain at the second level
+    Skeleton::BoneHandleList bones;
+    bones.push_back(0);
+    bones.push_back(1);
+    mSkeleton->addAnimationLodLevel(100, 2);
+    mSkeleton->addAnimationLodLevel(200, 4, &bones);
+    try
+    {
+        mSkeleton->addAnimationLodLevel(150, 8);
+        CPPUNIT_FAIL("Expected InvalidParametersException!");
+    }
+    catch (const InvalidParametersException&)
+    {
+        // ok
+    }
+    CPPUNIT_ASSERT_EQUAL((unsigned short)3, mSkeleton->getNumAnimationLodLevels());
+    CPPUNIT_ASSERT_EQUAL((unsigned short)4, mSkeleton->getAnimationLodLevel(2).updateInterval);
+
+    // The distance strategy works on squared distances
+    const LodStrategy* strategy = mSkeleton->getAnimationLodStrategy();
+    CPPUNIT_ASSERT_EQUAL((unsigned short)0, mSkeleton->getAnimationLodIndex(strategy->transformUserValue(50)));
+    CPPUNIT_ASSERT_EQUAL((unsigned short)1, mSkeleton->getAnimationLodIndex(strategy->transformUserValue(150)));
+    CPPUNIT_ASSERT_EQUAL((unsigned short)2, mSkeleton->getAnimationLodIndex(strategy->transformUserValue(1000)));
+
+    AnimationStateSet animSet;
+    mSkeleton->_initAnimationState(&animSet);
+    animSet.getAnimationState("Test")->setEnabled(true);
+    animSet.getAnimationState("Test")->setTimePosition(3.3f);
+
+    mSkeleton->_setAnimationState(animSet, 0);
+    vector<Vector3>::type positions;
+    for (unsigned short handle = 0; handle < 4; ++handle)
+        positions.push_back(mSkeleton->getBone(handle)->getPosition());
+
+    // Levels without a bone subset animate every bone, the others keep their initial state
+    mSkeleton->_setAnimationState(animSet, 1);
+    for (unsigned short handle = 0; handle < 4; ++handle)
+        CPPUNIT_ASSERT(positions[handle].positionEquals(mSkeleton->getBone(handle)->getPosition()));
+    mSkeleton->_setAnimationState(animSet, 2);
+    for (unsigned short handle = 0; handle < 4; ++handle)
+    {
+        Bone* bone = mSkeleton->getBone(handle);
+        CPPUNIT_ASSERT(bone->getPosition().positionEquals(handle < 2 ? positions[handle] : bone->getInitialPosition()));
+    }
+
+    // Removing the levels leaves full detail only
+    mSkeleton->removeAllAnimationLodLevels();
+    CPPUNIT_ASSERT_EQUAL((unsigned short)1, mSkeleton->getNumAnimationLodLevels());
+    CPPUNIT_ASSERT_EQUAL((unsigned short)0, mSkeleton->getAnimationLodIndex(strategy->transformUserValue(1000)));
+
+    OGRE_DELETE lodStrategyManager;
+}
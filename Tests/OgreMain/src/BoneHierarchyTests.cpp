@@ -0,0 +1,150 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "BoneHierarchyTests.h"
+#include "OgreBone.h"
+#include "OgreMath.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( BoneHierarchyTests );
+
+using namespace Ogre;
+
+namespace {
+    /// Skeleton built by hand, which is never loaded so has to destroy its bones itself
+    class ManualSkeleton : public Skeleton
+    {
+    public:
+        ManualSkeleton() : Skeleton(0, "ManualSkeleton", 0, "Tests", true) {}
+        ~ManualSkeleton() { unloadImpl(); }
+    };
+
+    void randomiseTransform(Bone* bone)
+    {
+        bone->setPosition(Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10));
+        bone->setOrientation(Quaternion(Radian(Math::RangeRandom(-Math::PI, Math::PI)),
+            Vector3(Math::RangeRandom(-1, 1), Math::RangeRandom(-1, 1), 1).normalisedCopy()));
+        bone->setScale(Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2));
+    }
+}
+
+void BoneHierarchyTests::setUp()
+{
+    mReference = OGRE_NEW ManualSkeleton();
+    mSkeleton = OGRE_NEW ManualSkeleton();
+    mSkeleton->setBoneHierarchyEnabled(true);
+
+    createBones(mReference, 0, 60);
+    createBones(mSkeleton, 0, 60);
+    mReference->getRootBone();
+    mSkeleton->getRootBone();
+    mReference->setBindingPose();
+    mSkeleton->setBindingPose();
+}
+
+void BoneHierarchyTests::tearDown()
+{
+    OGRE_DELETE mReference;
+    OGRE_DELETE mSkeleton;
+}
+
+void BoneHierarchyTests::createBones(Skeleton* skeleton, unsigned short firstHandle, unsigned short numBones)
+{
+    // Same seed for both skeletons so they are identical. Parents are
+    // picked at random, so the bones are not sorted by depth.
+    srand(1234 + firstHandle);
+    for (unsigned short handle = firstHandle; handle < firstHandle + numBones; ++handle)
+    {
+        Bone* bone = skeleton->createBone(handle);
+        randomiseTransform(bone);
+        bone->setInheritOrientation(handle % 7 != 0);
+        bone->setInheritScale(handle % 5 != 0);
+        if (handle)
+            skeleton->getBone(static_cast<unsigned short>(rand() % handle))->addChild(bone);
+    }
+}
+
+void BoneHierarchyTests::updateAndCompare()
+{
+    size_t numBones = mReference->getNumBones();
+    vector<Matrix4>::type expected(numBones), actual(numBones);
+    mReference->_getBoneMatrices(&expected[0]);
+    mSkeleton->_getBoneMatrices(&actual[0]);
+
+    for (unsigned short handle = 0; handle < numBones; ++handle)
+    {
+        const Bone* reference = mReference->getBone(handle);
+        const Bone* bone = mSkeleton->getBone(handle);
+        CPPUNIT_ASSERT(reference->_getDerivedPosition().positionEquals(bone->_getDerivedPosition(), 1e-3f));
+        CPPUNIT_ASSERT(reference->_getDerivedOrientation().equals(bone->_getDerivedOrientation(), Radian(1e-3f)));
+        CPPUNIT_ASSERT(reference->_getDerivedScale().positionEquals(bone->_getDerivedScale(), 1e-3f));
+        for (size_t r = 0; r < 4; ++r)
+        {
+            for (size_t c = 0; c < 4; ++c)
+            {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[handle][r][c], actual[handle][r][c],
+                    1e-3f * std::max(Real(1), Math::Abs(expected[handle][r][c])));
+            }
+        }
+    }
+}
+
+void BoneHierarchyTests::testBoneMatrices()
+{
+    srand(5678);
+    for (unsigned short handle = 0; handle < mReference->getNumBones(); ++handle)
+        randomiseTransform(mReference->getBone(handle));
+    srand(5678);
+    for (unsigned short handle = 0; handle < mSkeleton->getNumBones(); ++handle)
+        randomiseTransform(mSkeleton->getBone(handle));
+    updateAndCompare();
+}
+
+void BoneHierarchyTests::testPartialUpdate()
+{
+    updateAndCompare();
+    for (unsigned short handle = 3; handle < mReference->getNumBones(); handle += 11)
+    {
+        mReference->getBone(handle)->translate(1, 2, 3);
+        mSkeleton->getBone(handle)->translate(1, 2, 3);
+        mReference->getBone(handle)->yaw(Degree(30));
+        mSkeleton->getBone(handle)->yaw(Degree(30));
+    }
+    updateAndCompare();
+}
+
+void BoneHierarchyTests::testNewBones()
+{
+    updateAndCompare();
+    createBones(mReference, 60, 20);
+    createBones(mSkeleton, 60, 20);
+    mReference->setBindingPose();
+    mSkeleton->setBindingPose();
+    mReference->getBone(0)->roll(Degree(45));
+    mSkeleton->getBone(0)->roll(Degree(45));
+    updateAndCompare();
+}
@@ -241,6 +241,40 @@ void FileSystemArchiveTests::testFileRead()
     CPPUNIT_ASSERT(stream->eof());
 
 }
+void FileSystemArchiveTests::testMemoryMappedRead()
+{
+    FileSystemArchive arch(testPath, "FileSystem", true);
+    arch.load();
+
+    FileSystemArchive::setUseMemoryMapping(true);
+    DataStreamPtr stream = arch.open("rootfile.txt");
+    FileSystemArchive::setUseMemoryMapping(false);
+
+    MmapDataStream* mapped = dynamic_cast<MmapDataStream*>(stream.get());
+    CPPUNIT_ASSERT(mapped);
+    CPPUNIT_ASSERT_EQUAL(String("this is line 1 in file 1"), stream->getLine());
+
+    // A memory copy of the rest shares the mapping
+    DataStreamPtr copy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+    CPPUNIT_ASSERT(stream->eof());
+    CPPUNIT_ASSERT(static_cast<MemoryDataStream*>(copy.get())->getPtr() == mapped->getCurrentPtr() - copy->size());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 2 in file 1"), copy->getLine());
+
+    // Closing the original keeps the memory alive for the copy
+    stream->close();
+    CPPUNIT_ASSERT(!mapped->getPtr());
+    CPPUNIT_ASSERT_EQUAL(String("this is line 3 in file 1"), copy->getLine());
+    stream.setNull();
+    CPPUNIT_ASSERT_EQUAL(String("this is line 4 in file 1"), copy->getLine());
+
+    // A closed stream has nothing left to share
+    FileSystemArchive::setUseMemoryMapping(true);
+    stream = arch.open("rootfile.txt");
+    FileSystemArchive::setUseMemoryMapping(false);
+    stream->close();
+    DataStreamPtr empty(OGRE_NEW MemoryDataStream(stream));
+    CPPUNIT_ASSERT(empty->eof());
+}
 void FileSystemArchiveTests::testReadInterleave()
 {
     // Test overlapping reads from same archive
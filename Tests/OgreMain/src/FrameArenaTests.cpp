@@ -0,0 +1,125 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "FrameArenaTests.h"
+#include "OgrePrerequisites.h"
+#include "OgrePlatformInformation.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( FrameArenaTests );
+
+using namespace Ogre;
+
+void FrameArenaTests::setUp()
+{
+    FrameArena::releaseMemory();
+    FrameArena::setChunkSize(1024);
+}
+
+void FrameArenaTests::tearDown()
+{
+    FrameArena::releaseMemory();
+    FrameArena::setChunkSize(64 * 1024);
+}
+
+void FrameArenaTests::testAlignment()
+{
+    void* a = FrameArena::allocate(3);
+    void* b = FrameArena::allocate(5, 64);
+    void* c = FrameAlignedAllocPolicy<8>::allocateBytes(1);
+    void* d = FrameAllocPolicy::allocateBytes(7);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, reinterpret_cast<size_t>(a) % OGRE_SIMD_ALIGNMENT);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, reinterpret_cast<size_t>(b) % 64);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, reinterpret_cast<size_t>(c) % 8);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, reinterpret_cast<size_t>(d) % OGRE_SIMD_ALIGNMENT);
+    CPPUNIT_ASSERT(static_cast<char*>(b) >= static_cast<char*>(a) + 3);
+    CPPUNIT_ASSERT(static_cast<char*>(c) >= static_cast<char*>(b) + 5);
+    CPPUNIT_ASSERT(static_cast<char*>(d) >= static_cast<char*>(c) + 1);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, FrameArena::getNumLiveAllocations());
+
+    FrameArena::deallocate(a);
+    FrameArena::deallocate(b);
+    FrameArena::deallocate(c);
+    FrameArena::deallocate(d);
+}
+
+void FrameArenaTests::testRewind()
+{
+    typedef vector<int, STLAllocator<int, FrameAllocPolicy> >::type FrameIntVector;
+    void* first;
+    {
+        FrameIntVector values;
+        for (int i = 0; i < 100; ++i)
+            values.push_back(i);
+        first = FrameArena::allocate(16);
+        CPPUNIT_ASSERT(FrameArena::getBytesAllocated() >= 100 * sizeof(int) + 16);
+        CPPUNIT_ASSERT_EQUAL(99, values.back());
+    }
+    // Still in use, nothing is reclaimed at the end of the frame
+    CPPUNIT_ASSERT_EQUAL((size_t)1, FrameArena::getNumLiveAllocations());
+    FrameArena::reset();
+    CPPUNIT_ASSERT(FrameArena::getBytesAllocated() > 0);
+
+    FrameArena::deallocate(first);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, FrameArena::getBytesAllocated());
+    void* again = OGRE_MALLOC(4, MEMCATEGORY_FRAME);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, FrameArena::getNumLiveAllocations());
+    OGRE_FREE(again, MEMCATEGORY_FRAME);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, FrameArena::getNumLiveAllocations());
+}
+
+void FrameArenaTests::testGrowth()
+{
+    void* small = FrameArena::allocate(100);
+    CPPUNIT_ASSERT_EQUAL((size_t)1024, FrameArena::getCapacity());
+    // Neither fits in the rest of the chunk
+    void* big = FrameArena::allocate(1000);
+    void* huge = FrameArena::allocate(5000);
+    CPPUNIT_ASSERT_EQUAL((size_t)1024, FrameArena::getCapacity());
+    memset(big, 1, 1000);
+    memset(huge, 2, 5000);
+    size_t peak = FrameArena::getPeakBytesAllocated();
+    CPPUNIT_ASSERT(peak >= 6100);
+
+    FrameArena::deallocate(huge);
+    FrameArena::deallocate(big);
+    FrameArena::deallocate(small);
+    CPPUNIT_ASSERT(FrameArena::getCapacity() >= peak);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, FrameArena::getCapacity() % 1024);
+    CPPUNIT_ASSERT_EQUAL(peak, FrameArena::getPeakBytesAllocated());
+    FrameArena::reset();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, FrameArena::getPeakBytesAllocated());
+
+    // Now the same frame fits in the chunk
+    small = FrameArena::allocate(100);
+    big = FrameArena::allocate(1000);
+    huge = FrameArena::allocate(5000);
+    CPPUNIT_ASSERT(static_cast<char*>(huge) - static_cast<char*>(small) < (ptrdiff_t)FrameArena::getCapacity());
+    FrameArena::deallocate(small);
+    FrameArena::deallocate(big);
+    FrameArena::deallocate(huge);
+}
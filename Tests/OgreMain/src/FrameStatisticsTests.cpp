@@ -0,0 +1,176 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "FrameStatisticsTests.h"
+#include "OgreRoot.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreSceneManager.h"
+#include "OgreManualObject.h"
+#include "OgreCamera.h"
+#include "OgreRenderWindow.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreTextureManager.h"
+#include <fstream>
+#include <cstdio>
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( FrameStatisticsTests );
+
+using namespace Ogre;
+
+void FrameStatisticsTests::setUp()
+{
+    mFixture.setUp();
+    mFixture.initialise();
+
+    mSceneMgr = mFixture.getRoot()->createSceneManager(ST_GENERIC);
+    Camera* camera = mSceneMgr->createCamera("Camera");
+    camera->setPosition(0, 0, 100);
+    camera->lookAt(0, 0, 0);
+    camera->setNearClipDistance(1);
+    mFixture.getWindow()->addViewport(camera);
+}
+
+void FrameStatisticsTests::tearDown()
+{
+    mFixture.tearDown();
+}
+
+void FrameStatisticsTests::addTriangle(const String& materialName, Real z)
+{
+    ManualObject* triangle = mSceneMgr->createManualObject();
+    triangle->begin(materialName);
+    triangle->position(0, 0, z);
+    triangle->position(10, 0, z);
+    triangle->position(0, 10, z);
+    triangle->triangle(0, 1, 2);
+    triangle->end();
+    mSceneMgr->getRootSceneNode()->attachObject(triangle);
+}
+
+void FrameStatisticsTests::testLastFrameStatistics()
+{
+    addTriangle("BaseWhiteNoLighting", 0);
+
+    Root* root = mFixture.getRoot();
+    unsigned long firstFrame = root->getNextFrameNumber();
+    root->renderOneFrame();
+    // Nothing was completed yet
+    CPPUNIT_ASSERT_EQUAL((size_t)0, mSceneMgr->getLastFrameStatistics().scenesRendered);
+
+    root->renderOneFrame();
+    const SceneManager::FrameStatistics& stats = mSceneMgr->getLastFrameStatistics();
+    CPPUNIT_ASSERT_EQUAL(firstFrame, stats.frameNumber);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.scenesRendered);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.passesApplied);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, stats.passesAvoided);
+}
+
+void FrameStatisticsTests::testPassesAvoided()
+{
+    TexturePtr tex = TextureManager::getSingleton().createManual("FrameStatisticsTests",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 4, 4, 0, PF_A8R8G8B8);
+    MaterialPtr mat = MaterialManager::getSingleton().create("FrameStatisticsTests/Transparent",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Pass* pass = mat->getTechnique(0)->getPass(0);
+    pass->setLightingEnabled(false);
+    pass->setSceneBlending(SBT_TRANSPARENT_ALPHA);
+    pass->setDepthWriteEnabled(false);
+    pass->createTextureUnitState(tex->getName());
+
+    // Transparent renderables are sorted by depth rather than grouped by pass
+    const size_t numTriangles = 3;
+    for (size_t i = 0; i < numTriangles; ++i)
+        addTriangle(mat->getName(), (Real)i);
+
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+    Root* root = mFixture.getRoot();
+    root->renderOneFrame();
+    rs->resetStatistics();
+    root->renderOneFrame();
+
+    const SceneManager::FrameStatistics& stats = mSceneMgr->getLastFrameStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.passesApplied);
+    CPPUNIT_ASSERT_EQUAL(numTriangles - 1, stats.passesAvoided);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.textureUnitsApplied);
+    CPPUNIT_ASSERT_EQUAL(numTriangles - 1, stats.textureUnitsAvoided);
+    // Every triangle is still drawn
+    CPPUNIT_ASSERT_EQUAL(numTriangles, rs->getStatistics().drawCalls);
+}
+
+void FrameStatisticsTests::testProgramBindsAvoided()
+{
+    GpuProgramManager::getSingleton().createProgramFromString("FrameStatisticsTests/VP",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, "!!ARBvp1.0\nEND\n",
+        GPT_VERTEX_PROGRAM, "arbvp1");
+
+    // Two materials, so two passes, sharing the same program
+    for (int i = 0; i < 2; ++i)
+    {
+        MaterialPtr mat = MaterialManager::getSingleton().create(
+            "FrameStatisticsTests/Program" + StringConverter::toString(i),
+            ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        mat->getTechnique(0)->getPass(0)->setVertexProgram("FrameStatisticsTests/VP");
+        addTriangle(mat->getName(), 0);
+    }
+
+    Root* root = mFixture.getRoot();
+    root->renderOneFrame();
+    root->renderOneFrame();
+
+    const SceneManager::FrameStatistics& stats = mSceneMgr->getLastFrameStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t)2, stats.passesApplied);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.programsBound);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.programBindsAvoided);
+}
+
+void FrameStatisticsTests::testLogFile()
+{
+    addTriangle("BaseWhiteNoLighting", 0);
+
+    const String fileName = "FrameStatisticsTests.csv";
+    mSceneMgr->setFrameStatisticsLogFile(fileName);
+    const size_t numFrames = 3;
+    for (size_t i = 0; i < numFrames; ++i)
+        mFixture.getRoot()->renderOneFrame();
+    // Closing the file writes the last frame
+    mSceneMgr->setFrameStatisticsLogFile(StringUtil::BLANK);
+
+    std::ifstream log(fileName.c_str());
+    size_t numLines = 0;
+    std::string line;
+    while (std::getline(log, line))
+        ++numLines;
+    log.close();
+    std::remove(fileName.c_str());
+
+    // A header, then one line per frame
+    CPPUNIT_ASSERT_EQUAL(numFrames + 1, numLines);
+}
@@ -0,0 +1,127 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "FrustumTests.h"
+#include "OgreRoot.h"
+#include "OgreFrustum.h"
+#include "OgreSphere.h"
+#include "OgreMath.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( FrustumTests );
+
+using namespace Ogre;
+
+void FrustumTests::setUp()
+{
+    mFixture.setUp();
+    mFixture.initialise();
+}
+
+void FrustumTests::tearDown()
+{
+    mFixture.tearDown();
+}
+
+void FrustumTests::testBoxesVisibility()
+{
+    // Not a multiple of the batch sizes, so the remainders are tested too
+    const size_t numBoxes = 203;
+    vector<AxisAlignedBox>::type boxes(numBoxes);
+    vector<const AxisAlignedBox*>::type bounds(numBoxes);
+    for (size_t i = 0; i < numBoxes; ++i)
+    {
+        if (i % 50 == 7)
+        {
+            boxes[i].setNull();
+        }
+        else if (i % 50 == 8)
+        {
+            boxes[i].setInfinite();
+        }
+        else
+        {
+            Vector3 centre(Math::RangeRandom(-150, 150), Math::RangeRandom(-150, 150),
+                Math::RangeRandom(-150, 50));
+            Vector3 halfSize(Math::RangeRandom(0, 20), Math::RangeRandom(0, 20),
+                Math::RangeRandom(0, 20));
+            boxes[i].setExtents(centre - halfSize, centre + halfSize);
+        }
+        bounds[i] = &boxes[i];
+    }
+
+    Frustum frustum;
+    frustum.setNearClipDistance(1);
+    vector<char>::type visibilities(numBoxes);
+    for (int infinite = 0; infinite < 2; ++infinite)
+    {
+        frustum.setFarClipDistance(infinite ? 0 : 100);
+        frustum.isVisible(&bounds[0], numBoxes, &visibilities[0]);
+
+        size_t numVisible = 0;
+        for (size_t i = 0; i < numBoxes; ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(frustum.isVisible(boxes[i]), visibilities[i] != 0);
+            if (visibilities[i])
+                ++numVisible;
+        }
+        // Make sure both cases are covered
+        CPPUNIT_ASSERT(numVisible > 0 && numVisible < numBoxes);
+    }
+}
+
+void FrustumTests::testSpheresVisibility()
+{
+    const size_t numSpheres = 203;
+    vector<Sphere>::type spheres(numSpheres);
+    vector<const Sphere*>::type bounds(numSpheres);
+    for (size_t i = 0; i < numSpheres; ++i)
+    {
+        spheres[i].setCenter(Vector3(Math::RangeRandom(-150, 150), Math::RangeRandom(-150, 150),
+            Math::RangeRandom(-150, 50)));
+        spheres[i].setRadius(Math::RangeRandom(0, 20));
+        bounds[i] = &spheres[i];
+    }
+
+    Frustum frustum;
+    frustum.setNearClipDistance(1);
+    vector<char>::type visibilities(numSpheres);
+    for (int infinite = 0; infinite < 2; ++infinite)
+    {
+        frustum.setFarClipDistance(infinite ? 0 : 100);
+        frustum.isVisible(&bounds[0], numSpheres, &visibilities[0]);
+
+        size_t numVisible = 0;
+        for (size_t i = 0; i < numSpheres; ++i)
+        {
+            CPPUNIT_ASSERT_EQUAL(frustum.isVisible(spheres[i]), visibilities[i] != 0);
+            if (visibilities[i])
+                ++numVisible;
+        }
+        CPPUNIT_ASSERT(numVisible > 0 && numVisible < numSpheres);
+    }
+}
@@ -0,0 +1,219 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "GpuProgramParametersTests.h"
+#include "OgreAutoParamDataSource.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( GpuProgramParametersTests );
+
+using namespace Ogre;
+
+namespace {
+    /// Physical indexes of the autos used
+    const size_t AMBIENT_INDEX = 0;
+    const size_t PASS_NUMBER_INDEX = 4;
+    const size_t WORLD_INDEX = 8;
+
+    const float GARBAGE = -123.0f;
+
+    void addDefinition(GpuNamedConstants& constants, const String& name, 
+        GpuConstantType type, size_t physicalIndex, size_t logicalIndex = 0,
+        GpuLogicalBufferStruct* logicalToPhysical = 0)
+    {
+        GpuConstantDefinition def;
+        def.constType = type;
+        def.physicalIndex = physicalIndex;
+        def.logicalIndex = logicalIndex;
+        def.elementSize = GpuConstantDefinition::getElementSize(type, false);
+        constants.map[name] = def;
+        if (logicalToPhysical)
+        {
+            logicalToPhysical->map.insert(GpuLogicalIndexUseMap::value_type(logicalIndex,
+                GpuLogicalIndexUse(physicalIndex, def.elementSize, GPV_GLOBAL)));
+        }
+    }
+}
+
+void GpuProgramParametersTests::setUp()
+{
+    GpuNamedConstantsPtr constants(OGRE_NEW GpuNamedConstants());
+    constants->floatBufferSize = 24;
+    mParams.bind(OGRE_NEW GpuProgramParameters());
+    mParams->_setNamedConstants(constants);
+    mParams->_setRawAutoConstant(AMBIENT_INDEX, GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR, 0, GPV_GLOBAL);
+    mParams->_setRawAutoConstant(PASS_NUMBER_INDEX, GpuProgramParameters::ACT_PASS_NUMBER, 0, GPV_GLOBAL);
+    mParams->_setRawAutoConstant(WORLD_INDEX, GpuProgramParameters::ACT_WORLD_MATRIX, 0, GPV_PER_OBJECT, 16);
+
+    mSource = OGRE_NEW AutoParamDataSource();
+    mSource->setAmbientLightColour(ColourValue(0.5f, 0.25f, 0.125f));
+    mSource->setPassNumber(1);
+    mSource->setWorldMatrices(&Matrix4::IDENTITY, 1);
+}
+
+void GpuProgramParametersTests::tearDown()
+{
+    mParams.setNull();
+    OGRE_DELETE mSource;
+}
+
+void GpuProgramParametersTests::testUnchangedAutoParamsSkipped()
+{
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL((uint16)(GPV_GLOBAL | GPV_PER_OBJECT), mParams->_getUpdatedVariability());
+    CPPUNIT_ASSERT_EQUAL(0.5f, *mParams->getFloatPointer(AMBIENT_INDEX));
+    CPPUNIT_ASSERT_EQUAL(1.0f, *mParams->getFloatPointer(PASS_NUMBER_INDEX));
+    CPPUNIT_ASSERT_EQUAL(1.0f, *mParams->getFloatPointer(WORLD_INDEX));
+
+    // Overwritten values show whether a slot was recalculated
+    *mParams->getFloatPointer(AMBIENT_INDEX) = GARBAGE;
+    *mParams->getFloatPointer(PASS_NUMBER_INDEX) = GARBAGE;
+    *mParams->getFloatPointer(WORLD_INDEX) = GARBAGE;
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL((uint16)0, mParams->_getUpdatedVariability());
+    CPPUNIT_ASSERT_EQUAL(GARBAGE, *mParams->getFloatPointer(AMBIENT_INDEX));
+
+    mSource->setPassNumber(2);
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL((uint16)GPV_GLOBAL, mParams->_getUpdatedVariability());
+    CPPUNIT_ASSERT_EQUAL(GARBAGE, *mParams->getFloatPointer(AMBIENT_INDEX));
+    CPPUNIT_ASSERT_EQUAL(2.0f, *mParams->getFloatPointer(PASS_NUMBER_INDEX));
+    CPPUNIT_ASSERT_EQUAL(GARBAGE, *mParams->getFloatPointer(WORLD_INDEX));
+
+    // A change outside the mask is picked up once the mask includes it
+    mSource->setWorldMatrices(&Matrix4::IDENTITY, 1);
+    mParams->_updateAutoParams(mSource, GPV_GLOBAL);
+    CPPUNIT_ASSERT_EQUAL(GARBAGE, *mParams->getFloatPointer(WORLD_INDEX));
+    mParams->_updateAutoParams(mSource, GPV_PER_OBJECT);
+    CPPUNIT_ASSERT_EQUAL((uint16)GPV_PER_OBJECT, mParams->_getUpdatedVariability());
+    CPPUNIT_ASSERT_EQUAL(1.0f, *mParams->getFloatPointer(WORLD_INDEX));
+
+    mSource->invalidateInputs();
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL(0.5f, *mParams->getFloatPointer(AMBIENT_INDEX));
+}
+
+void GpuProgramParametersTests::testChangedSourceRecalculates()
+{
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    *mParams->getFloatPointer(AMBIENT_INDEX) = GARBAGE;
+
+    AutoParamDataSource other;
+    other.setAmbientLightColour(ColourValue::White);
+    other.setWorldMatrices(&Matrix4::IDENTITY, 1);
+    mParams->_updateAutoParams(&other, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL(1.0f, *mParams->getFloatPointer(AMBIENT_INDEX));
+
+    // Going back to the first source must not reuse values from the other one
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL(0.5f, *mParams->getFloatPointer(AMBIENT_INDEX));
+
+    // Reassigning a slot recalculates it
+    *mParams->getFloatPointer(PASS_NUMBER_INDEX) = GARBAGE;
+    mParams->_setRawAutoConstant(PASS_NUMBER_INDEX, GpuProgramParameters::ACT_PASS_NUMBER, 0, GPV_GLOBAL);
+    mParams->_updateAutoParams(mSource, GPV_ALL);
+    CPPUNIT_ASSERT_EQUAL(1.0f, *mParams->getFloatPointer(PASS_NUMBER_INDEX));
+}
+
+void GpuProgramParametersTests::testConstantBufferLayout()
+{
+    // Physical indexes in declaration order, which differs from the buffer order
+    GpuNamedConstantsPtr constants(OGRE_NEW GpuNamedConstants());
+    GpuLogicalBufferStructPtr floatLogical(OGRE_NEW GpuLogicalBufferStruct());
+    GpuLogicalBufferStructPtr doubleLogical(OGRE_NEW GpuLogicalBufferStruct());
+    GpuLogicalBufferStructPtr intLogical(OGRE_NEW GpuLogicalBufferStruct());
+    addDefinition(*constants, "colour", GCT_FLOAT4, 0, 0, floatLogical.get());
+    addDefinition(*constants, "scale", GCT_FLOAT1, 4, 1, floatLogical.get());
+    addDefinition(*constants, "world", GCT_MATRIX_4X4, 5, 2, floatLogical.get());
+    addDefinition(*constants, "count", GCT_INT1, 0, 0, intLogical.get());
+    constants->floatBufferSize = floatLogical->bufferSize = 21;
+    constants->intBufferSize = intLogical->bufferSize = 1;
+
+    size_t buffer = constants->addBufferLayout(100);
+    constants->addBufferConstant(buffer, "world", 0, 64);
+    constants->addBufferConstant(buffer, "colour", 64, 16);
+    constants->addBufferConstant(buffer, "count", 80, 4);
+    constants->addBufferConstant(buffer, "scale", 96, 4);
+    try
+    {
+        constants->addBufferConstant(buffer, "colour", 90, 16);
+        CPPUNIT_FAIL("Expected InvalidParametersException!");
+    }
+    catch (const InvalidParametersException&)
+    {
+        // ok
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)4, constants->getBufferLayout(buffer).blocks.size());
+
+    for (size_t mirror = 0; mirror < 2; ++mirror)
+    {
+        if (mirror)
+        {
+            constants->mirrorBufferLayouts(floatLogical.get(), doubleLogical.get(), intLogical.get());
+            // The floats around the int are each a single block
+            CPPUNIT_ASSERT_EQUAL((size_t)3, constants->getBufferLayout(buffer).blocks.size());
+
+            // The logical indexes follow the constants
+            CPPUNIT_ASSERT_EQUAL(constants->floatBufferSize, floatLogical->bufferSize);
+            CPPUNIT_ASSERT_EQUAL(constants->intBufferSize, intLogical->bufferSize);
+            CPPUNIT_ASSERT_EQUAL(constants->map["colour"].physicalIndex,
+                floatLogical->map.find(0)->second.physicalIndex);
+            CPPUNIT_ASSERT_EQUAL(constants->map["count"].physicalIndex,
+                intLogical->map.find(0)->second.physicalIndex);
+        }
+
+        GpuProgramParameters params;
+        params._setNamedConstants(constants);
+        params._setLogicalIndexes(floatLogical, doubleLogical, intLogical);
+        Matrix4 world(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+        params.setNamedConstant("world", world);
+        // Set by logical index, as low level programs do
+        params.setConstant(0, Vector4(0.1f, 0.2f, 0.3f, 0.4f));
+        params.setNamedConstant("count", 7);
+        params.setNamedConstant("scale", 2.5f);
+
+        char data[100];
+        params._copyConstantBuffer(buffer, data);
+        const float* values = reinterpret_cast<const float*>(data);
+        for (size_t i = 0; i < 16; ++i)
+            CPPUNIT_ASSERT_EQUAL((float)world[i / 4][i % 4], values[i]);
+        CPPUNIT_ASSERT_EQUAL(0.3f, values[18]);
+        CPPUNIT_ASSERT_EQUAL(7, *reinterpret_cast<const int*>(data + 80));
+        CPPUNIT_ASSERT_EQUAL(2.5f, values[24]);
+
+        // Lookups go through the hash index
+        try
+        {
+            params.setNamedConstant("missing", 1.0f);
+            CPPUNIT_FAIL("Expected InvalidParametersException!");
+        }
+        catch (const InvalidParametersException&)
+        {
+            // ok
+        }
+    }
+}
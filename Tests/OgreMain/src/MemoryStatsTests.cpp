@@ -0,0 +1,107 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "MemoryStatsTests.h"
+#include "OgrePrerequisites.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( MemoryStatsTests );
+
+using namespace Ogre;
+
+namespace {
+    struct AllocateTask
+    {
+        void** mPtr;
+        AllocateTask(void** ptr) : mPtr(ptr) {}
+        void operator()() { *mPtr = OGRE_MALLOC(1000, MEMCATEGORY_SCRIPTING); }
+    };
+    struct FreeTask
+    {
+        void* mPtr;
+        FreeTask(void* ptr) : mPtr(ptr) {}
+        void operator()() { OGRE_FREE(mPtr, MEMCATEGORY_SCRIPTING); }
+    };
+}
+
+void MemoryStatsTests::testCounters()
+{
+    // An empty frame
+    MemoryStats::_frameEnded();
+    MemoryStats::_frameEnded();
+    MemoryCategoryStats before = MemoryStats::getStats(MEMCATEGORY_SCRIPTING);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, before.frameAllocations);
+
+    void* a = OGRE_MALLOC(100, MEMCATEGORY_SCRIPTING);
+    void* b = OGRE_MALLOC_SIMD(200, MEMCATEGORY_SCRIPTING);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, reinterpret_cast<size_t>(b) % 16);
+    float* c = OGRE_ALLOC_T(float, 25, MEMCATEGORY_SCRIPTING);
+    MemoryCategoryStats stats = MemoryStats::getStats(MEMCATEGORY_SCRIPTING);
+    CPPUNIT_ASSERT_EQUAL(before.liveBytes + 400, stats.liveBytes);
+    CPPUNIT_ASSERT_EQUAL(before.liveAllocations + 3, stats.liveAllocations);
+    CPPUNIT_ASSERT_EQUAL(before.totalAllocations + 3, stats.totalAllocations);
+    CPPUNIT_ASSERT(stats.peakBytes >= stats.liveBytes);
+
+    // The category the memory was allocated with counts
+    OGRE_FREE(a, MEMCATEGORY_GENERAL);
+    OGRE_FREE_SIMD(b, MEMCATEGORY_SCRIPTING);
+    stats = MemoryStats::getStats(MEMCATEGORY_SCRIPTING);
+    CPPUNIT_ASSERT_EQUAL(before.liveBytes + 100, stats.liveBytes);
+    CPPUNIT_ASSERT_EQUAL(before.liveAllocations + 1, stats.liveAllocations);
+    CPPUNIT_ASSERT(stats.peakBytes >= before.liveBytes + 400);
+
+    MemoryStats::_frameEnded();
+    CPPUNIT_ASSERT_EQUAL((size_t)3, MemoryStats::getStats(MEMCATEGORY_SCRIPTING).frameAllocations);
+    OGRE_FREE(c, MEMCATEGORY_SCRIPTING);
+    MemoryStats::_frameEnded();
+    CPPUNIT_ASSERT_EQUAL((size_t)0, MemoryStats::getStats(MEMCATEGORY_SCRIPTING).frameAllocations);
+    CPPUNIT_ASSERT_EQUAL(before.liveBytes, MemoryStats::getStats(MEMCATEGORY_SCRIPTING).liveBytes);
+}
+
+void MemoryStatsTests::testOtherThreads()
+{
+#if OGRE_THREAD_SUPPORT
+    MemoryCategoryStats before = MemoryStats::getStats(MEMCATEGORY_SCRIPTING);
+    void* ptr = 0;
+    OGRE_THREAD_CREATE(allocator, AllocateTask(&ptr))
+    allocator->join();
+    OGRE_THREAD_DESTROY(allocator);
+    CPPUNIT_ASSERT_EQUAL(before.liveBytes + 1000, MemoryStats::getStats(MEMCATEGORY_SCRIPTING).liveBytes);
+
+    OGRE_FREE(ptr, MEMCATEGORY_SCRIPTING);
+    CPPUNIT_ASSERT_EQUAL(before.liveBytes, MemoryStats::getStats(MEMCATEGORY_SCRIPTING).liveBytes);
+
+    ptr = OGRE_MALLOC(1000, MEMCATEGORY_SCRIPTING);
+    OGRE_THREAD_CREATE(freer, FreeTask(ptr))
+    freer->join();
+    OGRE_THREAD_DESTROY(freer);
+    MemoryCategoryStats after = MemoryStats::getStats(MEMCATEGORY_SCRIPTING);
+    CPPUNIT_ASSERT_EQUAL(before.liveBytes, after.liveBytes);
+    CPPUNIT_ASSERT_EQUAL(before.liveAllocations, after.liveAllocations);
+    CPPUNIT_ASSERT_EQUAL(before.totalAllocations + 2, after.totalAllocations);
+#endif
+}
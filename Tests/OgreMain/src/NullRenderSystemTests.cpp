@@ -0,0 +1,219 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "NullRenderSystemTests.h"
+#include "OgreRoot.h"
+#include "OgreNullRenderSystem.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreTextureManager.h"
+#include "OgreHardwarePixelBuffer.h"
+#include "OgreSceneManager.h"
+#include "OgreManualObject.h"
+#include "OgreCamera.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+#include "OgreRenderWindow.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( NullRenderSystemTests );
+
+using namespace Ogre;
+
+namespace
+{
+    void checkAllZero(const NullRenderSystem::Statistics& stats)
+    {
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.frames);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.viewports);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.drawCalls);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.stateChanges);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.transformChanges);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.textureChanges);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.programBinds);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.vertexStreamChanges);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.clears);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.parameterBytes);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.bufferBytes);
+        CPPUNIT_ASSERT_EQUAL((size_t)0, stats.textureBytes);
+    }
+}
+
+void NullRenderSystemTests::setUp()
+{
+    mFixture.setUp();
+    mFixture.initialise();
+    mFixture.getRenderSystem()->resetStatistics();
+}
+
+void NullRenderSystemTests::tearDown()
+{
+    mFixture.tearDown();
+}
+
+void NullRenderSystemTests::testResetStatistics()
+{
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+    checkAllZero(rs->getStatistics());
+
+    rs->_setWorldMatrix(Matrix4::IDENTITY);
+    rs->setLightingEnabled(false);
+    rs->clearFrameBuffer(FBT_COLOUR);
+    rs->_notifyBufferUpload(16);
+    rs->_notifyTextureUpload(32);
+    NullRenderSystem::Statistics stats = rs->getStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.transformChanges);
+    CPPUNIT_ASSERT_EQUAL((size_t)16, stats.bufferBytes);
+
+    rs->resetStatistics();
+    checkAllZero(rs->getStatistics());
+}
+
+void NullRenderSystemTests::testStateCounters()
+{
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+
+    rs->_setWorldMatrix(Matrix4::IDENTITY);
+    rs->_setViewMatrix(Matrix4::IDENTITY);
+    rs->_setProjectionMatrix(Matrix4::IDENTITY);
+    rs->setLightingEnabled(true);
+    rs->setShadingType(SO_GOURAUD);
+    rs->_setTexture(0, false, TexturePtr());
+    rs->setVertexDeclaration(0);
+    rs->setVertexBufferBinding(0);
+    rs->clearFrameBuffer(FBT_COLOUR | FBT_DEPTH);
+    rs->clearFrameBuffer(FBT_DEPTH);
+
+    NullRenderSystem::Statistics stats = rs->getStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t)3, stats.transformChanges);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, stats.stateChanges);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.textureChanges);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, stats.vertexStreamChanges);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, stats.clears);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, stats.drawCalls);
+}
+
+void NullRenderSystemTests::testParameterBytes()
+{
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+
+    rs->bindGpuProgramPassIterationParameters(GPT_VERTEX_PROGRAM);
+    rs->bindGpuProgramPassIterationParameters(GPT_FRAGMENT_PROGRAM);
+
+    CPPUNIT_ASSERT_EQUAL(2 * 4 * sizeof(float), rs->getStatistics().parameterBytes);
+}
+
+void NullRenderSystemTests::testBufferBytes()
+{
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        3 * sizeof(float), 10, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    float data[30] = { 0 };
+    vbuf->writeData(0, sizeof(data), data);
+
+    HardwareIndexBufferSharedPtr ibuf = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_16BIT, 12, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    // A locked range counts as written, unless it was only read
+    ibuf->lock(HardwareBuffer::HBL_DISCARD);
+    ibuf->unlock();
+    ibuf->lock(HardwareBuffer::HBL_READ_ONLY);
+    ibuf->unlock();
+
+    CPPUNIT_ASSERT_EQUAL(sizeof(data) + 12 * sizeof(uint16),
+        mFixture.getRenderSystem()->getStatistics().bufferBytes);
+}
+
+void NullRenderSystemTests::testTextureBytes()
+{
+    TexturePtr tex = TextureManager::getSingleton().createManual("NullRenderSystemTests",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 16, 8, 0, PF_A8R8G8B8);
+    // Loading the texture may have uploaded its initial contents
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+    rs->resetStatistics();
+
+    HardwarePixelBufferSharedPtr buffer = tex->getBuffer();
+    uint32 pixels[16 * 8] = { 0 };
+    buffer->blitFromMemory(PixelBox(16, 8, 1, PF_A8R8G8B8, pixels));
+    CPPUNIT_ASSERT_EQUAL(sizeof(pixels), rs->getStatistics().textureBytes);
+
+    buffer->lock(Image::Box(0, 0, 4, 4), HardwareBuffer::HBL_NORMAL);
+    buffer->unlock();
+    CPPUNIT_ASSERT_EQUAL(sizeof(pixels) + 4 * 4 * sizeof(uint32), rs->getStatistics().textureBytes);
+
+    TextureManager::getSingleton().remove(tex->getHandle());
+}
+
+void NullRenderSystemTests::testTextureUnitSettings()
+{
+    TexturePtr tex = TextureManager::getSingleton().createManual("NullRenderSystemTests",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, TEX_TYPE_2D, 4, 4, 0, PF_A8R8G8B8);
+    MaterialPtr mat = MaterialManager::getSingleton().create("NullRenderSystemTests",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    TextureUnitState* fragmentUnit = mat->getTechnique(0)->getPass(0)->createTextureUnitState(tex->getName());
+    TextureUnitState* vertexUnit = mat->getTechnique(0)->getPass(0)->createTextureUnitState(tex->getName());
+    vertexUnit->setBindingType(TextureUnitState::BT_VERTEX);
+
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+    rs->_setTextureUnitSettings(0, *fragmentUnit);
+    rs->_setTextureUnitSettings(1, *vertexUnit);
+    rs->_disableTextureUnitsFrom(2);
+
+    CPPUNIT_ASSERT(rs->getStatistics().textureChanges >= 2);
+}
+
+void NullRenderSystemTests::testRenderOneFrame()
+{
+    SceneManager* sceneMgr = mFixture.getRoot()->createSceneManager(ST_GENERIC);
+    Camera* camera = sceneMgr->createCamera("Camera");
+    camera->setPosition(0, 0, 100);
+    camera->lookAt(0, 0, 0);
+    camera->setNearClipDistance(1);
+    mFixture.getWindow()->addViewport(camera);
+
+    ManualObject* triangle = sceneMgr->createManualObject();
+    triangle->begin("BaseWhiteNoLighting");
+    triangle->position(0, 0, 0);
+    triangle->position(10, 0, 0);
+    triangle->position(0, 10, 0);
+    triangle->triangle(0, 1, 2);
+    triangle->end();
+    sceneMgr->getRootSceneNode()->attachObject(triangle);
+
+    NullRenderSystem* rs = mFixture.getRenderSystem();
+    rs->resetStatistics();
+    mFixture.getRoot()->renderOneFrame();
+
+    NullRenderSystem::Statistics stats = rs->getStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.frames);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.viewports);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.clears);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, stats.drawCalls);
+    CPPUNIT_ASSERT(stats.stateChanges > 0);
+    CPPUNIT_ASSERT(stats.transformChanges > 0);
+
+    // The window still counts its own statistics like a real one
+    CPPUNIT_ASSERT_EQUAL((size_t)1, mFixture.getWindow()->getTriangleCount());
+}
@@ -0,0 +1,442 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OptimisedUtilTests.h"
+#include "OgreOptimisedUtil.h"
+#include "OgreMatrix4.h"
+#include "OgreVector4.h"
+#include "OgreMath.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( OptimisedUtilTests );
+
+using namespace Ogre;
+
+namespace {
+    // Not a multiple of the SIMD widths, so the remainders are tested too
+    const size_t NUM_ELEMENTS = 37;
+
+    void checkEqual(Real expected, Real actual)
+    {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, actual, 1e-4f * std::max(Real(1), Math::Abs(expected)));
+    }
+
+    void checkEqual(const Vector3& expected, const float* actual)
+    {
+        checkEqual(expected.x, actual[0]);
+        checkEqual(expected.y, actual[1]);
+        checkEqual(expected.z, actual[2]);
+    }
+
+    Vector4 makeVector4(const Vector3& v, Real w)
+    {
+        return Vector4(v.x, v.y, v.z, w);
+    }
+
+    Vector3 randomVector3(Real range)
+    {
+        return Vector3(Math::RangeRandom(-range, range),
+            Math::RangeRandom(-range, range), Math::RangeRandom(-range, range));
+    }
+
+    Matrix4 randomAffineMatrix(void)
+    {
+        Matrix4 m;
+        m.makeTransform(randomVector3(10), Vector3(Math::RangeRandom(0.5, 2)),
+            Quaternion(Radian(Math::RangeRandom(0, Math::TWO_PI)), randomVector3(1).normalisedCopy()));
+        return m;
+    }
+}
+
+void OptimisedUtilTests::setUp()
+{
+}
+
+void OptimisedUtilTests::tearDown()
+{
+}
+
+void OptimisedUtilTests::checkAllImplementations(Check check)
+{
+    OptimisedUtil::NamedImplementationList implementations = OptimisedUtil::getAvailableImplementations();
+    for (size_t i = 0; i < implementations.size(); ++i)
+        (this->*check)(implementations[i].second);
+}
+
+void OptimisedUtilTests::testSoftwareVertexSkinning()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkSoftwareVertexSkinning);
+}
+
+void OptimisedUtilTests::checkSoftwareVertexSkinning(OptimisedUtil* util)
+{
+    const size_t numMatrices = 4;
+    Matrix4* matrices = OGRE_ALLOC_T_SIMD(Matrix4, numMatrices, MEMCATEGORY_GENERAL);
+    const Matrix4* matrixPointers[numMatrices];
+    for (size_t i = 0; i < numMatrices; ++i)
+    {
+        matrices[i] = randomAffineMatrix();
+        matrixPointers[i] = &matrices[i];
+    }
+
+    // Positions and normals in separate buffers, two weights per vertex
+    vector<float>::type srcPos(NUM_ELEMENTS * 3), srcNorm(NUM_ELEMENTS * 3);
+    vector<float>::type destPos(NUM_ELEMENTS * 3), destNorm(NUM_ELEMENTS * 3);
+    vector<float>::type weights(NUM_ELEMENTS * 2);
+    vector<unsigned char>::type indices(NUM_ELEMENTS * 2);
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        Vector3 pos = randomVector3(10);
+        Vector3 norm = randomVector3(1).normalisedCopy();
+        memcpy(&srcPos[i * 3], pos.ptr(), sizeof(float) * 3);
+        memcpy(&srcNorm[i * 3], norm.ptr(), sizeof(float) * 3);
+        weights[i * 2] = Math::UnitRandom();
+        weights[i * 2 + 1] = 1 - weights[i * 2];
+        indices[i * 2] = static_cast<unsigned char>(i % numMatrices);
+        indices[i * 2 + 1] = static_cast<unsigned char>((i / numMatrices) % numMatrices);
+    }
+
+    util->softwareVertexSkinning(
+        &srcPos[0], &destPos[0], &srcNorm[0], &destNorm[0],
+        &weights[0], &indices[0], matrixPointers,
+        sizeof(float) * 3, sizeof(float) * 3, sizeof(float) * 3, sizeof(float) * 3,
+        sizeof(float) * 2, 2, 2, NUM_ELEMENTS);
+
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        Vector3 pos(&srcPos[i * 3]), norm(&srcNorm[i * 3]);
+        Vector3 expectedPos = Vector3::ZERO, expectedNorm = Vector3::ZERO;
+        for (size_t w = 0; w < 2; ++w)
+        {
+            const Matrix4& m = matrices[indices[i * 2 + w]];
+            Matrix3 m3;
+            m.extract3x3Matrix(m3);
+            expectedPos += m.transformAffine(pos) * weights[i * 2 + w];
+            expectedNorm += (m3 * norm) * weights[i * 2 + w];
+        }
+        expectedNorm.normalise();
+
+        checkEqual(expectedPos, &destPos[i * 3]);
+        checkEqual(expectedNorm, &destNorm[i * 3]);
+    }
+
+    // Positions only, which implementations may skin differently
+    vector<float>::type destPosOnly(NUM_ELEMENTS * 3);
+    util->softwareVertexSkinning(
+        &srcPos[0], &destPosOnly[0], 0, 0,
+        &weights[0], &indices[0], matrixPointers,
+        sizeof(float) * 3, sizeof(float) * 3, 0, 0,
+        sizeof(float) * 2, 2, 2, NUM_ELEMENTS);
+    for (size_t i = 0; i < NUM_ELEMENTS * 3; ++i)
+        checkEqual(destPos[i], destPosOnly[i]);
+
+    OGRE_FREE_SIMD(matrices, MEMCATEGORY_GENERAL);
+}
+
+void OptimisedUtilTests::testSoftwareVertexMorph()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkSoftwareVertexMorph);
+}
+
+void OptimisedUtilTests::checkSoftwareVertexMorph(OptimisedUtil* util)
+{
+    // Packed positions, packed positions and normals, and padded positions
+    const size_t layouts[3][2] = { { 3, 0 }, { 6, 1 }, { 4, 0 } };
+    for (size_t layout = 0; layout < 3; ++layout)
+    {
+        size_t vertexFloats = layouts[layout][0];
+        bool morphNormals = layouts[layout][1] != 0;
+
+        vector<float>::type src1(NUM_ELEMENTS * vertexFloats), src2(NUM_ELEMENTS * vertexFloats);
+        vector<float>::type dst(NUM_ELEMENTS * vertexFloats);
+        for (size_t i = 0; i < NUM_ELEMENTS * vertexFloats; ++i)
+        {
+            src1[i] = Math::RangeRandom(-10, 10);
+            src2[i] = Math::RangeRandom(-10, 10);
+        }
+
+        const Real t = 0.3f;
+        size_t vertexSize = vertexFloats * sizeof(float);
+        util->softwareVertexMorph(t, &src1[0], &src2[0], &dst[0],
+            vertexSize, vertexSize, vertexSize, NUM_ELEMENTS, morphNormals);
+
+        for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+        {
+            size_t offset = i * vertexFloats;
+            Vector3 a(&src1[offset]), b(&src2[offset]);
+            checkEqual(a + (b - a) * t, &dst[offset]);
+
+            if (morphNormals)
+            {
+                Vector3 na(&src1[offset + 3]), nb(&src2[offset + 3]);
+                checkEqual((na + (nb - na) * t).normalisedCopy(), &dst[offset + 3]);
+            }
+        }
+    }
+}
+
+void OptimisedUtilTests::testSoftwareVertexMorphMixedLayouts()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkSoftwareVertexMorphMixedLayouts);
+}
+
+void OptimisedUtilTests::checkSoftwareVertexMorphMixedLayouts(OptimisedUtil* util)
+{
+    // Padded source, packed source and a destination with two spare floats
+    const size_t src1Floats = 4, src2Floats = 3, dstFloats = 5;
+    vector<float>::type src1(NUM_ELEMENTS * src1Floats), src2(NUM_ELEMENTS * src2Floats);
+    vector<float>::type dst(NUM_ELEMENTS * dstFloats, 0.0f);
+    for (size_t i = 0; i < src1.size(); ++i)
+        src1[i] = Math::RangeRandom(-10, 10);
+    for (size_t i = 0; i < src2.size(); ++i)
+        src2[i] = Math::RangeRandom(-10, 10);
+
+    const Real t = 0.7f;
+    util->softwareVertexMorph(t, &src1[0], &src2[0], &dst[0],
+        src1Floats * sizeof(float), src2Floats * sizeof(float), dstFloats * sizeof(float),
+        NUM_ELEMENTS, false);
+
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        Vector3 a(&src1[i * src1Floats]), b(&src2[i * src2Floats]);
+        checkEqual(a + (b - a) * t, &dst[i * dstFloats]);
+        // The spare floats are left alone
+        CPPUNIT_ASSERT_EQUAL(0.0f, dst[i * dstFloats + 3]);
+        CPPUNIT_ASSERT_EQUAL(0.0f, dst[i * dstFloats + 4]);
+    }
+}
+
+void OptimisedUtilTests::testSoftwareVertexMorphNormalAlongZ()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkSoftwareVertexMorphNormalAlongZ);
+}
+
+void OptimisedUtilTests::checkSoftwareVertexMorphNormalAlongZ(OptimisedUtil* util)
+{
+    // Unit normals that only have a z component stay unit length
+    vector<float>::type src1(NUM_ELEMENTS * 6), src2(NUM_ELEMENTS * 6), dst(NUM_ELEMENTS * 6);
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        for (size_t c = 0; c < 3; ++c)
+        {
+            src1[i * 6 + c] = Math::RangeRandom(-10, 10);
+            src2[i * 6 + c] = Math::RangeRandom(-10, 10);
+            src1[i * 6 + 3 + c] = src2[i * 6 + 3 + c] = c == 2 ? 1.0f : 0.0f;
+        }
+    }
+
+    util->softwareVertexMorph(0.5f, &src1[0], &src2[0], &dst[0],
+        6 * sizeof(float), 6 * sizeof(float), 6 * sizeof(float), NUM_ELEMENTS, true);
+
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+        checkEqual(Vector3::UNIT_Z, &dst[i * 6 + 3]);
+}
+
+void OptimisedUtilTests::testConcatenateAffineMatrices()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkConcatenateAffineMatrices);
+}
+
+void OptimisedUtilTests::checkConcatenateAffineMatrices(OptimisedUtil* util)
+{
+    Matrix4* matrices = OGRE_ALLOC_T_SIMD(Matrix4, NUM_ELEMENTS * 2, MEMCATEGORY_GENERAL);
+    Matrix4* srcMatrices = matrices;
+    Matrix4* dstMatrices = matrices + NUM_ELEMENTS;
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+        srcMatrices[i] = randomAffineMatrix();
+
+    Matrix4 base = randomAffineMatrix();
+    util->concatenateAffineMatrices(
+        base, srcMatrices, dstMatrices, NUM_ELEMENTS);
+
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        Matrix4 expected = base.concatenateAffine(srcMatrices[i]);
+        for (size_t r = 0; r < 4; ++r)
+        {
+            for (size_t c = 0; c < 4; ++c)
+                checkEqual(expected[r][c], dstMatrices[i][r][c]);
+        }
+    }
+
+    OGRE_FREE_SIMD(matrices, MEMCATEGORY_GENERAL);
+}
+
+void OptimisedUtilTests::testCalculateFaceNormals()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkCalculateFaceNormals);
+}
+
+void OptimisedUtilTests::checkCalculateFaceNormals(OptimisedUtil* util)
+{
+    const size_t numVertices = 20;
+    vector<float>::type positions(numVertices * 3);
+    for (size_t i = 0; i < numVertices * 3; ++i)
+        positions[i] = Math::RangeRandom(-10, 10);
+
+    vector<EdgeData::Triangle>::type triangles(NUM_ELEMENTS);
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        for (size_t v = 0; v < 3; ++v)
+            triangles[i].vertIndex[v] = (i * 7 + v * 3) % numVertices;
+    }
+
+    Vector4* faceNormals = OGRE_ALLOC_T_SIMD(Vector4, NUM_ELEMENTS, MEMCATEGORY_GENERAL);
+    util->calculateFaceNormals(
+        &positions[0], &triangles[0], faceNormals, NUM_ELEMENTS);
+
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        const EdgeData::Triangle& t = triangles[i];
+        Vector4 expected = Math::calculateFaceNormalWithoutNormalize(
+            Vector3(&positions[t.vertIndex[0] * 3]),
+            Vector3(&positions[t.vertIndex[1] * 3]),
+            Vector3(&positions[t.vertIndex[2] * 3]));
+        for (size_t c = 0; c < 4; ++c)
+            checkEqual(expected[c], faceNormals[i][c]);
+    }
+
+    OGRE_FREE_SIMD(faceNormals, MEMCATEGORY_GENERAL);
+}
+
+void OptimisedUtilTests::testCalculateLightFacing()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkCalculateLightFacing);
+}
+
+void OptimisedUtilTests::checkCalculateLightFacing(OptimisedUtil* util)
+{
+    Vector4* faceNormals = OGRE_ALLOC_T_SIMD(Vector4, NUM_ELEMENTS, MEMCATEGORY_GENERAL);
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+        faceNormals[i] = makeVector4(randomVector3(1).normalisedCopy(), Math::RangeRandom(-10, 10));
+
+    // Point and directional lights
+    for (int w = 0; w < 2; ++w)
+    {
+        Vector4 lightPos = makeVector4(randomVector3(10), Real(w));
+        vector<char>::type lightFacings(NUM_ELEMENTS);
+        util->calculateLightFacing(
+            lightPos, faceNormals, &lightFacings[0], NUM_ELEMENTS);
+
+        for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+        {
+            Real dp = lightPos.dotProduct(faceNormals[i]);
+            // Too close to call with the rounding of the different implementations
+            if (Math::Abs(dp) > 1e-4f)
+                CPPUNIT_ASSERT_EQUAL(dp > 0, lightFacings[i] != 0);
+        }
+    }
+
+    OGRE_FREE_SIMD(faceNormals, MEMCATEGORY_GENERAL);
+}
+
+void OptimisedUtilTests::testExtrudeVertices()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkExtrudeVertices);
+}
+
+void OptimisedUtilTests::checkExtrudeVertices(OptimisedUtil* util)
+{
+    vector<float>::type srcPos(NUM_ELEMENTS * 3), destPos(NUM_ELEMENTS * 3);
+    for (size_t i = 0; i < NUM_ELEMENTS * 3; ++i)
+        srcPos[i] = Math::RangeRandom(-10, 10);
+
+    const Real extrudeDist = 100;
+    // Point and directional lights
+    for (int w = 0; w < 2; ++w)
+    {
+        Vector4 lightPos = makeVector4(randomVector3(20), Real(w));
+        util->extrudeVertices(
+            lightPos, extrudeDist, &srcPos[0], &destPos[0], NUM_ELEMENTS);
+
+        for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+        {
+            Vector3 pos(&srcPos[i * 3]);
+            Vector3 dir = w ? pos - Vector3(lightPos.ptr()) : -Vector3(lightPos.ptr());
+            checkEqual(pos + dir.normalisedCopy() * extrudeDist, &destPos[i * 3]);
+        }
+    }
+}
+
+void OptimisedUtilTests::testCalculateBoneMatrices()
+{
+    checkAllImplementations(&OptimisedUtilTests::checkCalculateBoneMatrices);
+}
+
+void OptimisedUtilTests::checkCalculateBoneMatrices(OptimisedUtil* util)
+{
+    // Derived and inverse binding pose transforms, ten streams each
+    vector<float>::type streams(NUM_ELEMENTS * 20);
+    TransformStreams derived, inverse;
+    TransformStreams* allStreams[2] = { &derived, &inverse };
+    float* stream = &streams[0];
+    for (size_t s = 0; s < 2; ++s)
+    {
+        for (size_t c = 0; c < 3; ++c, stream += NUM_ELEMENTS)
+            allStreams[s]->position[c] = stream;
+        for (size_t c = 0; c < 4; ++c, stream += NUM_ELEMENTS)
+            allStreams[s]->orientation[c] = stream;
+        for (size_t c = 0; c < 3; ++c, stream += NUM_ELEMENTS)
+            allStreams[s]->scale[c] = stream;
+    }
+
+    vector<Matrix4>::type expected(NUM_ELEMENTS), actual(NUM_ELEMENTS);
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        Vector3 position[2], scale[2];
+        Quaternion orientation[2];
+        for (size_t s = 0; s < 2; ++s)
+        {
+            position[s] = randomVector3(10);
+            scale[s] = Vector3(Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2));
+            orientation[s] = Quaternion(Radian(Math::RangeRandom(0, Math::TWO_PI)), randomVector3(1).normalisedCopy());
+            for (size_t c = 0; c < 3; ++c)
+            {
+                allStreams[s]->position[c][i] = position[s][c];
+                allStreams[s]->scale[c][i] = scale[s][c];
+            }
+            for (size_t c = 0; c < 4; ++c)
+                allStreams[s]->orientation[c][i] = orientation[s][c];
+        }
+
+        // As Bone::_getOffsetTransform
+        Vector3 locScale = scale[0] * scale[1];
+        Quaternion locRotate = orientation[0] * orientation[1];
+        expected[i].makeTransform(position[0] + locRotate * (locScale * position[1]), locScale, locRotate);
+    }
+
+    util->calculateBoneMatrices(derived, inverse, &actual[0], NUM_ELEMENTS);
+
+    for (size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+        for (size_t r = 0; r < 4; ++r)
+        {
+            for (size_t c = 0; c < 4; ++c)
+                checkEqual(expected[i][r][c], actual[i][r][c]);
+        }
+    }
+}
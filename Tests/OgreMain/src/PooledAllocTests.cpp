@@ -0,0 +1,101 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "PooledAllocTests.h"
+#include "OgrePrerequisites.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( PooledAllocTests );
+
+using namespace Ogre;
+
+namespace {
+    typedef PooledAllocPolicy<MEMCATEGORY_GENERAL, 256> TestPolicy;
+
+    class PooledObject : public AllocatedObject<TestPolicy>
+    {
+    public:
+        char data[100];
+    };
+}
+
+void PooledAllocTests::testSlotReuse()
+{
+    FixedSizePoolSet& pools = TestPolicy::getPools();
+    size_t inUse = pools.getNumSlotsInUse();
+
+    PooledObject* objects[10];
+    for (size_t i = 0; i < 10; ++i)
+    {
+        objects[i] = OGRE_NEW PooledObject();
+        CPPUNIT_ASSERT(FixedSizePoolSet::isPooled(objects[i]));
+        CPPUNIT_ASSERT_EQUAL((size_t)0, reinterpret_cast<size_t>(objects[i]) % 16);
+    }
+    CPPUNIT_ASSERT_EQUAL(inUse + 10, pools.getNumSlotsInUse());
+    // Objects of one size are packed together
+    for (size_t i = 1; i < 10; ++i)
+    {
+        CPPUNIT_ASSERT(std::abs(reinterpret_cast<char*>(objects[i]) - reinterpret_cast<char*>(objects[i - 1])) < 16 * 1024);
+    }
+
+    PooledObject* freed = objects[3];
+    OGRE_DELETE objects[3];
+    objects[3] = OGRE_NEW PooledObject();
+    CPPUNIT_ASSERT_EQUAL(freed, objects[3]);
+
+    size_t slots = pools.getNumSlots();
+    for (size_t i = 0; i < 10; ++i)
+        OGRE_DELETE objects[i];
+    CPPUNIT_ASSERT_EQUAL(inUse, pools.getNumSlotsInUse());
+    CPPUNIT_ASSERT_EQUAL(slots, pools.getNumSlots());
+}
+
+void PooledAllocTests::testLargeAllocations()
+{
+    FixedSizePoolSet& pools = TestPolicy::getPools();
+    size_t inUse = pools.getNumSlotsInUse();
+
+    void* large = TestPolicy::allocateBytes(1000);
+    void* small = TestPolicy::allocateBytes(256);
+    CPPUNIT_ASSERT(!FixedSizePoolSet::isPooled(large));
+    CPPUNIT_ASSERT(FixedSizePoolSet::isPooled(small));
+    CPPUNIT_ASSERT_EQUAL(inUse + 1, pools.getNumSlotsInUse());
+    memset(large, 0, 1000);
+    memset(small, 0, 256);
+
+    // Arrays go through the policy too
+    PooledObject* array = OGRE_NEW PooledObject[20];
+    CPPUNIT_ASSERT_EQUAL(inUse + 1, pools.getNumSlotsInUse());
+    OGRE_DELETE [] array;
+    PooledObject* pair = OGRE_NEW PooledObject[2];
+    CPPUNIT_ASSERT_EQUAL(inUse + 2, pools.getNumSlotsInUse());
+    OGRE_DELETE [] pair;
+
+    TestPolicy::deallocateBytes(large);
+    TestPolicy::deallocateBytes(small);
+    CPPUNIT_ASSERT_EQUAL(inUse, pools.getNumSlotsInUse());
+}
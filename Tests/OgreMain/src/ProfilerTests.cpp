@@ -0,0 +1,185 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ProfilerTests.h"
+#include "OgreProfiler.h"
+#include "OgreTimer.h"
+#include "OgreStringConverter.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ProfilerTests );
+
+using namespace Ogre;
+
+namespace {
+    String exportTrace(Profiler* profiler)
+    {
+        StringUtil::StrStreamType stream;
+        profiler->exportTrace(stream);
+        return stream.str();
+    }
+
+    bool contains(const String& str, const String& sub)
+    {
+        return str.find(sub) != String::npos;
+    }
+
+#if OGRE_THREAD_SUPPORT
+    struct NamedThreadProfile
+    {
+        Profiler* profiler;
+        void operator()()
+        {
+            profiler->setTraceThreadName("Test worker");
+            profiler->beginProfile("Worker profile");
+            profiler->endProfile("Worker profile");
+        }
+    };
+#endif
+}
+
+void ProfilerTests::setUp()
+{
+    mTimer = OGRE_NEW Timer();
+    mProfiler = OGRE_NEW Profiler();
+    mProfiler->setTimer(mTimer);
+}
+
+void ProfilerTests::tearDown()
+{
+    OGRE_DELETE mProfiler;
+    OGRE_DELETE mTimer;
+}
+
+void ProfilerTests::testTraceExport()
+{
+    mProfiler->beginTraceCapture();
+    mProfiler->beginProfile("Outer");
+    mProfiler->beginProfile("Inner \"quoted\"", OGREPROF_CULLING);
+    mProfiler->endProfile("Inner \"quoted\"", OGREPROF_CULLING);
+    mProfiler->endProfile("Outer");
+    mProfiler->endTraceCapture();
+
+    String trace = exportTrace(mProfiler);
+    CPPUNIT_ASSERT(contains(trace, "\"traceEvents\":["));
+    CPPUNIT_ASSERT(contains(trace, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Main\"}}"));
+    CPPUNIT_ASSERT(contains(trace, "{\"name\":\"Outer\",\"cat\":\"user\",\"ph\":\"X\""));
+    CPPUNIT_ASSERT(contains(trace, "{\"name\":\"Inner \\\"quoted\\\"\",\"cat\":\"culling\",\"ph\":\"X\""));
+    // The inner profile completes first
+    CPPUNIT_ASSERT(trace.find("Inner") < trace.find("Outer"));
+}
+
+void ProfilerTests::testTraceRingBuffer()
+{
+    mProfiler->setTraceBufferSize(4);
+    mProfiler->beginTraceCapture();
+    for (int i = 0; i < 10; ++i)
+    {
+        String name = "Profile " + StringConverter::toString(i);
+        mProfiler->beginProfile(name);
+        mProfiler->endProfile(name);
+    }
+    mProfiler->endTraceCapture();
+
+    String trace = exportTrace(mProfiler);
+    CPPUNIT_ASSERT(!contains(trace, "\"Profile 5\""));
+    for (int i = 6; i < 10; ++i)
+        CPPUNIT_ASSERT(contains(trace, "\"Profile " + StringConverter::toString(i) + "\""));
+    CPPUNIT_ASSERT(trace.find("Profile 6") < trace.find("Profile 9"));
+
+    // A new capture discards the previous one
+    mProfiler->beginTraceCapture();
+    mProfiler->endTraceCapture();
+    CPPUNIT_ASSERT(!contains(exportTrace(mProfiler), "Profile"));
+}
+
+void ProfilerTests::testTraceGroupMask()
+{
+    mProfiler->setProfileGroupMask(OGREPROF_ALL);
+    mProfiler->beginTraceCapture();
+    mProfiler->beginProfile("User");
+    mProfiler->beginProfile("Culling", OGREPROF_CULLING);
+    mProfiler->endProfile("Culling", OGREPROF_CULLING);
+    mProfiler->endProfile("User");
+    mProfiler->endTraceCapture();
+
+    String trace = exportTrace(mProfiler);
+    CPPUNIT_ASSERT(contains(trace, "\"Culling\""));
+    CPPUNIT_ASSERT(!contains(trace, "\"User\""));
+}
+
+void ProfilerTests::testTraceThreads()
+{
+#if OGRE_THREAD_SUPPORT
+    mProfiler->beginTraceCapture();
+    mProfiler->beginProfile("Main profile");
+
+    NamedThreadProfile worker;
+    worker.profiler = mProfiler;
+    OGRE_THREAD_CREATE(thread, worker);
+    thread->join();
+    OGRE_THREAD_DESTROY(thread);
+
+    mProfiler->endProfile("Main profile");
+    mProfiler->endTraceCapture();
+
+    String trace = exportTrace(mProfiler);
+    CPPUNIT_ASSERT(contains(trace, "\"tid\":1,\"args\":{\"name\":\"Test worker\"}"));
+    CPPUNIT_ASSERT(contains(trace, "{\"name\":\"Worker profile\",\"cat\":\"user\",\"ph\":\"X\""));
+    CPPUNIT_ASSERT(contains(trace, "{\"name\":\"Main profile\",\"cat\":\"user\",\"ph\":\"X\""));
+#endif
+}
+
+void ProfilerTests::testTraceScopeCache()
+{
+    uint32 outerScope = 0, innerScope = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        mProfiler->beginTraceCapture();
+        mProfiler->beginProfile("Cached outer", OGREPROF_USER_DEFAULT, &outerScope);
+        mProfiler->beginProfile("Cached inner", OGREPROF_USER_DEFAULT, &innerScope);
+        mProfiler->endProfile("Cached inner");
+        mProfiler->endProfile("Cached outer");
+        mProfiler->endTraceCapture();
+
+        CPPUNIT_ASSERT(outerScope != 0 && innerScope != 0 && outerScope != innerScope);
+        String trace = exportTrace(mProfiler);
+        CPPUNIT_ASSERT(contains(trace, "{\"name\":\"Cached outer\",\"cat\":\"user\",\"ph\":\"X\""));
+        CPPUNIT_ASSERT(contains(trace, "{\"name\":\"Cached inner\",\"cat\":\"user\",\"ph\":\"X\""));
+
+        // The second pass uses the same caches with a new profiler
+        tearDown();
+        setUp();
+    }
+
+    // Uncached lookups of the same name share the identifier
+    mProfiler->beginTraceCapture();
+    mProfiler->beginProfile("Cached inner");
+    mProfiler->endProfile("Cached inner");
+    mProfiler->endTraceCapture();
+    CPPUNIT_ASSERT(contains(exportTrace(mProfiler), "\"Cached inner\""));
+}
@@ -61,6 +61,15 @@ public:
 
 };
 
+class UInt64SortFunctor
+{
+public:
+	uint64 operator()(const std::pair<uint64, int>& p) const
+	{
+		return p.first;
+	}
+
+};
 class UnsignedIntSortFunctor
 {
 public:
@@ -202,3 +211,32 @@ void RadixSortTests::testIntVector()
 }
 
 
+void RadixSortTests::testUInt64Vector()
+{
+	typedef std::vector<std::pair<uint64, int> > Container;
+	Container container;
+	UInt64SortFunctor func;
+	RadixSort<Container, std::pair<uint64, int>, uint64> sorter;
+
+	// Few distinct values in the upper word, so some passes are skipped
+	// and equal keys are common
+	for (int i = 0; i < 1000; ++i)
+	{
+		uint64 upper = (uint64)Math::RangeRandom(0, 16) << 48;
+		uint64 lower = (uint64)Math::RangeRandom(0, 64);
+		container.push_back(std::make_pair(upper | lower, i));
+	}
+
+	sorter.sort(container, func);
+
+	Container::iterator v = container.begin();
+	std::pair<uint64, int> lastValue = *v++;
+	for (;v != container.end(); ++v)
+	{
+		CPPUNIT_ASSERT(v->first >= lastValue.first);
+		// The sort is stable
+		if (v->first == lastValue.first)
+			CPPUNIT_ASSERT(v->second > lastValue.second);
+		lastValue = *v;
+	}
+}
@@ -0,0 +1,213 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "RenderQueueSortingTests.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreRenderable.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( RenderQueueSortingTests );
+
+using namespace Ogre;
+
+namespace {
+    /// Renderable which is only ever sorted
+    class DepthRenderable : public Renderable
+    {
+    public:
+        Real depth;
+
+        DepthRenderable(Real d) : depth(d) {}
+
+        const MaterialPtr& getMaterial(void) const { return mMaterial; }
+        void getRenderOperation(RenderOperation& op) {}
+        void getWorldTransforms(Matrix4* xform) const { *xform = Matrix4::IDENTITY; }
+        Real getSquaredViewDepth(const Camera* cam) const { return depth; }
+        const LightList& getLights(void) const { return mLights; }
+
+    protected:
+        MaterialPtr mMaterial;
+        LightList mLights;
+    };
+
+    /// Records the order in which a collection is visited
+    class RecordingVisitor : public QueuedRenderableVisitor
+    {
+    public:
+        const Pass* skippedPass;
+        vector<const Pass*>::type passes;
+        vector<RenderablePass>::type items;
+
+        RecordingVisitor() : skippedPass(0) {}
+
+        void visit(RenderablePass* rp)
+        {
+            items.push_back(*rp);
+        }
+        bool visit(const Pass* p)
+        {
+            passes.push_back(p);
+            return p != skippedPass;
+        }
+        void visit(Renderable* r)
+        {
+            items.push_back(RenderablePass(r, const_cast<Pass*>(passes.back())));
+        }
+    };
+}
+
+void RenderQueueSortingTests::setUp()
+{
+    // Pass hashes are built from the pass index
+    for (unsigned short i = 0; i < 3; ++i)
+        mPasses[i] = OGRE_NEW Pass(0, i);
+}
+
+void RenderQueueSortingTests::tearDown()
+{
+    for (int i = 0; i < 3; ++i)
+        OGRE_DELETE mPasses[i];
+}
+
+void RenderQueueSortingTests::testSortKeyGrouping()
+{
+    DepthRenderable far(100), middle(10), near(1);
+
+    QueuedRenderableCollection collection;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_KEY);
+    collection.addRenderable(mPasses[2], &far);
+    collection.addRenderable(mPasses[0], &far);
+    collection.addRenderable(mPasses[0], &near);
+    collection.addRenderable(mPasses[2], &middle);
+    collection.addRenderable(mPasses[0], &middle);
+    collection.sort(0);
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_SORT_KEY);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)2, visitor.passes.size());
+    CPPUNIT_ASSERT(visitor.passes[0] == mPasses[0]);
+    CPPUNIT_ASSERT(visitor.passes[1] == mPasses[2]);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)5, visitor.items.size());
+    CPPUNIT_ASSERT(visitor.items[0].renderable == &near);
+    CPPUNIT_ASSERT(visitor.items[1].renderable == &middle);
+    CPPUNIT_ASSERT(visitor.items[2].renderable == &far);
+    CPPUNIT_ASSERT(visitor.items[3].renderable == &middle);
+    CPPUNIT_ASSERT(visitor.items[4].renderable == &far);
+
+    // Renderables of a skipped pass are not visited
+    RecordingVisitor skipping;
+    skipping.skippedPass = mPasses[0];
+    collection.acceptVisitor(&skipping, QueuedRenderableCollection::OM_SORT_KEY);
+    CPPUNIT_ASSERT_EQUAL((size_t)2, skipping.passes.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)2, skipping.items.size());
+    CPPUNIT_ASSERT(skipping.items[0].pass == mPasses[2]);
+
+    // Clearing empties the list but the collection can be filled again
+    collection.clear();
+    RecordingVisitor empty;
+    collection.acceptVisitor(&empty, QueuedRenderableCollection::OM_SORT_KEY);
+    CPPUNIT_ASSERT(empty.passes.empty());
+}
+
+void RenderQueueSortingTests::testSortKeyFallback()
+{
+    // Enough items to take the radix sort path
+    vector<DepthRenderable*>::type rends;
+    QueuedRenderableCollection collection;
+    collection.addOrganisationMode(QueuedRenderableCollection::OM_SORT_KEY);
+    for (int i = 0; i < 300; ++i)
+    {
+        rends.push_back(OGRE_NEW_T(DepthRenderable, MEMCATEGORY_GENERAL)(
+            Math::RangeRandom(0, 1000)));
+        collection.addRenderable(mPasses[i % 3], rends.back());
+    }
+    collection.sort(0);
+
+    RecordingVisitor visitor;
+    collection.acceptVisitor(&visitor, QueuedRenderableCollection::OM_PASS_GROUP);
+
+    CPPUNIT_ASSERT_EQUAL((size_t)3, visitor.passes.size());
+    CPPUNIT_ASSERT_EQUAL((size_t)300, visitor.items.size());
+    for (size_t i = 1; i < visitor.items.size(); ++i)
+    {
+        const RenderablePass& prev = visitor.items[i - 1];
+        const RenderablePass& cur = visitor.items[i];
+        if (prev.pass == cur.pass)
+            CPPUNIT_ASSERT(prev.renderable->getSquaredViewDepth(0) <= cur.renderable->getSquaredViewDepth(0));
+        else
+            CPPUNIT_ASSERT(prev.pass->getHash() < cur.pass->getHash());
+    }
+
+    for (size_t i = 0; i < rends.size(); ++i)
+        OGRE_DELETE_T(rends[i], DepthRenderable, MEMCATEGORY_GENERAL);
+}
+
+void RenderQueueSortingTests::testRadixSortDescending()
+{
+    // Quantised depths so some items tie and are ordered by pass
+    vector<DepthRenderable*>::type rends;
+    QueuedRenderableCollection small, large;
+    small.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    large.addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    for (int i = 0; i < 3000; ++i)
+    {
+        rends.push_back(OGRE_NEW_T(DepthRenderable, MEMCATEGORY_GENERAL)(
+            Math::Floor(Math::RangeRandom(0, 500))));
+        large.addRenderable(mPasses[i % 3], rends.back());
+    }
+    // Below the radix sort threshold, so sorted by comparison
+    for (int i = 0; i < 1500; ++i)
+        small.addRenderable(mPasses[i % 3], rends[i]);
+    large.sort(0);
+    small.sort(0);
+
+    RecordingVisitor visitor;
+    large.acceptVisitor(&visitor, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    CPPUNIT_ASSERT_EQUAL((size_t)3000, visitor.items.size());
+    for (size_t i = 1; i < visitor.items.size(); ++i)
+    {
+        Real prevDepth = visitor.items[i - 1].renderable->getSquaredViewDepth(0);
+        Real depth = visitor.items[i].renderable->getSquaredViewDepth(0);
+        CPPUNIT_ASSERT(prevDepth >= depth);
+        if (prevDepth == depth)
+            CPPUNIT_ASSERT(visitor.items[i - 1].pass->getHash() <= visitor.items[i].pass->getHash());
+    }
+
+    RecordingVisitor smallVisitor;
+    small.acceptVisitor(&smallVisitor, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    CPPUNIT_ASSERT_EQUAL((size_t)1500, smallVisitor.items.size());
+    for (size_t i = 1; i < smallVisitor.items.size(); ++i)
+    {
+        CPPUNIT_ASSERT(smallVisitor.items[i - 1].renderable->getSquaredViewDepth(0) >=
+            smallVisitor.items[i].renderable->getSquaredViewDepth(0));
+    }
+
+    for (size_t i = 0; i < rends.size(); ++i)
+        OGRE_DELETE_T(rends[i], DepthRenderable, MEMCATEGORY_GENERAL);
+}
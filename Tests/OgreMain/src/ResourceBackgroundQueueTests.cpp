@@ -0,0 +1,206 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ResourceBackgroundQueueTests.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreResourceManager.h"
+#include "OgreRoot.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( ResourceBackgroundQueueTests );
+
+using namespace Ogre;
+
+namespace {
+    // Closed while the gate resource holds up the worker thread
+    AtomicScalar<bool> gateOpen(true);
+    OGRE_STATIC_MUTEX(preparedMutex)
+    // Names of the resources in the order they were prepared
+    StringVector prepared;
+
+    class OrderedResource : public Resource
+    {
+    public:
+        OrderedResource(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group)
+            : Resource(creator, name, handle, group) {}
+    protected:
+        void prepareImpl(void)
+        {
+            if (mName == "Gate")
+            {
+                while (!gateOpen.get())
+                    OGRE_THREAD_SLEEP(1);
+            }
+            OGRE_LOCK_MUTEX(preparedMutex)
+            prepared.push_back(mName);
+        }
+        void loadImpl(void) {}
+        void unloadImpl(void) {}
+        size_t calculateSize(void) const { return 100; }
+    };
+
+    class OrderedResourceManager : public ResourceManager
+    {
+    public:
+        OrderedResourceManager() { mResourceType = "Ordered"; }
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, 
+            const String& group, bool isManual, ManualResourceLoader* loader, 
+            const NameValuePairList* createParams)
+        {
+            return OGRE_NEW OrderedResource(this, name, handle, group);
+        }
+    };
+}
+
+void ResourceBackgroundQueueTests::setUp()
+{
+    mRoot = OGRE_NEW Root("");
+
+    DefaultWorkQueue* queue = static_cast<DefaultWorkQueue*>(mRoot->getWorkQueue());
+    queue->setWorkerThreadCount(2);
+    queue->setWorkersCanAccessRenderSystem(false);
+    queue->startup();
+    ResourceBackgroundQueue::getSingleton().initialise();
+
+    mManager = OGRE_NEW OrderedResourceManager();
+    ResourceGroupManager::getSingleton()._registerResourceManager("Ordered", mManager);
+    prepared.clear();
+    gateOpen = true;
+}
+
+void ResourceBackgroundQueueTests::tearDown()
+{
+    ResourceBackgroundQueue::getSingleton().shutdown();
+    ResourceGroupManager::getSingleton()._unregisterResourceManager("Ordered");
+    OGRE_DELETE mManager;
+    OGRE_DELETE mRoot;
+}
+
+void ResourceBackgroundQueueTests::waitFor(BackgroundProcessTicket ticket)
+{
+    ResourceBackgroundQueue& rbq = ResourceBackgroundQueue::getSingleton();
+    for (int i = 0; i < 5000 && !rbq.isProcessComplete(ticket); ++i)
+    {
+        mRoot->getWorkQueue()->processResponses();
+        rbq._processPendingLoads();
+        OGRE_THREAD_SLEEP(1);
+    }
+    CPPUNIT_ASSERT(rbq.isProcessComplete(ticket));
+}
+
+void ResourceBackgroundQueueTests::testPriorityOrder()
+{
+    ResourceBackgroundQueue& rbq = ResourceBackgroundQueue::getSingleton();
+    rbq.setMaxActiveRequests(1);
+
+    // Hold up the only active request while the others are queued
+    gateOpen = false;
+    rbq.prepare("Ordered", "Gate", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    BackgroundProcessTicket low = rbq.prepare("Ordered", "Low",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 1);
+    rbq.prepare("Ordered", "High", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 9);
+    rbq.prepare("Ordered", "Middle", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 5);
+    rbq.prepare("Ordered", "High2", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 9);
+    CPPUNIT_ASSERT_EQUAL(BPS_QUEUED, rbq.getProcessState(low));
+    gateOpen = true;
+
+    waitFor(low);
+    CPPUNIT_ASSERT_EQUAL(BPS_COMPLETE, rbq.getProcessState(low));
+    const char* expected[] = { "Gate", "High", "High2", "Middle", "Low" };
+    CPPUNIT_ASSERT_EQUAL((size_t)5, prepared.size());
+    for (size_t i = 0; i < prepared.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL(String(expected[i]), prepared[i]);
+}
+
+void ResourceBackgroundQueueTests::testAbortAndReprioritise()
+{
+    ResourceBackgroundQueue& rbq = ResourceBackgroundQueue::getSingleton();
+    rbq.setMaxActiveRequests(1);
+
+    gateOpen = false;
+    rbq.prepare("Ordered", "Gate", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 9);
+    BackgroundProcessTicket first = rbq.prepare("Ordered", "First", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    BackgroundProcessTicket aborted = rbq.prepare("Ordered", "Aborted", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    BackgroundProcessTicket last = rbq.prepare("Ordered", "Last", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    BackgroundProcessTicket dropped = rbq.prepare("Ordered", "Dropped", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    rbq.abortRequest(aborted);
+    CPPUNIT_ASSERT(rbq.isProcessComplete(aborted));
+    CPPUNIT_ASSERT(rbq.setRequestPriority(last, 3));
+    CPPUNIT_ASSERT(rbq.setRequestPriority(first, 5));
+    rbq.abortRequestsBelowPriority(1);
+    CPPUNIT_ASSERT(rbq.isProcessComplete(dropped));
+    CPPUNIT_ASSERT(!rbq.isProcessComplete(first));
+    gateOpen = true;
+
+    waitFor(last);
+    CPPUNIT_ASSERT_EQUAL((size_t)3, prepared.size());
+    CPPUNIT_ASSERT_EQUAL(String("Gate"), prepared[0]);
+    CPPUNIT_ASSERT_EQUAL(String("First"), prepared[1]);
+    CPPUNIT_ASSERT_EQUAL(String("Last"), prepared[2]);
+    CPPUNIT_ASSERT(!rbq.setRequestPriority(last, 0));
+}
+
+void ResourceBackgroundQueueTests::testLoadSizeBudget()
+{
+#if OGRE_THREAD_SUPPORT == 2
+    ResourceBackgroundQueue& rbq = ResourceBackgroundQueue::getSingleton();
+    // One resource per frame
+    rbq.setLoadSizeBudget(1);
+
+    BackgroundProcessTicket low = rbq.load("Ordered", "Low",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 1);
+    BackgroundProcessTicket high = rbq.load("Ordered", "High",
+        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, false, 0, 0, 0, 2);
+
+    // Wait for both to be prepared without running the load steps
+    for (int i = 0; i < 5000; ++i)
+    {
+        mRoot->getWorkQueue()->processResponses();
+        if (rbq.getProcessState(low) == BPS_WAITING_FOR_LOAD &&
+            rbq.getProcessState(high) == BPS_WAITING_FOR_LOAD)
+            break;
+        OGRE_THREAD_SLEEP(1);
+    }
+    CPPUNIT_ASSERT_EQUAL(BPS_WAITING_FOR_LOAD, rbq.getProcessState(low));
+    CPPUNIT_ASSERT_EQUAL(BPS_WAITING_FOR_LOAD, rbq.getProcessState(high));
+    CPPUNIT_ASSERT(!mManager->getByName("Low")->isLoaded());
+
+    rbq._processPendingLoads();
+    CPPUNIT_ASSERT_EQUAL(BPS_COMPLETE, rbq.getProcessState(high));
+    CPPUNIT_ASSERT(mManager->getByName("High")->isLoaded());
+    CPPUNIT_ASSERT_EQUAL(BPS_WAITING_FOR_LOAD, rbq.getProcessState(low));
+    CPPUNIT_ASSERT(!mManager->getByName("Low")->isLoaded());
+
+    rbq._processPendingLoads();
+    CPPUNIT_ASSERT_EQUAL(BPS_COMPLETE, rbq.getProcessState(low));
+    CPPUNIT_ASSERT(mManager->getByName("Low")->isLoaded());
+#endif
+}
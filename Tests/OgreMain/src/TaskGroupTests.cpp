@@ -0,0 +1,444 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "TaskGroupTests.h"
+#include "OgreTaskGroup.h"
+#include "OgreRoot.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+#include "OgreSceneManager.h"
+#include "OgreMath.h"
+#include "OgreMovableObject.h"
+#include "OgreResourceManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreScriptCompiler.h"
+#include "OgreMaterialManager.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( TaskGroupTests );
+
+using namespace Ogre;
+
+namespace {
+    class CountingTask : public TaskGroup::Task
+    {
+    public:
+        size_t count;
+        CountingTask() : count(0) {}
+        void execute(void)
+        {
+            // Enough work for the tasks to overlap between threads
+            Real sum = 0;
+            for (int i = 0; i < 1000; ++i)
+                sum += Math::Sqrt(Real(i));
+            if (sum > 0)
+                ++count;
+        }
+    };
+
+    // Object recording the order in which it is queued for rendering
+    class QueuedOrderObject : public MovableObject
+    {
+    public:
+        vector<MovableObject*>::type* queued;
+        AxisAlignedBox box;
+        QueuedOrderObject(vector<MovableObject*>::type* q) : queued(q), box(-1, -1, -1, 1, 1, 1) {}
+        const String& getMovableType(void) const { static String type = "QueuedOrder"; return type; }
+        const AxisAlignedBox& getBoundingBox(void) const { return box; }
+        Real getBoundingRadius(void) const { return Math::Sqrt(3); }
+        void _updateRenderQueue(RenderQueue* queue) { queued->push_back(this); }
+        void visitRenderables(Renderable::Visitor* visitor, bool debugRenderables) {}
+    };
+
+    // Scene node hiding itself and its descendants from the parallel culling
+    class HiddenSubtreeNode : public SceneNode
+    {
+    public:
+        size_t calls;
+        HiddenSubtreeNode(SceneManager* creator) : SceneNode(creator, "HiddenSubtree"), calls(0) {}
+        void _findVisibleNodes(const CullingPlanes& planes, vector<SceneNode*>::type& visibleNodes,
+            bool boundsVisible)
+        {
+            ++calls;
+        }
+    };
+
+    // Resource counting how often it is prepared and loaded
+    class CountingResource : public Resource
+    {
+    public:
+        AtomicScalar<size_t> prepareCount;
+        size_t loadCount;
+        CountingResource(ResourceManager* creator, const String& name, ResourceHandle handle,
+            const String& group)
+            : Resource(creator, name, handle, group), prepareCount(0), loadCount(0) {}
+    protected:
+        void prepareImpl(void) { ++prepareCount; }
+        void loadImpl(void) { ++loadCount; }
+        void unloadImpl(void) {}
+        size_t calculateSize(void) const { return 0; }
+    };
+
+    class CountingResourceManager : public ResourceManager
+    {
+    public:
+        CountingResourceManager() { mResourceType = "Counting"; }
+    protected:
+        Resource* createImpl(const String& name, ResourceHandle handle, 
+            const String& group, bool isManual, ManualResourceLoader* loader, 
+            const NameValuePairList* createParams)
+        {
+            return OGRE_NEW CountingResource(this, name, handle, group);
+        }
+    };
+
+    // Listener recording the resources in the order their loading was reported
+    class LoadOrderListener : public ResourceGroupListener
+    {
+    public:
+        vector<Resource*>::type loaded;
+        size_t expectedCount;
+        size_t endedCount;
+        LoadOrderListener() : expectedCount(0), endedCount(0) {}
+        void resourceGroupScriptingStarted(const String& groupName, size_t scriptCount) {}
+        void scriptParseStarted(const String& scriptName, bool& skipThisScript) {}
+        void scriptParseEnded(const String& scriptName, bool skipped) {}
+        void resourceGroupScriptingEnded(const String& groupName) {}
+        void resourceGroupLoadStarted(const String& groupName, size_t resourceCount) { expectedCount = resourceCount; }
+        void resourceLoadStarted(const ResourcePtr& resource) { loaded.push_back(resource.get()); }
+        void resourceLoadEnded(void) { ++endedCount; }
+        void worldGeometryStageStarted(const String& description) {}
+        void worldGeometryStageEnded(void) {}
+        void resourceGroupLoadEnded(const String& groupName) {}
+    };
+}
+
+void TaskGroupTests::setUp()
+{
+    mFixture.setUp();
+    mRoot = mFixture.getRoot();
+
+    DefaultWorkQueue* queue = static_cast<DefaultWorkQueue*>(mRoot->getWorkQueue());
+    queue->setWorkerThreadCount(3);
+    queue->setWorkersCanAccessRenderSystem(false);
+    mFixture.initialise();
+}
+
+void TaskGroupTests::tearDown()
+{
+    mFixture.tearDown();
+}
+
+void TaskGroupTests::testRunTasks()
+{
+    TaskGroup group("Test/TaskGroup");
+
+    vector<CountingTask>::type tasks(100);
+    TaskGroup::TaskList taskList;
+    for (size_t i = 0; i < tasks.size(); ++i)
+        taskList.push_back(&tasks[i]);
+
+    for (int run = 0; run < 20; ++run)
+        group.run(taskList);
+
+    for (size_t i = 0; i < tasks.size(); ++i)
+        CPPUNIT_ASSERT_EQUAL((size_t)20, tasks[i].count);
+}
+
+void TaskGroupTests::testRunEmptyList()
+{
+    TaskGroup group("Test/TaskGroup");
+    group.run(TaskGroup::TaskList());
+}
+
+void TaskGroupTests::testParallelSceneGraphUpdate()
+{
+    SceneManager* serial = mRoot->createSceneManager(ST_GENERIC);
+    SceneManager* parallel = mRoot->createSceneManager(ST_GENERIC);
+    parallel->setParallelSceneGraphUpdateEnabled(true);
+    CPPUNIT_ASSERT(parallel->isParallelSceneGraphUpdateEnabled());
+
+    // Same seed for both graphs so they are identical
+    vector<SceneNode*>::type serialNodes, parallelNodes;
+    SceneManager* managers[2] = { serial, parallel };
+    vector<SceneNode*>::type* nodeLists[2] = { &serialNodes, &parallelNodes };
+    for (int m = 0; m < 2; ++m)
+    {
+        srand(4321);
+        vector<SceneNode*>::type& nodes = *nodeLists[m];
+        nodes.push_back(managers[m]->getRootSceneNode());
+        for (size_t i = 1; i < 500; ++i)
+        {
+            // Bias towards shallow nodes so that the root has many subtrees
+            SceneNode* parent = nodes[rand() % std::min(i, (size_t)40)];
+            SceneNode* node = parent->createChildSceneNode(
+                Vector3(Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10)),
+                Quaternion(Radian(Math::RangeRandom(-Math::PI, Math::PI)), Vector3::UNIT_Y));
+            node->setScale(Math::RangeRandom(0.5, 2), 1, 1);
+            nodes.push_back(node);
+        }
+    }
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        serial->_updateSceneGraph(0);
+        parallel->_updateSceneGraph(0);
+        for (size_t i = 0; i < serialNodes.size(); ++i)
+        {
+            CPPUNIT_ASSERT(serialNodes[i]->_getDerivedPosition().positionEquals(
+                parallelNodes[i]->_getDerivedPosition(), 1e-3f));
+            CPPUNIT_ASSERT(serialNodes[i]->_getDerivedOrientation().equals(
+                parallelNodes[i]->_getDerivedOrientation(), Radian(1e-3f)));
+        }
+
+        // Move a few nodes, including the root, for the next frame
+        for (size_t i = 0; i < serialNodes.size(); i += 23)
+        {
+            serialNodes[i]->translate(1, 0, frame);
+            parallelNodes[i]->translate(1, 0, frame);
+        }
+    }
+
+    mRoot->destroySceneManager(parallel);
+    mRoot->destroySceneManager(serial);
+}
+
+void TaskGroupTests::testParallelSceneGraphUpdateDeepGraph()
+{
+    SceneManager* serial = mRoot->createSceneManager(ST_GENERIC);
+    SceneManager* parallel = mRoot->createSceneManager(ST_GENERIC);
+    parallel->setParallelSceneGraphUpdateEnabled(true);
+
+    // A chain below the root ending in a binary tree, with an object on
+    // every node so that the bounds of the split nodes are checked too
+    vector<MovableObject*>::type queued;
+    vector<QueuedOrderObject*>::type objects;
+    vector<SceneNode*>::type serialNodes, parallelNodes;
+    SceneManager* managers[2] = { serial, parallel };
+    vector<SceneNode*>::type* nodeLists[2] = { &serialNodes, &parallelNodes };
+    for (int m = 0; m < 2; ++m)
+    {
+        vector<SceneNode*>::type& nodes = *nodeLists[m];
+        nodes.push_back(managers[m]->getRootSceneNode());
+        for (size_t i = 1; i < 255; ++i)
+        {
+            SceneNode* parent = nodes[i < 4 ? i - 1 : (i - 2) / 2];
+            SceneNode* node = parent->createChildSceneNode(
+                Vector3(Real(i % 7), Real(i % 5), -Real(i % 3)),
+                Quaternion(Radian(Real(i) * 0.1f), Vector3::UNIT_Y));
+            objects.push_back(OGRE_NEW QueuedOrderObject(&queued));
+            node->attachObject(objects.back());
+            nodes.push_back(node);
+        }
+    }
+
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        serial->_updateSceneGraph(0);
+        parallel->_updateSceneGraph(0);
+        for (size_t i = 0; i < serialNodes.size(); ++i)
+        {
+            CPPUNIT_ASSERT(serialNodes[i]->_getDerivedPosition().positionEquals(
+                parallelNodes[i]->_getDerivedPosition(), 1e-3f));
+            const AxisAlignedBox& serialBox = serialNodes[i]->_getWorldAABB();
+            const AxisAlignedBox& parallelBox = parallelNodes[i]->_getWorldAABB();
+            CPPUNIT_ASSERT(serialBox.getMinimum().positionEquals(parallelBox.getMinimum(), 1e-3f));
+            CPPUNIT_ASSERT(serialBox.getMaximum().positionEquals(parallelBox.getMaximum(), 1e-3f));
+        }
+
+        // Move a node deep down the tree for the next frame
+        serialNodes[200]->translate(0, 5, 0);
+        parallelNodes[200]->translate(0, 5, 0);
+    }
+
+    mRoot->destroySceneManager(parallel);
+    mRoot->destroySceneManager(serial);
+    for (size_t i = 0; i < objects.size(); ++i)
+        OGRE_DELETE objects[i];
+}
+
+void TaskGroupTests::testParallelCulling()
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    Camera* camera = sceneMgr->createCamera("Camera");
+    camera->setPosition(0, 0, 0);
+    camera->lookAt(0, 0, -1);
+    camera->setNearClipDistance(1);
+
+    vector<MovableObject*>::type queued, objects;
+    srand(4321);
+    vector<SceneNode*>::type nodes;
+    nodes.push_back(sceneMgr->getRootSceneNode());
+    for (size_t i = 1; i < 500; ++i)
+    {
+        SceneNode* parent = nodes[rand() % std::min(i, (size_t)40)];
+        SceneNode* node = parent->createChildSceneNode(
+            Vector3(Math::RangeRandom(-50, 50), Math::RangeRandom(-50, 50), Math::RangeRandom(-50, 50)));
+        MovableObject* object = OGRE_NEW QueuedOrderObject(&queued);
+        node->attachObject(object);
+        objects.push_back(object);
+        nodes.push_back(node);
+    }
+    sceneMgr->_updateSceneGraph(camera);
+
+    VisibleObjectsBoundsInfo bounds;
+    sceneMgr->_findVisibleObjects(camera, &bounds, false);
+    vector<MovableObject*>::type serialQueued;
+    serialQueued.swap(queued);
+    CPPUNIT_ASSERT(!serialQueued.empty());
+    CPPUNIT_ASSERT(serialQueued.size() < objects.size());
+
+    sceneMgr->setParallelCullingEnabled(true);
+    CPPUNIT_ASSERT(sceneMgr->isParallelCullingEnabled());
+    for (int run = 0; run < 5; ++run)
+    {
+        sceneMgr->_findVisibleObjects(camera, &bounds, false);
+        CPPUNIT_ASSERT(serialQueued == queued);
+        queued.clear();
+    }
+
+    sceneMgr->getRootSceneNode()->removeAndDestroyAllChildren();
+    for (size_t i = 0; i < objects.size(); ++i)
+        OGRE_DELETE objects[i];
+    mRoot->destroySceneManager(sceneMgr);
+}
+
+void TaskGroupTests::testParallelCullingNodeOverride()
+{
+    SceneManager* sceneMgr = mRoot->createSceneManager(ST_GENERIC);
+    Camera* camera = sceneMgr->createCamera("Camera");
+    camera->setPosition(0, 0, 0);
+    camera->lookAt(0, 0, -1);
+    camera->setNearClipDistance(1);
+
+    // Everything is in view; the hidden node is below a visible one
+    vector<MovableObject*>::type queued, objects;
+    SceneNode* root = sceneMgr->getRootSceneNode();
+    SceneNode* visible = root->createChildSceneNode(Vector3(0, 0, -20));
+    HiddenSubtreeNode* hidden = OGRE_NEW HiddenSubtreeNode(sceneMgr);
+    visible->addChild(hidden);
+    SceneNode* hiddenChild = hidden->createChildSceneNode();
+    SceneNode* nodes[] = { visible, hidden, hiddenChild };
+    for (size_t i = 0; i < 3; ++i)
+    {
+        MovableObject* object = OGRE_NEW QueuedOrderObject(&queued);
+        nodes[i]->attachObject(object);
+        objects.push_back(object);
+    }
+    sceneMgr->_updateSceneGraph(camera);
+
+    sceneMgr->setParallelCullingEnabled(true);
+    VisibleObjectsBoundsInfo bounds;
+    sceneMgr->_findVisibleObjects(camera, &bounds, false);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, hidden->calls);
+    CPPUNIT_ASSERT_EQUAL((size_t)1, queued.size());
+    CPPUNIT_ASSERT(queued[0] == objects[0]);
+
+    visible->removeChild(hidden);
+    hidden->removeAndDestroyAllChildren();
+    OGRE_DELETE hidden;
+    root->removeAndDestroyAllChildren();
+    for (size_t i = 0; i < objects.size(); ++i)
+        OGRE_DELETE objects[i];
+    mRoot->destroySceneManager(sceneMgr);
+}
+
+void TaskGroupTests::testParallelResourceLoading()
+{
+    ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+    rgm.createResourceGroup("ParallelLoading");
+    CountingResourceManager* manager = OGRE_NEW CountingResourceManager();
+    vector<ResourcePtr>::type resources;
+    for (int i = 0; i < 50; ++i)
+        resources.push_back(manager->create("Resource" + StringConverter::toString(i), "ParallelLoading"));
+
+    LoadOrderListener listener;
+    rgm.addResourceGroupListener(&listener);
+    rgm.setParallelLoadingEnabled(true);
+    CPPUNIT_ASSERT(rgm.isParallelLoadingEnabled());
+    rgm.loadResourceGroup("ParallelLoading");
+    rgm.setParallelLoadingEnabled(false);
+    rgm.removeResourceGroupListener(&listener);
+
+    CPPUNIT_ASSERT(rgm.isResourceGroupLoaded("ParallelLoading"));
+    // Events are reported for every resource, in the order they were created
+    CPPUNIT_ASSERT_EQUAL(resources.size(), listener.expectedCount);
+    CPPUNIT_ASSERT_EQUAL(resources.size(), listener.endedCount);
+    CPPUNIT_ASSERT_EQUAL(resources.size(), listener.loaded.size());
+    for (size_t i = 0; i < resources.size(); ++i)
+    {
+        CountingResource* res = static_cast<CountingResource*>(resources[i].get());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Resource*>(res), listener.loaded[i]);
+        CPPUNIT_ASSERT(res->isLoaded());
+        CPPUNIT_ASSERT_EQUAL((size_t)1, res->prepareCount.get());
+        CPPUNIT_ASSERT_EQUAL((size_t)1, res->loadCount);
+    }
+
+    resources.clear();
+    rgm.destroyResourceGroup("ParallelLoading");
+    OGRE_DELETE manager;
+}
+
+void TaskGroupTests::testScriptPreParsing()
+{
+    ScriptCompilerManager& compilerMgr = ScriptCompilerManager::getSingleton();
+    StringVector scripts(20);
+    vector<DataStreamPtr>::type streams;
+    for (size_t i = 0; i < scripts.size(); ++i)
+    {
+        String name = "PreParsed" + StringConverter::toString(i);
+        scripts[i] = "material " + name + "\n{\n technique\n {\n pass\n {\n }\n }\n}\n";
+        streams.push_back(DataStreamPtr(OGRE_NEW MemoryDataStream(name + ".material",
+            &scripts[i][0], scripts[i].size())));
+    }
+
+    // Pre-parse the scripts across threads, as initialising a resource group does
+    struct PreParseTask : public TaskGroup::Task
+    {
+        DataStreamPtr stream;
+        void execute(void)
+        {
+            ScriptCompilerManager::getSingleton().preParseScript(stream, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        }
+    };
+    vector<PreParseTask>::type tasks(streams.size());
+    TaskGroup::TaskList taskList;
+    for (size_t i = 0; i < streams.size(); ++i)
+    {
+        tasks[i].stream = streams[i];
+        taskList.push_back(&tasks[i]);
+    }
+    TaskGroup group("Test/TaskGroup");
+    group.run(taskList);
+
+    // The text has been read, so the materials can only come from the pre-parsed nodes
+    for (size_t i = 0; i < streams.size(); ++i)
+    {
+        CPPUNIT_ASSERT(streams[i]->eof());
+        compilerMgr.parseScript(streams[i], ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+        CPPUNIT_ASSERT(MaterialManager::getSingleton().resourceExists("PreParsed" + StringConverter::toString(i)));
+    }
+}
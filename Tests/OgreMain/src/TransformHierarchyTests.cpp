@@ -0,0 +1,126 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "TransformHierarchyTests.h"
+#include "OgreTransformHierarchy.h"
+#include "OgreSceneNode.h"
+#include "OgreMath.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( TransformHierarchyTests );
+
+using namespace Ogre;
+
+void TransformHierarchyTests::setUp()
+{
+    mHierarchy = OGRE_NEW TransformHierarchy();
+    createTree(mReferenceNodes);
+    createTree(mHierarchyNodes);
+}
+
+void TransformHierarchyTests::tearDown()
+{
+    OGRE_DELETE mHierarchy;
+    for (size_t i = 0; i < mReferenceNodes.size(); ++i)
+    {
+        OGRE_DELETE mReferenceNodes[i];
+        OGRE_DELETE mHierarchyNodes[i];
+    }
+    mReferenceNodes.clear();
+    mHierarchyNodes.clear();
+}
+
+void TransformHierarchyTests::createTree(NodeList& nodes)
+{
+    // Same seed for both trees so they are identical
+    srand(1234);
+    nodes.push_back(OGRE_NEW SceneNode(0));
+    for (size_t i = 1; i < 200; ++i)
+    {
+        SceneNode* node = OGRE_NEW SceneNode(0);
+        node->setPosition(Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10), Math::RangeRandom(-10, 10));
+        node->setOrientation(Quaternion(Radian(Math::RangeRandom(-Math::PI, Math::PI)),
+            Vector3(Math::RangeRandom(-1, 1), Math::RangeRandom(-1, 1), 1).normalisedCopy()));
+        node->setScale(Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2), Math::RangeRandom(0.5, 2));
+        node->setInheritOrientation(i % 7 != 0);
+        node->setInheritScale(i % 5 != 0);
+        nodes[rand() % i]->addChild(node);
+        nodes.push_back(node);
+    }
+}
+
+void TransformHierarchyTests::updateAndCompare()
+{
+    mReferenceNodes[0]->_update(true, false);
+    mHierarchy->_update(mHierarchyNodes[0]);
+
+    for (size_t i = 0; i < mReferenceNodes.size(); ++i)
+    {
+        const SceneNode* reference = mReferenceNodes[i];
+        const SceneNode* node = mHierarchyNodes[i];
+        CPPUNIT_ASSERT(reference->_getDerivedPosition().positionEquals(node->_getDerivedPosition(), 1e-3f));
+        CPPUNIT_ASSERT(reference->_getDerivedOrientation().equals(node->_getDerivedOrientation(), Radian(1e-3f)));
+        CPPUNIT_ASSERT(reference->_getDerivedScale().positionEquals(node->_getDerivedScale(), 1e-3f));
+    }
+}
+
+void TransformHierarchyTests::testInitialUpdate()
+{
+    updateAndCompare();
+    CPPUNIT_ASSERT_EQUAL(mReferenceNodes.size(), mHierarchy->getNumNodes());
+}
+
+void TransformHierarchyTests::testPartialUpdate()
+{
+    updateAndCompare();
+    for (size_t i = 3; i < mReferenceNodes.size(); i += 17)
+    {
+        mReferenceNodes[i]->translate(1, 2, 3);
+        mHierarchyNodes[i]->translate(1, 2, 3);
+        mReferenceNodes[i]->yaw(Degree(30));
+        mHierarchyNodes[i]->yaw(Degree(30));
+    }
+    updateAndCompare();
+}
+
+void TransformHierarchyTests::testReparenting()
+{
+    updateAndCompare();
+
+    // Make a chain out of a few nodes; a node never has a descendant with a
+    // lower index, so this cannot create a cycle
+    for (size_t i = 10; i < 20; ++i)
+    {
+        mReferenceNodes[i]->getParent()->removeChild(mReferenceNodes[i]);
+        mReferenceNodes[i - 1]->addChild(mReferenceNodes[i]);
+        mHierarchyNodes[i]->getParent()->removeChild(mHierarchyNodes[i]);
+        mHierarchyNodes[i - 1]->addChild(mHierarchyNodes[i]);
+    }
+    updateAndCompare();
+    CPPUNIT_ASSERT_EQUAL(mReferenceNodes.size(), mHierarchy->getNumNodes());
+    CPPUNIT_ASSERT(mHierarchy->getNumLevels() >= 12);
+}
@@ -0,0 +1,180 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2013 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "WorkQueueTests.h"
+#include "OgreRoot.h"
+#include "Threading/OgreDefaultWorkQueue.h"
+
+// Register the suite
+CPPUNIT_TEST_SUITE_REGISTRATION( WorkQueueTests );
+
+using namespace Ogre;
+
+namespace {
+    // Handler recording which requests it processed, and on which thread
+    class RecordingHandler : public WorkQueue::RequestHandler
+    {
+    public:
+        OGRE_MUTEX(mutex)
+        vector<WorkQueue::RequestID>::type processed;
+        set<String>::type threads;
+
+        WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
+        {
+            {
+                OGRE_LOCK_MUTEX(mutex)
+                processed.push_back(req->getID());
+                StringUtil::StrStreamType thread;
+                thread << OGRE_THREAD_CURRENT_ID;
+                threads.insert(thread.str());
+            }
+            return OGRE_NEW WorkQueue::Response(req, true, Any());
+        }
+
+        size_t getNumProcessed(void)
+        {
+            OGRE_LOCK_MUTEX(mutex)
+            return processed.size();
+        }
+
+        // Wait for the workers to get through a number of requests
+        bool waitForProcessed(size_t count)
+        {
+            for (int i = 0; i < 1000 && getNumProcessed() < count; ++i)
+                OGRE_THREAD_SLEEP(10);
+            return getNumProcessed() == count;
+        }
+    };
+}
+
+void WorkQueueTests::setUp()
+{
+    mRoot = OGRE_NEW Root("");
+}
+
+void WorkQueueTests::tearDown()
+{
+    OGRE_DELETE mRoot;
+}
+
+void WorkQueueTests::testPriorities()
+{
+#if OGRE_THREAD_SUPPORT
+    DefaultWorkQueueBase::RequestScheduling schedulings[2] =
+        { DefaultWorkQueueBase::RS_SHARED_QUEUE, DefaultWorkQueueBase::RS_WORK_STEALING };
+    for (int s = 0; s < 2; ++s)
+    {
+        // No workers, so requests are only processed when asked to
+        DefaultWorkQueue queue("Test");
+        queue.setWorkerThreadCount(0);
+        queue.setRequestScheduling(schedulings[s]);
+        queue.startup();
+
+        RecordingHandler handler;
+        queue.addRequestHandler(1, &handler);
+        queue.addRequestHandler(2, &handler);
+        queue.setChannelPriority(2, 10);
+        CPPUNIT_ASSERT_EQUAL((uint8)10, queue.getChannelPriority(2));
+        CPPUNIT_ASSERT_EQUAL((uint8)0, queue.getChannelPriority(1));
+
+        WorkQueue::RequestID low1 = queue.addRequest(1, 0, Any());
+        WorkQueue::RequestID high1 = queue.addRequest(2, 0, Any());
+        WorkQueue::RequestID low2 = queue.addRequest(1, 0, Any());
+        WorkQueue::RequestID high2 = queue.addRequest(2, 0, Any());
+
+        for (int i = 0; i < 4; ++i)
+            queue._processNextRequest();
+
+        CPPUNIT_ASSERT_EQUAL((size_t)4, handler.processed.size());
+        CPPUNIT_ASSERT_EQUAL(high1, handler.processed[0]);
+        CPPUNIT_ASSERT_EQUAL(high2, handler.processed[1]);
+        CPPUNIT_ASSERT_EQUAL(low1, handler.processed[2]);
+        CPPUNIT_ASSERT_EQUAL(low2, handler.processed[3]);
+
+        queue.removeRequestHandler(1, &handler);
+        queue.removeRequestHandler(2, &handler);
+    }
+#endif
+}
+
+void WorkQueueTests::testWorkStealing()
+{
+#if OGRE_THREAD_SUPPORT
+    DefaultWorkQueue queue("Test");
+    queue.setWorkerThreadCount(3);
+    queue.setRequestScheduling(DefaultWorkQueueBase::RS_WORK_STEALING);
+    queue.startup();
+
+    RecordingHandler handler;
+    queue.addRequestHandler(1, &handler);
+
+    set<WorkQueue::RequestID>::type ids;
+    for (int i = 0; i < 300; ++i)
+        ids.insert(queue.addRequest(1, 0, Any()));
+
+    CPPUNIT_ASSERT(handler.waitForProcessed(ids.size()));
+    queue.processResponses();
+    set<WorkQueue::RequestID>::type processed(handler.processed.begin(), handler.processed.end());
+    CPPUNIT_ASSERT(processed == ids);
+
+    queue.removeRequestHandler(1, &handler);
+    queue.shutdown();
+#endif
+}
+
+void WorkQueueTests::testChannelAffinity()
+{
+#if OGRE_THREAD_SUPPORT
+    DefaultWorkQueue queue("Test");
+    queue.setWorkerThreadCount(3);
+    queue.setRequestScheduling(DefaultWorkQueueBase::RS_WORK_STEALING);
+    queue.startup();
+
+    RecordingHandler bound, unbound;
+    queue.addRequestHandler(1, &bound);
+    queue.addRequestHandler(2, &unbound);
+    queue.setChannelAffinity(1, 1);
+
+    vector<WorkQueue::RequestID>::type ids;
+    for (int i = 0; i < 100; ++i)
+    {
+        ids.push_back(queue.addRequest(1, 0, Any()));
+        queue.addRequest(2, 0, Any());
+    }
+
+    CPPUNIT_ASSERT(bound.waitForProcessed(100));
+    CPPUNIT_ASSERT(unbound.waitForProcessed(100));
+    queue.processResponses();
+    // One thread takes them all, one at a time in order
+    CPPUNIT_ASSERT_EQUAL((size_t)1, bound.threads.size());
+    CPPUNIT_ASSERT(bound.processed == ids);
+
+    queue.removeRequestHandler(1, &bound);
+    queue.removeRequestHandler(2, &unbound);
+    queue.shutdown();
+#endif
+}
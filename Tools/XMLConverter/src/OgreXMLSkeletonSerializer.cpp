@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgreAnimation.h"
 #include "OgreAnimationTrack.h"
 #include "OgreKeyFrame.h"
+#include "OgreCompressedTransformKeys.h"
 #include "OgreBone.h"
 #include "OgreString.h"
 #include "OgreLogManager.h"
@@ -590,6 +591,19 @@ namespace Ogre {
         // Write all keyframes
         TiXmlElement* keysNode = 
             trackNode->InsertEndChild(TiXmlElement("keyframes"))->ToElement();
+        const CompressedTransformKeys* keys = track->getCompressedKeys();
+        if (keys)
+        {
+            // No compressed form in XML, write the decoded keys
+            for (size_t i = 0; i < keys->getNumKeys(); ++i)
+            {
+                TransformKeyFrame key(0, keys->getTime(i));
+                key.setRotation(keys->getRotation(i));
+                key.setTranslate(keys->getTranslate(i));
+                key.setScale(keys->getScale(i));
+                writeKeyFrame(keysNode, &key);
+            }
+        }
         for (unsigned short i = 0; i < track->getNumKeyFrames(); ++i)
         {
             writeKeyFrame(keysNode, track->getNodeKeyFrame(i));